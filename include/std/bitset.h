@@ -0,0 +1,361 @@
+/*
+ * std/bitset.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_BITSET_H_
+#define STD_BITSET_H_
+
+#include "std/vector.h"
+
+/*
+ * A bitset is a growable array of bits, packed 64 to a word into a vector
+ * of uint64_t (so it uses the same memory handler plumbing as a vector). Its
+ * items are therefore words: std_size(), std_at() and the iterators all
+ * work on words, while std_bitset_size() gives the number of bits. Any bits
+ * in the final word beyond the end of the bitset are always zero.
+ *
+ * Counting, searching and combining bitsets all work a whole word at a time
+ * (popcount, count trailing zeros, and plain word-wide logic), so they cost
+ * O(n/64). Setting a bit beyond the end of a bitset grows it to fit.
+ *
+ * std_bitset_rank() and std_bitset_select() use a directory holding the
+ * number of set bits before each block of STD_BITSET_RANK_BLOCK_WORDS words,
+ * which is rebuilt (in O(n/64)) the first time either is called after the
+ * bitset has changed. After that, rank is O(1) and select is O(log n).
+ * Because of this, they take the container's lock for writing.
+ */
+
+// Value returned by searches that find no set bit
+#define STD_BITSET_NPOS					((size_t)-1)
+
+#ifndef STD_BITSET_RANK_BLOCK_WORDS
+#define STD_BITSET_RANK_BLOCK_WORDS		8U
+#endif
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;
+	size_t szNumBits;
+	size_t * pszRankBlocks;			// Number of set bits before each block of words
+	size_t szNumRankBlocksAlloced;
+	bool bRankValid;				// True if the rank directory is up to date
+} std_bitset_t;
+
+#define STD_BITSET_DECLARE(HAS_ENUM,...)	\
+		STD_VECTOR(std_bitset_t, std_vector_iterator_t, uint64_t, std_container_enum_bitset, HAS_ENUM, STD_DEFAULT_PARAMETER(std_bitset_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+// (Words need no item handler, so there are no itemhandler variants)
+#define std_bitset(...)									STD_BITSET_DECLARE(std_container_has_no_handlers,__VA_ARGS__)
+#define std_bitset_memoryhandler(...)					STD_BITSET_DECLARE(std_container_has_memoryhandler,__VA_ARGS__)
+#define std_bitset_lockhandler(...)						STD_BITSET_DECLARE(std_container_has_lockhandler,__VA_ARGS__)
+#define std_bitset_lockhandler_memoryhandler(...)		STD_BITSET_DECLARE(std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+
+extern void stdlib_bitset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_bitset_destruct(std_container_t * pstContainer);
+
+extern bool stdlib_bitset_resize(std_container_t * pstContainer, size_t szNumBits);
+extern bool stdlib_bitset_assign(std_container_t * pstContainer, size_t szBit, bool bValue);
+extern bool stdlib_bitset_flip(std_container_t * pstContainer, size_t szBit);
+extern bool stdlib_bitset_test(std_container_t * pstContainer, size_t szBit);
+extern size_t stdlib_bitset_count(std_container_t * pstContainer);
+extern size_t stdlib_bitset_find_from(std_container_t * pstContainer, size_t szBit);
+extern size_t stdlib_bitset_rank(std_container_t * pstContainer, size_t szBit);
+extern size_t stdlib_bitset_select(std_container_t * pstContainer, size_t szRank);
+
+extern bool stdlib_bitset_and(std_container_t * pstContainer, std_container_t * pstOther);
+extern bool stdlib_bitset_or(std_container_t * pstContainer, std_container_t * pstOther);
+extern bool stdlib_bitset_xor(std_container_t * pstContainer, std_container_t * pstOther);
+extern bool stdlib_bitset_andnot(std_container_t * pstContainer, std_container_t * pstOther);
+
+extern const std_item_handler_t std_bitset_default_itemhandler;
+
+/**
+ * Resize a bitset (any new bits are cleared)
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szNumBits		New number of bits
+ *
+ * @return True if the bitset was resized, false if memory ran out
+ */
+STD_INLINE bool std_container_call_bitset_resize(std_container_t * pstContainer, std_container_has_t eHas, size_t szNumBits)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_bitset_resize(pstContainer, szNumBits);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Set, clear or flip a bit in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szBit			Bit index
+ * @param[in]	bFlip			If true, flip the bit (rather than assigning a value to it)
+ * @param[in]	bValue			Value to assign to the bit (ignored when flipping)
+ *
+ * @return True if the bit was modified, false if memory ran out
+ */
+STD_INLINE bool std_container_call_bitset_modify(std_container_t * pstContainer, std_container_has_t eHas, size_t szBit, bool bFlip, bool bValue)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = bFlip ? stdlib_bitset_flip(pstContainer, szBit) : stdlib_bitset_assign(pstContainer, szBit, bValue);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Test a bit in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szBit			Bit index
+ *
+ * @return True if the bit is set, false if it is clear (or beyond the end of the bitset)
+ */
+STD_INLINE bool std_container_call_bitset_test(std_container_t * pstContainer, std_container_has_t eHas, size_t szBit)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	bool bResult = stdlib_bitset_test(pstContainer, szBit);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Count the set bits in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return Number of set bits
+ */
+STD_INLINE size_t std_container_call_bitset_count(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	size_t szCount = stdlib_bitset_count(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szCount;
+}
+
+/**
+ * Find the first set bit in a bitset at or after a bit index
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szBit			Bit index to start searching from
+ *
+ * @return Index of the set bit (or STD_BITSET_NPOS if there isn't one)
+ */
+STD_INLINE size_t std_container_call_bitset_find_from(std_container_t * pstContainer, std_container_has_t eHas, size_t szBit)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	size_t szFound = stdlib_bitset_find_from(pstContainer, szBit);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szFound;
+}
+
+/**
+ * Find the rank of a bit (or the bit with a given rank) in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValue			Bit index (for rank) or rank (for select)
+ * @param[in]	bSelect			If true, select rather than rank
+ *
+ * @return Number of set bits before the bit index (for rank), or index of the set bit with that rank (for select)
+ */
+STD_INLINE size_t std_container_call_bitset_rank_select(std_container_t * pstContainer, std_container_has_t eHas, size_t szValue, bool bSelect)
+{
+	// These may rebuild the rank directory, so need write access
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	size_t szResult = bSelect ? stdlib_bitset_select(pstContainer, szValue) : stdlib_bitset_rank(pstContainer, szValue);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szResult;
+}
+
+/**
+ * Combine one bitset into another, word by word
+ *
+ * @param[in]	pstContainer	Destination bitset container
+ * @param[in]	pstOther		Other bitset container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[in]	pfnCombine		Library-side combining function
+ *
+ * @return True if the bitsets were combined, false if memory ran out
+ */
+STD_INLINE bool std_container_call_bitset_combine(std_container_t * pstContainer, std_container_t * pstOther, std_container_has_t eHas, bool (*pfnCombine)(std_container_t * pstContainer, std_container_t * pstOther))
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	std_lock_state_t eOldOtherState = std_container_lock_for_reading(pstOther, eHas);
+	bool bResult = (*pfnCombine)(pstContainer, pstOther);
+	std_container_lock_restore(pstOther, eHas, eOldOtherState);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+#define STD_BITSET_ENUM_CHECK(B)		STD_CONTAINER_ENUM_CHECK(B, std_container_enum_bitset)
+
+#define std_bitset_size(B)				(STD_BITSET_ENUM_CHECK(B), B.stBody.szNumBits)
+
+#define std_bitset_resize(B,NUMBITS)											\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_resize(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), NUMBITS)	\
+	)
+
+// Set a bit (growing the bitset if needed), returning false if memory ran out
+#define std_bitset_set(B,BIT)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_modify(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT, false, true)	\
+	)
+
+#define std_bitset_clear(B,BIT)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_modify(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT, false, false)	\
+	)
+
+#define std_bitset_assign(B,BIT,VALUE)											\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_modify(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT, false, VALUE)	\
+	)
+
+#define std_bitset_flip(B,BIT)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_modify(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT, true, false)	\
+	)
+
+#define std_bitset_test(B,BIT)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_test(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT)	\
+	)
+
+// Number of set bits
+#define std_bitset_count(B)														\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_count(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B))	\
+	)
+
+// Visit every set bit, e.g. for (szBit = std_bitset_find_first(set); szBit != STD_BITSET_NPOS; szBit = std_bitset_find_next(set, szBit))
+#define std_bitset_find_first(B)												\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_find_from(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), 0U)	\
+	)
+
+// Find the first set bit after BIT
+#define std_bitset_find_next(B,BIT)												\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_find_from(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), (BIT) + 1U)	\
+	)
+
+// Number of set bits before BIT
+#define std_bitset_rank(B,BIT)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_rank_select(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), BIT, false)	\
+	)
+
+// Index of the set bit with RANK set bits before it (or STD_BITSET_NPOS if there are too few set bits)
+#define std_bitset_select(B,RANK)												\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		std_container_call_bitset_rank_select(&B.stBody.stContainer, STD_CONTAINER_HAS_GET(B), RANK, true)	\
+	)
+
+// B &= OTHER (bits beyond the end of OTHER are cleared)
+#define std_bitset_and(B,OTHER)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		STD_CHECK_SAME_CONTAINERS(B,OTHER),										\
+		std_container_call_bitset_combine(&B.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(B), &stdlib_bitset_and)	\
+	)
+
+// B |= OTHER (growing B to at least the size of OTHER)
+#define std_bitset_or(B,OTHER)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		STD_CHECK_SAME_CONTAINERS(B,OTHER),										\
+		std_container_call_bitset_combine(&B.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(B), &stdlib_bitset_or)	\
+	)
+
+// B ^= OTHER (growing B to at least the size of OTHER)
+#define std_bitset_xor(B,OTHER)													\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		STD_CHECK_SAME_CONTAINERS(B,OTHER),										\
+		std_container_call_bitset_combine(&B.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(B), &stdlib_bitset_xor)	\
+	)
+
+// B &= ~OTHER (a set difference)
+#define std_bitset_andnot(B,OTHER)												\
+	(																			\
+		STD_BITSET_ENUM_CHECK(B),												\
+		STD_CHECK_SAME_CONTAINERS(B,OTHER),										\
+		std_container_call_bitset_combine(&B.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(B), &stdlib_bitset_andnot)	\
+	)
+
+enum
+{
+	std_bitset_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_BITSET_JUMPTABLE \
+	.pachContainerName = "bitset",									\
+	.pfn_construct		= &stdlib_bitset_construct,					\
+	.pfn_destruct		= &stdlib_bitset_destruct,					\
+	.pfn_at				= &stdlib_vector_at,						\
+	.astIterators =													\
+	{																\
+		[std_iterator_enum_forward] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},															\
+		[std_iterator_enum_reverse] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}															\
+	},																\
+	.pstDefaultItemHandler = &std_bitset_default_itemhandler
+
+#endif /* STD_BITSET_H_ */
@@ -0,0 +1,364 @@
+/*
+ * std/cache.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_CACHE_H_
+#define STD_CACHE_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+
+/*
+ * A cache is a bounded map of { stKey, stValue } entries, which evicts
+ * entries to stay within a capacity (in entries, in bytes, or both). Each
+ * entry is charged a cost in bytes (sizeof the entry, unless given one when
+ * it's put), and a capacity of zero means unlimited.
+ *
+ * Entries live in a node array, indexed by an open-addressed (linear
+ * probing) hash table of node indices, and the nodes are threaded onto an
+ * intrusive circular recency ring. The ring is used in one of two ways:
+ *	- LRU: getting an entry moves it to the head of the ring, and the
+ *	  victim is always the entry at the tail
+ *	- CLOCK: getting an entry just sets its referenced bit (so gets never
+ *	  relink nodes), and a hand sweeps the ring for a victim, giving each
+ *	  referenced entry a second chance (by clearing its bit) as it passes
+ * Either way, get, put, erase and evict are all O(1) (amortised, for
+ * CLOCK's sweeps).
+ *
+ * Evicted, replaced and erased entries are destructed by the cache's item
+ * handler, so pfn_Destructor doubles as the eviction callback.
+ *
+ * Note: pointers to values returned by get / peek / put only stay valid
+ * until the next put (which can evict their entry, or grow the node array).
+ *
+ * Iterating (e.g. with std_each) walks round the ring: from most to least
+ * recently used for LRU, or in the order the hand will sweep for CLOCK.
+ *
+ * As with unordered maps, keys are hashed and compared byte by byte unless
+ * hash / equality functions are set (which are passed pointers to keys).
+ */
+
+typedef enum
+{
+	std_cache_policy_lru,
+	std_cache_policy_clock
+} std_cache_policy_t;
+
+#define STD_CACHE_ENTRY(KEYTYPE,VALUETYPE,NAME)	\
+	struct NAME								\
+	{										\
+		KEYTYPE stKey;						\
+		VALUETYPE stValue;					\
+	}
+
+// The STD_CACHE macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- type smuggles, used to give easy access to (entry *), (key *) and (value *) casts
+//	- typed hash and equality functions (on keys)
+//	- an iterator smuggle, used to give easy access to associated iterators
+// Note: entries aren't wrapped, so the wrapped item size passes the key's size down instead
+#define STD_CACHE(BASE, ITBASE, KEYTYPE, VALUETYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, ENTRYNAME, KEYWRAPPER, VALUEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(KEYWRAPPER,KEYTYPE) * pstKeyWrapper;			\
+		STD_TYPE_SET(VALUEWRAPPER,VALUETYPE) * pstValueWrapper;		\
+		STD_CACHE_ENTRY(STD_TYPE_GET(KEYWRAPPER),STD_TYPE_GET(VALUEWRAPPER),ENTRYNAME) * pstEntry;	\
+		\
+		BASE 	   			 stBody;					\
+		struct ENTRYNAME		*	pstType;			\
+		STD_TYPE_GET(KEYWRAPPER)	*	pstKey;			\
+		STD_TYPE_GET(VALUEWRAPPER)	*	pstValue;		\
+		STD_HASH(const STD_TYPE_GET(KEYWRAPPER), pfnHash);		\
+		STD_EQUAL(const STD_TYPE_GET(KEYWRAPPER), pfnEqual);	\
+		\
+		STD_ITERATORS(ITBASE, struct ENTRYNAME, UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct ENTRYNAME, stValue));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(KEYWRAPPER)));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+typedef struct
+{
+	uint32_t u32Prev;				// Previous node round the recency ring
+	uint32_t u32Next;				// Next node round the recency ring (or the next free node)
+	uint32_t u32Hash;				// Hash of the node's key
+	bool bReferenced;				// CLOCK: set when the entry is got, cleared as the hand passes
+	size_t szCost;					// Bytes charged for the entry
+} std_cache_node_t;
+
+typedef struct
+{
+	std_container_t stContainer;
+	pfn_std_hash_t pfnHash;			// Hash function (or NULL to hash the key's bytes)
+	pfn_std_equal_t pfnEqual;		// Equality function (or NULL to compare the key's bytes)
+	size_t szKeySizeof;				// Size of the key at the start of each entry
+	std_cache_policy_t ePolicy;		// Which victim to evict
+	size_t szMaxItems;				// Capacity in entries (or zero for no limit)
+	size_t szMaxBytes;				// Capacity in bytes (or zero for no limit)
+	size_t szNumBytes;				// Bytes charged for the entries currently held
+	void * pvEntries;				// Entry of each node
+	std_cache_node_t * pstNodes;	// Every node allocated so far
+	size_t szNumNodesAlloced;		// Number of nodes (and entries) allocated
+	uint32_t * pu32Index;			// Hash index of node indices (a power of two in size)
+	size_t szIndexCapacity;			// Number of hash index slots
+	uint32_t u32Head;				// LRU: most recently used node, CLOCK: the hand (or UINT32_MAX)
+	uint32_t u32FreeNode;			// First free node (or UINT32_MAX)
+	uint32_t u32NumUsedNodes;		// Number of nodes ever handed out
+} std_cache_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	uint32_t u32Node;
+	size_t szNumLeft;
+} std_cache_iterator_t;
+
+// Client-side declaration code
+
+#define STD_CACHE_DECLARE(K,V,HAS_ENUM,...)	\
+	STD_CACHE(std_cache_t, std_cache_iterator_t, K, V, std_container_enum_cache, HAS_ENUM, STD_DEFAULT_PARAMETER(std_cache_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_cache(K,V,...)											STD_CACHE_DECLARE(K,V,std_container_has_no_handlers,__VA_ARGS__)
+#define std_cache_itemhandler(K,V,...)								STD_CACHE_DECLARE(K,V,std_container_has_itemhandler,__VA_ARGS__)
+#define std_cache_memoryhandler(K,V,...)							STD_CACHE_DECLARE(K,V,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_cache_memoryhandler_itemhandler(K,V,...)				STD_CACHE_DECLARE(K,V,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_cache_lockhandler(K,V,...)								STD_CACHE_DECLARE(K,V,std_container_has_lockhandler,__VA_ARGS__)
+#define std_cache_lockhandler_itemhandler(K,V,...)					STD_CACHE_DECLARE(K,V,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_cache_lockhandler_memoryhandler(K,V,...)				STD_CACHE_DECLARE(K,V,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_cache_lockhandler_memoryhandler_itemhandler(K,V,...)	STD_CACHE_DECLARE(K,V,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods
+
+extern void stdlib_cache_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas);
+extern bool stdlib_cache_destruct(std_container_t * pstContainer);
+extern bool stdlib_cache_reserve(std_container_t * pstContainer, size_t szNewSize);
+
+extern void stdlib_cache_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual);
+extern void stdlib_cache_policy_set(std_container_t * pstContainer, std_cache_policy_t ePolicy);
+extern void stdlib_cache_capacity_set(std_container_t * pstContainer, size_t szMaxItems, size_t szMaxBytes);
+
+extern void * stdlib_cache_find(std_container_t * pstContainer, const void * pvKey, bool bTouch);
+extern void * stdlib_cache_put(std_container_t * pstContainer, const void * pvEntry, size_t szCost);
+extern bool stdlib_cache_erase(std_container_t * pstContainer, const void * pvKey);
+extern bool stdlib_cache_evict(std_container_t * pstContainer);
+
+extern void stdlib_cache_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_cache_forwarditerator_next(std_iterator_t * pstIterator);
+
+extern const std_item_handler_t std_cache_default_itemhandler;
+
+// Set the hash and equality functions that a cache uses on its keys (before putting any entries)
+#define std_cache_hash_set(C,HASH,EQUAL)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(HASH, C.pfnHash), STD_CONCAT(Incompatible_hash_functions_,__COUNTER__)), \
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(EQUAL, C.pfnEqual), STD_CONCAT(Incompatible_equality_functions_,__COUNTER__)), \
+		stdlib_cache_hash_set(&C.stBody.stContainer,(pfn_std_hash_t)(HASH),(pfn_std_equal_t)(EQUAL))	\
+	)
+
+// Set a cache's eviction policy (before putting any entries), e.g. std_cache_policy_set(cache, std_cache_policy_clock)
+#define std_cache_policy_set(C,POLICY)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		stdlib_cache_policy_set(&C.stBody.stContainer, POLICY)					\
+	)
+
+/**
+ * Set a cache's capacity (evicting entries straight away, if it now holds too many)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szMaxItems		Capacity in entries (or zero for no limit)
+ * @param[in]	szMaxBytes		Capacity in bytes (or zero for no limit)
+ */
+STD_INLINE void std_container_call_cache_capacity_set(std_container_t * pstContainer, std_container_has_t eHas, size_t szMaxItems, size_t szMaxBytes)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_cache_capacity_set(pstContainer, szMaxItems, szMaxBytes);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+}
+
+/**
+ * Find the value stored against a key in a cache
+ *
+ * Note: getting an entry counts as using it (which changes the ring), so takes the write lock
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvKey			Key to look for
+ * @param[in]	bTouch			If true, mark the entry as just used (a get), else leave it alone (a peek)
+ *
+ * @return Pointer to the value (or NULL if the key isn't in the cache)
+ */
+STD_INLINE void * std_container_call_cache_find(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvKey, bool bTouch)
+{
+	std_lock_state_t eOldState = bTouch ? std_container_lock_for_writing(pstContainer, eHas) : std_container_lock_for_reading(pstContainer, eHas);
+	void * pvEntry = stdlib_cache_find(pstContainer, pvKey, bTouch);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvEntry == NULL) ? NULL : STD_LINEAR_ADD(pvEntry, szValueOffset);
+}
+
+/**
+ * Put an entry into a cache (replacing any entry already there with the same key)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvEntry			Entry to put
+ * @param[in]	szCost			Bytes to charge for the entry
+ *
+ * @return Pointer to the stored value (or NULL if memory ran out)
+ */
+STD_INLINE void * std_container_call_cache_put(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvEntry, size_t szCost)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvSlot = stdlib_cache_put(pstContainer, pvEntry, szCost);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvSlot == NULL) ? NULL : STD_LINEAR_ADD(pvSlot, szValueOffset);
+}
+
+/**
+ * Erase the entry holding a key from a cache
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key of the entry to erase
+ *
+ * @return True if an entry was erased, false if there wasn't one
+ */
+STD_INLINE bool std_container_call_cache_erase(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_cache_erase(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Evict the policy's next victim from a cache
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return True if an entry was evicted, false if the cache was empty
+ */
+STD_INLINE bool std_container_call_cache_evict(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_cache_evict(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Typed casts for a cache's keys and values
+#define STD_CACHE_KEY_TYPEOF(C)				STD_TYPEOF(C.pstKey[0])
+#define STD_CACHE_VALUE_PTR_CAST(C,X)		((STD_TYPEOF(C.pstValue[0]) *)(X))
+
+// Set a cache's capacity in entries and/or bytes (zero for no limit), e.g. std_cache_capacity_set(cache, 1000, 0)
+#define std_cache_capacity_set(C,MAXITEMS,MAXBYTES)								\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		std_container_call_cache_capacity_set(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), MAXITEMS, MAXBYTES)	\
+	)
+
+// Get the value stored against a key (marking it as just used), e.g. pstValue = std_cache_get(cache, 42)
+#define std_cache_get(C,...)													\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		STD_CACHE_VALUE_PTR_CAST(C, std_container_call_cache_find(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), STD_CONTAINER_PAYLOAD_OFFSET_GET(C), (STD_CACHE_KEY_TYPEOF(C)[]){ __VA_ARGS__ }, true))	\
+	)
+
+// Look at the value stored against a key (without marking it as used)
+#define std_cache_peek(C,...)													\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		STD_CACHE_VALUE_PTR_CAST(C, std_container_call_cache_find(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), STD_CONTAINER_PAYLOAD_OFFSET_GET(C), (STD_CACHE_KEY_TYPEOF(C)[]){ __VA_ARGS__ }, false))	\
+	)
+
+#define std_cache_contains(C,...)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		(std_container_call_cache_find(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), 0U, (STD_CACHE_KEY_TYPEOF(C)[]){ __VA_ARGS__ }, false) != NULL)	\
+	)
+
+// Put a value against a key (replacing the key's existing entry), e.g. std_cache_put(cache, 42, { .x = 1, .y = 2 })
+#define std_cache_put(C,KEY,...)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		STD_CACHE_VALUE_PTR_CAST(C, std_container_call_cache_put(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), STD_CONTAINER_PAYLOAD_OFFSET_GET(C), (STD_ITEM_TYPEOF(C)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, sizeof(STD_ITEM_TYPEOF(C))))	\
+	)
+
+// Put a value against a key, charging it a given number of bytes, e.g. std_cache_put_sized(cache, 42, 4096, pvPage)
+#define std_cache_put_sized(C,KEY,BYTES,...)									\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		STD_CACHE_VALUE_PTR_CAST(C, std_container_call_cache_put(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), STD_CONTAINER_PAYLOAD_OFFSET_GET(C), (STD_ITEM_TYPEOF(C)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, BYTES))	\
+	)
+
+#define std_cache_erase(C,...)													\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		std_container_call_cache_erase(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C), (STD_CACHE_KEY_TYPEOF(C)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_cache_evict(C)														\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache),					\
+		std_container_call_cache_evict(&C.stBody.stContainer, STD_CONTAINER_HAS_GET(C))	\
+	)
+
+#define std_cache_num_bytes(C)			(STD_CONTAINER_ENUM_CHECK(C, std_container_enum_cache), (size_t) C.stBody.szNumBytes)
+
+enum
+{
+	std_cache_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_forward_constructnext
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_CACHE_JUMPTABLE \
+	.pachContainerName = "cache",							\
+	.pfn_construct		= &stdlib_cache_construct,			\
+	.pfn_destruct		= &stdlib_cache_destruct,			\
+	.pfn_reserve		= &stdlib_cache_reserve,			\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_cache_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_cache_forwarditerator_next,		\
+		},													\
+	},														\
+	.pstDefaultItemHandler = &std_cache_default_itemhandler
+
+#endif /* STD_CACHE_H_ */
@@ -0,0 +1,261 @@
+/*
+ * std/calendar_queue.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_CALENDAR_QUEUE_H_
+#define STD_CALENDAR_QUEUE_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+/*
+ * A calendar queue is a hierarchical timing wheel: every item is pushed with
+ * an expiry time (in whatever ticks the caller likes), and items can later be
+ * popped in bulk once they are due. Pushing, cancelling and rescheduling an
+ * item are all O(1), and no items are ever compared with each other.
+ *
+ * The wheel has STD_CALENDAR_QUEUE_NUM_LEVELS levels of 64 slots, where each
+ * level covers 64 times the span of the level below it. An item is kept on
+ * the lowest level whose span reaches from the queue's current time to the
+ * item's expiry time. As time advances, the items in each higher-level slot
+ * are cascaded down into the level below, until they reach level 0, whose
+ * slots each hold the items due at one particular tick.
+ *
+ * Pushing an item returns a handle, which stays valid until that item is
+ * popped or cancelled. Items due at the same tick are popped in no particular
+ * order, and the queue's time never goes backwards: an item pushed with an
+ * expiry time in the past is simply due immediately.
+ */
+
+#define STD_CALENDAR_QUEUE_SLOT_BITS	6U
+#define STD_CALENDAR_QUEUE_NUM_SLOTS	(1U << STD_CALENDAR_QUEUE_SLOT_BITS)
+#define STD_CALENDAR_QUEUE_NUM_LEVELS	((64U + STD_CALENDAR_QUEUE_SLOT_BITS - 1U) / STD_CALENDAR_QUEUE_SLOT_BITS)
+
+#define STD_CALENDAR_QUEUE_NODE(TYPE,NAME)	\
+	struct NAME								\
+	{										\
+		std_calendar_queue_node_t stLink;	\
+		TYPE stPayload;						\
+	}
+
+// The STD_CALENDAR_QUEUE macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (unused, but expected by the common macros)
+//	- an iterator smuggle (unused, but expected by the common macros)
+#define STD_CALENDAR_QUEUE(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, NODENAME, TYPEWRAPPER)		\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		STD_CALENDAR_QUEUE_NODE(STD_TYPE_GET(TYPEWRAPPER),NODENAME) * pstLink;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(STD_TYPE_GET(TYPEWRAPPER) const, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);			\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
+	}
+
+typedef struct std_calendar_queue_node_s std_calendar_queue_node_t;
+
+struct std_calendar_queue_node_s
+{
+	std_calendar_queue_node_t * pstPrev;	// Previous node in the same slot (circular)
+	std_calendar_queue_node_t * pstNext;	// Next node in the same slot (circular)
+	uint64_t u64Expiry;						// Time at which the item is due
+};
+
+// Handle returned when an item is pushed (NULL if the push failed)
+typedef std_calendar_queue_node_t * std_calendar_queue_handle_t;
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szPayloadOffset;
+	uint64_t u64Now;													// Current time
+	uint64_t au64Occupied[STD_CALENDAR_QUEUE_NUM_LEVELS];				// Bitmap of the non-empty slots on each level
+	std_calendar_queue_node_t * apstSlots[STD_CALENDAR_QUEUE_NUM_LEVELS][STD_CALENDAR_QUEUE_NUM_SLOTS];	// First node in each slot
+	std_node_pool_t stPool;												// Where the nodes are allocated from
+} std_calendar_queue_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+} std_calendar_queue_iterator_t;
+
+#define STD_CALENDAR_QUEUE_DECLARE(T,HAS_ENUM,...)	\
+	STD_CALENDAR_QUEUE(std_calendar_queue_t, std_calendar_queue_iterator_t, T, std_container_enum_calendar_queue, HAS_ENUM, STD_DEFAULT_PARAMETER(std_calendar_queue_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_calendar_queue(T,...)											STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_calendar_queue_itemhandler(T,...)								STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_calendar_queue_memoryhandler(T,...)								STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_calendar_queue_memoryhandler_itemhandler(T,...)					STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_calendar_queue_lockhandler(T,...)								STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_calendar_queue_lockhandler_itemhandler(T,...)					STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_calendar_queue_lockhandler_memoryhandler(T,...)					STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_calendar_queue_lockhandler_memoryhandler_itemhandler(T,...)		STD_CALENDAR_QUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_calendar_queue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_calendar_queue_destruct(std_container_t * pstContainer);
+
+extern std_calendar_queue_handle_t stdlib_calendar_queue_push(std_container_t * pstContainer, uint64_t u64Expiry, const void * pvItem);
+extern bool stdlib_calendar_queue_cancel(std_container_t * pstContainer, std_calendar_queue_handle_t pstHandle);
+extern bool stdlib_calendar_queue_reschedule(std_container_t * pstContainer, std_calendar_queue_handle_t pstHandle, uint64_t u64Expiry);
+extern size_t stdlib_calendar_queue_pop_due(std_container_t * pstContainer, uint64_t u64Time, void * pvResult, size_t szMaxItems);
+
+extern const std_item_handler_t std_calendar_queue_default_itemhandler;
+
+/**
+ * Push an item into a calendar queue
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	u64Expiry		Time at which the item is due
+ * @param[in]	pvItem			Item to push
+ *
+ * @return Handle of the pushed item (or NULL if it couldn't be pushed)
+ */
+STD_INLINE std_calendar_queue_handle_t std_container_call_calendar_queue_push(std_container_t * pstContainer, std_container_has_t eHas, uint64_t u64Expiry, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	std_calendar_queue_handle_t pstHandle = stdlib_calendar_queue_push(pstContainer, u64Expiry, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pstHandle;
+}
+
+/**
+ * Cancel (i.e. erase) an item in a calendar queue before it is due
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pstHandle		Handle of the item
+ *
+ * @return True if the item was cancelled, else false
+ */
+STD_INLINE bool std_container_call_calendar_queue_cancel(std_container_t * pstContainer, std_container_has_t eHas, std_calendar_queue_handle_t pstHandle)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_calendar_queue_cancel(pstContainer, pstHandle);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Change the time at which an item in a calendar queue is due
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pstHandle		Handle of the item
+ * @param[in]	u64Expiry		New time at which the item is due
+ *
+ * @return True if the item was rescheduled, else false
+ */
+STD_INLINE bool std_container_call_calendar_queue_reschedule(std_container_t * pstContainer, std_container_has_t eHas, std_calendar_queue_handle_t pstHandle, uint64_t u64Expiry)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_calendar_queue_reschedule(pstContainer, pstHandle, u64Expiry);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Advance a calendar queue's time, popping the items that are due by then
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	u64Time			Time to advance to
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+STD_INLINE size_t std_container_call_calendar_queue_pop_due(std_container_t * pstContainer, std_container_has_t eHas, uint64_t u64Time, void * pvResult, size_t szMaxItems)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	size_t szNum = stdlib_calendar_queue_pop_due(pstContainer, u64Time, pvResult, szMaxItems);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szNum;
+}
+
+// Push one item, e.g. hTimer = std_calendar_queue_push(cq, u64Now + 30U, pstConnection)
+#define std_calendar_queue_push(V,EXPIRY,...)								\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_calendar_queue),		\
+		std_container_call_calendar_queue_push(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), EXPIRY, (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_calendar_queue_cancel(V,HANDLE)									\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_calendar_queue),		\
+		std_container_call_calendar_queue_cancel(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE)	\
+	)
+
+#define std_calendar_queue_reschedule(V,HANDLE,EXPIRY)						\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_calendar_queue),		\
+		std_container_call_calendar_queue_reschedule(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE, EXPIRY)	\
+	)
+
+// Pop up to MAXITEMS items that are due by TIME (call again if it returns MAXITEMS, as there may be more)
+#define std_calendar_queue_pop_due(V,TIME,RESULT,MAXITEMS)					\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_calendar_queue),		\
+		STD_CHECK_TYPE(V, (RESULT)[0], pop_result_parameter),				\
+		std_container_call_calendar_queue_pop_due(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), TIME, RESULT, MAXITEMS)	\
+	)
+
+// Access the item that a handle refers to
+#define std_calendar_queue_at(V,HANDLE)										\
+	STD_ITEM_PTR_CAST(V, STD_LINEAR_ADD(HANDLE, STD_CONTAINER_PAYLOAD_OFFSET_GET(V)))
+
+// Find the time at which the item that a handle refers to is due
+#define std_calendar_queue_expiry(HANDLE)		((HANDLE)->u64Expiry)
+
+// Find a calendar queue's current time
+#define std_calendar_queue_now(V)				((V).stBody.u64Now)
+
+enum
+{
+	std_calendar_queue_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_CALENDAR_QUEUE_JUMPTABLE \
+	.pachContainerName = "calendar queue",					\
+	.pfn_construct		= &stdlib_calendar_queue_construct,	\
+	.pfn_destruct		= &stdlib_calendar_queue_destruct,	\
+	.pstDefaultItemHandler = &std_calendar_queue_default_itemhandler
+
+#endif /* STD_CALENDAR_QUEUE_H_ */
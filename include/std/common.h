@@ -38,9 +38,13 @@ SOFTWARE.
 #include "std/memory.h"
 
 typedef int  (*pfn_std_compare_t)(const void * a, const void * b);
+typedef size_t (*pfn_std_hash_t)(const void * a);
+typedef bool (*pfn_std_equal_t)(const void * a, const void * b);
 
 // Field construction helper macros (for making typed version of untyped callbacks)
 #define STD_COMPARE(T, FIELD)	int (*FIELD)(T * a, T * b)
+#define STD_HASH(T, FIELD)		size_t (*FIELD)(T * a)
+#define STD_EQUAL(T, FIELD)		bool (*FIELD)(T * a, T * b)
 
 typedef struct
 {
@@ -71,6 +75,206 @@ STD_INLINE void std_container_constructor(std_container_t * pstContainer, size_t
 	pstContainer->eHas = eHas;
 }
 
+// Container operations have no way to report that their lock timed out, so they wait for as long as it takes
+#define CONTAINER_TIMEOUT_DEFAULT	STD_LOCK_TIMEOUT_INFINITE
+
+/**
+ * Lock an untyped container
+ *
+ * @param[in]	pstContainer	The container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	bReadOnly		True if the caller only wants to lock for reading, else false
+ *
+ * @return e_std_lock_NoRestoreNeeded if no lock restore needed, else the lock state to restore to
+ */
+STD_INLINE std_lock_state_t std_container_lock(std_container_t* pstContainer, std_container_has_t eHas, bool bReadOnly)
+{
+	if (eHas & std_container_has_lockhandler)
+	{
+		return (bReadOnly)
+			? std_lock_for_reading(pstContainer->pstLockHandler, pstContainer->phLock, CONTAINER_TIMEOUT_DEFAULT)
+			: std_lock_for_writing(pstContainer->pstLockHandler, pstContainer->phLock, CONTAINER_TIMEOUT_DEFAULT);
+	}
+	return e_std_lock_NoRestoreNeeded;
+}
+
+// Lock a typed container for reading
+#define std_container_lock_for_reading(CONTAINER,HAS)	\
+			std_container_lock(CONTAINER,HAS,true)
+
+// Lock a typed container for writing
+#define std_container_lock_for_writing(CONTAINER,HAS)	\
+			std_container_lock(CONTAINER,HAS,false)
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/**
+ * Restore a container's previous lock state
+ *
+ * @param[in]	pstContainer	The container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	eOldState		Previous lock state to restore
+ */
+STD_INLINE void std_container_lock_restore(std_container_t* pstContainer, std_container_has_t eHas, std_lock_state_t eOldState)
+{
+	if (	(eHas & std_container_has_lockhandler)
+		&&	(eOldState != e_std_lock_NoRestoreNeeded)	)
+	{
+		std_lock_update(pstContainer->pstLockHandler, pstContainer->phLock, eOldState, CONTAINER_TIMEOUT_DEFAULT);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/**
+ * Lock two containers for writing, always locking the one at the lower address
+ * first (so that two threads moving items between the same two containers in
+ * opposite directions can't deadlock)
+ *
+ * @param[in]	pstFirst		First container
+ * @param[in]	pstSecond		Second container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[out]	peOldFirst		Lock state to restore the first container to
+ * @param[out]	peOldSecond		Lock state to restore the second container to
+ */
+STD_INLINE void std_container_lock_pair_for_writing(std_container_t* pstFirst, std_container_t* pstSecond, std_container_has_t eHas, std_lock_state_t* peOldFirst, std_lock_state_t* peOldSecond)
+{
+	if ((uintptr_t) pstFirst <= (uintptr_t) pstSecond)
+	{
+		*peOldFirst		= std_container_lock_for_writing(pstFirst, eHas);
+		*peOldSecond	= std_container_lock_for_writing(pstSecond, eHas);
+	}
+	else
+	{
+		*peOldSecond	= std_container_lock_for_writing(pstSecond, eHas);
+		*peOldFirst		= std_container_lock_for_writing(pstFirst, eHas);
+	}
+}
+
+/**
+ * Restore the previous lock states of two containers locked by std_container_lock_pair_for_writing()
+ *
+ * @param[in]	pstFirst		First container
+ * @param[in]	pstSecond		Second container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[in]	eOldFirst		Lock state to restore the first container to
+ * @param[in]	eOldSecond		Lock state to restore the second container to
+ */
+STD_INLINE void std_container_lock_pair_restore(std_container_t* pstFirst, std_container_t* pstSecond, std_container_has_t eHas, std_lock_state_t eOldFirst, std_lock_state_t eOldSecond)
+{
+	if ((uintptr_t) pstFirst <= (uintptr_t) pstSecond)
+	{
+		std_container_lock_restore(pstSecond, eHas, eOldSecond);
+		std_container_lock_restore(pstFirst, eHas, eOldFirst);
+	}
+	else
+	{
+		std_container_lock_restore(pstFirst, eHas, eOldFirst);
+		std_container_lock_restore(pstSecond, eHas, eOldSecond);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/**
+ * Start a locked session on an untyped container (whose lock the caller now holds)
+ *
+ * @param[in,out]	pstView		Copy of the container, to stand in for it during the session
+ */
+STD_INLINE void std_container_session_begin(std_container_t* pstView)
+{
+	// The view is only ever used by the thread holding the container's lock, so needs no locking of its own
+	pstView->pstLockHandler = NULL;
+}
+
+/**
+ * End a locked session on an untyped container (before its lock is released)
+ *
+ * @param[out]	pstContainer	The container
+ * @param[in]	pstView			Copy of the container that stood in for it during the session
+ * @param[in]	szSizeof		Size of the container
+ */
+STD_INLINE void std_container_session_end(std_container_t* pstContainer, std_container_t* pstView, size_t szSizeof)
+{
+	pstView->pstLockHandler = pstContainer->pstLockHandler;
+	memcpy(pstContainer, pstView, szSizeof);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/**
+ * Find out whether an untyped container's lock lets readers in without locking (e.g. a seqlock).
+ * If it does, the container's storage mustn't move or be freed while it's in use, as readers
+ * may still be looking at it
+ *
+ * @param[in]	pstContainer	The container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return True if it does, else false
+ */
+STD_INLINE bool std_container_has_optimistic_reads(const std_container_t* pstContainer, std_container_has_t eHas)
+{
+	return (eHas & std_container_has_lockhandler) && std_lock_has_optimistic_reads(pstContainer->pstLockHandler);
+}
+
+// State of a (possibly optimistic) read of a container
+typedef struct
+{
+	std_lock_state_t eOldState;		// Lock state to restore (for a read under a read lock)
+	uint32_t u32Sequence;			// Lock sequence number when the read started (for an optimistic read)
+	bool bReading;					// True while the read (still) needs to be done
+} std_container_read_t;
+
+/**
+ * Start reading an untyped container (optimistically if its lock supports it, else under a read lock)
+ *
+ * @param[in]	pstContainer	The container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return State of the read
+ */
+STD_INLINE std_container_read_t std_container_read_begin(std_container_t* pstContainer, std_container_has_t eHas)
+{
+	std_container_read_t stRead;
+
+	stRead.u32Sequence = 0;
+	if (std_container_has_optimistic_reads(pstContainer, eHas))
+	{
+		stRead.eOldState = e_std_lock_NoRestoreNeeded;
+		stRead.u32Sequence = std_lock_read_begin(pstContainer->pstLockHandler, pstContainer->phLock);
+	}
+	else
+	{
+		stRead.eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	}
+	stRead.bReading = (stRead.eOldState != e_std_lock_Invalid);
+	return stRead;
+}
+
+/**
+ * Finish reading an untyped container
+ *
+ * @param[in]	pstContainer	The container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in,out]	pstRead		State of the read (restarted if it has to be retried)
+ *
+ * @return True if a writer interfered with an optimistic read (so it has to be retried), else false
+ */
+STD_INLINE bool std_container_read_retry(std_container_t* pstContainer, std_container_has_t eHas, std_container_read_t* pstRead)
+{
+	if (std_container_has_optimistic_reads(pstContainer, eHas))
+	{
+		if (!std_lock_read_validate(pstContainer->pstLockHandler, pstContainer->phLock, pstRead->u32Sequence))
+		{
+			pstRead->u32Sequence = std_lock_read_begin(pstContainer->pstLockHandler, pstContainer->phLock);
+			return true;
+		}
+		return false;
+	}
+	std_container_lock_restore(pstContainer, eHas, pstRead->eOldState);
+	return false;
+}
+
 // Note: every base class should include an std_item_handler_t
 #define STD_ITEM_GET(CONTAINER)		stBody.stContainer.pstItemHandler
 
@@ -90,6 +294,8 @@ STD_INLINE void std_container_constructor(std_container_t * pstContainer, size_t
 
 #define STD_CONTAINER_ENUM_SET(ENUM)				STD_ENUM_CONTAINER_SET(ENUM) pau8ContainerEnum
 #define STD_CONTAINER_ENUM_GET(CONTAINER)			STD_ENUM_CONTAINER_GET(CONTAINER.pau8ContainerEnum)
+#define STD_CONTAINER_ENUM_CHECK(CONTAINER,ENUM)	\
+			STD_STATIC_ASSERT(STD_CONTAINER_ENUM_GET(CONTAINER) == ENUM, STD_CONCAT(operation_is_not_supported_by_this_type_of_container_,__COUNTER__))
 
 #define STD_CONTAINER_HAS_SET(ENUM)					STD_ENUM_HAS_SET(ENUM) pau8HasHandler
 #define STD_CONTAINER_HAS_GET(CONTAINER)			STD_ENUM_HAS_GET(CONTAINER.pau8HasHandler)
@@ -0,0 +1,207 @@
+/*
+ * std/concurrent_map.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_CONCURRENT_MAP_H_
+#define STD_CONCURRENT_MAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/unordered_set.h"
+#include "std/unordered_map.h"
+
+/*
+ * A concurrent map is an unordered map for sharing between threads, which
+ * doesn't serialise every access through one container-wide lock. Instead
+ * its entries are striped across a fixed number of segments by the top bits
+ * of their keys' hashes, and each segment is an unordered map of its own,
+ * with its own lock (constructed by the container's lock handler). So:
+ *	- threads only contend when their keys land in the same segment (and
+ *	  then only for writing, if the lock handler is a reader/writer lock)
+ *	- each segment grows on its own, under its own write lock, so a resize
+ *	  never stops the whole map
+ *
+ * Segments are padded out to whole cache lines, so that threads working on
+ * neighbouring segments don't falsely share their locks.
+ *
+ * Because another thread can erase or move an entry the moment a segment is
+ * unlocked, lookups copy values out rather than returning pointers, and
+ * std_concurrent_map_update() runs a callback on a value in place, under its
+ * segment's write lock (for atomic read-modify-writes).
+ *
+ * Note: there is no shared item count (a shared counter would bring back
+ * exactly the contention that striping avoids), so std_size() and
+ * std_is_empty() don't compile for concurrent maps: use
+ * std_concurrent_map_size(), which sums the segments' sizes.
+ *
+ * Without a lock handler, a concurrent map works just like an unordered map
+ * (for single-threaded use).
+ */
+
+// Number of segments (a power of two): should comfortably exceed the number of threads sharing the map
+#ifndef STD_CONCURRENT_MAP_SEGMENTS
+#define STD_CONCURRENT_MAP_SEGMENTS		64U
+#endif
+
+// Size of a cache line (segments are aligned to, and padded out to, whole cache lines)
+#ifndef STD_CONCURRENT_MAP_CACHE_LINE
+#define STD_CONCURRENT_MAP_CACHE_LINE	64U
+#endif
+
+typedef struct
+{
+	std_unorderedset_t stTable;		// The segment's entries (an unordered map)
+	std_lock_handle_t hLock;		// The segment's lock
+} std_concurrent_map_segment_t;
+
+typedef struct
+{
+	std_container_t stContainer;
+	void * pvSegmentAlloc;			// Memory allocated for the segments
+	void * pvSegments;				// The segments (cache-line aligned)
+	size_t szSegmentStride;			// Size of each segment (padded to whole cache lines)
+	size_t szNumSegments;			// Number of segments (zero if they couldn't be allocated)
+} std_concurrent_map_t;
+
+// Callback used to update a value in place, e.g. to bump a counter
+typedef void (*pfn_std_concurrent_map_update_t)(void * pvContext, void * pvValue);
+
+// Callback used to visit each entry (in no particular order)
+typedef void (*pfn_std_concurrent_map_visit_t)(void * pvContext, const void * pvEntry);
+
+// Client-side declaration code
+
+#define STD_CONCURRENT_MAP_DECLARE(K,V,HAS_ENUM,...)	\
+	STD_UNORDERED_MAP(std_concurrent_map_t, std_unorderedset_iterator_t, K, V, std_container_enum_concurrent_map, HAS_ENUM, STD_DEFAULT_PARAMETER(std_concurrent_map_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_concurrent_map(K,V,...)											STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_no_handlers,__VA_ARGS__)
+#define std_concurrent_map_itemhandler(K,V,...)								STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_itemhandler,__VA_ARGS__)
+#define std_concurrent_map_memoryhandler(K,V,...)							STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_concurrent_map_memoryhandler_itemhandler(K,V,...)				STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_concurrent_map_lockhandler(K,V,...)								STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_lockhandler,__VA_ARGS__)
+#define std_concurrent_map_lockhandler_itemhandler(K,V,...)					STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_concurrent_map_lockhandler_memoryhandler(K,V,...)				STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_concurrent_map_lockhandler_memoryhandler_itemhandler(K,V,...)	STD_CONCURRENT_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods
+
+extern void stdlib_concurrent_map_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas);
+extern bool stdlib_concurrent_map_destruct(std_container_t * pstContainer);
+extern bool stdlib_concurrent_map_reserve(std_container_t * pstContainer, size_t szNewSize);
+
+extern void stdlib_concurrent_map_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual);
+extern bool stdlib_concurrent_map_find(std_container_t * pstContainer, const void * pvKey, size_t szValueOffset, void * pvValue, size_t szValueSizeof);
+extern bool stdlib_concurrent_map_insert(std_container_t * pstContainer, const void * pvEntry, bool bReplace);
+extern bool stdlib_concurrent_map_update(std_container_t * pstContainer, const void * pvKey, size_t szValueOffset, pfn_std_concurrent_map_update_t pfnUpdate, void * pvContext);
+extern bool stdlib_concurrent_map_erase(std_container_t * pstContainer, const void * pvKey);
+extern size_t stdlib_concurrent_map_size(std_container_t * pstContainer);
+extern void stdlib_concurrent_map_visit(std_container_t * pstContainer, pfn_std_concurrent_map_visit_t pfnVisit, void * pvContext);
+
+extern const std_item_handler_t std_concurrent_map_default_itemhandler;
+
+// Note: a concurrent map locks its segments itself, so its operations are called directly (without taking the container's lock)
+
+// Set the hash and equality functions that a concurrent map uses on its keys (before any entries are inserted, or threads started)
+#define std_concurrent_map_hash_set(M,HASH,EQUAL)								\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(HASH, M.pfnHash), STD_CONCAT(Incompatible_hash_functions_,__COUNTER__)), \
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(EQUAL, M.pfnEqual), STD_CONCAT(Incompatible_equality_functions_,__COUNTER__)), \
+		stdlib_concurrent_map_hash_set(&M.stBody.stContainer,(pfn_std_hash_t)(HASH),(pfn_std_equal_t)(EQUAL))	\
+	)
+
+// Copy out the value stored against a key, e.g. if (std_concurrent_map_find(map, 42, &stValue)) { ... }
+#define std_concurrent_map_find(M,KEY,VALUE)									\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(M.pstValue[0], (VALUE)[0]), STD_CONCAT(find_result_is_inconsistent_with_value_type_,__COUNTER__)),	\
+		stdlib_concurrent_map_find(&M.stBody.stContainer, (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ KEY }, STD_CONTAINER_PAYLOAD_OFFSET_GET(M), VALUE, sizeof(M.pstValue[0]))	\
+	)
+
+#define std_concurrent_map_contains(M,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_find(&M.stBody.stContainer, (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }, 0U, NULL, 0U)	\
+	)
+
+// Insert a value against a key that isn't already in the map (returning false if it was, or memory ran out)
+#define std_concurrent_map_insert(M,KEY,...)									\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_insert(&M.stBody.stContainer, (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, false)	\
+	)
+
+// Insert a value against a key (replacing the key's existing entry, if there is one)
+#define std_concurrent_map_upsert(M,KEY,...)									\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_insert(&M.stBody.stContainer, (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, true)	\
+	)
+
+// Run a callback on the value stored against a key, under its segment's write lock (returning false if the key isn't in the map)
+#define std_concurrent_map_update(M,KEY,FN,CONTEXT)								\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_update(&M.stBody.stContainer, (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ KEY }, STD_CONTAINER_PAYLOAD_OFFSET_GET(M), FN, CONTEXT)	\
+	)
+
+#define std_concurrent_map_erase(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_erase(&M.stBody.stContainer, (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ })	\
+	)
+
+// Number of entries (summed segment by segment, so only a snapshot while other threads are writing)
+#define std_concurrent_map_size(M)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_size(&M.stBody.stContainer)						\
+	)
+
+// Visit every entry, one segment at a time (under each segment's read lock)
+#define std_concurrent_map_visit(M,FN,CONTEXT)									\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_concurrent_map),			\
+		stdlib_concurrent_map_visit(&M.stBody.stContainer, FN, CONTEXT)			\
+	)
+
+enum
+{
+	std_concurrent_map_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_CONCURRENT_MAP_JUMPTABLE \
+	.pachContainerName = "concurrent map",					\
+	.pfn_construct		= &stdlib_concurrent_map_construct,	\
+	.pfn_destruct		= &stdlib_concurrent_map_destruct,	\
+	.pfn_reserve		= &stdlib_concurrent_map_reserve,	\
+	.pstDefaultItemHandler = &std_concurrent_map_default_itemhandler
+
+#endif /* STD_CONCURRENT_MAP_H_ */
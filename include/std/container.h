@@ -30,13 +30,32 @@ SOFTWARE.
 #include "std/linear_series.h"
 
 #include "std/vector.h"
+#include "std/soa_vector.h"
+#include "std/slot_map.h"
+#include "std/bitset.h"
 #include "std/forward_list.h"
 #include "std/list.h"
+#include "std/unrolled_list.h"
 #include "std/deque.h"
 #include "std/ring.h"
 #include "std/set.h"
-
-#define CONTAINER_TIMEOUT_DEFAULT	500		// FIXME (should probably move this into the lock handler?!)
+#include "std/map.h"
+#include "std/flat_set.h"
+#include "std/flat_map.h"
+#include "std/sparse_set.h"
+#include "std/sparse_map.h"
+#include "std/graph.h"
+#include "std/priority_deque.h"
+#include "std/priority_queue.h"
+#include "std/indexed_priority_queue.h"
+#include "std/calendar_queue.h"
+#include "std/radix_heap.h"
+#include "std/skew_heap.h"
+#include "std/splay_tree.h"
+#include "std/unordered_set.h"
+#include "std/unordered_map.h"
+#include "std/concurrent_map.h"
+#include "std/cache.h"
 
 #define STD_CONTAINER_CALL(CONTAINER_INDEX,PTRFUNC)	\
 		(*std_container_jumptable_array[CONTAINER_INDEX].PTRFUNC)
@@ -71,6 +90,11 @@ SOFTWARE.
 		STD_ITERATOR_ENUM_GET(IT)	\
 	)
 
+#define STD_CHECK_SAME_CONTAINERS(V1,V2)	\
+			STD_STATIC_ASSERT(	(STD_CONTAINER_ENUM_GET(V1) == STD_CONTAINER_ENUM_GET(V2))	\
+							&&	STD_TYPES_ARE_SAME(STD_ITEM_TYPEOF(V1), STD_ITEM_TYPEOF(V2)),	\
+					STD_CONCAT(containers_are_not_the_same_type_,__COUNTER__) )
+
 #define STD_CHECK_TYPE(CONTAINER,VAR,PFN)	\
 			STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(STD_ITEM_TYPEOF(CONTAINER),VAR), \
 					PFN##_is_inconsistent_with_type_of_item_held_by_container_##__COUNTER__)
@@ -89,6 +113,9 @@ typedef struct
 	void	(* const pfn_ranged_sort)	(std_container_t * pstContainer, size_t szFirst, size_t szLast, pfn_std_compare_t pfn_Compare);
 	void *	(* const pfn_at)			(std_container_t * pstContainer, size_t szIndex);
 	bool	(* const pfn_destruct)		(std_container_t * pstContainer);
+	size_t	(* const pfn_splice)		(std_container_t * pstContainer, std_container_t * pstSource, size_t szFirst, size_t szLast);
+	bool	(* const pfn_merge)			(std_container_t * pstContainer, std_container_t * pstSource, pfn_std_compare_t pfn_Compare);
+	size_t	(* const pfn_split)			(std_iterator_t * pstIterator, std_container_t * pstDestination);
 
 	std_container_iterate_jumptable_t	astIterators[std_iterator_enum_MAX];
 
@@ -97,19 +124,45 @@ typedef struct
 
 STD_STATIC const std_container_jumptable_t std_container_jumptable_array[std_container_enum_MAX] =
 {
+	[std_container_enum_bitset]			= { STD_BITSET_JUMPTABLE },
+	[std_container_enum_cache]			= { STD_CACHE_JUMPTABLE },
+	[std_container_enum_calendar_queue]	= { STD_CALENDAR_QUEUE_JUMPTABLE },
+	[std_container_enum_concurrent_map]	= { STD_CONCURRENT_MAP_JUMPTABLE },
 	[std_container_enum_deque]			= { STD_DEQUE_JUMPTABLE },
+	[std_container_enum_flat_map]		= { STD_FLAT_MAP_JUMPTABLE },
+	[std_container_enum_flat_set]		= { STD_FLAT_SET_JUMPTABLE },
 	[std_container_enum_forward_list]	= { STD_FORWARD_LIST_JUMPTABLE },
+	[std_container_enum_graph]			= { STD_GRAPH_JUMPTABLE },
+	[std_container_enum_indexed_priorityqueue]	= { STD_INDEXED_PRIORITYQUEUE_JUMPTABLE },
 	[std_container_enum_list]			= { STD_LIST_JUMPTABLE },
-//	[std_container_enum_prioritydeque]	= { STD_PRIORITYDEQUE_JUMPTABLE },
-//	[std_container_enum_priorityqueue]	= { STD_PRIORITYQUEUE_JUMPTABLE },
+	[std_container_enum_map]			= { STD_MAP_JUMPTABLE },
+	[std_container_enum_multiset]		= { STD_MULTISET_JUMPTABLE },
+	[std_container_enum_prioritydeque]	= { STD_PRIORITYDEQUE_JUMPTABLE },
+	[std_container_enum_priorityqueue]	= { STD_PRIORITYQUEUE_JUMPTABLE },
+	[std_container_enum_radix_heap]		= { STD_RADIX_HEAP_JUMPTABLE },
 	[std_container_enum_ring]			= { STD_RING_JUMPTABLE },
 	[std_container_enum_set]			= { STD_SET_JUMPTABLE },
+	[std_container_enum_skew_heap]		= { STD_SKEW_HEAP_JUMPTABLE },
+	[std_container_enum_slot_map]		= { STD_SLOT_MAP_JUMPTABLE },
+	[std_container_enum_soa_vector]		= { STD_SOA_VECTOR_JUMPTABLE },
+	[std_container_enum_sparse_map]		= { STD_SPARSE_MAP_JUMPTABLE },
+	[std_container_enum_sparse_set]		= { STD_SPARSE_SET_JUMPTABLE },
+	[std_container_enum_splay_tree]		= { STD_SPLAY_TREE_JUMPTABLE },
+	[std_container_enum_unorderedmap]	= { STD_UNORDERED_MAP_JUMPTABLE },
+	[std_container_enum_unorderedset]	= { STD_UNORDERED_SET_JUMPTABLE },
+	[std_container_enum_unrolled_list]	= { STD_UNROLLED_LIST_JUMPTABLE },
 	[std_container_enum_vector]			= { STD_VECTOR_JUMPTABLE },
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#define std_size(V)				(V.stBody.stContainer.szNumItems)
+// (Not for concurrent maps, whose sizes are kept segment by segment: use std_concurrent_map_size() for those)
+#define std_size(V)																\
+	(																			\
+		STD_STATIC_ASSERT(STD_CONTAINER_ENUM_GET(V) != std_container_enum_concurrent_map,	\
+				STD_CONCAT(use_std_concurrent_map_size_for_concurrent_maps_,__COUNTER__)),	\
+		V.stBody.stContainer.szNumItems											\
+	)
 #define std_is_empty(V)			(std_size(V) == 0U)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -174,6 +227,13 @@ STD_INLINE void std_container_call_construct(std_container_t* pstContainer, std_
 				size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset)
 {
 	STD_CONTAINER_CALL(eContainer, pfn_construct)(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+
+	// The container's lock instance is created here (the container itself only stores the handle)
+	pstContainer->phLock = NULL;
+	if (eHas & std_container_has_lockhandler)
+	{
+		std_lock_construct(pstContainer->pstLockHandler, &pstContainer->phLock);
+	}
 }
 
 // Construct a typed container
@@ -225,52 +285,6 @@ STD_INLINE void std_container_call_construct(std_container_t* pstContainer, std_
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-/**
- * Lock an untyped container
- *
- * @param[in]	pstContainer	The container
- * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
- * @param[in]	bReadOnly		True if the caller only wants to lock for reading, else false
- *
- * @return e_std_lock_NoRestoreNeeded if no lock restore needed, else the lock state to restore to
- */
-STD_INLINE std_lock_state_t std_container_lock(std_container_t* pstContainer, std_container_has_t eHas, bool bReadOnly)
-{
-	if (eHas & std_container_has_lockhandler)
-	{
-		return (bReadOnly)
-			? std_lock_for_reading(pstContainer->pstLockHandler, pstContainer->phLock, CONTAINER_TIMEOUT_DEFAULT)
-			: std_lock_for_writing(pstContainer->pstLockHandler, pstContainer->phLock, CONTAINER_TIMEOUT_DEFAULT);
-	}
-	return e_std_lock_NoRestoreNeeded;
-}
-
-// Lock a typed container for reading
-#define std_container_lock_for_reading(CONTAINER,HAS)	\
-			std_container_lock(CONTAINER,HAS,true)
-
-// Lock a typed container for writing
-#define std_container_lock_for_writing(CONTAINER,HAS)	\
-			std_container_lock(CONTAINER,HAS,false)
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-/**
- * Restore a container's previous lock state
- *
- * @param[in]	pstContainer	The container
- * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
- * @param[in]	eOldState		Previous lock state to restore
- */
-STD_INLINE void std_container_lock_restore(std_container_t* pstContainer, std_container_has_t eHas, std_lock_state_t eOldState)
-{
-	if (	(eHas & std_container_has_lockhandler)
-		&&	(eOldState != e_std_lock_NoRestoreNeeded)	)
-	{
-		std_lock_update(pstContainer->pstLockHandler, pstContainer->phLock, eOldState, CONTAINER_TIMEOUT_DEFAULT);
-	}
-}
-
 // Wrap an untyped container lock/unlock for-loop around the actions that follow
 // Note: this must ultimately be wrapped by a for(....)!
 #define STD_CONTAINER_LOCK_WRAPPER(CONTAINER,HAS,READONLY,VARNAME)	\
@@ -286,6 +300,41 @@ STD_INLINE void std_container_lock_restore(std_container_t* pstContainer, std_co
 				READONLY,								\
 				STD_FAKEVAR()	)
 
+// Wrap an untyped container read for-loop around the actions that follow: for a lock with optimistic
+// reads (e.g. a seqlock), these run without taking the lock, and are run again if the lock reports that
+// a writer interfered, so they must only read from the container (into locals), and mustn't break or
+// return out of the loop
+// Note: this must ultimately be wrapped by a for(....)!
+#define STD_CONTAINER_READ_WRAPPER(CONTAINER,HAS,VARNAME)	\
+	std_container_read_t VARNAME = std_container_read_begin(CONTAINER, HAS);	\
+		VARNAME.bReading;	\
+		VARNAME.bReading = std_container_read_retry(CONTAINER, HAS, &VARNAME)
+
+// Wrap a typed container read for-loop around the actions that follow
+#define std_container_read_wrapper(CONTAINER)		\
+			STD_CONTAINER_READ_WRAPPER(				\
+				&CONTAINER.stBody.stContainer,		\
+				STD_CONTAINER_HAS_GET(CONTAINER),	\
+				STD_FAKEVAR()	)
+
+// Wrap a locked session around the actions that follow: the container is locked for writing just once,
+// and VIEW (only in scope inside the session) stands in for it, so operations on VIEW skip per-call locking.
+// Changes made through VIEW are written back to the container at the end of the session, so the container
+// itself mustn't be used inside the session, and the session mustn't be left with break or return.
+// (Not for concurrent maps, whose operations lock their segments rather than the container)
+#define STD_CONTAINER_SESSION(CONTAINER,VIEW,SESSIONVAR)	\
+	std_container_lock_wrapper(CONTAINER, false))	\
+		for (STD_TYPEOF(CONTAINER) VIEW = CONTAINER, * SESSIONVAR = (	\
+				STD_STATIC_ASSERT(STD_CONTAINER_ENUM_GET(CONTAINER) != std_container_enum_concurrent_map,	\
+						STD_CONCAT(locked_sessions_are_not_supported_by_this_type_of_container_,__COUNTER__)),	\
+				std_container_session_begin(&VIEW.stBody.stContainer),	\
+				&CONTAINER	);	\
+			SESSIONVAR != NULL;	\
+			std_container_session_end(&CONTAINER.stBody.stContainer, &VIEW.stBody.stContainer, sizeof(CONTAINER.stBody)), SESSIONVAR = NULL
+
+#define std_lock_session(CONTAINER,VIEW)	\
+			STD_CONTAINER_SESSION(CONTAINER, VIEW, STD_FAKEVAR())
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 /**
@@ -297,8 +346,16 @@ STD_INLINE void std_container_lock_restore(std_container_t* pstContainer, std_co
  */
 STD_INLINE bool std_container_call_destruct(std_container_t* pstContainer, std_container_enum_t eContainer, std_container_has_t eHas)
 {
-	/* std_lock_state_t eOldState = */ std_container_lock_for_writing(pstContainer, eHas);
-	return STD_CONTAINER_CALL(eContainer, pfn_destruct)(pstContainer);
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = STD_CONTAINER_CALL(eContainer, pfn_destruct)(pstContainer);
+
+	// Release the lock (so that its handler can tear it down)
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	if (eHas & std_container_has_lockhandler)
+	{
+		std_lock_destruct(pstContainer->pstLockHandler, &pstContainer->phLock);
+	}
+	return bResult;
 }
 
 // Destruct a typed container
@@ -526,6 +583,75 @@ STD_INLINE void std_container_call_ranged_sort(std_container_t* pstContainer, st
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+/**
+ * Move a range of items from one container onto the back of another (by relinking, rather than copying)
+ *
+ * Note: relinking the range is O(1), but finding it means walking to it by index (in from the nearer
+ * end of a list, or from the front of a forward list), which is O(n). std_splice_all() needs no walk.
+ *
+ * @param[in]	pstContainer	Destination container
+ * @param[in]	pstSource		Source container (of the same type)
+ * @param[in]	eContainer		The container type index
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[in]	szFirst			Index of first item in source range
+ * @param[in]	szLast			Index of last  item in source range
+ *
+ * @return Number of items moved (none if the containers use different memory handlers)
+ */
+STD_INLINE size_t std_container_call_splice(std_container_t* pstContainer, std_container_t* pstSource, std_container_enum_t eContainer, std_container_has_t eHas, size_t szFirst, size_t szLast)
+{
+	std_lock_state_t eOldState;
+	std_lock_state_t eOldSourceState;
+	std_container_lock_pair_for_writing(pstContainer, pstSource, eHas, &eOldState, &eOldSourceState);
+	size_t szNumItems = STD_CONTAINER_CALL(eContainer, pfn_splice)(pstContainer, pstSource, szFirst, szLast);
+	std_container_lock_pair_restore(pstContainer, pstSource, eHas, eOldState, eOldSourceState);
+	return szNumItems;
+}
+
+#define std_splice(V,SOURCE,FIRST,LAST)		\
+			(	STD_CHECK_SAME_CONTAINERS(V,SOURCE),	\
+				std_container_call_splice(	\
+					&V.stBody.stContainer,	\
+					&SOURCE.stBody.stContainer,	\
+					STD_CONTAINER_ENUM_GET_AND_CHECK(V,splice),	\
+					STD_CONTAINER_HAS_GET(V),	\
+					FIRST,					\
+					LAST )	)
+
+#define std_splice_all(V,SOURCE)	std_splice(V, SOURCE, 0, std_size(SOURCE) - 1U)
+
+/**
+ * Merge a sorted container into another sorted container, leaving the source container empty
+ *
+ * @param[in]	pstContainer	Destination container
+ * @param[in]	pstSource		Source container (of the same type)
+ * @param[in]	eContainer		The container type index
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[in]	pfn_Compare		Comparison callback function
+ *
+ * @return True if the containers were merged, else false
+ */
+STD_INLINE bool std_container_call_merge(std_container_t* pstContainer, std_container_t* pstSource, std_container_enum_t eContainer, std_container_has_t eHas, pfn_std_compare_t pfn_Compare)
+{
+	std_lock_state_t eOldState;
+	std_lock_state_t eOldSourceState;
+	std_container_lock_pair_for_writing(pstContainer, pstSource, eHas, &eOldState, &eOldSourceState);
+	bool bResult = STD_CONTAINER_CALL(eContainer, pfn_merge)(pstContainer, pstSource, pfn_Compare);
+	std_container_lock_pair_restore(pstContainer, pstSource, eHas, eOldState, eOldSourceState);
+	return bResult;
+}
+
+#define std_merge(V,SOURCE,COMPARE)			\
+			(	STD_CHECK_SAME_CONTAINERS(V,SOURCE),	\
+				std_container_call_merge(	\
+					&V.stBody.stContainer,	\
+					&SOURCE.stBody.stContainer,	\
+					STD_CONTAINER_ENUM_GET_AND_CHECK(V,splice),	\
+					STD_CONTAINER_HAS_GET(V),	\
+					(pfn_std_compare_t)(void (*)(void))STD_CONST_COMPARE_CAST(V,COMPARE)	)	)
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 /**
  * Calculate a pointer to an indexed entry within a container
  *
@@ -747,4 +873,36 @@ STD_INLINE void std_iterator_call_pop_at(std_iterator_t* pstIterator, std_contai
 
 #define std_erase(IT)	std_pop_at(IT,NULL)
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/**
+ * Split a container at a (forward) iterator, moving the current item and every
+ * item after it onto the back of a destination container. The iterator is done afterwards.
+ *
+ * @param[in]	pstIterator		Forward iterator
+ * @param[in]	pstDestination	Destination container (of the same type)
+ * @param[in]	eContainer		The container type index
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ *
+ * @return Number of items moved
+ */
+STD_INLINE size_t std_iterator_call_split(std_iterator_t* pstIterator, std_container_t* pstDestination, std_container_enum_t eContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState;
+	std_lock_state_t eOldSourceState;
+	std_container_lock_pair_for_writing(pstDestination, pstIterator->pstContainer, eHas, &eOldState, &eOldSourceState);
+	size_t szNumItems = STD_CONTAINER_CALL(eContainer, pfn_split)(pstIterator, pstDestination);
+	std_container_lock_pair_restore(pstDestination, pstIterator->pstContainer, eHas, eOldState, eOldSourceState);
+	return szNumItems;
+}
+
+#define std_split(IT,DESTINATION)					\
+			(	STD_CHECK_SAME_CONTAINERS(IT.puParent[0],DESTINATION),	\
+				STD_STATIC_ASSERT(STD_ITERATOR_ENUM_GET(IT) == std_iterator_enum_forward, STD_CONCAT(split_needs_a_forward_iterator_,__COUNTER__)),	\
+				std_iterator_call_split(				\
+					&IT.stItBody.stIterator,			\
+					&DESTINATION.stBody.stContainer,	\
+					STD_ITERATOR_PARENT_ENUM_GET_AND_CHECK(IT,splice),	\
+					STD_ITERATOR_PARENT_HAS_GET(IT) )	)
+
 #endif /* STD_CONTAINER_H_ */
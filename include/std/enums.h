@@ -71,6 +71,7 @@ typedef enum
 	std_container_implements_push_pop = 1 << 23,
 	std_container_implements_enqueue_dequeue = 1 << 24,
 	std_container_implements_ranged_iterator = 1 << 25,
+	std_container_implements_splice = 1 << 26,
 
 	std_container_implements_pushpop_front = std_container_implements_push_front | std_container_implements_pop_front,
 	std_container_implements_pushpop_back = std_container_implements_push_back | std_container_implements_pop_back,
@@ -87,22 +88,34 @@ typedef enum
 	X(std_container_enum_deque)				\
 	X(std_container_enum_forward_list)		\
 	X(std_container_enum_list)				\
+	X(std_container_enum_unrolled_list)		\
 	X(std_container_enum_ring)				\
 	X(std_container_enum_vector)			\
+	X(std_container_enum_soa_vector)		\
+	X(std_container_enum_slot_map)			\
+	X(std_container_enum_bitset)			\
 											\
 	X(std_container_enum_heap)				\
 	X(std_container_enum_splay_tree)		\
 	X(std_container_enum_skew_heap)			\
 	X(std_container_enum_calendar_queue)	\
+	X(std_container_enum_radix_heap)		\
 											\
 	X(std_container_enum_set)				\
 	X(std_container_enum_unorderedset)		\
 	X(std_container_enum_multiset)			\
 	X(std_container_enum_map)				\
 	X(std_container_enum_unorderedmap)		\
+	X(std_container_enum_concurrent_map)	\
+	X(std_container_enum_flat_set)			\
+	X(std_container_enum_flat_map)			\
+	X(std_container_enum_sparse_set)		\
+	X(std_container_enum_sparse_map)		\
+	X(std_container_enum_cache)				\
 											\
 	X(std_container_enum_prioritydeque)		\
 	X(std_container_enum_priorityqueue)		\
+	X(std_container_enum_indexed_priorityqueue)	\
 	X(std_container_enum_graph)
 
 typedef enum
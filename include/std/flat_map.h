@@ -0,0 +1,194 @@
+/*
+ * std/flat_map.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_FLAT_MAP_H_
+#define STD_FLAT_MAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/flat_set.h"
+
+/*
+ * A flat map is a flat set (i.e. a sorted vector) of { stKey, stValue }
+ * entries, ordered by a comparison function on their keys alone (the key
+ * comes first in each entry, so the set's comparisons only look at keys).
+ *
+ * Pushing a series of entries bulk-loads them (sort, remove duplicate keys,
+ * then merge in one pass), and std_flat_set_merge() / _intersect() /
+ * _subtract() combine flat maps by key just as they do flat sets.
+ */
+
+#define STD_FLAT_MAP_ENTRY(KEYTYPE,VALUETYPE,NAME)	\
+	struct NAME								\
+	{										\
+		KEYTYPE stKey;						\
+		VALUETYPE stValue;					\
+	}
+
+// The STD_FLAT_MAP macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- type smuggles, used to give easy access to (entry *), (key *) and (value *) casts
+//	- a typed comparison function (on keys)
+//	- an iterator smuggle, used to give easy access to associated iterators
+#define STD_FLAT_MAP(BASE, ITBASE, KEYTYPE, VALUETYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, ENTRYNAME, KEYWRAPPER, VALUEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(KEYWRAPPER,KEYTYPE) * pstKeyWrapper;			\
+		STD_TYPE_SET(VALUEWRAPPER,VALUETYPE) * pstValueWrapper;		\
+		STD_FLAT_MAP_ENTRY(STD_TYPE_GET(KEYWRAPPER),STD_TYPE_GET(VALUEWRAPPER),ENTRYNAME) * pstEntry;	\
+		\
+		BASE 	   			 stBody;					\
+		struct ENTRYNAME		*	pstType;			\
+		STD_TYPE_GET(KEYWRAPPER)	*	pstKey;			\
+		STD_TYPE_GET(VALUEWRAPPER)	*	pstValue;		\
+		STD_COMPARE(const STD_TYPE_GET(KEYWRAPPER), pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, struct ENTRYNAME, UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct ENTRYNAME, stValue));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct ENTRYNAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+// Client-side declaration code
+
+#define STD_FLAT_MAP_DECLARE(K,V,HAS_ENUM,...)	\
+	STD_FLAT_MAP(std_flat_set_t, std_vector_iterator_t, K, V, std_container_enum_flat_map, HAS_ENUM, STD_DEFAULT_PARAMETER(std_flat_map_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_flat_map(K,V,...)											STD_FLAT_MAP_DECLARE(K,V,std_container_has_no_handlers,__VA_ARGS__)
+#define std_flat_map_itemhandler(K,V,...)								STD_FLAT_MAP_DECLARE(K,V,std_container_has_itemhandler,__VA_ARGS__)
+#define std_flat_map_memoryhandler(K,V,...)								STD_FLAT_MAP_DECLARE(K,V,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_flat_map_memoryhandler_itemhandler(K,V,...)					STD_FLAT_MAP_DECLARE(K,V,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_flat_map_lockhandler(K,V,...)								STD_FLAT_MAP_DECLARE(K,V,std_container_has_lockhandler,__VA_ARGS__)
+#define std_flat_map_lockhandler_itemhandler(K,V,...)					STD_FLAT_MAP_DECLARE(K,V,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_flat_map_lockhandler_memoryhandler(K,V,...)					STD_FLAT_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_flat_map_lockhandler_memoryhandler_itemhandler(K,V,...)		STD_FLAT_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Set the comparison function that a flat map orders its keys by (before inserting any entries)
+#define std_flat_map_compare_set(FLATMAP,COMPARE)		std_flat_set_compare_set(FLATMAP,COMPARE)
+
+/**
+ * Find the value stored against a key in a flat map
+ *
+ * @param[in]	pstContainer	Flat map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvKey			Key to look for
+ *
+ * @return Pointer to the value (or NULL if the key isn't in the map)
+ */
+STD_INLINE void * std_container_call_flat_map_find(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvEntry = stdlib_flat_set_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvEntry == NULL) ? NULL : STD_LINEAR_ADD(pvEntry, szValueOffset);
+}
+
+/**
+ * Insert an entry into a flat map
+ *
+ * @param[in]	pstContainer	Flat map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvEntry			Entry to insert
+ * @param[in]	bReplace		If true, replace any entry already there with the same key
+ *
+ * @return Pointer to the stored value (or NULL if the key was already present and not replaced, or memory ran out)
+ */
+STD_INLINE void * std_container_call_flat_map_insert(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvEntry, bool bReplace)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvSlot = stdlib_flat_set_insert(pstContainer, pvEntry, bReplace, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted ? STD_LINEAR_ADD(pvSlot, szValueOffset) : NULL;
+}
+
+// Typed casts for a flat map's keys and values
+#define STD_FLAT_MAP_KEY_TYPEOF(M)			STD_TYPEOF(M.pstKey[0])
+#define STD_FLAT_MAP_VALUE_PTR_CAST(M,X)	((STD_TYPEOF(M.pstValue[0]) *)(X))
+
+// Find the value stored against a key, e.g. pstValue = std_flat_map_find(map, 42)
+#define std_flat_map_find(M,...)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		STD_FLAT_MAP_VALUE_PTR_CAST(M, std_container_call_flat_map_find(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_FLAT_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_flat_map_contains(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		(std_container_call_flat_map_find(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), 0U, (STD_FLAT_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+// Insert a value against a key that isn't already in the map, e.g. std_flat_map_insert(map, 42, { .x = 1, .y = 2 })
+#define std_flat_map_insert(M,KEY,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		STD_FLAT_MAP_VALUE_PTR_CAST(M, std_container_call_flat_map_insert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, false))	\
+	)
+
+// Insert a value against a key (replacing the key's existing entry, if there is one)
+#define std_flat_map_upsert(M,KEY,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		STD_FLAT_MAP_VALUE_PTR_CAST(M, std_container_call_flat_map_insert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }, true))	\
+	)
+
+#define std_flat_map_erase(M,...)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		std_container_call_flat_set_erase(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), (STD_FLAT_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ })	\
+	)
+
+// Index of the first entry whose key isn't ranked before a key
+#define std_flat_map_lower_bound(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		std_container_call_flat_set_bound(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), (STD_FLAT_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }, false)	\
+	)
+
+// Index of the first entry whose key is ranked after a key
+#define std_flat_map_upper_bound(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_flat_map),				\
+		std_container_call_flat_set_bound(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), (STD_FLAT_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }, true)	\
+	)
+
+enum
+{
+	std_flat_map_implements = std_flat_set_implements
+};
+
+#define STD_FLAT_MAP_JUMPTABLE								\
+	.pachContainerName = "flat map",						\
+	.pfn_construct		= &stdlib_flat_set_construct,		\
+	STD_FLAT_SET_SHARED_JUMPTABLE
+
+#endif /* STD_FLAT_MAP_H_ */
@@ -0,0 +1,308 @@
+/*
+ * std/flat_set.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_FLAT_SET_H_
+#define STD_FLAT_SET_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/vector.h"
+
+/*
+ * A flat set is an ordered set held as a sorted vector: no per-item nodes
+ * or pointers, so it takes the least memory of any ordered container and
+ * lookups (binary searches) touch only a handful of cache lines. In return,
+ * inserting or erasing a single item is O(n), so flat sets suit read-mostly
+ * indexes that get rebuilt (or bulk-updated) now and then.
+ *
+ * Pushing a series of items bulk-loads them: the series is stably sorted,
+ * has its duplicates removed, and is then merged into the set in a single
+ * pass (so an empty set is built in O(n log n)). Where a key is pushed more
+ * than once, the item already in the set (else the first pushed) is kept,
+ * and the others are left alone (as with the other sets).
+ *
+ * Sets can also be combined in place: std_flat_set_merge() moves all the
+ * items of one set into another (a union), while std_flat_set_intersect()
+ * and std_flat_set_subtract() erase items from one set according to the
+ * items in another. All of these gallop (search exponentially) through
+ * runs of items, so combining a small set with a large one is much faster
+ * than a linear merge.
+ *
+ * Items are stored in sorted order, so std_at(), std_for_range() and the
+ * indices returned by std_flat_set_lower_bound() / std_flat_set_upper_bound()
+ * work directly on the underlying vector.
+ */
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;
+	pfn_std_compare_t pfnCompare;
+} std_flat_set_t;
+
+#define STD_FLAT_SET_DECLARE(T,HAS_ENUM,...)	\
+	STD_VECTOR(std_flat_set_t, std_vector_iterator_t, T, std_container_enum_flat_set, HAS_ENUM, STD_DEFAULT_PARAMETER(std_flat_set_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_flat_set(T,...)											STD_FLAT_SET_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_flat_set_itemhandler(T,...)								STD_FLAT_SET_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_flat_set_memoryhandler(T,...)							STD_FLAT_SET_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_flat_set_memoryhandler_itemhandler(T,...)				STD_FLAT_SET_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_flat_set_lockhandler(T,...)								STD_FLAT_SET_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_flat_set_lockhandler_itemhandler(T,...)					STD_FLAT_SET_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_flat_set_lockhandler_memoryhandler(T,...)				STD_FLAT_SET_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_flat_set_lockhandler_memoryhandler_itemhandler(T,...)	STD_FLAT_SET_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods (everything else is shared with vectors)
+
+extern void stdlib_flat_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern size_t stdlib_flat_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+
+extern void stdlib_flat_set_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+extern void * stdlib_flat_set_find(std_container_t * pstContainer, const void * pvKey);
+extern void * stdlib_flat_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted);
+extern bool stdlib_flat_set_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult);
+extern size_t stdlib_flat_set_lower_bound(std_container_t * pstContainer, const void * pvKey);
+extern size_t stdlib_flat_set_upper_bound(std_container_t * pstContainer, const void * pvKey);
+
+extern bool stdlib_flat_set_merge(std_container_t * pstContainer, std_container_t * pstSource);
+extern bool stdlib_flat_set_intersect(std_container_t * pstContainer, std_container_t * pstOther);
+extern bool stdlib_flat_set_subtract(std_container_t * pstContainer, std_container_t * pstOther);
+
+extern const std_item_handler_t std_flat_set_default_itemhandler;
+
+// Flat sets and flat maps share the same operations
+#define STD_FLAT_SET_ENUM_CHECK(V)															\
+	STD_STATIC_ASSERT(		(STD_CONTAINER_ENUM_GET(V) == std_container_enum_flat_set)		\
+						||	(STD_CONTAINER_ENUM_GET(V) == std_container_enum_flat_map),		\
+						STD_CONCAT(operation_is_not_supported_by_this_type_of_container_,__COUNTER__))
+
+// Set the comparison function that a flat set orders its items by (before pushing any items)
+#define std_flat_set_compare_set(FLATSET,COMPARE)											\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(FLATSET),													\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, FLATSET.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_flat_set_compare_set(&FLATSET.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Find an item matching a key in a flat set
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key to look for
+ *
+ * @return Pointer to a matching item (or NULL if there isn't one)
+ */
+STD_INLINE void * std_container_call_flat_set_find(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_flat_set_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Insert an item into a flat set (unless it already holds an item with the same key)
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, else false
+ */
+STD_INLINE bool std_container_call_flat_set_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_flat_set_insert(pstContainer, pvItem, false, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted;
+}
+
+/**
+ * Erase the item matching a key from a flat set
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key of the item to erase
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+STD_INLINE bool std_container_call_flat_set_erase(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_flat_set_erase(pstContainer, pvKey, NULL);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Find the index of the first item in a flat set that isn't ranked before a key
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key
+ * @param[in]	bUpper			If true, find the first item ranked after the key instead
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+STD_INLINE size_t std_container_call_flat_set_bound(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey, bool bUpper)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	size_t szIndex = bUpper ? stdlib_flat_set_upper_bound(pstContainer, pvKey) : stdlib_flat_set_lower_bound(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szIndex;
+}
+
+/**
+ * Combine one flat set into another
+ *
+ * @param[in]	pstContainer	Destination flat set container
+ * @param[in]	pstOther		Other flat set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ * @param[in]	pfnCombine		Library-side combining function
+ *
+ * @return True if the sets were combined, else false
+ */
+STD_INLINE bool std_container_call_flat_set_combine(std_container_t * pstContainer, std_container_t * pstOther, std_container_has_t eHas, bool (*pfnCombine)(std_container_t * pstContainer, std_container_t * pstOther))
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	std_lock_state_t eOldOtherState = std_container_lock_for_writing(pstOther, eHas);
+	bool bResult = (*pfnCombine)(pstContainer, pstOther);
+	std_container_lock_restore(pstOther, eHas, eOldOtherState);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Find an item, e.g. pstPoint = std_flat_set_find(set, { .x = 1, .y = 2 })
+#define std_flat_set_find(V,...)															\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		STD_ITEM_PTR_CAST(V, std_container_call_flat_set_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_flat_set_contains(V,...)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		(std_container_call_flat_set_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+#define std_flat_set_insert(V,...)															\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		std_container_call_flat_set_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_flat_set_erase(V,...)															\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		std_container_call_flat_set_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+// Index of the first item not ranked before a key, e.g. for (std_for_range(set, it, std_flat_set_lower_bound(set, 10), std_flat_set_upper_bound(set, 20) - 1U))
+#define std_flat_set_lower_bound(V,...)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		std_container_call_flat_set_bound(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }, false)	\
+	)
+
+// Index of the first item ranked after a key
+#define std_flat_set_upper_bound(V,...)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		std_container_call_flat_set_bound(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }, true)	\
+	)
+
+// Move all the items of SOURCE into V (a union), leaving SOURCE empty (items whose keys V already holds are destructed)
+#define std_flat_set_merge(V,SOURCE)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		STD_CHECK_SAME_CONTAINERS(V,SOURCE),												\
+		std_container_call_flat_set_combine(&V.stBody.stContainer, &SOURCE.stBody.stContainer, STD_CONTAINER_HAS_GET(V), &stdlib_flat_set_merge)	\
+	)
+
+// Erase every item of V whose key isn't in OTHER (an intersection)
+#define std_flat_set_intersect(V,OTHER)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		STD_CHECK_SAME_CONTAINERS(V,OTHER),													\
+		std_container_call_flat_set_combine(&V.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(V), &stdlib_flat_set_intersect)	\
+	)
+
+// Erase every item of V whose key is in OTHER (a difference)
+#define std_flat_set_subtract(V,OTHER)														\
+	(																						\
+		STD_FLAT_SET_ENUM_CHECK(V),															\
+		STD_CHECK_SAME_CONTAINERS(V,OTHER),													\
+		std_container_call_flat_set_combine(&V.stBody.stContainer, &OTHER.stBody.stContainer, STD_CONTAINER_HAS_GET(V), &stdlib_flat_set_subtract)	\
+	)
+
+enum
+{
+	std_flat_set_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_pop_front
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_FLAT_SET_SHARED_JUMPTABLE						\
+	.pfn_destruct		= &stdlib_vector_destruct,			\
+	.pfn_reserve		= &stdlib_vector_reserve,			\
+	.pfn_push_back		= &stdlib_flat_set_push,			\
+	.pfn_pop_front		= &stdlib_vector_pop_front,			\
+	.pfn_pop_back		= &stdlib_vector_pop_back,			\
+	.pfn_at				= &stdlib_vector_at,				\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}													\
+	},														\
+	.pstDefaultItemHandler = &std_flat_set_default_itemhandler
+
+#define STD_FLAT_SET_JUMPTABLE								\
+	.pachContainerName = "flat set",						\
+	.pfn_construct		= &stdlib_flat_set_construct,		\
+	STD_FLAT_SET_SHARED_JUMPTABLE
+
+#endif /* STD_FLAT_SET_H_ */
@@ -29,6 +29,7 @@ SOFTWARE.
 #include "std/item.h"
 #include "std/linear_series.h"
 #include "std/iterator.h"
+#include "std/node_pool.h"
 
 #define STD_FORWARD_LIST_NODE(TYPE,NAME)	\
 	struct NAME								\
@@ -51,7 +52,7 @@ SOFTWARE.
 		\
 		STD_CONTAINER_ENUM_SET(ENUM);			\
 		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
-		STD_CONTAINER_PAYLOAD_OFFSET_SET(STD_OFFSETOF(struct NODENAME, stPayload));	\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
 		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
 		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
 	}
@@ -70,6 +71,7 @@ typedef struct
 	size_t szPayloadOffset;
 	std_forward_list_node_t* pstHead;	// Very first node in this forward list
 	std_forward_list_node_t* pstLast;	// Final node in this forward list
+	std_node_pool_t stPool;				// Where the nodes are allocated from
 } std_forward_list_t;
 
 typedef	struct
@@ -99,6 +101,10 @@ extern bool stdlib_forward_list_destruct(std_container_t* pstContainer);
 extern size_t stdlib_forward_list_push_front(std_container_t* pstContainer, const std_linear_series_t* pstSeries);
 extern size_t stdlib_forward_list_push_back(std_container_t* pstContainer, const std_linear_series_t* pstSeries);
 extern size_t stdlib_forward_list_pop_front(std_container_t* pstContainer, void* pvResult, size_t szMaxItems);
+extern size_t stdlib_forward_list_splice(std_container_t* pstContainer, std_container_t* pstSource, size_t szFirst, size_t szLast);
+extern bool stdlib_forward_list_merge(std_container_t* pstContainer, std_container_t* pstSource, pfn_std_compare_t pfn_Compare);
+extern size_t stdlib_forward_list_split(std_iterator_t* pstIterator, std_container_t* pstDestination);
+extern void stdlib_forward_list_ranged_sort(std_container_t* pstContainer, size_t szFirst, size_t szLast, pfn_std_compare_t pfn_Compare);
 
 extern void stdlib_forward_list_forwarditerator_construct(std_container_t* pstContainer, std_iterator_t* pstIterator, size_t szFirst, size_t szLast);
 extern size_t stdlib_forward_list_push_after(std_iterator_t* pstIterator, const std_linear_series_t* pstSeries);
@@ -145,6 +151,8 @@ enum
 		| std_container_implements_destruct
 		| std_container_implements_pushpop_front
 		| std_container_implements_push_back
+		| std_container_implements_ranged_sort
+		| std_container_implements_splice
 		| std_container_implements_forward_construct
 		| std_container_implements_forward_next
 		| std_container_implements_forward_push_after
@@ -160,6 +168,10 @@ enum
 	.pfn_push_front		= &stdlib_forward_list_push_front,	\
 	.pfn_push_back		= &stdlib_forward_list_push_back,	\
 	.pfn_pop_front		= &stdlib_forward_list_pop_front,	\
+	.pfn_ranged_sort	= &stdlib_forward_list_ranged_sort,	\
+	.pfn_splice			= &stdlib_forward_list_splice,		\
+	.pfn_merge			= &stdlib_forward_list_merge,		\
+	.pfn_split			= &stdlib_forward_list_split,		\
 	.astIterators =									\
 	{												\
 		[std_iterator_enum_forward] =				\
@@ -0,0 +1,352 @@
+/*
+ * std/graph.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_GRAPH_H_
+#define STD_GRAPH_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/vector.h"
+
+/*
+ * A graph holds a directed graph in compressed sparse row (CSR) form: every
+ * vertex's outgoing edges are stored next to each other in one big edge
+ * array, and a second array holds the index of each vertex's first edge.
+ * A vertex's neighbours are therefore a single contiguous span of edges,
+ * and a whole graph costs just one edge record per edge plus one offset
+ * (and one payload) per vertex, with no per-edge pointers at all.
+ *
+ * Vertices are numbered from zero, and each has a (typed) payload. Each
+ * edge is a { szTarget, stValue } record (i.e. the container's items are
+ * edges), and the item handler (if any) applies to edges.
+ *
+ * Edges are added to a pending buffer (one at a time, or as an edge list),
+ * and only become visible once std_graph_commit() merges the buffer into
+ * the CSR arrays. This is done in place with a counting sort (histogram of
+ * sources, prefix sum, scatter), so a commit costs O(V + E) however many
+ * edges are pending: the whole graph can be built from an edge list in a
+ * single commit, or topped up incrementally. Committing keeps each vertex's
+ * edges in the order they were added. Vertices that edges refer to are
+ * added automatically (with zeroed payloads).
+ *
+ * std_at(), std_each() and std_for_range() work on the edge array, so a
+ * vertex's edges can also be walked with std_for_range() over the indices
+ * between std_graph_edges_begin() and std_graph_edges_end().
+ */
+
+#define STD_GRAPH_EDGE(VALUETYPE,NAME)		\
+	struct NAME								\
+	{										\
+		size_t szTarget;					\
+		VALUETYPE stValue;					\
+	}
+
+// The STD_GRAPH macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- type smuggles, used to give easy access to (edge *) and (vertex *) casts
+//	- a typed comparison function (on edges)
+//	- an iterator smuggle, used to give easy access to associated iterators
+// Note that the "wrapped item size" passed to the constructor is the size of a vertex payload
+#define STD_GRAPH(BASE, ITBASE, VERTEXTYPE, EDGETYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, EDGENAME, VERTEXWRAPPER, EDGEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(VERTEXWRAPPER,VERTEXTYPE) * pstVertexWrapper;	\
+		STD_TYPE_SET(EDGEWRAPPER,EDGETYPE) * pstEdgeWrapper;		\
+		STD_GRAPH_EDGE(STD_TYPE_GET(EDGEWRAPPER),EDGENAME) * pstEdge;	\
+		\
+		BASE 	   			 stBody;					\
+		struct EDGENAME		*	pstType;				\
+		STD_TYPE_GET(VERTEXWRAPPER)	*	pstVertex;		\
+		STD_COMPARE(const struct EDGENAME, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, struct EDGENAME, UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct EDGENAME, stValue));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(VERTEXWRAPPER)));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;					// The committed edges, grouped by source vertex
+
+	size_t * pszOffsets;				// Index of each vertex's first edge (plus one final entry)
+	void * pvVertices;					// Vertex payloads
+	size_t szSizeofVertex;
+	size_t szNumVertices;
+	size_t szVerticesAlloced;
+
+	size_t * pszPendingSources;			// Source vertex of each pending edge
+	void * pvPendingEdges;				// Pending edges, in the order they were added
+	size_t szNumPending;
+	size_t szPendingAlloced;
+} std_graph_t;
+
+// Client-side declaration code
+
+#define STD_GRAPH_DECLARE(V,E,HAS_ENUM,...)	\
+	STD_GRAPH(std_graph_t, std_vector_iterator_t, V, E, std_container_enum_graph, HAS_ENUM, STD_DEFAULT_PARAMETER(std_graph_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_graph(V,E,...)											STD_GRAPH_DECLARE(V,E,std_container_has_no_handlers,__VA_ARGS__)
+#define std_graph_itemhandler(V,E,...)								STD_GRAPH_DECLARE(V,E,std_container_has_itemhandler,__VA_ARGS__)
+#define std_graph_memoryhandler(V,E,...)							STD_GRAPH_DECLARE(V,E,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_graph_memoryhandler_itemhandler(V,E,...)				STD_GRAPH_DECLARE(V,E,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_graph_lockhandler(V,E,...)								STD_GRAPH_DECLARE(V,E,std_container_has_lockhandler,__VA_ARGS__)
+#define std_graph_lockhandler_itemhandler(V,E,...)					STD_GRAPH_DECLARE(V,E,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_graph_lockhandler_memoryhandler(V,E,...)				STD_GRAPH_DECLARE(V,E,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_graph_lockhandler_memoryhandler_itemhandler(V,E,...)	STD_GRAPH_DECLARE(V,E,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods (iterating over and indexing edges is shared with vectors)
+
+extern void stdlib_graph_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_graph_destruct(std_container_t * pstContainer);
+
+extern size_t stdlib_graph_add_vertices(std_container_t * pstContainer, size_t szNumVertices);
+extern bool stdlib_graph_add_edges(std_container_t * pstContainer, const size_t * pszSources, const void * pvEdges, size_t szNumEdges);
+extern bool stdlib_graph_commit(std_container_t * pstContainer);
+
+extern void * stdlib_graph_vertex(std_container_t * pstContainer, size_t szVertex);
+extern void * stdlib_graph_neighbours(std_container_t * pstContainer, size_t szVertex, size_t * pszNumEdges);
+
+extern const std_item_handler_t std_graph_default_itemhandler;
+
+/**
+ * Add a number of (isolated) vertices to a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szNumVertices	Number of vertices to add
+ *
+ * @return Index of the first vertex added (or SIZE_MAX if memory ran out)
+ */
+STD_INLINE size_t std_container_call_graph_add_vertices(std_container_t * pstContainer, std_container_has_t eHas, size_t szNumVertices)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	size_t szFirst = stdlib_graph_add_vertices(pstContainer, szNumVertices);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szFirst;
+}
+
+/**
+ * Add a series of edges to a graph's pending buffer
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pszSources		Source vertex of each edge
+ * @param[in]	pvEdges			Edges (each holding its target vertex and its value)
+ * @param[in]	szNumEdges		Number of edges
+ *
+ * @return True if the edges were added, false if memory ran out
+ */
+STD_INLINE bool std_container_call_graph_add_edges(std_container_t * pstContainer, std_container_has_t eHas, const size_t * pszSources, const void * pvEdges, size_t szNumEdges)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_graph_add_edges(pstContainer, pszSources, pvEdges, szNumEdges);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Merge a graph's pending edges into its CSR arrays
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return True if the edges were merged, false if memory ran out (in which case they are still pending)
+ */
+STD_INLINE bool std_container_call_graph_commit(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_graph_commit(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Find a vertex's payload in a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szVertex		Vertex index
+ *
+ * @return Pointer to the vertex's payload (or NULL if there is no such vertex)
+ */
+STD_INLINE void * std_container_call_graph_vertex(std_container_t * pstContainer, std_container_has_t eHas, size_t szVertex)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvVertex = stdlib_graph_vertex(pstContainer, szVertex);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvVertex;
+}
+
+/**
+ * Find the span of (committed) edges leading out of a vertex in a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szVertex		Vertex index
+ * @param[out]	pszNumEdges		Number of edges in the span (can be NULL)
+ *
+ * @return Pointer to the vertex's first edge (or NULL if it has none)
+ */
+STD_INLINE void * std_container_call_graph_neighbours(std_container_t * pstContainer, std_container_has_t eHas, size_t szVertex, size_t * pszNumEdges)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvEdges = stdlib_graph_neighbours(pstContainer, szVertex, pszNumEdges);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvEdges;
+}
+
+/**
+ * Find the index of a vertex's first (committed) edge in a graph's edge array
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szVertex		Vertex index (up to and including the number of vertices)
+ *
+ * @return Index of the edge
+ */
+STD_INLINE size_t std_container_call_graph_edges_begin(std_container_t * pstContainer, std_container_has_t eHas, size_t szVertex)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	const std_graph_t * pstGraph = STD_CONTAINER_OF(pstContainer, std_graph_t, stContainer);
+	size_t szIndex = (szVertex < pstGraph->szNumVertices) ? pstGraph->pszOffsets[szVertex] : pstContainer->szNumItems;
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szIndex;
+}
+
+// Typed casts for a graph's vertex payloads
+#define STD_GRAPH_VERTEX_PTR_CAST(G,X)		((STD_TYPEOF(G.pstVertex[0]) *)(X))
+
+#define STD_GRAPH_ENUM_CHECK(G)		STD_CONTAINER_ENUM_CHECK(G, std_container_enum_graph)
+
+// Add a number of isolated vertices, returning the index of the first one
+#define std_graph_add_vertices(G,NUM)											\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_add_vertices(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), NUM)	\
+	)
+
+// Add an edge to the pending buffer, e.g. std_graph_add_edge(graph, 3, 7, { .x = 1, .y = 2 })
+#define std_graph_add_edge(G,SOURCE,TARGET,...)									\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_add_edges(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), (size_t[]){ SOURCE }, (STD_ITEM_TYPEOF(G)[]){ { .szTarget = TARGET, .stValue = __VA_ARGS__ } }, 1U)	\
+	)
+
+// Add an edge list (held as parallel arrays of sources and edges) to the pending buffer
+#define std_graph_add_edges(G,SOURCES,EDGES,NUM)								\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		STD_CHECK_TYPE(G, (EDGES)[0], graph_edges_parameter),					\
+		std_container_call_graph_add_edges(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), SOURCES, EDGES, NUM)	\
+	)
+
+// Merge all the pending edges into the graph
+#define std_graph_commit(G)														\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_commit(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G))	\
+	)
+
+#define std_graph_num_vertices(G)		(STD_GRAPH_ENUM_CHECK(G), G.stBody.szNumVertices)
+#define std_graph_num_pending(G)		(STD_GRAPH_ENUM_CHECK(G), G.stBody.szNumPending)
+
+// Find a vertex's payload, e.g. pstPoint = std_graph_vertex(graph, 3)
+#define std_graph_vertex(G,VERTEX)												\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		STD_GRAPH_VERTEX_PTR_CAST(G, std_container_call_graph_vertex(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), VERTEX))	\
+	)
+
+// Find the contiguous span of a vertex's edges, e.g. pstEdges = std_graph_neighbours(graph, 3, &szNumEdges)
+#define std_graph_neighbours(G,VERTEX,PNUMEDGES)								\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		STD_ITEM_PTR_CAST(G, std_container_call_graph_neighbours(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), VERTEX, PNUMEDGES))	\
+	)
+
+#define std_graph_degree(G,VERTEX)												\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_edges_begin(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), (VERTEX) + 1U)	\
+			- std_container_call_graph_edges_begin(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), VERTEX)	\
+	)
+
+// Edge array indices of a vertex's edges, e.g. for (std_for_range(graph, it, std_graph_edges_begin(graph, 3), std_graph_edges_end(graph, 3) - 1U))
+#define std_graph_edges_begin(G,VERTEX)											\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_edges_begin(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), VERTEX)	\
+	)
+
+#define std_graph_edges_end(G,VERTEX)											\
+	(																			\
+		STD_GRAPH_ENUM_CHECK(G),												\
+		std_container_call_graph_edges_begin(&G.stBody.stContainer, STD_CONTAINER_HAS_GET(G), (VERTEX) + 1U)	\
+	)
+
+enum
+{
+	std_graph_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_GRAPH_JUMPTABLE									\
+	.pachContainerName = "graph",							\
+	.pfn_construct		= &stdlib_graph_construct,			\
+	.pfn_destruct		= &stdlib_graph_destruct,			\
+	.pfn_reserve		= &stdlib_vector_reserve,			\
+	.pfn_at				= &stdlib_vector_at,				\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}													\
+	},														\
+	.pstDefaultItemHandler = &std_graph_default_itemhandler
+
+#endif /* STD_GRAPH_H_ */
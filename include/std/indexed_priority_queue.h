@@ -0,0 +1,246 @@
+/*
+ * std/indexed_priority_queue.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_INDEXED_PRIORITY_QUEUE_H_
+#define STD_INDEXED_PRIORITY_QUEUE_H_
+
+#include <limits.h>		// for CHAR_BIT
+
+#include "std/vector.h"
+
+/*
+ * An indexed priority queue is a priority queue whose items can be reached
+ * by a handle (returned when each item is pushed), so that an item can be
+ * re-prioritised or erased in O(log n) without having to find it first.
+ *
+ * The items are held as a 4-ary heap in a vector (just like a priority
+ * queue), alongside two arrays that map each heap index to its item's handle
+ * and each handle back to its item's current heap index.
+ *
+ * A handle stays valid until its item is popped or erased. Handles carry a
+ * generation count (like a slot map's), so a stale handle is never mistaken
+ * for a later item that reuses its slot (until its generation wraps round).
+ *
+ * A handle is a size_t split in half (see STD_INDEXED_PRIORITYQUEUE_SLOT_BITS):
+ * its low half picks its slot, and its high half holds the slot's generation.
+ * So a queue can hold at most 2^(bits/2) - 1 items at once: 65535 on a 32-bit
+ * platform (with generations wrapping after 2^15 reuses of a slot), or about
+ * 4 billion on a 64-bit platform (after 2^31 reuses). Once every slot is in
+ * use, pushes fail (returning STD_INDEXED_PRIORITYQUEUE_NO_HANDLE, and leaving
+ * the queue unchanged) until an item is popped or erased.
+ *
+ * std_pop() pops the last-ranked (e.g. largest) items first, and std_front()
+ * peeks at the next item that std_pop() would return. Iterators see the
+ * items in heap order (i.e. not sorted).
+ */
+
+// Number of a handle's bits that pick its slot (the rest hold the slot's generation)
+#ifndef STD_INDEXED_PRIORITYQUEUE_SLOT_BITS
+#define STD_INDEXED_PRIORITYQUEUE_SLOT_BITS		(sizeof(size_t) * CHAR_BIT / 2U)
+#endif
+
+// Value returned instead of a handle when a push fails
+#define STD_INDEXED_PRIORITYQUEUE_NO_HANDLE		((size_t)-1)
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;
+	pfn_std_compare_t pfnCompare;
+	size_t * pszHeapToHandle;		// Handle of the item at each heap index
+	size_t * pszHandleToHeap;		// Heap index of each live slot's item (or the next free slot and the slot's generation)
+	size_t szNumIndexAlloced;		// Number of entries allocated in each of the two arrays
+	size_t szNumSlots;				// Number of handle slots used so far
+	size_t szFreeSlot;				// First free handle slot (or all ones if there are none)
+} std_indexed_priorityqueue_t;
+
+#define STD_INDEXED_PRIORITYQUEUE_DECLARE(T,HAS_ENUM,...)	\
+		STD_VECTOR(std_indexed_priorityqueue_t, std_vector_iterator_t, T, std_container_enum_indexed_priorityqueue, HAS_ENUM, STD_DEFAULT_PARAMETER(std_indexed_priorityqueue_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_indexed_priorityqueue(T,...)											STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_indexed_priorityqueue_itemhandler(T,...)								STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_memoryhandler(T,...)								STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_memoryhandler_itemhandler(T,...)					STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_lockhandler(T,...)								STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_lockhandler_itemhandler(T,...)					STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_lockhandler_memoryhandler(T,...)					STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_indexed_priorityqueue_lockhandler_memoryhandler_itemhandler(T,...)		STD_INDEXED_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_indexed_priorityqueue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_indexed_priorityqueue_destruct(std_container_t * pstContainer);
+extern bool stdlib_indexed_priorityqueue_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_indexed_priorityqueue_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_indexed_priorityqueue_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern size_t stdlib_indexed_priorityqueue_push_handle(std_container_t * pstContainer, const void * pvItem);
+extern void * stdlib_indexed_priorityqueue_handle_at(std_container_t * pstContainer, size_t szHandle);
+extern bool stdlib_indexed_priorityqueue_update(std_container_t * pstContainer, size_t szHandle, const void * pvItem);
+extern bool stdlib_indexed_priorityqueue_erase(std_container_t * pstContainer, size_t szHandle);
+
+extern void stdlib_indexed_priorityqueue_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+
+extern const std_item_handler_t std_indexed_priorityqueue_default_itemhandler;
+
+// Set the comparison function that an indexed priority queue orders its items by (before pushing any items)
+#define std_indexed_priorityqueue_compare_set(PRIORITYQUEUE,COMPARE)		\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(PRIORITYQUEUE, std_container_enum_indexed_priorityqueue),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, PRIORITYQUEUE.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_indexed_priorityqueue_compare_set(&PRIORITYQUEUE.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Push an item into an indexed priority queue
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to push
+ *
+ * @return Handle of the pushed item (or STD_INDEXED_PRIORITYQUEUE_NO_HANDLE if it couldn't be pushed)
+ */
+STD_INLINE size_t std_container_call_indexed_priorityqueue_push(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	size_t szHandle = stdlib_indexed_priorityqueue_push_handle(pstContainer, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szHandle;
+}
+
+/**
+ * Find the item that a handle refers to in an indexed priority queue
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szHandle		Handle of the item
+ *
+ * @return Pointer to the item (or NULL if the handle isn't live)
+ */
+STD_INLINE void * std_container_call_indexed_priorityqueue_at(std_container_t * pstContainer, std_container_has_t eHas, size_t szHandle)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_indexed_priorityqueue_handle_at(pstContainer, szHandle);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Replace the item that a handle refers to in an indexed priority queue (moving it up or down the queue as needed)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szHandle		Handle of the item
+ * @param[in]	pvItem			Replacement item
+ *
+ * @return True if the item was replaced, false if the handle isn't live
+ */
+STD_INLINE bool std_container_call_indexed_priorityqueue_update(std_container_t * pstContainer, std_container_has_t eHas, size_t szHandle, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_indexed_priorityqueue_update(pstContainer, szHandle, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Erase the item that a handle refers to from an indexed priority queue
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szHandle		Handle of the item
+ *
+ * @return True if the item was erased, false if the handle isn't live
+ */
+STD_INLINE bool std_container_call_indexed_priorityqueue_erase(std_container_t * pstContainer, std_container_has_t eHas, size_t szHandle)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_indexed_priorityqueue_erase(pstContainer, szHandle);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Push one item, e.g. szHandle = std_indexed_priorityqueue_push(pq, { .szNode = 3U, .u32Distance = 10U })
+#define std_indexed_priorityqueue_push(V,...)								\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_indexed_priorityqueue),	\
+		std_container_call_indexed_priorityqueue_push(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+// Read (but don't modify) the item that a handle refers to
+#define std_indexed_priorityqueue_at(V,HANDLE)								\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_indexed_priorityqueue),	\
+		STD_ITEM_PTR_CAST(V, std_container_call_indexed_priorityqueue_at(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE))	\
+	)
+
+// Replace the item that a handle refers to (e.g. to decrease or increase its key)
+#define std_indexed_priorityqueue_update(V,HANDLE,...)						\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_indexed_priorityqueue),	\
+		std_container_call_indexed_priorityqueue_update(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE, (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_indexed_priorityqueue_erase(V,HANDLE)							\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_indexed_priorityqueue),	\
+		std_container_call_indexed_priorityqueue_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE)	\
+	)
+
+enum
+{
+	std_indexed_priorityqueue_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_INDEXED_PRIORITYQUEUE_JUMPTABLE \
+	.pachContainerName = "indexed priority queue",					\
+	.pfn_construct		= &stdlib_indexed_priorityqueue_construct,	\
+	.pfn_destruct		= &stdlib_indexed_priorityqueue_destruct,	\
+	.pfn_reserve		= &stdlib_indexed_priorityqueue_reserve,	\
+	.pfn_push_back		= &stdlib_indexed_priorityqueue_push,		\
+	.pfn_pop_back		= &stdlib_indexed_priorityqueue_pop,		\
+	.pfn_at				= &stdlib_vector_at,						\
+	.astIterators =													\
+	{																\
+		[std_iterator_enum_forward] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},															\
+		[std_iterator_enum_reverse] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}															\
+	},																\
+	.pstDefaultItemHandler = &std_indexed_priorityqueue_default_itemhandler
+
+#endif /* STD_INDEXED_PRIORITY_QUEUE_H_ */
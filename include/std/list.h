@@ -29,6 +29,7 @@ SOFTWARE.
 #include "std/item.h"
 #include "std/linear_series.h"
 #include "std/iterator.h"
+#include "std/node_pool.h"
 
 #define STD_LIST_NODE(TYPE,NAME)	\
 	struct NAME						\
@@ -56,7 +57,7 @@ SOFTWARE.
 		\
 		STD_CONTAINER_ENUM_SET(ENUM);			\
 		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
-		STD_CONTAINER_PAYLOAD_OFFSET_SET(STD_OFFSETOF(struct NODENAME, stPayload));	\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
 		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
 		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
 	}
@@ -76,6 +77,7 @@ typedef struct
 	size_t szPayloadOffset;
 	std_list_node_t * pstHead;
 	std_list_node_t * pstTail;
+	std_node_pool_t stPool;		// Where the nodes are allocated from
 } std_list_t;
 
 typedef	struct
@@ -105,6 +107,10 @@ extern size_t stdlib_list_push_front(	std_container_t * pstContainer, const std_
 extern size_t stdlib_list_push_back(	std_container_t * pstContainer, const std_linear_series_t * pstSeries);
 extern size_t stdlib_list_pop_front(	std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
 extern size_t stdlib_list_pop_back(		std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_list_splice(		std_container_t * pstContainer, std_container_t * pstSource, size_t szFirst, size_t szLast);
+extern bool stdlib_list_merge(			std_container_t * pstContainer, std_container_t * pstSource, pfn_std_compare_t pfn_Compare);
+extern size_t stdlib_list_split(		std_iterator_t * pstIterator, std_container_t * pstDestination);
+extern void stdlib_list_ranged_sort(	std_container_t * pstContainer, size_t szFirst, size_t szLast, pfn_std_compare_t pfn_Compare);
 
 extern void stdlib_list_forwarditerator_construct(std_container_t* pstContainer, std_iterator_t* pstIterator, size_t szFirst, size_t szLast);
 extern void stdlib_list_reverseiterator_construct(std_container_t* pstContainer, std_iterator_t* pstIterator, size_t szFirst, size_t szLast);
@@ -167,6 +173,8 @@ enum
 		| std_container_implements_destruct
 		| std_container_implements_pushpop_front
 		| std_container_implements_pushpop_back
+		| std_container_implements_ranged_sort
+		| std_container_implements_splice
 		| std_container_implements_forward_constructnext
 		| std_container_implements_forward_push_after
 		| std_container_implements_forward_push_before
@@ -186,6 +194,10 @@ enum
 	.pfn_push_back		= &stdlib_list_push_back,	\
 	.pfn_pop_front		= &stdlib_list_pop_front,	\
 	.pfn_pop_back		= &stdlib_list_pop_back,	\
+	.pfn_ranged_sort	= &stdlib_list_ranged_sort,	\
+	.pfn_splice			= &stdlib_list_splice,		\
+	.pfn_merge			= &stdlib_list_merge,		\
+	.pfn_split			= &stdlib_list_split,		\
 	.astIterators =									\
 	{												\
 		[std_iterator_enum_forward] =				\
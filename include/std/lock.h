@@ -53,6 +53,9 @@ typedef enum
 	e_std_lock_MAX
 } std_lock_state_t;
 
+// Timeout meaning "wait for as long as it takes"
+#define STD_LOCK_TIMEOUT_INFINITE	UINT32_MAX
+
 // Handle to a lock instance of an unspecified type
 typedef void * std_lock_handle_t;
 
@@ -62,6 +65,12 @@ typedef struct
 	bool (*pfnLock_Destruct)(std_lock_handle_t * ppstvLock);
 
 	std_lock_state_t (*pfnLock_Update)(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec);
+
+	// Optional optimistic (lock-free) reads, for locks whose readers take no lock (NULL if not supported):
+	// ReadBegin returns a sequence number, and ReadValidate returns false if a writer has run since
+	// (Updating such a lock to e_std_lock_ReadLocked can return e_std_lock_NoRestoreNeeded, having locked nothing)
+	uint32_t (*pfnLock_ReadBegin)(std_lock_handle_t pstvLock);
+	bool (*pfnLock_ReadValidate)(std_lock_handle_t pstvLock, uint32_t u32Sequence);
 } std_lock_handler_t;
 
 STD_INLINE bool std_lock_construct(const std_lock_handler_t* pstLockHandler, std_lock_handle_t* ppstvLock)
@@ -103,4 +112,19 @@ STD_INLINE std_lock_state_t std_lock_for_writing(const std_lock_handler_t* pstLo
 	return std_lock_update(pstLockHandler, pstvLock, e_std_lock_WriteLocked, u32Timeout_msec);
 }
 
+STD_INLINE bool std_lock_has_optimistic_reads(const std_lock_handler_t* pstLockHandler)
+{
+	return (pstLockHandler != NULL) && (pstLockHandler->pfnLock_ReadBegin != NULL) && (pstLockHandler->pfnLock_ReadValidate != NULL);
+}
+
+STD_INLINE uint32_t std_lock_read_begin(const std_lock_handler_t* pstLockHandler, std_lock_handle_t pstvLock)
+{
+	return (*pstLockHandler->pfnLock_ReadBegin)(pstvLock);
+}
+
+STD_INLINE bool std_lock_read_validate(const std_lock_handler_t* pstLockHandler, std_lock_handle_t pstvLock, uint32_t u32Sequence)
+{
+	return (*pstLockHandler->pfnLock_ReadValidate)(pstvLock, u32Sequence);
+}
+
 #endif /* _STD_LOCK_H */
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+ * std/lock_handlers.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef _STD_LOCK_HANDLERS_H
+#define _STD_LOCK_HANDLERS_H
+
+#include "std/lock.h"
+
+/*
+ * Ready-made lock handlers, e.g. std_construct_lockhandler(v, &std_lock_handler_spinlock):
+ *	- std_lock_handler_pthread_rwlock	readers share the lock, writers exclude everyone
+ *	- std_lock_handler_pthread_mutex	readers and writers all exclude each other (and sleep while waiting)
+ *	- std_lock_handler_spinlock			test-and-test-and-set, with exponential backoff
+ *	- std_lock_handler_ticketlock		FIFO: waiters are served strictly in the order they arrived
+ *	- std_lock_handler_seqlock			readers take no lock, and retry if a writer got in (see below)
+ *
+ * Each follows the state machine that std_container_lock() and
+ * std_container_lock_restore() expect: locking returns the calling thread's
+ * previous state, and updating the lock back to that state undoes it. Locks
+ * remember which thread holds them exclusively, so a thread that already
+ * holds a lock can re-lock it (e.g. an operation on a container calling
+ * another one on the same container) without deadlocking itself. The one
+ * exception is upgrading a shared read lock to a write lock on the rwlock,
+ * which (as with pthread_rwlock_t itself) deadlocks.
+ *
+ * If a lock can't be taken within u32Timeout_msec, e_std_lock_Invalid is
+ * returned (and passing that back in is a no-op). Container operations can't
+ * report that, so they lock with STD_LOCK_TIMEOUT_INFINITE (i.e. they wait
+ * for as long as it takes): shorter timeouts are only for callers updating a
+ * lock directly, who check for e_std_lock_Invalid. A ticket, once taken, has
+ * to be served (abandoning it would stall every later ticket), so the ticket
+ * lock only honours a timeout of zero (as a try-lock): any other timeout
+ * waits for as long as it takes.
+ *
+ * The seqlock is for containers that are read far more often than they are
+ * written. Writers exclude each other with a spinlock, and bump a sequence
+ * counter as they start and finish, but readers don't write to the lock at
+ * all: they only load the counter before and after reading. Reads wrapped in
+ * std_container_read_wrapper() are run again if the counter moved (or was
+ * odd) in between, e.g.
+ *
+ *		for (std_container_read_wrapper(v))
+ *		{
+ *			iValue = *std_at(v, 3);
+ *		}
+ *
+ * so must only copy items into locals, and not keep pointers to them. Reads
+ * that aren't wrapped (e.g. a plain std_at(), or std_each() loops) just wait
+ * for the write in progress to finish, and aren't checked afterwards. A
+ * thread that writes in the middle of its own wrapped read doesn't wait for
+ * itself, and only has to retry the read if another thread wrote too.
+ *
+ * As readers can be looking at a container at any time, its items must never
+ * move or be freed while it's in use, so the seqlock is only for vectors and
+ * rings: once their memory is allocated, they don't reallocate it (reserving
+ * more, or pushing past their capacity, fails instead), so reserve enough up
+ * front. Writers can still push, pop and update items in place.
+ *
+ * The pthread handlers need POSIX threads, and the spinning handlers need C11
+ * atomics: handlers that the platform can't support aren't declared.
+ */
+
+#if !defined(STD_LOCK_NO_PTHREADS) && (defined(__unix__) || defined(__APPLE__))
+#define STD_LOCK_HAS_PTHREADS			1
+#endif
+
+#if !defined(__STDC_NO_ATOMICS__)
+#define STD_LOCK_HAS_ATOMICS			1
+#endif
+
+// Number of times a spinning lock polls between checks of the clock (for its timeout)
+#ifndef STD_LOCK_SPINS_PER_CLOCK_CHECK
+#define STD_LOCK_SPINS_PER_CLOCK_CHECK	1024U
+#endif
+
+// Most backoff pause iterations a spinning lock waits between attempts (before it starts yielding its time slice too)
+#ifndef STD_LOCK_SPIN_BACKOFF_MAX
+#define STD_LOCK_SPIN_BACKOFF_MAX		1024U
+#endif
+
+#if defined(STD_LOCK_HAS_PTHREADS) && defined(STD_LOCK_HAS_ATOMICS)
+extern const std_lock_handler_t std_lock_handler_pthread_rwlock;
+extern const std_lock_handler_t std_lock_handler_pthread_mutex;
+#endif
+
+#if defined(STD_LOCK_HAS_ATOMICS)
+extern const std_lock_handler_t std_lock_handler_spinlock;
+extern const std_lock_handler_t std_lock_handler_ticketlock;
+extern const std_lock_handler_t std_lock_handler_seqlock;
+#endif
+
+#endif /* _STD_LOCK_HANDLERS_H */
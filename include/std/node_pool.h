@@ -0,0 +1,84 @@
+/*
+ * std/node_pool.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_NODE_POOL_H_
+#define STD_NODE_POOL_H_
+
+#include "std/common.h"
+
+// Smallest and largest number of nodes allocated in a single block
+#ifndef STD_NODE_POOL_BATCH_MIN
+#define STD_NODE_POOL_BATCH_MIN		8U
+#endif
+#ifndef STD_NODE_POOL_BATCH_MAX
+#define STD_NODE_POOL_BATCH_MAX		1024U
+#endif
+
+/*
+ * A node pool hands out fixed-size nodes (e.g. for linked lists), carving
+ * them out of larger blocks so that each block costs only one allocator call
+ * and the nodes in it sit close together in memory. Released nodes are kept
+ * on a freelist for reuse, and the blocks are only freed when the pool is
+ * destructed.
+ *
+ * Nodes of a movable pool can also move between containers (e.g. when
+ * splicing lists) without their blocks changing hands: each such node
+ * records which block it came from, and a node released into a pool that
+ * doesn't own its block is sent back to that block, for the owning pool to
+ * reuse. A block outlives its owning pool for as long as any of its nodes are
+ * still in use elsewhere, and is freed by whichever pool releases the last one.
+ */
+
+typedef union std_node_pool_block_u std_node_pool_block_t;
+
+typedef struct std_node_pool_free_s std_node_pool_free_t;
+
+struct std_node_pool_free_s
+{
+	std_node_pool_free_t * pstNext;
+};
+
+typedef struct
+{
+	size_t szNodeSize;						// Size of each node
+	size_t szStride;						// Distance between nodes in a block
+	size_t szId;							// Identifies the blocks that this pool owns (0 if the pool isn't movable)
+	bool bLent;								// True if nodes have moved out of this pool's container
+	size_t szNumNodes;						// Total number of nodes carved out by this pool
+	size_t szNumFree;						// Number of nodes on the freelist
+	std_node_pool_free_t * pstFree;			// Freelist of unused nodes
+	std_node_pool_block_t ** ppstBlocks;	// Array of the blocks that this pool owns
+	size_t szNumBlocks;						// Number of blocks in that array
+	size_t szBlocksAlloced;					// Capacity of that array
+} std_node_pool_t;
+
+extern void stdlib_node_pool_construct(std_node_pool_t * pstPool, size_t szNodeSize);
+extern void stdlib_node_pool_construct_movable(std_node_pool_t * pstPool, size_t szNodeSize);
+extern void stdlib_node_pool_destruct(std_node_pool_t * pstPool, std_container_t * pstContainer);
+extern bool stdlib_node_pool_reserve(std_node_pool_t * pstPool, std_container_t * pstContainer, size_t szNumNodes);
+extern void * stdlib_node_pool_alloc(std_node_pool_t * pstPool, std_container_t * pstContainer);
+extern void stdlib_node_pool_free(std_node_pool_t * pstPool, void * pvNode);
+extern bool stdlib_node_pool_lend(std_node_pool_t * pstPool, const std_container_t * pstContainer, const std_node_pool_t * pstOther, const std_container_t * pstOtherContainer);
+
+#endif /* STD_NODE_POOL_H_ */
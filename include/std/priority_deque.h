@@ -25,25 +25,104 @@ SOFTWARE.
 #ifndef STD_PRIORITY_DEQUE_H_
 #define STD_PRIORITY_DEQUE_H_
 
-#include "std/deque.h"
+#include "std/vector.h"
+
+/*
+ * A priority deque is held as a min-max heap: a binary heap laid out in a
+ * vector, whose levels alternate between "min" levels (where each item ranks
+ * no later than any of its descendants) and "max" levels (where each item
+ * ranks no earlier than any of its descendants).
+ *
+ * The first-ranked item is therefore always at the root and the last-ranked
+ * item is always one of the root's children, so both can be found in O(1),
+ * and pushing or popping at either end takes O(log n).
+ *
+ * std_pop_front() pops the first-ranked (e.g. smallest) items, while
+ * std_pop_back() and std_pop() pop the last-ranked (e.g. largest) items.
+ * Iterators step through the items in heap order (i.e. not sorted).
+ */
 
 typedef struct
 {
 	std_container_t stContainer;
-	STD_DEQUE_FIELDS;
+	STD_VECTOR_FIELDS;
+	pfn_std_compare_t pfnCompare;
 } std_prioritydeque_t;
 
-#define STD_PRIORITYDEQUE_DECLARE(T,HAS_ENUM)	\
-	STD_DEQUE(std_prioritydeque_t, std_deque_iterator_t, T, std_container_enum_prioritydeque, HAS_ENUM, std_prioritydeque_implements, STD_FAKEVAR())
+#define STD_PRIORITYDEQUE_DECLARE(T,HAS_ENUM,...)	\
+	STD_VECTOR(std_prioritydeque_t, std_vector_iterator_t, T, std_container_enum_prioritydeque, HAS_ENUM, STD_DEFAULT_PARAMETER(std_prioritydeque_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_prioritydeque(T,...)											STD_PRIORITYDEQUE_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_prioritydeque_itemhandler(T,...)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_prioritydeque_memoryhandler(T,...)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_prioritydeque_memoryhandler_itemhandler(T,...)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_prioritydeque_lockhandler(T,...)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_prioritydeque_lockhandler_itemhandler(T,...)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_prioritydeque_lockhandler_memoryhandler(T,...)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_prioritydeque_lockhandler_memoryhandler_itemhandler(T,...)		STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_prioritydeque_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern size_t stdlib_prioritydeque_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_prioritydeque_pop_min(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_prioritydeque_pop_max(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern void * stdlib_prioritydeque_min(std_container_t * pstContainer);
+extern void * stdlib_prioritydeque_max(std_container_t * pstContainer);
+
+extern void stdlib_prioritydeque_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+
+extern const std_item_handler_t std_prioritydeque_default_itemhandler;
+
+// Set the comparison function that a priority deque orders its items by (before pushing any items)
+#define std_prioritydeque_compare_set(PRIORITYDEQUE,COMPARE)				\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(PRIORITYDEQUE, std_container_enum_prioritydeque),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, PRIORITYDEQUE.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_prioritydeque_compare_set(&PRIORITYDEQUE.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Find the first-ranked (e.g. smallest) item in a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return Pointer to the item (or NULL if the priority deque is empty)
+ */
+STD_INLINE void * std_container_call_prioritydeque_min(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_prioritydeque_min(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Find the last-ranked (e.g. largest) item in a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return Pointer to the item (or NULL if the priority deque is empty)
+ */
+STD_INLINE void * std_container_call_prioritydeque_max(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_prioritydeque_max(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+#define std_prioritydeque_min(V)									\
+	(																\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_prioritydeque),	\
+		STD_ITEM_PTR_CAST(V, std_container_call_prioritydeque_min(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V)))	\
+	)
 
-#define std_prioritydeque(T)											STD_PRIORITYDEQUE_DECLARE(T,std_container_has_no_handlers)
-#define std_prioritydeque_itemhandler(T)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_itemhandler)
-#define std_prioritydeque_memoryhandler(T)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_memoryhandler)
-#define std_prioritydeque_memoryhandler_itemhandler(T)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_memoryhandler_itemhandler)
-#define std_prioritydeque_lockhandler(T)								STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler)
-#define std_prioritydeque_lockhandler_itemhandler(T)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_itemhandler)
-#define std_prioritydeque_lockhandler_memoryhandler(T)					STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_memoryhandler)
-#define std_prioritydeque_lockhandler_memoryhandler_itemhandler(T)		STD_PRIORITYDEQUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler)
+#define std_prioritydeque_max(V)									\
+	(																\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_prioritydeque),	\
+		STD_ITEM_PTR_CAST(V, std_container_call_prioritydeque_max(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V)))	\
+	)
 
 enum
 {
@@ -51,18 +130,36 @@ enum
 		( std_container_implements_name
 		| std_container_implements_construct
 		| std_container_implements_destruct
+		| std_container_implements_reserve
 		| std_container_implements_push_pop
-		| std_container_implements_at
+		| std_container_implements_pop_front
+		| std_container_implements_pop_back
+		| std_container_implements_forward_constructnext
+		| std_container_implements_reverse_constructnext
 		| std_container_implements_default_itemhandler)
 };
 
 #define STD_PRIORITYDEQUE_JUMPTABLE \
-	.pachContainerName = "priority deque",			\
-	.pfn_construct		= &stdlib_deque_construct,	\
-	.pfn_destruct		= &stdlib_deque_destruct,	\
-	.pfn_push			= &stdlib_deque_push_front,	\
-	.pfn_pop			= &stdlib_deque_pop_back,	\
-	.pfn_at				= &stdlib_deque_at,			\
-	.pstDefaultItemHandler = &std_deque_default_itemhandler,
+	.pachContainerName = "priority deque",					\
+	.pfn_construct		= &stdlib_prioritydeque_construct,	\
+	.pfn_destruct		= &stdlib_vector_destruct,			\
+	.pfn_reserve		= &stdlib_vector_reserve,			\
+	.pfn_push_back		= &stdlib_prioritydeque_push,		\
+	.pfn_pop_front		= &stdlib_prioritydeque_pop_min,	\
+	.pfn_pop_back		= &stdlib_prioritydeque_pop_max,	\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}													\
+	},														\
+	.pstDefaultItemHandler = &std_prioritydeque_default_itemhandler
 
 #endif /* STD_PRIORITY_DEQUE_H_ */
@@ -25,56 +25,126 @@ SOFTWARE.
 #ifndef STD_PRIORITY_QUEUE_H_
 #define STD_PRIORITY_QUEUE_H_
 
-#include "std/config.h"
 #include "std/vector.h"
 
+/*
+ * A priority queue is held as a d-ary heap laid out in a vector, where the
+ * children of the item at index i sit at indices (d * i) + 1 ... (d * i) + d.
+ *
+ * Raising the fan-out (d) makes the heap shallower, so popping touches fewer
+ * levels, and the d children compared at each level sit next to each other
+ * in memory (e.g. 16 4-byte keys fill a 64-byte cache line). Pushing gets
+ * cheaper too, but each level of a pop compares d children instead of two.
+ *
+ * std_pop() pops the last-ranked (e.g. largest) items first, and std_front()
+ * peeks at the next item that std_pop() would return. Iterators (and
+ * std_at() for any other index) see the items in heap order (i.e. not sorted).
+ */
+
+// Fan-out used until std_priorityqueue_fanout_set() is called (must be a power of two)
+#ifndef STD_PRIORITYQUEUE_DEFAULT_FANOUT
+#define STD_PRIORITYQUEUE_DEFAULT_FANOUT	4U
+#endif
+
+// Largest fan-out allowed
+#define STD_PRIORITYQUEUE_MAX_FANOUT		256U
+
 typedef struct
 {
 	std_container_t stContainer;
 	STD_VECTOR_FIELDS;
-	int (*pfnCompare)(const void* a, const void* b);
+	pfn_std_compare_t pfnCompare;
+	size_t szFanoutShift;		// log2(fan-out)
 } std_priorityqueue_t;
 
-#define STD_PRIORITYQUEUE_DECLARE(T,HAS_ENUM)	\
-		STD_VECTOR(std_priorityqueue_t, std_vector_iterator_t, T, std_container_enum_priorityqueue, HAS_ENUM, std_priorityqueue_implements, STD_FAKEUNION(), STD_FAKESTRUCT())
+#define STD_PRIORITYQUEUE_DECLARE(T,HAS_ENUM,...)	\
+		STD_VECTOR(std_priorityqueue_t, std_vector_iterator_t, T, std_container_enum_priorityqueue, HAS_ENUM, STD_DEFAULT_PARAMETER(std_priorityqueue_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_priorityqueue(T,...)											STD_PRIORITYQUEUE_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_priorityqueue_itemhandler(T,...)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_priorityqueue_memoryhandler(T,...)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_priorityqueue_memoryhandler_itemhandler(T,...)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_priorityqueue_lockhandler(T,...)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_priorityqueue_lockhandler_itemhandler(T,...)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_priorityqueue_lockhandler_memoryhandler(T,...)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_priorityqueue_lockhandler_memoryhandler_itemhandler(T,...)		STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
 
-#define std_priorityqueue(T)											STD_PRIORITYQUEUE_DECLARE(T,std_container_has_no_handlers)
-#define std_priorityqueue_itemhandler(T)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_itemhandler)
-#define std_priorityqueue_memoryhandler(T)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler)
-#define std_priorityqueue_memoryhandler_itemhandler(T)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_memoryhandler_itemhandler)
-#define std_priorityqueue_lockhandler(T)								STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler)
-#define std_priorityqueue_lockhandler_itemhandler(T)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_itemhandler)
-#define std_priorityqueue_lockhandler_memoryhandler(T)					STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler)
-#define std_priorityqueue_lockhandler_memoryhandler_itemhandler(T)		STD_PRIORITYQUEUE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler)
+extern void stdlib_priorityqueue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern size_t stdlib_priorityqueue_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_priorityqueue_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
 
-extern size_t stdlib_priorityqueue_push(std_container_t* pstContainer, std_linear_series_t* pstSeries);
+extern void stdlib_priorityqueue_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+extern bool stdlib_priorityqueue_fanout_set(std_container_t * pstContainer, size_t szFanout);
 
-extern void stdlib_priorityqueue_compare_set(std_priorityqueue_t* pstPriorityQueue, pfn_std_compare_t pfnCompare);
+extern const std_item_handler_t std_priorityqueue_default_itemhandler;
 
+// Set the comparison function that a priority queue orders its items by (before pushing any items)
 #define std_priorityqueue_compare_set(PRIORITYQUEUE,COMPARE)				\
 	(																		\
+		STD_CONTAINER_ENUM_CHECK(PRIORITYQUEUE, std_container_enum_priorityqueue),	\
 		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, PRIORITYQUEUE.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
-		stdlib_priorityqueue_compare_set(&PRIORITYQUEUE.stBody,(pfn_std_compare_t)(COMPARE))	\
+		stdlib_priorityqueue_compare_set(&PRIORITYQUEUE.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Set the fan-out (number of children per item) of a priority queue's heap
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szFanout		Fan-out (a power of two, from 2 to STD_PRIORITYQUEUE_MAX_FANOUT)
+ *
+ * @return True if the fan-out was set, else false
+ */
+STD_INLINE bool std_container_call_priorityqueue_fanout_set(std_container_t * pstContainer, std_container_has_t eHas, size_t szFanout)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_priorityqueue_fanout_set(pstContainer, szFanout);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// e.g. std_priorityqueue_fanout_set(pq, 64U / sizeof(STD_ITEM(pq))) for a cache-line-sized fan-out
+#define std_priorityqueue_fanout_set(PRIORITYQUEUE,FANOUT)					\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(PRIORITYQUEUE, std_container_enum_priorityqueue),	\
+		std_container_call_priorityqueue_fanout_set(&PRIORITYQUEUE.stBody.stContainer, STD_CONTAINER_HAS_GET(PRIORITYQUEUE), FANOUT)	\
 	)
 
 enum
 {
 	std_priorityqueue_implements =
-	(std_container_implements_name
+		( std_container_implements_name
 		| std_container_implements_construct
 		| std_container_implements_destruct
+		| std_container_implements_reserve
 		| std_container_implements_push_pop
 		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_reverse_constructnext
 		| std_container_implements_default_itemhandler)
 };
 
 #define STD_PRIORITYQUEUE_JUMPTABLE \
-	.pachContainerName = "priority queue",				\
-	.pfn_construct		= &stdlib_vector_construct,		\
-	.pfn_destruct		= &stdlib_vector_destruct,		\
-	.pfn_push			= &stdlib_priorityqueue_push,	\
-	.pfn_pop			= &stdlib_vector_pop_front,		\
-	.pfn_at				= &stdlib_vector_at,			\
-	.pstDefaultItemHandler = &std_vector_default_itemhandler,
+	.pachContainerName = "priority queue",					\
+	.pfn_construct		= &stdlib_priorityqueue_construct,	\
+	.pfn_destruct		= &stdlib_vector_destruct,			\
+	.pfn_reserve		= &stdlib_vector_reserve,			\
+	.pfn_push_back		= &stdlib_priorityqueue_push,		\
+	.pfn_pop_back		= &stdlib_priorityqueue_pop,		\
+	.pfn_at				= &stdlib_vector_at,				\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}													\
+	},														\
+	.pstDefaultItemHandler = &std_priorityqueue_default_itemhandler
 
 #endif /* STD_PRIORITY_QUEUE_H_ */
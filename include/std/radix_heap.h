@@ -0,0 +1,175 @@
+/*
+ * std/radix_heap.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_RADIX_HEAP_H_
+#define STD_RADIX_HEAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+/*
+ * A radix heap is a priority queue for unsigned integer keys that only ever
+ * grow: every item is pushed with a 64-bit key, std_pop_front() pops the
+ * items with the smallest key first, and no item may be pushed with a key
+ * smaller than that of the last item popped (as in event simulation, or
+ * Dijkstra's algorithm with non-negative integer weights).
+ *
+ * Items are kept in 65 buckets, chosen by the highest bit in which their key
+ * differs from the last key popped (bucket 0 holding the keys equal to it).
+ * When bucket 0 runs dry, the lowest non-empty bucket is emptied into the
+ * buckets below it, and since each item can only ever move to lower buckets,
+ * every operation takes amortised O(log C) time (for keys up to C), without
+ * any items ever being compared with each other.
+ *
+ * Items with equal keys are popped in no particular order.
+ */
+
+#define STD_RADIX_HEAP_NUM_BUCKETS		65U
+
+#define STD_RADIX_HEAP_NODE(TYPE,NAME)	\
+	struct NAME							\
+	{									\
+		std_radix_heap_node_t stLink;	\
+		TYPE stPayload;					\
+	}
+
+// The STD_RADIX_HEAP macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (unused, but expected by the common macros)
+//	- an iterator smuggle (unused, but expected by the common macros)
+#define STD_RADIX_HEAP(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, NODENAME, TYPEWRAPPER)		\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		STD_RADIX_HEAP_NODE(STD_TYPE_GET(TYPEWRAPPER),NODENAME) * pstLink;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(STD_TYPE_GET(TYPEWRAPPER) const, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);			\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
+	}
+
+typedef struct std_radix_heap_node_s std_radix_heap_node_t;
+
+struct std_radix_heap_node_s
+{
+	std_radix_heap_node_t * pstNext;	// Next node in the same bucket
+	uint64_t u64Key;					// Key that the item was pushed with
+};
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szPayloadOffset;
+	uint64_t u64LastKey;										// Key of the last item popped
+	uint64_t u64Occupied;										// Bitmap of the non-empty buckets (from bucket 1)
+	std_radix_heap_node_t * apstBuckets[STD_RADIX_HEAP_NUM_BUCKETS];	// First node in each bucket
+	std_node_pool_t stPool;										// Where the nodes are allocated from
+} std_radix_heap_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+} std_radix_heap_iterator_t;
+
+#define STD_RADIX_HEAP_DECLARE(T,HAS_ENUM,...)	\
+	STD_RADIX_HEAP(std_radix_heap_t, std_radix_heap_iterator_t, T, std_container_enum_radix_heap, HAS_ENUM, STD_DEFAULT_PARAMETER(std_radix_heap_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_radix_heap(T,...)											STD_RADIX_HEAP_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_radix_heap_itemhandler(T,...)								STD_RADIX_HEAP_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_radix_heap_memoryhandler(T,...)								STD_RADIX_HEAP_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_radix_heap_memoryhandler_itemhandler(T,...)					STD_RADIX_HEAP_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_radix_heap_lockhandler(T,...)								STD_RADIX_HEAP_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_radix_heap_lockhandler_itemhandler(T,...)					STD_RADIX_HEAP_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_radix_heap_lockhandler_memoryhandler(T,...)					STD_RADIX_HEAP_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_radix_heap_lockhandler_memoryhandler_itemhandler(T,...)		STD_RADIX_HEAP_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_radix_heap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_radix_heap_destruct(std_container_t * pstContainer);
+extern bool stdlib_radix_heap_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_radix_heap_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern bool stdlib_radix_heap_push(std_container_t * pstContainer, uint64_t u64Key, const void * pvItem);
+
+extern const std_item_handler_t std_radix_heap_default_itemhandler;
+
+/**
+ * Push an item into a radix heap
+ *
+ * @param[in]	pstContainer	Radix heap container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	u64Key			Key to push the item with
+ * @param[in]	pvItem			Item to push
+ *
+ * @return True if the item was pushed, false if out of memory or its key is smaller than the last key popped
+ */
+STD_INLINE bool std_container_call_radix_heap_push(std_container_t * pstContainer, std_container_has_t eHas, uint64_t u64Key, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_radix_heap_push(pstContainer, u64Key, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Push one item, e.g. std_radix_heap_push(rh, u64Distance, { .szNode = 3U })
+#define std_radix_heap_push(V,KEY,...)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_radix_heap),			\
+		std_container_call_radix_heap_push(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), KEY, (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+// Find the key of the last item popped (which is also the smallest key that can still be pushed)
+#define std_radix_heap_last_key(V)				((V).stBody.u64LastKey)
+
+enum
+{
+	std_radix_heap_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_pop_front
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_RADIX_HEAP_JUMPTABLE \
+	.pachContainerName = "radix heap",					\
+	.pfn_construct		= &stdlib_radix_heap_construct,	\
+	.pfn_destruct		= &stdlib_radix_heap_destruct,	\
+	.pfn_reserve		= &stdlib_radix_heap_reserve,	\
+	.pfn_pop_front		= &stdlib_radix_heap_pop_front,	\
+	.pstDefaultItemHandler = &std_radix_heap_default_itemhandler
+
+#endif /* STD_RADIX_HEAP_H_ */
@@ -25,13 +25,309 @@ SOFTWARE.
 #ifndef STD_SET_H_
 #define STD_SET_H_
 
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+// Rough size (in bytes) of the items held in each B-tree node
+#ifndef STD_SET_NODE_BYTES
+#define STD_SET_NODE_BYTES		256U
+#endif
+
+/*
+ * Sets, multisets and maps are all held as in-memory B-trees: each node
+ * holds a sorted run of up to a few cache lines' worth of items (and, if it
+ * isn't a leaf, a child pointer either side of each item). That puts many
+ * items into each cache miss, where a red-black tree would take one miss
+ * per item compared.
+ *
+ * Every node also counts the items in the subtree below it, so that items
+ * can be found by their index (their rank in sorted order) in O(log n): so
+ * std_at() works, and the indices that std_set_lower_bound() and
+ * std_set_upper_bound() return can be iterated over with std_for_range().
+ *
+ * Items are ordered by their comparison function (which has to be set
+ * before pushing any items): a set holds one item per key, whereas a
+ * multiset holds items with equal keys in the order they were pushed.
+ */
+
+typedef struct std_set_node_s std_set_node_t;
+
+struct std_set_node_s
+{
+	std_set_node_t * pstParent;		// Parent node (or NULL for the root)
+	size_t szCount;					// Number of items in the subtree rooted at this node
+	size_t szNumItems;				// Number of items in this node
+	bool bLeaf;						// True if this node has no children
+	// ...followed by the node's items (and, for internal nodes, its child pointers)
+};
+
+// The STD_SET macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (for ordering the set)
+//	- an iterator smuggle, used to give easy access to associated iterators
+#define STD_SET(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, TYPEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(const STD_TYPE_GET(TYPEWRAPPER), pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(0);			\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(TYPEWRAPPER)));		\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+typedef struct
+{
+	std_container_t stContainer;
+	pfn_std_compare_t pfnCompare;
+	std_set_node_t * pstRoot;
+	size_t szMinItems;				// Fewest items a non-root node may hold
+	size_t szMaxItems;				// Most items any node may hold
+	size_t szItemsOffset;			// Offset of the items inside a node
+	size_t szChildrenOffset;		// Offset of the child pointers inside an internal node
+	bool bMulti;					// True if items with equal keys are allowed
+	std_node_pool_t stLeafPool;		// Where the leaf nodes are allocated from
+	std_node_pool_t stBranchPool;	// Where the internal nodes are allocated from
+} std_set_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	std_set_node_t * pstNode;
+	size_t szIndex;					// Index of the current item inside its node
+	size_t szRemaining;				// Number of items left to step through after the current one
+} std_set_iterator_t;
+
+// Client-side declaration code
+
+#define STD_SET_DECLARE(T,ENUM,IMPLEMENTS,HAS_ENUM,...)	\
+	STD_SET(std_set_t, std_set_iterator_t, T, ENUM, HAS_ENUM, STD_DEFAULT_PARAMETER(IMPLEMENTS,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_set(T,...)												STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_no_handlers,__VA_ARGS__)
+#define std_set_itemhandler(T,...)									STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_itemhandler,__VA_ARGS__)
+#define std_set_memoryhandler(T,...)								STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_set_memoryhandler_itemhandler(T,...)					STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_set_lockhandler(T,...)									STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_lockhandler,__VA_ARGS__)
+#define std_set_lockhandler_itemhandler(T,...)						STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_set_lockhandler_memoryhandler(T,...)					STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_set_lockhandler_memoryhandler_itemhandler(T,...)		STD_SET_DECLARE(T,std_container_enum_set,std_set_implements,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+#define std_multiset(T,...)											STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_no_handlers,__VA_ARGS__)
+#define std_multiset_itemhandler(T,...)								STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_itemhandler,__VA_ARGS__)
+#define std_multiset_memoryhandler(T,...)							STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_multiset_memoryhandler_itemhandler(T,...)				STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_multiset_lockhandler(T,...)								STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_lockhandler,__VA_ARGS__)
+#define std_multiset_lockhandler_itemhandler(T,...)					STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_multiset_lockhandler_memoryhandler(T,...)				STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_multiset_lockhandler_memoryhandler_itemhandler(T,...)	STD_SET_DECLARE(T,std_container_enum_multiset,std_multiset_implements,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods
+
+extern void stdlib_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern void stdlib_multiset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_set_destruct(std_container_t * pstContainer);
+extern bool stdlib_set_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_set_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_set_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern void * stdlib_set_at(std_container_t * pstContainer, size_t szIndex);
+
+extern void stdlib_set_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+extern void * stdlib_set_find(std_container_t * pstContainer, const void * pvKey);
+extern void * stdlib_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted);
+extern bool stdlib_set_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult);
+extern size_t stdlib_set_lower_bound(std_container_t * pstContainer, const void * pvKey);
+extern size_t stdlib_set_upper_bound(std_container_t * pstContainer, const void * pvKey);
+
+extern void stdlib_set_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_set_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_set_forwarditerator_next(std_iterator_t * pstIterator);
+extern void stdlib_set_reverseiterator_next(std_iterator_t * pstIterator);
+
+extern const std_item_handler_t std_set_default_itemhandler;
+
+// Sets, multisets and maps all share the same operations
+#define STD_SET_ENUM_CHECK(V)																\
+	STD_STATIC_ASSERT(		(STD_CONTAINER_ENUM_GET(V) == std_container_enum_set)			\
+						||	(STD_CONTAINER_ENUM_GET(V) == std_container_enum_multiset)		\
+						||	(STD_CONTAINER_ENUM_GET(V) == std_container_enum_map),			\
+						STD_CONCAT(operation_is_not_supported_by_this_type_of_container_,__COUNTER__))
+
+// Set the comparison function that a set orders its items by (before pushing any items)
+#define std_set_compare_set(SET,COMPARE)													\
+	(																						\
+		STD_SET_ENUM_CHECK(SET),															\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, SET.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_set_compare_set(&SET.stBody.stContainer,(pfn_std_compare_t)(COMPARE))		\
+	)
+
+/**
+ * Find an item matching a key in a set
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key to look for
+ *
+ * @return Pointer to a matching item (or NULL if there isn't one)
+ */
+STD_INLINE void * std_container_call_set_find(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_set_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Insert an item into a set (unless it's a set that already holds an item with the same key)
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, else false
+ */
+STD_INLINE bool std_container_call_set_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_set_insert(pstContainer, pvItem, false, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted;
+}
+
+/**
+ * Erase one item matching a key from a set (for a multiset, the first one pushed)
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key of the item to erase
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+STD_INLINE bool std_container_call_set_erase(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_set_erase(pstContainer, pvKey, NULL);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Find the index of the first item in a set that isn't ranked before a key
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key
+ * @param[in]	bUpper			If true, find the first item ranked after the key instead
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+STD_INLINE size_t std_container_call_set_bound(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey, bool bUpper)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	size_t szIndex = bUpper ? stdlib_set_upper_bound(pstContainer, pvKey) : stdlib_set_lower_bound(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return szIndex;
+}
+
+// Find an item (in a multiset, the first with the key), e.g. pstPoint = std_set_find(set, { .x = 1, .y = 2 })
+#define std_set_find(V,...)																	\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		STD_ITEM_PTR_CAST(V, std_container_call_set_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_set_contains(V,...)																\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		(std_container_call_set_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+#define std_set_insert(V,...)																\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		std_container_call_set_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_set_erase(V,...)																\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		std_container_call_set_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+// Index of the first item not ranked before a key, e.g. for (std_for_range(set, it, std_set_lower_bound(set, 10), std_set_upper_bound(set, 20) - 1U))
+#define std_set_lower_bound(V,...)															\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		std_container_call_set_bound(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }, false)	\
+	)
+
+// Index of the first item ranked after a key
+#define std_set_upper_bound(V,...)															\
+	(																						\
+		STD_SET_ENUM_CHECK(V),																\
+		std_container_call_set_bound(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }, true)	\
+	)
+
 enum
 {
 	std_set_implements =
-		std_container_implements_name
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_pop_front
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler),
+	std_multiset_implements = std_set_implements
 };
 
-#define STD_SET_JUMPTABLE \
-		.pachContainerName = "set"
+#define STD_SET_SHARED_JUMPTABLE							\
+	.pfn_destruct		= &stdlib_set_destruct,				\
+	.pfn_reserve		= &stdlib_set_reserve,				\
+	.pfn_push_back		= &stdlib_set_push,					\
+	.pfn_pop_front		= &stdlib_set_pop_front,			\
+	.pfn_pop_back		= &stdlib_set_pop_back,				\
+	.pfn_at				= &stdlib_set_at,					\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_set_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_set_forwarditerator_next,			\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_set_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_set_reverseiterator_next,			\
+		},													\
+	},														\
+	.pstDefaultItemHandler = &std_set_default_itemhandler
+
+#define STD_SET_JUMPTABLE									\
+	.pachContainerName = "set",								\
+	.pfn_construct		= &stdlib_set_construct,			\
+	STD_SET_SHARED_JUMPTABLE
+
+#define STD_MULTISET_JUMPTABLE								\
+	.pachContainerName = "multiset",						\
+	.pfn_construct		= &stdlib_multiset_construct,		\
+	STD_SET_SHARED_JUMPTABLE
 
 #endif /* STD_SET_H_ */
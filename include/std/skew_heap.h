@@ -0,0 +1,204 @@
+/*
+ * std/skew_heap.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SKEW_HEAP_H_
+#define STD_SKEW_HEAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+/*
+ * A skew heap is a priority queue held as a binary tree of nodes (in heap
+ * order, but with no balance condition), whose every operation is built from
+ * melding two heaps together along their right-hand paths. Melding swaps the
+ * children of each node it passes, which keeps those paths short enough for
+ * pushing, popping and melding to take amortised O(log n) time.
+ *
+ * Melding one skew heap into another only relinks nodes (no items are ever
+ * copied), so a whole heap can be merged into another in O(log n) rather
+ * than having to pop and push every item.
+ *
+ * Like a priority queue, std_pop() pops the last-ranked (e.g. largest) items
+ * first.
+ */
+
+#define STD_SKEW_HEAP_NODE(TYPE,NAME)	\
+	struct NAME							\
+	{									\
+		std_skew_heap_node_t stLink;	\
+		TYPE stPayload;					\
+	}
+
+// The STD_SKEW_HEAP macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (for ordering the heap)
+//	- an iterator smuggle (unused, but expected by the common macros)
+#define STD_SKEW_HEAP(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, NODENAME, TYPEWRAPPER)		\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		STD_SKEW_HEAP_NODE(STD_TYPE_GET(TYPEWRAPPER),NODENAME) * pstLink;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(STD_TYPE_GET(TYPEWRAPPER) const, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);			\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
+	}
+
+typedef struct std_skew_heap_node_s std_skew_heap_node_t;
+
+struct std_skew_heap_node_s
+{
+	std_skew_heap_node_t * pstLeft;
+	std_skew_heap_node_t * pstRight;
+};
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szPayloadOffset;
+	pfn_std_compare_t pfnCompare;
+	std_skew_heap_node_t * pstRoot;
+	std_node_pool_t stPool;		// Where the nodes are allocated from
+} std_skew_heap_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+} std_skew_heap_iterator_t;
+
+#define STD_SKEW_HEAP_DECLARE(T,HAS_ENUM,...)	\
+	STD_SKEW_HEAP(std_skew_heap_t, std_skew_heap_iterator_t, T, std_container_enum_skew_heap, HAS_ENUM, STD_DEFAULT_PARAMETER(std_skew_heap_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_skew_heap(T,...)											STD_SKEW_HEAP_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_skew_heap_itemhandler(T,...)								STD_SKEW_HEAP_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_skew_heap_memoryhandler(T,...)								STD_SKEW_HEAP_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_skew_heap_memoryhandler_itemhandler(T,...)					STD_SKEW_HEAP_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_skew_heap_lockhandler(T,...)								STD_SKEW_HEAP_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_skew_heap_lockhandler_itemhandler(T,...)					STD_SKEW_HEAP_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_skew_heap_lockhandler_memoryhandler(T,...)					STD_SKEW_HEAP_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_skew_heap_lockhandler_memoryhandler_itemhandler(T,...)		STD_SKEW_HEAP_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_skew_heap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_skew_heap_destruct(std_container_t * pstContainer);
+extern bool stdlib_skew_heap_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_skew_heap_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_skew_heap_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern void * stdlib_skew_heap_top(std_container_t * pstContainer);
+extern bool stdlib_skew_heap_meld(std_container_t * pstContainer, std_container_t * pstSource);
+extern void stdlib_skew_heap_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+
+extern const std_item_handler_t std_skew_heap_default_itemhandler;
+
+// Set the comparison function that a skew heap orders its items by (before pushing any items)
+#define std_skew_heap_compare_set(SKEWHEAP,COMPARE)							\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(SKEWHEAP, std_container_enum_skew_heap),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, SKEWHEAP.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_skew_heap_compare_set(&SKEWHEAP.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Find the item that a skew heap would pop next
+ *
+ * @param[in]	pstContainer	Skew heap container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ *
+ * @return Pointer to the item (or NULL if the skew heap is empty)
+ */
+STD_INLINE void * std_container_call_skew_heap_top(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_skew_heap_top(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Meld all the items of one skew heap into another, leaving the source skew heap empty
+ *
+ * Note: both skew heaps must use the same comparison function and memory handler
+ *
+ * @param[in]	pstContainer	Destination skew heap container
+ * @param[in]	pstSource		Source skew heap container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers these containers have
+ *
+ * @return True if the skew heaps were melded (false if they use different memory handlers)
+ */
+STD_INLINE bool std_container_call_skew_heap_meld(std_container_t * pstContainer, std_container_t * pstSource, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState;
+	std_lock_state_t eOldSourceState;
+	std_container_lock_pair_for_writing(pstContainer, pstSource, eHas, &eOldState, &eOldSourceState);
+	bool bResult = stdlib_skew_heap_meld(pstContainer, pstSource);
+	std_container_lock_pair_restore(pstContainer, pstSource, eHas, eOldState, eOldSourceState);
+	return bResult;
+}
+
+#define std_skew_heap_top(V)												\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_skew_heap),			\
+		STD_ITEM_PTR_CAST(V, std_container_call_skew_heap_top(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V)))	\
+	)
+
+#define std_skew_heap_meld(V,SOURCE)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_skew_heap),			\
+		STD_CHECK_SAME_CONTAINERS(V,SOURCE),								\
+		std_container_call_skew_heap_meld(&V.stBody.stContainer, &SOURCE.stBody.stContainer, STD_CONTAINER_HAS_GET(V))	\
+	)
+
+enum
+{
+	std_skew_heap_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_SKEW_HEAP_JUMPTABLE \
+	.pachContainerName = "skew heap",					\
+	.pfn_construct		= &stdlib_skew_heap_construct,	\
+	.pfn_destruct		= &stdlib_skew_heap_destruct,	\
+	.pfn_reserve		= &stdlib_skew_heap_reserve,	\
+	.pfn_push_back		= &stdlib_skew_heap_push,		\
+	.pfn_pop_back		= &stdlib_skew_heap_pop,		\
+	.pstDefaultItemHandler = &std_skew_heap_default_itemhandler
+
+#endif /* STD_SKEW_HEAP_H_ */
@@ -0,0 +1,244 @@
+/*
+ * std/slot_map.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SLOT_MAP_H_
+#define STD_SLOT_MAP_H_
+
+#include "std/vector.h"
+
+/*
+ * A slot map holds its items densely packed in a vector (so they can be
+ * iterated contiguously, just like a vector's), and hands out a stable
+ * handle for each item inserted. A handle is a (slot, generation) pair: the
+ * slot array maps each slot to its item's current vector index, so looking
+ * up a handle is O(1) with one indirection, and erasing an item moves the
+ * final item into its place (updating that item's slot).
+ *
+ * Each slot's generation is bumped whenever its item is inserted or erased
+ * (so live slots have odd generations), and freed slots are recycled through
+ * a free list. A handle whose item has since been erased therefore never
+ * matches its slot again (until its generation wraps round, after 2^31
+ * reuses of the slot), and looking it up safely returns NULL.
+ *
+ * Iterators, std_at() and std_for_range() see the items in their (dense)
+ * vector order, which changes as items are erased: std_slot_map_handle_at()
+ * gives the handle of the item at a given index.
+ */
+
+typedef struct
+{
+	uint32_t u32Slot;
+	uint32_t u32Generation;
+} std_slot_map_handle_t;
+
+// A handle that never refers to an item (generation zero is never handed out)
+#define STD_SLOT_MAP_NULL_HANDLE		((std_slot_map_handle_t){ .u32Slot = 0U, .u32Generation = 0U })
+
+typedef struct
+{
+	uint32_t u32Index;				// Vector index of the slot's item (or the next free slot)
+	uint32_t u32Generation;			// Odd while the slot holds an item
+} std_slot_map_slot_t;
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;
+	std_slot_map_slot_t * pstSlots;	// Every slot handed out so far
+	uint32_t * pu32IndexToSlot;		// Slot of the item at each vector index
+	size_t szNumIndexAlloced;		// Number of entries allocated in each of the two arrays
+	uint32_t u32NumSlots;			// Number of slots handed out so far
+	uint32_t u32FreeSlot;			// First free slot (or UINT32_MAX)
+} std_slot_map_t;
+
+#define STD_SLOT_MAP_DECLARE(T,HAS_ENUM,...)	\
+		STD_VECTOR(std_slot_map_t, std_vector_iterator_t, T, std_container_enum_slot_map, HAS_ENUM, STD_DEFAULT_PARAMETER(std_slot_map_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_slot_map(T,...)											STD_SLOT_MAP_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_slot_map_itemhandler(T,...)								STD_SLOT_MAP_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_slot_map_memoryhandler(T,...)							STD_SLOT_MAP_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_slot_map_memoryhandler_itemhandler(T,...)				STD_SLOT_MAP_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_slot_map_lockhandler(T,...)								STD_SLOT_MAP_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_slot_map_lockhandler_itemhandler(T,...)					STD_SLOT_MAP_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_slot_map_lockhandler_memoryhandler(T,...)				STD_SLOT_MAP_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_slot_map_lockhandler_memoryhandler_itemhandler(T,...)	STD_SLOT_MAP_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_slot_map_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_slot_map_destruct(std_container_t * pstContainer);
+extern bool stdlib_slot_map_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_slot_map_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_slot_map_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern std_slot_map_handle_t stdlib_slot_map_insert(std_container_t * pstContainer, const void * pvItem);
+extern void * stdlib_slot_map_handle_to_item(std_container_t * pstContainer, std_slot_map_handle_t stHandle);
+extern std_slot_map_handle_t stdlib_slot_map_index_to_handle(std_container_t * pstContainer, size_t szIndex);
+extern bool stdlib_slot_map_erase(std_container_t * pstContainer, std_slot_map_handle_t stHandle, void * pvResult);
+
+extern const std_item_handler_t std_slot_map_default_itemhandler;
+
+/**
+ * Insert an item into a slot map
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return Handle of the inserted item (or STD_SLOT_MAP_NULL_HANDLE if it couldn't be inserted)
+ */
+STD_INLINE std_slot_map_handle_t std_container_call_slot_map_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	std_slot_map_handle_t stHandle = stdlib_slot_map_insert(pstContainer, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return stHandle;
+}
+
+/**
+ * Find the item that a handle refers to in a slot map
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	stHandle		Handle of the item
+ *
+ * @return Pointer to the item (or NULL if the handle is stale)
+ */
+STD_INLINE void * std_container_call_slot_map_at(std_container_t * pstContainer, std_container_has_t eHas, std_slot_map_handle_t stHandle)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_slot_map_handle_to_item(pstContainer, stHandle);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Find the handle of the item at an index in a slot map
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szIndex			Index of the item
+ *
+ * @return Handle of the item (or STD_SLOT_MAP_NULL_HANDLE if the index is out of range)
+ */
+STD_INLINE std_slot_map_handle_t std_container_call_slot_map_handle_at(std_container_t * pstContainer, std_container_has_t eHas, size_t szIndex)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	std_slot_map_handle_t stHandle = stdlib_slot_map_index_to_handle(pstContainer, szIndex);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return stHandle;
+}
+
+/**
+ * Erase the item that a handle refers to from a slot map
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	stHandle		Handle of the item
+ *
+ * @return True if the item was erased, false if the handle is stale
+ */
+STD_INLINE bool std_container_call_slot_map_erase(std_container_t * pstContainer, std_container_has_t eHas, std_slot_map_handle_t stHandle)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_slot_map_erase(pstContainer, stHandle, NULL);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Find out whether a handle is the null handle
+#define std_slot_map_handle_is_null(HANDLE)		((HANDLE).u32Generation == 0U)
+
+// Insert one item, e.g. stHandle = std_slot_map_insert(map, { .x = 1, .y = 2 })
+#define std_slot_map_insert(V,...)											\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_slot_map),			\
+		std_container_call_slot_map_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+// Find the item that a handle refers to (or NULL, if the handle is stale)
+#define std_slot_map_at(V,HANDLE)											\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_slot_map),			\
+		STD_ITEM_PTR_CAST(V, std_container_call_slot_map_at(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE))	\
+	)
+
+#define std_slot_map_contains(V,HANDLE)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_slot_map),			\
+		(std_container_call_slot_map_at(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE) != NULL)	\
+	)
+
+// Find the handle of the item at an index (e.g. while iterating through the items)
+#define std_slot_map_handle_at(V,INDEX)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_slot_map),			\
+		std_container_call_slot_map_handle_at(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), INDEX)	\
+	)
+
+#define std_slot_map_erase(V,HANDLE)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_slot_map),			\
+		std_container_call_slot_map_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), HANDLE)	\
+	)
+
+enum
+{
+	std_slot_map_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_SLOT_MAP_JUMPTABLE \
+	.pachContainerName = "slot map",								\
+	.pfn_construct		= &stdlib_slot_map_construct,				\
+	.pfn_destruct		= &stdlib_slot_map_destruct,				\
+	.pfn_reserve		= &stdlib_slot_map_reserve,					\
+	.pfn_push_back		= &stdlib_slot_map_push,					\
+	.pfn_pop_back		= &stdlib_slot_map_pop,						\
+	.pfn_at				= &stdlib_vector_at,						\
+	.astIterators =													\
+	{																\
+		[std_iterator_enum_forward] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},															\
+		[std_iterator_enum_reverse] =								\
+		{															\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}															\
+	},																\
+	.pstDefaultItemHandler = &std_slot_map_default_itemhandler
+
+#endif /* STD_SLOT_MAP_H_ */
@@ -0,0 +1,256 @@
+/*
+ * std/soa_vector.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SOA_VECTOR_H_
+#define STD_SOA_VECTOR_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+
+/*
+ * A struct-of-arrays (SoA) vector holds items of a struct type, but stores
+ * each registered field (column) of the struct in its own contiguous array.
+ * All the columns live inside a single allocation, so growing the container
+ * reallocates every column together.
+ *
+ * Because an item never exists as a whole struct inside the container, its
+ * iterators gather each item into a row buffer held inside the iterator:
+ * std_iterator_at() returns a pointer to that (read-only) copy. To modify an
+ * item in place, use std_soa_vector_at() on the relevant field.
+ */
+
+#ifndef STD_SOA_VECTOR_MAX_COLUMNS
+#define STD_SOA_VECTOR_MAX_COLUMNS		16
+#endif
+
+// Smallest number of items allocated: this keeps every column 16-byte aligned
+#ifndef STD_SOA_VECTOR_MIN_CAPACITY
+#define STD_SOA_VECTOR_MIN_CAPACITY		16
+#endif
+
+#define STD_SOA_VECTOR_ITERATOR(TYPE,NAME)	\
+	struct NAME						\
+	{								\
+		std_iterator_t	stIterator;	\
+		size_t			szIndex;	\
+		size_t			szRangeEnd;	\
+		TYPE			stRow;		\
+	}
+
+// The STD_SOA_VECTOR macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function type (e.g. for sorting)
+//	- an iterator smuggle, used to give easy access to associated iterators
+// Note that the payload offset is the offset of the gathered row inside an iterator
+#define STD_SOA_VECTOR(BASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, ITNAME, TYPEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		STD_SOA_VECTOR_ITERATOR(STD_TYPE_GET(TYPEWRAPPER),ITNAME) * pstRowIterator;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(const STD_TYPE_GET(TYPEWRAPPER), pfnCompare);	\
+		\
+		STD_ITERATORS(struct ITNAME, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct ITNAME, stRow));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(TYPEWRAPPER)));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+// Description of a single column (i.e. a field of the item struct)
+typedef struct
+{
+	size_t szOffset;		// Offset of the field within the item
+	size_t szSizeof;		// Size of the field
+} std_soa_vector_column_t;
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szNumAlloced;
+	void* pvStartAddr;
+	size_t szRowOffset;		// Offset of the gathered row within an iterator
+	size_t szNumColumns;
+	size_t szRowBytes;		// Sum of the sizes of all the columns
+	std_soa_vector_column_t astColumns[STD_SOA_VECTOR_MAX_COLUMNS];
+	size_t aszColumnPrefix[STD_SOA_VECTOR_MAX_COLUMNS];		// Column N starts at (szNumAlloced * aszColumnPrefix[N])
+} std_soa_vector_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	size_t szIndex;
+	size_t szRangeEnd;
+} std_soa_vector_iterator_t;
+
+// Client-side declaration code
+// Note: items are split into columns, so item handlers are not supported
+
+#define STD_SOA_VECTOR_DECLARE(T,HAS_ENUM,...)	\
+	STD_SOA_VECTOR(std_soa_vector_t, T, std_container_enum_soa_vector, HAS_ENUM, STD_DEFAULT_PARAMETER(std_soa_vector_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_soa_vector(T,...)									STD_SOA_VECTOR_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_soa_vector_memoryhandler(T,...)						STD_SOA_VECTOR_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_soa_vector_lockhandler(T,...)						STD_SOA_VECTOR_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_soa_vector_lockhandler_memoryhandler(T,...)			STD_SOA_VECTOR_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods
+
+extern void stdlib_soa_vector_construct(	std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_soa_vector_destruct(		std_container_t * pstContainer);
+extern bool stdlib_soa_vector_reserve(		std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_soa_vector_push_front(	std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_soa_vector_push_back(	std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_soa_vector_pop_front(	std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_soa_vector_pop_back(	std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern bool stdlib_soa_vector_columns_set(std_container_t * pstContainer, const std_soa_vector_column_t * pastColumns, size_t szNumColumns);
+extern void * stdlib_soa_vector_column_at(std_container_t * pstContainer, size_t szOffset, size_t szSizeof, size_t szIndex);
+
+extern void stdlib_soa_vector_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_soa_vector_forwarditerator_seek(std_iterator_t * pstIterator, size_t szIndex);
+extern void stdlib_soa_vector_forwarditerator_next(std_iterator_t * pstIterator);
+extern void stdlib_soa_vector_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_soa_vector_reverseiterator_next(std_iterator_t * pstIterator);
+
+extern const std_item_handler_t std_soa_vector_default_itemhandler;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Describe one field of a typed SoA vector's item struct as a column
+#define STD_SOA_VECTOR_FIELD(V,FIELD)	\
+	{ .szOffset = STD_OFFSETOF(STD_ITEM_TYPEOF(V), FIELD), .szSizeof = sizeof(STD_ITEM(V).FIELD) }
+
+/**
+ * Set the columns that an (empty) SoA vector splits its items into
+ *
+ * @param[in]	pstContainer	SoA vector container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pastColumns		Array of column descriptions
+ * @param[in]	szNumColumns	Number of columns in the array
+ *
+ * @return True if the columns were set, else false (e.g. if the container wasn't empty)
+ */
+STD_INLINE bool std_container_call_soa_vector_columns_set(std_container_t * pstContainer, std_container_has_t eHas, const std_soa_vector_column_t * pastColumns, size_t szNumColumns)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bRetVal = stdlib_soa_vector_columns_set(pstContainer, pastColumns, szNumColumns);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bRetVal;
+}
+
+// e.g. std_soa_vector_columns_set(v, STD_SOA_VECTOR_FIELD(v, x), STD_SOA_VECTOR_FIELD(v, y));
+#define std_soa_vector_columns_set(V,...)									\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_soa_vector),			\
+		std_container_call_soa_vector_columns_set(							\
+			&V.stBody.stContainer,											\
+			STD_CONTAINER_HAS_GET(V),										\
+			(const std_soa_vector_column_t[]){ __VA_ARGS__ },				\
+			STD_NUM_ELEMENTS(((const std_soa_vector_column_t[]){ __VA_ARGS__ })) )	\
+	)
+
+/**
+ * Calculate a pointer to an indexed entry within one of a SoA vector's columns
+ *
+ * @param[in]	pstContainer	SoA vector container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szOffset		Offset of the column's field within the item
+ * @param[in]	szSizeof		Size of the column's field
+ * @param[in]	szIndex			Index of entry
+ *
+ * @return Pointer to the entry (or NULL if the field isn't a column)
+ */
+STD_INLINE void * std_container_call_soa_vector_column_at(std_container_t * pstContainer, std_container_has_t eHas, size_t szOffset, size_t szSizeof, size_t szIndex)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvPtr = stdlib_soa_vector_column_at(pstContainer, szOffset, szSizeof, szIndex);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvPtr;
+}
+
+// Get a typed pointer to a field of an indexed item (held within its column)
+#define std_soa_vector_at(V,FIELD,INDEX)									\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_soa_vector),			\
+		(STD_TYPEOF(STD_ITEM(V).FIELD) *) std_container_call_soa_vector_column_at(	\
+			&V.stBody.stContainer,											\
+			STD_CONTAINER_HAS_GET(V),										\
+			STD_OFFSETOF(STD_ITEM_TYPEOF(V), FIELD),						\
+			sizeof(STD_ITEM(V).FIELD),										\
+			INDEX)															\
+	)
+
+// Get a typed pointer to the (contiguous) array holding a column
+#define std_soa_vector_column(V,FIELD)		std_soa_vector_at(V,FIELD,0)
+
+enum
+{
+	std_soa_vector_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_pushpop_front
+		| std_container_implements_pushpop_back
+		| std_container_implements_reserve
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_default_itemhandler
+		| std_container_implements_ranged_iterator	)
+};
+
+#define STD_SOA_VECTOR_JUMPTABLE \
+	.pachContainerName = "soa vector",					\
+	.pfn_construct		= &stdlib_soa_vector_construct,		\
+	.pfn_destruct		= &stdlib_soa_vector_destruct,		\
+	.pfn_push_front		= &stdlib_soa_vector_push_front,	\
+	.pfn_push_back		= &stdlib_soa_vector_push_back,		\
+	.pfn_pop_front		= &stdlib_soa_vector_pop_front,		\
+	.pfn_pop_back		= &stdlib_soa_vector_pop_back,		\
+	.pfn_reserve		= &stdlib_soa_vector_reserve,		\
+	.astIterators =										\
+	{													\
+		[std_iterator_enum_forward] =					\
+		{												\
+			.pfn_construct	= &stdlib_soa_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_soa_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_soa_vector_forwarditerator_next,		\
+		},												\
+		[std_iterator_enum_reverse] =					\
+		{												\
+			.pfn_construct	= &stdlib_soa_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_soa_vector_reverseiterator_next,		\
+		}												\
+	},													\
+	.pstDefaultItemHandler = &std_soa_vector_default_itemhandler
+
+#endif /* STD_SOA_VECTOR_H_ */
@@ -0,0 +1,163 @@
+/*
+ * std/sparse_map.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SPARSE_MAP_H_
+#define STD_SPARSE_MAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/sparse_set.h"
+
+/*
+ * A sparse map is a sparse set whose items are { szKey, stValue } entries,
+ * i.e. it carries a payload per key. The key comes first in each entry, so
+ * the sparse set's code only ever looks at keys.
+ *
+ * Clearing a sparse map is O(1) unless it has an item handler that needs to
+ * destruct its entries.
+ */
+
+#define STD_SPARSE_MAP_ENTRY(VALUETYPE,NAME)	\
+	struct NAME								\
+	{										\
+		size_t szKey;						\
+		VALUETYPE stValue;					\
+	}
+
+// The STD_SPARSE_MAP macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- type smuggles, used to give easy access to (entry *) and (value *) casts
+//	- a typed comparison function (on entries)
+//	- an iterator smuggle, used to give easy access to associated iterators
+#define STD_SPARSE_MAP(BASE, ITBASE, VALUETYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, ENTRYNAME, VALUEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(VALUEWRAPPER,VALUETYPE) * pstValueWrapper;		\
+		STD_SPARSE_MAP_ENTRY(STD_TYPE_GET(VALUEWRAPPER),ENTRYNAME) * pstEntry;	\
+		\
+		BASE 	   			 stBody;					\
+		struct ENTRYNAME		*	pstType;			\
+		STD_TYPE_GET(VALUEWRAPPER)	*	pstValue;		\
+		STD_COMPARE(const struct ENTRYNAME, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, struct ENTRYNAME, UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct ENTRYNAME, stValue));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct ENTRYNAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+// Client-side declaration code
+
+#define STD_SPARSE_MAP_DECLARE(V,HAS_ENUM,...)	\
+	STD_SPARSE_MAP(std_sparse_set_t, std_vector_iterator_t, V, std_container_enum_sparse_map, HAS_ENUM, STD_DEFAULT_PARAMETER(std_sparse_map_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_sparse_map(V,...)											STD_SPARSE_MAP_DECLARE(V,std_container_has_no_handlers,__VA_ARGS__)
+#define std_sparse_map_itemhandler(V,...)								STD_SPARSE_MAP_DECLARE(V,std_container_has_itemhandler,__VA_ARGS__)
+#define std_sparse_map_memoryhandler(V,...)								STD_SPARSE_MAP_DECLARE(V,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_sparse_map_memoryhandler_itemhandler(V,...)					STD_SPARSE_MAP_DECLARE(V,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_sparse_map_lockhandler(V,...)								STD_SPARSE_MAP_DECLARE(V,std_container_has_lockhandler,__VA_ARGS__)
+#define std_sparse_map_lockhandler_itemhandler(V,...)					STD_SPARSE_MAP_DECLARE(V,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_sparse_map_lockhandler_memoryhandler(V,...)					STD_SPARSE_MAP_DECLARE(V,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_sparse_map_lockhandler_memoryhandler_itemhandler(V,...)		STD_SPARSE_MAP_DECLARE(V,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+/**
+ * Find the value stored against a key in a sparse map
+ *
+ * @param[in]	pstContainer	Sparse map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	szKey			Key to look for
+ *
+ * @return Pointer to the value (or NULL if the key isn't in the map)
+ */
+STD_INLINE void * std_container_call_sparse_map_find(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, size_t szKey)
+{
+	void * pvEntry = std_container_call_sparse_set_find(pstContainer, eHas, szKey);
+	return (pvEntry == NULL) ? NULL : STD_LINEAR_ADD(pvEntry, szValueOffset);
+}
+
+/**
+ * Insert an entry into a sparse map
+ *
+ * @param[in]	pstContainer	Sparse map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvEntry			Entry to insert
+ * @param[in]	bReplace		If true, replace any entry already there with the same key
+ *
+ * @return Pointer to the stored value (or NULL if the key was already present and not replaced, or memory ran out)
+ */
+STD_INLINE void * std_container_call_sparse_map_insert(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvEntry, bool bReplace)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvSlot = stdlib_sparse_set_insert(pstContainer, pvEntry, bReplace, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted ? STD_LINEAR_ADD(pvSlot, szValueOffset) : NULL;
+}
+
+// Typed casts for a sparse map's values
+#define STD_SPARSE_MAP_VALUE_PTR_CAST(M,X)		((STD_TYPEOF(M.pstValue[0]) *)(X))
+
+// Find the value stored against a key, e.g. pstValue = std_sparse_map_find(map, 42)
+#define std_sparse_map_find(M,KEY)												\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_sparse_map),				\
+		STD_SPARSE_MAP_VALUE_PTR_CAST(M, std_container_call_sparse_map_find(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), KEY))	\
+	)
+
+#define std_sparse_map_contains(M,KEY)		std_sparse_set_contains(M,KEY)
+
+// Insert a value against a key that isn't already in the map, e.g. std_sparse_map_insert(map, 42, { .x = 1, .y = 2 })
+#define std_sparse_map_insert(M,KEY,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_sparse_map),				\
+		STD_SPARSE_MAP_VALUE_PTR_CAST(M, std_container_call_sparse_map_insert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .szKey = KEY, .stValue = __VA_ARGS__ } }, false))	\
+	)
+
+// Insert a value against a key (replacing the key's existing entry, if there is one)
+#define std_sparse_map_upsert(M,KEY,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_sparse_map),				\
+		STD_SPARSE_MAP_VALUE_PTR_CAST(M, std_container_call_sparse_map_insert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .szKey = KEY, .stValue = __VA_ARGS__ } }, true))	\
+	)
+
+#define std_sparse_map_erase(M,KEY)			std_sparse_set_erase(M,KEY)
+#define std_sparse_map_clear(M)				std_sparse_set_clear(M)
+
+enum
+{
+	std_sparse_map_implements = std_sparse_set_implements
+};
+
+#define STD_SPARSE_MAP_JUMPTABLE							\
+	.pachContainerName = "sparse map",						\
+	STD_SPARSE_SET_SHARED_JUMPTABLE
+
+#endif /* STD_SPARSE_MAP_H_ */
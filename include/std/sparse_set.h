@@ -0,0 +1,231 @@
+/*
+ * std/sparse_set.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SPARSE_SET_H_
+#define STD_SPARSE_SET_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/vector.h"
+
+/*
+ * A sparse set (Briggs & Torczon, "An efficient representation for sparse
+ * sets", 1993) holds a set of small integer keys as a dense vector of items
+ * plus a sparse index array, indexed by key, holding each key's position in
+ * the dense vector. A key is in the set if its index entry points inside
+ * the dense vector at an item holding that same key, so stale entries in the
+ * index never need to be cleaned up:
+ *
+ *	- inserting appends the item to the dense vector, and points the key's
+ *	  index entry at it
+ *	- erasing moves the final item into the erased item's place
+ *	- clearing just empties the dense vector (in O(1), unless the items need
+ *	  to be destructed)
+ *
+ * Pushing an item whose key is already in the set leaves the set unchanged
+ * (and the item with the caller), as with the other sets.
+ *
+ * Iterators, std_at() and std_for_range() see only the live items, densely
+ * packed (in insertion order, until items are erased).
+ *
+ * The index array grows to fit the largest key inserted so far (so keys
+ * should be small integers, e.g. ids). Newly grown parts of it are zeroed
+ * once, so that no uninitialised memory is ever read.
+ *
+ * A sparse set's items are plain size_t keys, while a sparse map's items
+ * are { szKey, stValue } entries (see std/sparse_map.h).
+ */
+
+typedef struct
+{
+	std_container_t stContainer;
+	STD_VECTOR_FIELDS;
+	uint32_t * pu32Sparse;				// Dense index of each key's item (only meaningful if it points back at the key)
+	size_t szNumKeysAlloced;			// Number of entries allocated in the index array
+} std_sparse_set_t;
+
+#define STD_SPARSE_SET_DECLARE(HAS_ENUM,...)	\
+	STD_VECTOR(std_sparse_set_t, std_vector_iterator_t, size_t, std_container_enum_sparse_set, HAS_ENUM, STD_DEFAULT_PARAMETER(std_sparse_set_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+// (Keys need no item handler, so there are no itemhandler variants)
+#define std_sparse_set(...)									STD_SPARSE_SET_DECLARE(std_container_has_no_handlers,__VA_ARGS__)
+#define std_sparse_set_memoryhandler(...)					STD_SPARSE_SET_DECLARE(std_container_has_memoryhandler,__VA_ARGS__)
+#define std_sparse_set_lockhandler(...)						STD_SPARSE_SET_DECLARE(std_container_has_lockhandler,__VA_ARGS__)
+#define std_sparse_set_lockhandler_memoryhandler(...)		STD_SPARSE_SET_DECLARE(std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods (everything else is shared with vectors)
+
+extern void stdlib_sparse_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_sparse_set_destruct(std_container_t * pstContainer);
+extern size_t stdlib_sparse_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+
+extern void * stdlib_sparse_set_find(std_container_t * pstContainer, size_t szKey);
+extern void * stdlib_sparse_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted);
+extern bool stdlib_sparse_set_erase(std_container_t * pstContainer, size_t szKey);
+extern void stdlib_sparse_set_clear(std_container_t * pstContainer);
+
+extern const std_item_handler_t std_sparse_set_default_itemhandler;
+
+// Sparse sets and sparse maps share the same operations
+#define STD_SPARSE_SET_ENUM_CHECK(V)														\
+	STD_STATIC_ASSERT(		(STD_CONTAINER_ENUM_GET(V) == std_container_enum_sparse_set)	\
+						||	(STD_CONTAINER_ENUM_GET(V) == std_container_enum_sparse_map),	\
+						STD_CONCAT(operation_is_not_supported_by_this_type_of_container_,__COUNTER__))
+
+/**
+ * Find the item holding a key in a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szKey			Key to look for
+ *
+ * @return Pointer to the item (or NULL if the key isn't in the set)
+ */
+STD_INLINE void * std_container_call_sparse_set_find(std_container_t * pstContainer, std_container_has_t eHas, size_t szKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_sparse_set_find(pstContainer, szKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Insert an item into a sparse set (unless it already holds the item's key)
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, else false
+ */
+STD_INLINE bool std_container_call_sparse_set_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_sparse_set_insert(pstContainer, pvItem, false, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted;
+}
+
+/**
+ * Erase the item holding a key from a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szKey			Key of the item to erase
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+STD_INLINE bool std_container_call_sparse_set_erase(std_container_t * pstContainer, std_container_has_t eHas, size_t szKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_sparse_set_erase(pstContainer, szKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Erase every item from a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ */
+STD_INLINE void std_container_call_sparse_set_clear(std_container_t * pstContainer, std_container_has_t eHas)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_sparse_set_clear(pstContainer);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+}
+
+#define std_sparse_set_contains(V,KEY)														\
+	(																						\
+		STD_SPARSE_SET_ENUM_CHECK(V),														\
+		(std_container_call_sparse_set_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), KEY) != NULL)	\
+	)
+
+// Insert a key, returning false if it was already in the set (or memory ran out)
+#define std_sparse_set_insert(V,KEY)														\
+	(																						\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_sparse_set),							\
+		std_container_call_sparse_set_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (size_t[]){ KEY })	\
+	)
+
+#define std_sparse_set_erase(V,KEY)															\
+	(																						\
+		STD_SPARSE_SET_ENUM_CHECK(V),														\
+		std_container_call_sparse_set_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), KEY)	\
+	)
+
+#define std_sparse_set_clear(V)																\
+	(																						\
+		STD_SPARSE_SET_ENUM_CHECK(V),														\
+		std_container_call_sparse_set_clear(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V))	\
+	)
+
+enum
+{
+	std_sparse_set_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_at
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_seek
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_ranged_iterator
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_SPARSE_SET_SHARED_JUMPTABLE						\
+	.pfn_construct		= &stdlib_sparse_set_construct,		\
+	.pfn_destruct		= &stdlib_sparse_set_destruct,		\
+	.pfn_reserve		= &stdlib_vector_reserve,			\
+	.pfn_push_back		= &stdlib_sparse_set_push,			\
+	.pfn_pop_back		= &stdlib_vector_pop_back,			\
+	.pfn_at				= &stdlib_vector_at,				\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_forwarditerator_construct,	\
+			.pfn_seek		= &stdlib_vector_forwarditerator_seek,		\
+			.pfn_next		= &stdlib_vector_forwarditerator_next,		\
+		},													\
+		[std_iterator_enum_reverse] =						\
+		{													\
+			.pfn_construct	= &stdlib_vector_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_vector_reverseiterator_next,		\
+		}													\
+	},														\
+	.pstDefaultItemHandler = &std_sparse_set_default_itemhandler
+
+#define STD_SPARSE_SET_JUMPTABLE							\
+	.pachContainerName = "sparse set",						\
+	STD_SPARSE_SET_SHARED_JUMPTABLE
+
+#endif /* STD_SPARSE_SET_H_ */
@@ -0,0 +1,259 @@
+/*
+ * std/splay_tree.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_SPLAY_TREE_H_
+#define STD_SPLAY_TREE_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+/*
+ * A splay tree is an ordered set held as a binary search tree with no
+ * balance condition: instead, every access (finding, inserting or erasing a
+ * key) rotates the node it reaches all the way up to the root. That makes
+ * every operation take amortised O(log n) time, but keys that are accessed
+ * often stay near the root, so on skewed (e.g. Zipfian) access patterns the
+ * average lookup is much shallower than in any balanced tree.
+ *
+ * Because finding a key restructures the tree, std_splay_tree_find() (and
+ * std_splay_tree_contains()) take a splay tree's lock for writing, not just
+ * for reading. Iterating visits items in order without restructuring.
+ *
+ * Like a set, std_pop() pops the last-ranked (e.g. largest) items, and
+ * std_pop_front() the first-ranked (e.g. smallest) items.
+ */
+
+#define STD_SPLAY_TREE_NODE(TYPE,NAME)	\
+	struct NAME							\
+	{									\
+		std_splay_tree_node_t stLink;	\
+		TYPE stPayload;					\
+	}
+
+// The STD_SPLAY_TREE macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (for ordering the tree)
+//	- an iterator smuggle, used to give easy access to associated iterators
+#define STD_SPLAY_TREE(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, NODENAME, TYPEWRAPPER)		\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		STD_SPLAY_TREE_NODE(STD_TYPE_GET(TYPEWRAPPER),NODENAME) * pstLink;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(STD_TYPE_GET(TYPEWRAPPER) const, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);			\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct NODENAME, stPayload));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(struct NODENAME));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
+	}
+
+typedef struct std_splay_tree_node_s std_splay_tree_node_t;
+
+struct std_splay_tree_node_s
+{
+	std_splay_tree_node_t * pstLeft;
+	std_splay_tree_node_t * pstRight;
+	std_splay_tree_node_t * pstParent;
+};
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szPayloadOffset;
+	pfn_std_compare_t pfnCompare;
+	std_splay_tree_node_t * pstRoot;
+	std_node_pool_t stPool;		// Where the nodes are allocated from
+} std_splay_tree_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	std_splay_tree_node_t * pstNode;
+	size_t szRemaining;			// Number of items left to step through after the current one
+} std_splay_tree_iterator_t;
+
+#define STD_SPLAY_TREE_DECLARE(T,HAS_ENUM,...)	\
+	STD_SPLAY_TREE(std_splay_tree_t, std_splay_tree_iterator_t, T, std_container_enum_splay_tree, HAS_ENUM, STD_DEFAULT_PARAMETER(std_splay_tree_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_splay_tree(T,...)											STD_SPLAY_TREE_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_splay_tree_itemhandler(T,...)								STD_SPLAY_TREE_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_splay_tree_memoryhandler(T,...)								STD_SPLAY_TREE_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_splay_tree_memoryhandler_itemhandler(T,...)					STD_SPLAY_TREE_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_splay_tree_lockhandler(T,...)								STD_SPLAY_TREE_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_splay_tree_lockhandler_itemhandler(T,...)					STD_SPLAY_TREE_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_splay_tree_lockhandler_memoryhandler(T,...)					STD_SPLAY_TREE_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_splay_tree_lockhandler_memoryhandler_itemhandler(T,...)		STD_SPLAY_TREE_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_splay_tree_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_splay_tree_destruct(std_container_t * pstContainer);
+extern bool stdlib_splay_tree_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_splay_tree_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_splay_tree_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_splay_tree_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern void stdlib_splay_tree_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare);
+extern void * stdlib_splay_tree_find(std_container_t * pstContainer, const void * pvKey);
+extern void * stdlib_splay_tree_insert(std_container_t * pstContainer, const void * pvItem, bool * pbInserted);
+extern bool stdlib_splay_tree_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult);
+
+extern void stdlib_splay_tree_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_splay_tree_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_splay_tree_forwarditerator_next(std_iterator_t * pstIterator);
+extern void stdlib_splay_tree_reverseiterator_next(std_iterator_t * pstIterator);
+
+extern const std_item_handler_t std_splay_tree_default_itemhandler;
+
+// Set the comparison function that a splay tree orders its items by (before pushing any items)
+#define std_splay_tree_compare_set(SPLAYTREE,COMPARE)						\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(SPLAYTREE, std_container_enum_splay_tree),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(COMPARE, SPLAYTREE.pfnCompare), STD_CONCAT(Incompatible_comparison_functions_,__COUNTER__)), \
+		stdlib_splay_tree_compare_set(&SPLAYTREE.stBody.stContainer,(pfn_std_compare_t)(COMPARE))	\
+	)
+
+/**
+ * Find an item matching a key in a splay tree (and splay it to the root)
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key to look for
+ *
+ * @return Pointer to a matching item (or NULL if there isn't one)
+ */
+STD_INLINE void * std_container_call_splay_tree_find(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvItem = stdlib_splay_tree_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Insert an item into a splay tree (unless it already holds an item with the same key)
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, else false
+ */
+STD_INLINE bool std_container_call_splay_tree_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	bool bInserted;
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	stdlib_splay_tree_insert(pstContainer, pvItem, &bInserted);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bInserted;
+}
+
+/**
+ * Erase the item matching a key from a splay tree
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Key of the item to erase
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+STD_INLINE bool std_container_call_splay_tree_erase(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_splay_tree_erase(pstContainer, pvKey, NULL);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Find an item (splaying it to the root), e.g. pstSymbol = std_splay_tree_find(tree, { .pachName = "main" })
+#define std_splay_tree_find(V,...)											\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_splay_tree),			\
+		STD_ITEM_PTR_CAST(V, std_container_call_splay_tree_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_splay_tree_contains(V,...)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_splay_tree),			\
+		(std_container_call_splay_tree_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+#define std_splay_tree_insert(V,...)										\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_splay_tree),			\
+		std_container_call_splay_tree_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_splay_tree_erase(V,...)											\
+	(																		\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_splay_tree),			\
+		std_container_call_splay_tree_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+enum
+{
+	std_splay_tree_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_pop_front
+		| std_container_implements_forward_constructnext
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_SPLAY_TREE_JUMPTABLE \
+	.pachContainerName = "splay tree",					\
+	.pfn_construct		= &stdlib_splay_tree_construct,	\
+	.pfn_destruct		= &stdlib_splay_tree_destruct,	\
+	.pfn_reserve		= &stdlib_splay_tree_reserve,	\
+	.pfn_push_back		= &stdlib_splay_tree_push,		\
+	.pfn_pop_front		= &stdlib_splay_tree_pop_front,	\
+	.pfn_pop_back		= &stdlib_splay_tree_pop_back,	\
+	.astIterators =										\
+	{													\
+		[std_iterator_enum_forward] =					\
+		{												\
+			.pfn_construct	= &stdlib_splay_tree_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_splay_tree_forwarditerator_next,		\
+		},												\
+		[std_iterator_enum_reverse] =					\
+		{												\
+			.pfn_construct	= &stdlib_splay_tree_reverseiterator_construct,	\
+			.pfn_next		= &stdlib_splay_tree_reverseiterator_next,		\
+		},												\
+	},													\
+	.pstDefaultItemHandler = &std_splay_tree_default_itemhandler
+
+#endif /* STD_SPLAY_TREE_H_ */
@@ -38,4 +38,18 @@ static inline int __builtin_clzl(unsigned long x)
 {
     return sizeof(x) == 8 ? __builtin_clzll(x) : __builtin_clz((unsigned)x);
 }
+
+static inline int __builtin_popcount(unsigned x)
+{
+    return (int)__popcnt(x);
+}
+
+static inline int __builtin_popcountll(unsigned long long x)
+{
+#ifdef _WIN64
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcount((unsigned)x) + __builtin_popcount((unsigned)(x >> 32));
+#endif
+}
 #endif
\ No newline at end of file
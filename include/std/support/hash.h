@@ -0,0 +1,62 @@
+#ifndef STD_SUPPORT_HASH_H_
+#define STD_SUPPORT_HASH_H_
+
+/*
+ * Hashing shared by the hashed containers (unordered set/map and cache)
+ */
+
+#include <stddef.h>		// for size_t
+#include <stdint.h>		// for uint64_t
+#include <string.h>		// for memcpy
+
+#include "std/config.h"
+
+/**
+ * Scramble a hash value, so that poor hash functions (e.g. the identity) still spread out well
+ *
+ * @param[in]	u64Hash		Hash value
+ *
+ * @return Scrambled hash value
+ */
+STD_INLINE uint64_t std_hash_mix(uint64_t u64Hash)
+{
+	u64Hash ^= u64Hash >> 32;
+	u64Hash *= 0xD6E8FEB86659FD93ULL;
+	u64Hash ^= u64Hash >> 32;
+	u64Hash *= 0xD6E8FEB86659FD93ULL;
+	u64Hash ^= u64Hash >> 32;
+	return u64Hash;
+}
+
+/**
+ * Hash a key's bytes (used when no hash function has been set)
+ *
+ * @param[in]	pvKey		Key
+ * @param[in]	szSize		Size of the key
+ *
+ * @return Hash value
+ */
+STD_INLINE uint64_t std_hash_bytes(const void * pvKey, size_t szSize)
+{
+	const uint8_t * pu8Key = (const uint8_t *) pvKey;
+	uint64_t u64Hash = 0x9E3779B97F4A7C15ULL ^ (uint64_t) szSize;
+	uint64_t u64Chunk;
+
+	while (szSize >= sizeof(u64Chunk))
+	{
+		memcpy(&u64Chunk, pu8Key, sizeof(u64Chunk));
+		u64Hash = (u64Hash ^ u64Chunk) * 0x9E3779B97F4A7C15ULL;
+		u64Hash ^= u64Hash >> 29;
+		pu8Key += sizeof(u64Chunk);
+		szSize -= sizeof(u64Chunk);
+	}
+	if (szSize > 0)
+	{
+		u64Chunk = 0;
+		memcpy(&u64Chunk, pu8Key, szSize);
+		u64Hash = (u64Hash ^ u64Chunk) * 0x9E3779B97F4A7C15ULL;
+	}
+	return u64Hash;
+}
+
+#endif /* STD_SUPPORT_HASH_H_ */
@@ -0,0 +1,235 @@
+/*
+ * std/unordered_map.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_UNORDERED_MAP_H_
+#define STD_UNORDERED_MAP_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/unordered_set.h"
+
+/*
+ * An unordered map is an unordered set of { stKey, stValue } entries, hashed
+ * and compared on their keys alone. Entries live directly in the hash
+ * table's slots (no per-entry allocations, and so no pointer chasing), with
+ * seven bits of each key's hash kept in the table's control bytes so that
+ * lookups hardly ever need to compare keys that don't match.
+ *
+ * The container's items are its entries, so iterating (e.g. with std_each)
+ * visits entries in no particular order, and an item handler handles a
+ * whole entry (key and value together).
+ *
+ * As with unordered sets, keys are hashed and compared byte by byte unless
+ * hash / equality functions are set (which are passed pointers to keys).
+ */
+
+#define STD_UNORDERED_MAP_ENTRY(KEYTYPE,VALUETYPE,NAME)	\
+	struct NAME								\
+	{										\
+		KEYTYPE stKey;						\
+		VALUETYPE stValue;					\
+	}
+
+// The STD_UNORDERED_MAP macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- type smuggles, used to give easy access to (entry *), (key *) and (value *) casts
+//	- typed hash and equality functions (on keys)
+//	- an iterator smuggle, used to give easy access to associated iterators
+// Note: entries aren't wrapped, so the wrapped item size passes the key's size down instead
+#define STD_UNORDERED_MAP(BASE, ITBASE, KEYTYPE, VALUETYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, ENTRYNAME, KEYWRAPPER, VALUEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(KEYWRAPPER,KEYTYPE) * pstKeyWrapper;			\
+		STD_TYPE_SET(VALUEWRAPPER,VALUETYPE) * pstValueWrapper;		\
+		STD_UNORDERED_MAP_ENTRY(STD_TYPE_GET(KEYWRAPPER),STD_TYPE_GET(VALUEWRAPPER),ENTRYNAME) * pstEntry;	\
+		\
+		BASE 	   			 stBody;					\
+		struct ENTRYNAME		*	pstType;			\
+		STD_TYPE_GET(KEYWRAPPER)	*	pstKey;			\
+		STD_TYPE_GET(VALUEWRAPPER)	*	pstValue;		\
+		STD_HASH(const STD_TYPE_GET(KEYWRAPPER), pfnHash);		\
+		STD_EQUAL(const STD_TYPE_GET(KEYWRAPPER), pfnEqual);	\
+		\
+		STD_ITERATORS(ITBASE, struct ENTRYNAME, UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(offsetof(struct ENTRYNAME, stValue));	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(KEYWRAPPER)));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+// Client-side declaration code
+
+#define STD_UNORDERED_MAP_DECLARE(K,V,HAS_ENUM,...)	\
+	STD_UNORDERED_MAP(std_unorderedset_t, std_unorderedset_iterator_t, K, V, std_container_enum_unorderedmap, HAS_ENUM, STD_DEFAULT_PARAMETER(std_unorderedmap_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT(), STD_FAKESTRUCT(), STD_FAKESTRUCT())
+
+#define std_unorderedmap(K,V,...)											STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_no_handlers,__VA_ARGS__)
+#define std_unorderedmap_itemhandler(K,V,...)								STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_itemhandler,__VA_ARGS__)
+#define std_unorderedmap_memoryhandler(K,V,...)								STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_unorderedmap_memoryhandler_itemhandler(K,V,...)					STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_unorderedmap_lockhandler(K,V,...)								STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_lockhandler,__VA_ARGS__)
+#define std_unorderedmap_lockhandler_itemhandler(K,V,...)					STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_unorderedmap_lockhandler_memoryhandler(K,V,...)					STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_unorderedmap_lockhandler_memoryhandler_itemhandler(K,V,...)		STD_UNORDERED_MAP_DECLARE(K,V,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods (everything else is shared with unordered sets)
+
+extern void stdlib_unorderedmap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas);
+extern void * stdlib_unorderedmap_insert(std_container_t * pstContainer, const void * pvEntry);
+extern void * stdlib_unorderedmap_upsert(std_container_t * pstContainer, const void * pvEntry);
+extern void * stdlib_unorderedmap_insert_hashed(std_container_t * pstContainer, const void * pvEntry, uint64_t u64Hash, bool bReplace);
+
+// Set the hash and equality functions that an unordered map uses on its keys (before inserting any entries)
+#define std_unorderedmap_hash_set(UNORDEREDMAP,HASH,EQUAL)						\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(UNORDEREDMAP, std_container_enum_unorderedmap),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(HASH, UNORDEREDMAP.pfnHash), STD_CONCAT(Incompatible_hash_functions_,__COUNTER__)), \
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(EQUAL, UNORDEREDMAP.pfnEqual), STD_CONCAT(Incompatible_equality_functions_,__COUNTER__)), \
+		stdlib_unorderedset_hash_set(&UNORDEREDMAP.stBody.stContainer,(pfn_std_hash_t)(HASH),(pfn_std_equal_t)(EQUAL))	\
+	)
+
+/**
+ * Find the value stored against a key in an unordered map
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvKey			Key to look for
+ *
+ * @return Pointer to the value (or NULL if the key isn't in the map)
+ */
+STD_INLINE void * std_container_call_unorderedmap_find(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvEntry = stdlib_unorderedset_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvEntry == NULL) ? NULL : STD_LINEAR_ADD(pvEntry, szValueOffset);
+}
+
+/**
+ * Insert an entry into an unordered map (if its key isn't already in the map)
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvEntry			Entry to insert
+ *
+ * @return Pointer to the inserted value (or NULL if the key was already present, or memory ran out)
+ */
+STD_INLINE void * std_container_call_unorderedmap_insert(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvEntry)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvSlot = stdlib_unorderedmap_insert(pstContainer, pvEntry);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvSlot == NULL) ? NULL : STD_LINEAR_ADD(pvSlot, szValueOffset);
+}
+
+/**
+ * Insert an entry into an unordered map, replacing any entry already there with the same key
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pvEntry			Entry to insert
+ *
+ * @return Pointer to the stored value (or NULL if memory ran out)
+ */
+STD_INLINE void * std_container_call_unorderedmap_upsert(std_container_t * pstContainer, std_container_has_t eHas, size_t szValueOffset, const void * pvEntry)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	void * pvSlot = stdlib_unorderedmap_upsert(pstContainer, pvEntry);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return (pvSlot == NULL) ? NULL : STD_LINEAR_ADD(pvSlot, szValueOffset);
+}
+
+// Typed casts for an unordered map's keys and values
+#define STD_UNORDERED_MAP_KEY_TYPEOF(M)			STD_TYPEOF(M.pstKey[0])
+#define STD_UNORDERED_MAP_VALUE_PTR_CAST(M,X)	((STD_TYPEOF(M.pstValue[0]) *)(X))
+
+// Find the value stored against a key, e.g. pstValue = std_unorderedmap_find(map, 42)
+#define std_unorderedmap_find(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_unorderedmap),			\
+		STD_UNORDERED_MAP_VALUE_PTR_CAST(M, std_container_call_unorderedmap_find(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_unorderedmap_contains(M,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_unorderedmap),			\
+		(std_container_call_unorderedmap_find(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), 0U, (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+// Insert a value against a key that isn't already in the map, e.g. std_unorderedmap_insert(map, 42, { .x = 1, .y = 2 })
+#define std_unorderedmap_insert(M,KEY,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_unorderedmap),			\
+		STD_UNORDERED_MAP_VALUE_PTR_CAST(M, std_container_call_unorderedmap_insert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }))	\
+	)
+
+// Insert a value against a key (replacing the key's existing entry, if there is one)
+#define std_unorderedmap_upsert(M,KEY,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_unorderedmap),			\
+		STD_UNORDERED_MAP_VALUE_PTR_CAST(M, std_container_call_unorderedmap_upsert(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), STD_CONTAINER_PAYLOAD_OFFSET_GET(M), (STD_ITEM_TYPEOF(M)[]){ { .stKey = KEY, .stValue = __VA_ARGS__ } }))	\
+	)
+
+#define std_unorderedmap_erase(M,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(M, std_container_enum_unorderedmap),			\
+		std_container_call_unorderedset_erase(&M.stBody.stContainer, STD_CONTAINER_HAS_GET(M), (STD_UNORDERED_MAP_KEY_TYPEOF(M)[]){ __VA_ARGS__ })	\
+	)
+
+enum
+{
+	std_unorderedmap_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_forward_constructnext
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_UNORDERED_MAP_JUMPTABLE \
+	.pachContainerName = "unordered map",					\
+	.pfn_construct		= &stdlib_unorderedmap_construct,	\
+	.pfn_destruct		= &stdlib_unorderedset_destruct,	\
+	.pfn_reserve		= &stdlib_unorderedset_reserve,		\
+	.pfn_push_back		= &stdlib_unorderedset_push,		\
+	.pfn_pop_back		= &stdlib_unorderedset_pop,			\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_unorderedset_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_unorderedset_forwarditerator_next,		\
+		},													\
+	},														\
+	.pstDefaultItemHandler = &std_unorderedset_default_itemhandler
+
+#endif /* STD_UNORDERED_MAP_H_ */
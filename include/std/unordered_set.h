@@ -0,0 +1,244 @@
+/*
+ * std/unordered_set.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_UNORDERED_SET_H_
+#define STD_UNORDERED_SET_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+
+/*
+ * An unordered set is an open-addressed hash table in the style of Google's
+ * SwissTable: alongside the array of item slots is an array of one-byte
+ * control words, each holding either EMPTY, DELETED or seven bits of the
+ * hash of the item in that slot. Lookups probe a whole group of control
+ * bytes at a time (16 with SSE2, else 8 using plain 64-bit arithmetic), so
+ * only the slots whose seven hash bits match ever get compared.
+ *
+ * Erasing an item from a group that has never filled up leaves no
+ * tombstone behind (no lookup can ever have probed past that group).
+ *
+ * If no hash / equality functions are set, items are hashed and compared
+ * byte by byte (so structs containing padding or pointers need their own).
+ *
+ * Items are in no particular order, and pushing an item that is already in
+ * the set leaves the set unchanged (and the item with the caller).
+ */
+
+// The STD_UNORDERED_SET macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- typed hash and equality functions
+//	- an iterator smuggle, used to give easy access to associated iterators
+#define STD_UNORDERED_SET(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, TYPEWRAPPER)	\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_HASH(const STD_TYPE_GET(TYPEWRAPPER), pfnHash);			\
+		STD_EQUAL(const STD_TYPE_GET(TYPEWRAPPER), pfnEqual);		\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);					\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);				\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(0);			\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(TYPEWRAPPER)));		\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS);		\
+	}
+
+typedef struct
+{
+	std_container_t stContainer;
+	pfn_std_hash_t pfnHash;		// Hash function (or NULL to hash the key's bytes)
+	pfn_std_equal_t pfnEqual;	// Equality function (or NULL to compare the key's bytes)
+	size_t szKeySizeof;			// Size of the key at the start of each item
+	size_t szCapacity;			// Number of slots (zero, or a power of two)
+	size_t szGrowthLeft;		// Number of EMPTY slots that can be filled before rehashing
+	uint8_t * pu8Control;		// One control byte per slot
+	void * pvSlots;				// The slots themselves
+} std_unorderedset_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	size_t szSlot;
+} std_unorderedset_iterator_t;
+
+// Client-side declaration code
+
+#define STD_UNORDERED_SET_DECLARE(T,HAS_ENUM,...)	\
+	STD_UNORDERED_SET(std_unorderedset_t, std_unorderedset_iterator_t, T, std_container_enum_unorderedset, HAS_ENUM, STD_DEFAULT_PARAMETER(std_unorderedset_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_unorderedset(T,...)											STD_UNORDERED_SET_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_unorderedset_itemhandler(T,...)								STD_UNORDERED_SET_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_unorderedset_memoryhandler(T,...)							STD_UNORDERED_SET_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_unorderedset_memoryhandler_itemhandler(T,...)				STD_UNORDERED_SET_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_unorderedset_lockhandler(T,...)								STD_UNORDERED_SET_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_unorderedset_lockhandler_itemhandler(T,...)					STD_UNORDERED_SET_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_unorderedset_lockhandler_memoryhandler(T,...)				STD_UNORDERED_SET_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_unorderedset_lockhandler_memoryhandler_itemhandler(T,...)	STD_UNORDERED_SET_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+// Library-side (untyped) methods
+
+extern void stdlib_unorderedset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_unorderedset_destruct(std_container_t * pstContainer);
+extern bool stdlib_unorderedset_reserve(std_container_t * pstContainer, size_t szNewSize);
+extern size_t stdlib_unorderedset_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_unorderedset_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern void stdlib_unorderedset_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual);
+extern uint64_t stdlib_unorderedset_hash(const std_container_t * pstContainer, const void * pvKey);
+extern void * stdlib_unorderedset_find(std_container_t * pstContainer, const void * pvKey);
+extern void * stdlib_unorderedset_find_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash);
+extern void * stdlib_unorderedset_insert_slot(std_container_t * pstContainer, const void * pvKey, bool * pbInserted);
+extern void * stdlib_unorderedset_insert_slot_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash, bool * pbInserted);
+extern bool stdlib_unorderedset_insert(std_container_t * pstContainer, const void * pvItem);
+extern bool stdlib_unorderedset_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult);
+extern bool stdlib_unorderedset_erase_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash, void * pvResult);
+
+extern void stdlib_unorderedset_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_unorderedset_forwarditerator_next(std_iterator_t * pstIterator);
+
+extern const std_item_handler_t std_unorderedset_default_itemhandler;
+
+// Set the hash and equality functions that an unordered set uses (before pushing any items)
+#define std_unorderedset_hash_set(UNORDEREDSET,HASH,EQUAL)						\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(UNORDEREDSET, std_container_enum_unorderedset),	\
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(HASH, UNORDEREDSET.pfnHash), STD_CONCAT(Incompatible_hash_functions_,__COUNTER__)), \
+		STD_STATIC_ASSERT(STD_TYPES_ARE_SAME(EQUAL, UNORDEREDSET.pfnEqual), STD_CONCAT(Incompatible_equality_functions_,__COUNTER__)), \
+		stdlib_unorderedset_hash_set(&UNORDEREDSET.stBody.stContainer,(pfn_std_hash_t)(HASH),(pfn_std_equal_t)(EQUAL))	\
+	)
+
+/**
+ * Find an item in an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Item to look for
+ *
+ * @return Pointer to the matching item in the set (or NULL if there isn't one)
+ */
+STD_INLINE void * std_container_call_unorderedset_find(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_reading(pstContainer, eHas);
+	void * pvItem = stdlib_unorderedset_find(pstContainer, pvKey);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return pvItem;
+}
+
+/**
+ * Insert an item into an unordered set (if it isn't already in it)
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, false if it was already present (or memory ran out)
+ */
+STD_INLINE bool std_container_call_unorderedset_insert(std_container_t * pstContainer, std_container_has_t eHas, const void * pvItem)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_unorderedset_insert(pstContainer, pvItem);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+/**
+ * Erase an item from an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	eHas			Bitmask of flags denoting which handlers this container has
+ * @param[in]	pvKey			Item to erase
+ *
+ * @return True if the item was erased, false if it wasn't in the set
+ */
+STD_INLINE bool std_container_call_unorderedset_erase(std_container_t * pstContainer, std_container_has_t eHas, const void * pvKey)
+{
+	std_lock_state_t eOldState = std_container_lock_for_writing(pstContainer, eHas);
+	bool bResult = stdlib_unorderedset_erase(pstContainer, pvKey, NULL);
+	std_container_lock_restore(pstContainer, eHas, eOldState);
+	return bResult;
+}
+
+// Find one item, e.g. pstPoint = std_unorderedset_find(set, { .x = 1, .y = 2 })
+#define std_unorderedset_find(V,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_unorderedset),			\
+		STD_ITEM_PTR_CAST(V, std_container_call_unorderedset_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }))	\
+	)
+
+#define std_unorderedset_contains(V,...)										\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_unorderedset),			\
+		(std_container_call_unorderedset_find(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ }) != NULL)	\
+	)
+
+#define std_unorderedset_insert(V,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_unorderedset),			\
+		std_container_call_unorderedset_insert(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+#define std_unorderedset_erase(V,...)											\
+	(																			\
+		STD_CONTAINER_ENUM_CHECK(V, std_container_enum_unorderedset),			\
+		std_container_call_unorderedset_erase(&V.stBody.stContainer, STD_CONTAINER_HAS_GET(V), (STD_ITEM_TYPEOF(V)[]){ __VA_ARGS__ })	\
+	)
+
+enum
+{
+	std_unorderedset_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_reserve
+		| std_container_implements_push_pop
+		| std_container_implements_forward_constructnext
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_UNORDERED_SET_JUMPTABLE \
+	.pachContainerName = "unordered set",					\
+	.pfn_construct		= &stdlib_unorderedset_construct,	\
+	.pfn_destruct		= &stdlib_unorderedset_destruct,	\
+	.pfn_reserve		= &stdlib_unorderedset_reserve,		\
+	.pfn_push_back		= &stdlib_unorderedset_push,		\
+	.pfn_pop_back		= &stdlib_unorderedset_pop,			\
+	.astIterators =											\
+	{														\
+		[std_iterator_enum_forward] =						\
+		{													\
+			.pfn_construct	= &stdlib_unorderedset_forwarditerator_construct,	\
+			.pfn_next		= &stdlib_unorderedset_forwarditerator_next,		\
+		},													\
+	},														\
+	.pstDefaultItemHandler = &std_unorderedset_default_itemhandler
+
+#endif /* STD_UNORDERED_SET_H_ */
@@ -0,0 +1,274 @@
+/*
+ * std/unrolled_list.h
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef STD_UNROLLED_LIST_H_
+#define STD_UNROLLED_LIST_H_
+
+#include "std/common.h"
+#include "std/item.h"
+#include "std/linear_series.h"
+#include "std/iterator.h"
+#include "std/node_pool.h"
+
+/*
+ * An unrolled list is a doubly-linked list whose nodes each hold a small
+ * array of items rather than a single item. Iterating through it mostly
+ * steps linearly through memory (like a vector), and the link overhead is
+ * shared between all the items in a node.
+ *
+ * The items in each node occupy a contiguous run of slots [szStart, szEnd),
+ * so pushing onto either end of the list only touches the end node. Inserting
+ * into (or erasing from) the middle of a node shuffles at most half a node's
+ * worth of items, splitting a full node in two (or folding a sparse node into
+ * its successor) as needed.
+ */
+
+// Target size (in bytes) of each node, and the smallest number of items held per node
+#ifndef STD_UNROLLED_LIST_NODE_SIZE
+#define STD_UNROLLED_LIST_NODE_SIZE				256U
+#endif
+#ifndef STD_UNROLLED_LIST_MIN_ITEMS_PER_NODE
+#define STD_UNROLLED_LIST_MIN_ITEMS_PER_NODE	4U
+#endif
+
+// The STD_UNROLLED_LIST macro creates a union of many separate things
+//	- an untyped base class, that gets passed down to library-side shared calls
+//	- a type smuggle, used to give easy access to an inner (TYPE *) cast
+//	- a typed comparison function (for sorting)
+//	- an iterator smuggle, used to give easy access to an associated iterator
+#define STD_UNROLLED_LIST(BASE, ITBASE, TYPE, ENUM, HAS_ENUM, IMPLEMENTS, UNIONNAME, TYPEWRAPPER)		\
+	union UNIONNAME										\
+	{													\
+		STD_TYPE_SET(TYPEWRAPPER,TYPE) * pstWrapper;	\
+		\
+		BASE 	   			 stBody;					\
+		STD_TYPE_GET(TYPEWRAPPER)	*	pstType;		\
+		STD_COMPARE(STD_TYPE_GET(TYPEWRAPPER) const, pfnCompare);	\
+		\
+		STD_ITERATORS(ITBASE, STD_TYPE_GET(TYPEWRAPPER), UNIONNAME);	\
+		\
+		STD_CONTAINER_ENUM_SET(ENUM);			\
+		STD_CONTAINER_HAS_SET(HAS_ENUM);		\
+		STD_CONTAINER_PAYLOAD_OFFSET_SET(0);	\
+		STD_CONTAINER_WRAPPEDITEM_SIZEOF_SET(sizeof(STD_TYPE_GET(TYPEWRAPPER)));	\
+		STD_CONTAINER_IMPLEMENTS_SET(IMPLEMENTS); \
+	}
+
+typedef struct std_unrolled_list_node_s std_unrolled_list_node_t;
+
+// Header at the start of every node (the node's array of item slots follows it)
+struct std_unrolled_list_node_s
+{
+	std_unrolled_list_node_t * pstPrev;
+	std_unrolled_list_node_t * pstNext;
+	size_t szStart;		// Index of the first occupied slot
+	size_t szEnd;		// Index after the last occupied slot
+};
+
+typedef struct
+{
+	std_container_t stContainer;
+	size_t szItemsPerNode;				// Number of item slots in each node
+	size_t szItemsOffset;				// Offset of the first item slot within each node
+	std_unrolled_list_node_t * pstHead;
+	std_unrolled_list_node_t * pstTail;
+	std_node_pool_t stPool;				// Where the nodes are allocated from
+} std_unrolled_list_t;
+
+typedef	struct
+{
+	std_iterator_t stIterator;
+	std_unrolled_list_node_t * pstNode;	// Node holding the current item
+	size_t szSlot;						// Slot holding the current item
+	bool bStay;							// Set when an erase has already moved the iterator on to the next item
+} std_unrolled_list_iterator_t;
+
+#define STD_UNROLLED_LIST_DECLARE(T,HAS_ENUM,...)	\
+	STD_UNROLLED_LIST(std_unrolled_list_t, std_unrolled_list_iterator_t, T, std_container_enum_unrolled_list, HAS_ENUM, STD_DEFAULT_PARAMETER(std_unrolled_list_implements,__VA_ARGS__), STD_FAKEUNION(), STD_FAKESTRUCT())
+
+#define std_unrolled_list(T,...)											STD_UNROLLED_LIST_DECLARE(T,std_container_has_no_handlers,__VA_ARGS__)
+#define std_unrolled_list_itemhandler(T,...)								STD_UNROLLED_LIST_DECLARE(T,std_container_has_itemhandler,__VA_ARGS__)
+#define std_unrolled_list_memoryhandler(T,...)								STD_UNROLLED_LIST_DECLARE(T,std_container_has_memoryhandler,__VA_ARGS__)
+#define std_unrolled_list_memoryhandler_itemhandler(T,...)					STD_UNROLLED_LIST_DECLARE(T,std_container_has_memoryhandler_itemhandler,__VA_ARGS__)
+#define std_unrolled_list_lockhandler(T,...)								STD_UNROLLED_LIST_DECLARE(T,std_container_has_lockhandler,__VA_ARGS__)
+#define std_unrolled_list_lockhandler_itemhandler(T,...)					STD_UNROLLED_LIST_DECLARE(T,std_container_has_lockhandler_itemhandler,__VA_ARGS__)
+#define std_unrolled_list_lockhandler_memoryhandler(T,...)					STD_UNROLLED_LIST_DECLARE(T,std_container_has_lockhandler_memoryhandler,__VA_ARGS__)
+#define std_unrolled_list_lockhandler_memoryhandler_itemhandler(T,...)		STD_UNROLLED_LIST_DECLARE(T,std_container_has_lockhandler_memoryhandler_itemhandler,__VA_ARGS__)
+
+extern void stdlib_unrolled_list_construct(std_container_t* pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas);
+extern bool stdlib_unrolled_list_destruct(std_container_t* pstContainer);
+
+extern size_t stdlib_unrolled_list_push_front(	std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_unrolled_list_push_back(	std_container_t * pstContainer, const std_linear_series_t * pstSeries);
+extern size_t stdlib_unrolled_list_pop_front(	std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+extern size_t stdlib_unrolled_list_pop_back(	std_container_t * pstContainer, void * pvResult, size_t szMaxItems);
+
+extern void stdlib_unrolled_list_forwarditerator_construct(std_container_t* pstContainer, std_iterator_t* pstIterator, size_t szFirst, size_t szLast);
+extern void stdlib_unrolled_list_reverseiterator_construct(std_container_t* pstContainer, std_iterator_t* pstIterator, size_t szFirst, size_t szLast);
+extern size_t stdlib_unrolled_list_push_after(std_iterator_t* pstIterator, const std_linear_series_t* pstSeries);
+extern size_t stdlib_unrolled_list_push_before(std_iterator_t* pstIterator, const std_linear_series_t* pstSeries);
+extern void stdlib_unrolled_list_forward_pop_at(std_iterator_t* pstIterator, void * pvResult);
+extern void stdlib_unrolled_list_reverse_pop_at(std_iterator_t* pstIterator, void * pvResult);
+
+extern const std_item_handler_t std_unrolled_list_default_itemhandler;
+
+// Cast a generic container to an unrolled list, and a generic iterator to an unrolled list iterator
+#define CONTAINER_TO_UNROLLED_LIST(CONTAINER)	STD_CONTAINER_OF(CONTAINER, std_unrolled_list_t, stContainer)
+#define ITERATOR_TO_UNROLLED_LISTIT(IT)			STD_CONTAINER_OF(IT, std_unrolled_list_iterator_t, stIterator)
+
+/**
+ * Step an unrolled list iterator forwards through an unrolled list container
+ *
+ * @param[in]	pstIterator	Unrolled list iterator
+ */
+STD_INLINE void stdlib_unrolled_list_forwarditerator_next(std_iterator_t* pstIterator)
+{
+	std_unrolled_list_iterator_t* pstListIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_unrolled_list_node_t* pstNode = pstListIt->pstNode;
+
+	if (pstListIt->bStay)
+	{
+		pstListIt->bStay = false;
+	}
+	else if (pstListIt->szSlot + 1U < pstNode->szEnd)
+	{
+		// Fast path: step linearly through the node's slots
+		pstListIt->szSlot++;
+		pstIterator->pvRef = STD_LINEAR_ADD(pstIterator->pvRef, pstIterator->szSizeofItem);
+		return;
+	}
+	else
+	{
+		pstNode = pstNode->pstNext;
+		pstListIt->pstNode = pstNode;
+		if (pstNode != NULL)
+		{
+			pstListIt->szSlot = pstNode->szStart;
+		}
+	}
+
+	if (pstListIt->pstNode == NULL)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstIterator->pvRef = STD_LINEAR_ADD(pstListIt->pstNode,
+									CONTAINER_TO_UNROLLED_LIST(pstIterator->pstContainer)->szItemsOffset
+								+	(pstListIt->szSlot * pstIterator->szSizeofItem)	);
+	}
+}
+
+/**
+ * Step an unrolled list iterator backwards through an unrolled list container
+ *
+ * @param[in]	pstIterator	Unrolled list iterator
+ */
+STD_INLINE void stdlib_unrolled_list_reverseiterator_next(std_iterator_t* pstIterator)
+{
+	std_unrolled_list_iterator_t* pstListIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_unrolled_list_node_t* pstNode = pstListIt->pstNode;
+
+	if (pstListIt->bStay)
+	{
+		pstListIt->bStay = false;
+	}
+	else if (pstListIt->szSlot > pstNode->szStart)
+	{
+		// Fast path: step linearly through the node's slots
+		pstListIt->szSlot--;
+		pstIterator->pvRef = STD_LINEAR_SUB(pstIterator->pvRef, pstIterator->szSizeofItem);
+		return;
+	}
+	else
+	{
+		pstNode = pstNode->pstPrev;
+		pstListIt->pstNode = pstNode;
+		if (pstNode != NULL)
+		{
+			pstListIt->szSlot = pstNode->szEnd - 1U;
+		}
+	}
+
+	if (pstListIt->pstNode == NULL)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstIterator->pvRef = STD_LINEAR_ADD(pstListIt->pstNode,
+									CONTAINER_TO_UNROLLED_LIST(pstIterator->pstContainer)->szItemsOffset
+								+	(pstListIt->szSlot * pstIterator->szSizeofItem)	);
+	}
+}
+
+enum
+{
+	std_unrolled_list_implements =
+		( std_container_implements_name
+		| std_container_implements_construct
+		| std_container_implements_destruct
+		| std_container_implements_pushpop_front
+		| std_container_implements_pushpop_back
+		| std_container_implements_forward_constructnext
+		| std_container_implements_forward_push_after
+		| std_container_implements_forward_push_before
+		| std_container_implements_forward_pop_at
+		| std_container_implements_reverse_constructnext
+		| std_container_implements_reverse_push_after
+		| std_container_implements_reverse_push_before
+		| std_container_implements_reverse_pop_at
+		| std_container_implements_default_itemhandler)
+};
+
+#define STD_UNROLLED_LIST_JUMPTABLE \
+	.pachContainerName = "unrolled list",					\
+	.pfn_construct		= &stdlib_unrolled_list_construct,	\
+	.pfn_destruct		= &stdlib_unrolled_list_destruct,	\
+	.pfn_push_front		= &stdlib_unrolled_list_push_front,	\
+	.pfn_push_back		= &stdlib_unrolled_list_push_back,	\
+	.pfn_pop_front		= &stdlib_unrolled_list_pop_front,	\
+	.pfn_pop_back		= &stdlib_unrolled_list_pop_back,	\
+	.astIterators =									\
+	{												\
+		[std_iterator_enum_forward] =				\
+		{											\
+			.pfn_construct = &stdlib_unrolled_list_forwarditerator_construct,	\
+			.pfn_next = &stdlib_unrolled_list_forwarditerator_next,			\
+			.pfn_push_after = &stdlib_unrolled_list_push_after,		\
+			.pfn_push_before = &stdlib_unrolled_list_push_before,	\
+			.pfn_pop_at = &stdlib_unrolled_list_forward_pop_at,		\
+		},											\
+		[std_iterator_enum_reverse] =				\
+		{											\
+			.pfn_construct = &stdlib_unrolled_list_reverseiterator_construct,	\
+			.pfn_next = &stdlib_unrolled_list_reverseiterator_next,			\
+			.pfn_push_after = &stdlib_unrolled_list_push_before,	\
+			.pfn_push_before = &stdlib_unrolled_list_push_after,	\
+			.pfn_pop_at = &stdlib_unrolled_list_reverse_pop_at,		\
+		}											\
+	},												\
+	.pstDefaultItemHandler = &std_unrolled_list_default_itemhandler
+
+#endif /* STD_UNROLLED_LIST_H_ */
@@ -0,0 +1,580 @@
+/*
+ * src/std_bitset.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>		// for memset
+
+#include "std/bitset.h"
+
+#define CONTAINER_TO_BITSET(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_bitset_t, stContainer)
+
+#define BITS_PER_WORD		64U
+#define WORD_INDEX(BIT)		((BIT) / BITS_PER_WORD)
+#define WORD_MASK(BIT)		(1ULL << ((BIT) % BITS_PER_WORD))
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the number of words needed to hold a number of bits
+ *
+ * @param[in]	szNumBits	Number of bits
+ *
+ * @return Number of words
+ */
+static size_t words_for_bits(size_t szNumBits)
+{
+	return (szNumBits + (BITS_PER_WORD - 1U)) / BITS_PER_WORD;
+}
+
+/**
+ * Find a bitset's words
+ *
+ * @param[in]	pstContainer	Bitset container
+ *
+ * @return Pointer to the first word
+ */
+static uint64_t * bitset_words(std_container_t * pstContainer)
+{
+	return CONTAINER_TO_BITSET(pstContainer)->pvStartAddr;
+}
+
+/**
+ * Resize a bitset, clearing any new bits (and any bits dropped from the final word)
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szNumBits		New number of bits
+ *
+ * @return True if the bitset was resized, false if memory ran out
+ */
+static bool bitset_resize(std_container_t * pstContainer, size_t szNumBits)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+	size_t szOldWords = pstContainer->szNumItems;
+	size_t szNewWords = words_for_bits(szNumBits);
+	uint64_t * pu64Words;
+
+	if (szNewWords > szOldWords)
+	{
+		if (!stdlib_vector_reserve(pstContainer, szNewWords))
+		{
+			return false;
+		}
+		memset(&bitset_words(pstContainer)[szOldWords], 0, (szNewWords - szOldWords) * sizeof(uint64_t));
+	}
+	else if ((szNumBits < pstBitset->szNumBits) && (szNumBits % BITS_PER_WORD))
+	{
+		pu64Words = bitset_words(pstContainer);
+		pu64Words[szNewWords - 1U] &= WORD_MASK(szNumBits) - 1U;
+	}
+
+	pstContainer->szNumItems = szNewWords;
+	pstBitset->szNumBits = szNumBits;
+	pstBitset->bRankValid = false;
+	return true;
+}
+
+/**
+ * Make sure that a bitset is large enough to hold a bit
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index
+ *
+ * @return True if the bitset holds the bit, false if memory ran out
+ */
+static bool bitset_fit(std_container_t * pstContainer, size_t szBit)
+{
+	return (szBit < CONTAINER_TO_BITSET(pstContainer)->szNumBits) || bitset_resize(pstContainer, szBit + 1U);
+}
+
+/**
+ * Find the index of a set bit within a word
+ *
+ * @param[in]	u64Word		Word
+ * @param[in]	szRank		Number of set bits before the one to find (must be less than the word's popcount)
+ *
+ * @return Bit index within the word
+ */
+static size_t word_select(uint64_t u64Word, size_t szRank)
+{
+	while (szRank-- > 0U)
+	{
+		u64Word &= u64Word - 1U;
+	}
+	return (size_t) __builtin_ctzll(u64Word);
+}
+
+/**
+ * Rebuild a bitset's rank directory (if it is out of date)
+ *
+ * The directory holds the number of set bits before each block of words,
+ * plus one final entry holding the total number of set bits.
+ *
+ * @param[in]	pstContainer	Bitset container
+ *
+ * @return True if the directory is up to date, false if memory ran out
+ */
+static bool rank_build(std_container_t * pstContainer)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+	const uint64_t * pu64Words = bitset_words(pstContainer);
+	size_t szNumWords = pstContainer->szNumItems;
+	size_t szNumBlocks = (szNumWords + (STD_BITSET_RANK_BLOCK_WORDS - 1U)) / STD_BITSET_RANK_BLOCK_WORDS;
+	size_t * pszBlocks;
+	size_t szCount;
+	size_t i;
+
+	if (pstBitset->bRankValid)
+	{
+		return true;
+	}
+
+	if (szNumBlocks + 1U > pstBitset->szNumRankBlocksAlloced)
+	{
+		pszBlocks = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstBitset->pszRankBlocks, (szNumBlocks + 1U) * sizeof(size_t));
+		if (pszBlocks == NULL)
+		{
+			return false;
+		}
+		pstBitset->pszRankBlocks = pszBlocks;
+		pstBitset->szNumRankBlocksAlloced = szNumBlocks + 1U;
+	}
+
+	szCount = 0U;
+	for (i = 0; i < szNumWords; i++)
+	{
+		if ((i % STD_BITSET_RANK_BLOCK_WORDS) == 0U)
+		{
+			pstBitset->pszRankBlocks[i / STD_BITSET_RANK_BLOCK_WORDS] = szCount;
+		}
+		szCount += (size_t) __builtin_popcountll(pu64Words[i]);
+	}
+	pstBitset->pszRankBlocks[szNumBlocks] = szCount;
+
+	pstBitset->bRankValid = true;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a bitset container
+ *
+ * @param[in]	pstContainer	Bitset to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item (i.e. a word)
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the payload within the wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_bitset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	pstBitset->szNumBits				= 0;
+	pstBitset->pszRankBlocks			= NULL;
+	pstBitset->szNumRankBlocksAlloced	= 0;
+	pstBitset->bRankValid				= false;
+}
+
+/**
+ * Destruct a bitset container
+ *
+ * @param[in]	pstContainer	Bitset container
+ *
+ * @return True if destruction was successful, else false
+ */
+bool stdlib_bitset_destruct(std_container_t * pstContainer)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+
+	if (!stdlib_vector_destruct(pstContainer))
+	{
+		return false;
+	}
+
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstBitset->pszRankBlocks);
+	pstBitset->szNumBits				= 0;
+	pstBitset->pszRankBlocks			= NULL;
+	pstBitset->szNumRankBlocksAlloced	= 0;
+	pstBitset->bRankValid				= false;
+	return true;
+}
+
+/**
+ * Resize a bitset (any new bits are cleared)
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szNumBits		New number of bits
+ *
+ * @return True if the bitset was resized, false if memory ran out
+ */
+bool stdlib_bitset_resize(std_container_t * pstContainer, size_t szNumBits)
+{
+	return bitset_resize(pstContainer, szNumBits);
+}
+
+/**
+ * Set or clear a bit in a bitset (growing the bitset to hold a set bit)
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index
+ * @param[in]	bValue			Value to assign to the bit
+ *
+ * @return True if the bit was assigned, false if memory ran out
+ */
+bool stdlib_bitset_assign(std_container_t * pstContainer, size_t szBit, bool bValue)
+{
+	uint64_t * pu64Word;
+
+	if (bValue)
+	{
+		if (!bitset_fit(pstContainer, szBit))
+		{
+			return false;
+		}
+		pu64Word = &bitset_words(pstContainer)[WORD_INDEX(szBit)];
+		*pu64Word |= WORD_MASK(szBit);
+	}
+	else if (szBit < CONTAINER_TO_BITSET(pstContainer)->szNumBits)
+	{
+		// (Bits beyond the end of the bitset are already clear)
+		pu64Word = &bitset_words(pstContainer)[WORD_INDEX(szBit)];
+		*pu64Word &= ~WORD_MASK(szBit);
+	}
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+/**
+ * Flip a bit in a bitset (growing the bitset to hold it)
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index
+ *
+ * @return True if the bit was flipped, false if memory ran out
+ */
+bool stdlib_bitset_flip(std_container_t * pstContainer, size_t szBit)
+{
+	if (!bitset_fit(pstContainer, szBit))
+	{
+		return false;
+	}
+	bitset_words(pstContainer)[WORD_INDEX(szBit)] ^= WORD_MASK(szBit);
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+/**
+ * Test a bit in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index
+ *
+ * @return True if the bit is set, false if it is clear (or beyond the end of the bitset)
+ */
+bool stdlib_bitset_test(std_container_t * pstContainer, size_t szBit)
+{
+	return	(szBit < CONTAINER_TO_BITSET(pstContainer)->szNumBits)
+		&&	((bitset_words(pstContainer)[WORD_INDEX(szBit)] & WORD_MASK(szBit)) != 0U);
+}
+
+/**
+ * Count the set bits in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ *
+ * @return Number of set bits
+ */
+size_t stdlib_bitset_count(std_container_t * pstContainer)
+{
+	const uint64_t * pu64Words = bitset_words(pstContainer);
+	size_t szCount = 0U;
+	size_t i;
+
+	for (i = 0; i < pstContainer->szNumItems; i++)
+	{
+		szCount += (size_t) __builtin_popcountll(pu64Words[i]);
+	}
+	return szCount;
+}
+
+/**
+ * Find the first set bit in a bitset at or after a bit index
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index to start searching from
+ *
+ * @return Index of the set bit (or STD_BITSET_NPOS if there isn't one)
+ */
+size_t stdlib_bitset_find_from(std_container_t * pstContainer, size_t szBit)
+{
+	const uint64_t * pu64Words = bitset_words(pstContainer);
+	size_t szNumWords = pstContainer->szNumItems;
+	size_t szWord;
+	uint64_t u64Word;
+
+	if (szBit >= CONTAINER_TO_BITSET(pstContainer)->szNumBits)
+	{
+		return STD_BITSET_NPOS;
+	}
+
+	// Ignore the bits before the starting bit in its own word, then skip whole clear words
+	szWord = WORD_INDEX(szBit);
+	u64Word = pu64Words[szWord] & ~(WORD_MASK(szBit) - 1U);
+	while (u64Word == 0U)
+	{
+		if (++szWord == szNumWords)
+		{
+			return STD_BITSET_NPOS;
+		}
+		u64Word = pu64Words[szWord];
+	}
+	return (szWord * BITS_PER_WORD) + (size_t) __builtin_ctzll(u64Word);
+}
+
+/**
+ * Count the set bits before a bit index in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szBit			Bit index (clamped to the size of the bitset)
+ *
+ * @return Number of set bits before the bit index (or STD_BITSET_NPOS if memory ran out)
+ */
+size_t stdlib_bitset_rank(std_container_t * pstContainer, size_t szBit)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+	const uint64_t * pu64Words = bitset_words(pstContainer);
+	size_t szWord;
+	size_t szRank;
+	size_t i;
+
+	if (!rank_build(pstContainer))
+	{
+		return STD_BITSET_NPOS;
+	}
+	if (szBit >= pstBitset->szNumBits)
+	{
+		szBit = pstBitset->szNumBits;
+	}
+
+	// Start from the block's count, then add up the whole words (and part word) before the bit
+	szWord = WORD_INDEX(szBit);
+	szRank = pstBitset->pszRankBlocks[szWord / STD_BITSET_RANK_BLOCK_WORDS];
+	for (i = szWord - (szWord % STD_BITSET_RANK_BLOCK_WORDS); i < szWord; i++)
+	{
+		szRank += (size_t) __builtin_popcountll(pu64Words[i]);
+	}
+	if (szBit % BITS_PER_WORD)
+	{
+		szRank += (size_t) __builtin_popcountll(pu64Words[szWord] & (WORD_MASK(szBit) - 1U));
+	}
+	return szRank;
+}
+
+/**
+ * Find the set bit with a given number of set bits before it in a bitset
+ *
+ * @param[in]	pstContainer	Bitset container
+ * @param[in]	szRank			Number of set bits before the one to find
+ *
+ * @return Index of the set bit (or STD_BITSET_NPOS if there are too few set bits, or memory ran out)
+ */
+size_t stdlib_bitset_select(std_container_t * pstContainer, size_t szRank)
+{
+	std_bitset_t * pstBitset = CONTAINER_TO_BITSET(pstContainer);
+	const uint64_t * pu64Words = bitset_words(pstContainer);
+	const size_t * pszBlocks;
+	size_t szNumBlocks;
+	size_t szLow;
+	size_t szHigh;
+	size_t szMid;
+	size_t szWord;
+	size_t szCount;
+
+	if (!rank_build(pstContainer))
+	{
+		return STD_BITSET_NPOS;
+	}
+	pszBlocks = pstBitset->pszRankBlocks;
+	szNumBlocks = (pstContainer->szNumItems + (STD_BITSET_RANK_BLOCK_WORDS - 1U)) / STD_BITSET_RANK_BLOCK_WORDS;
+	if (szRank >= pszBlocks[szNumBlocks])
+	{
+		return STD_BITSET_NPOS;
+	}
+
+	// Binary search for the last block with no more than szRank set bits before it...
+	szLow = 0U;
+	szHigh = szNumBlocks - 1U;
+	while (szLow < szHigh)
+	{
+		szMid = szLow + ((szHigh - szLow + 1U) / 2U);
+		if (pszBlocks[szMid] <= szRank)
+		{
+			szLow = szMid;
+		}
+		else
+		{
+			szHigh = szMid - 1U;
+		}
+	}
+
+	// ...then step through its words
+	szRank -= pszBlocks[szLow];
+	for (szWord = szLow * STD_BITSET_RANK_BLOCK_WORDS; ; szWord++)
+	{
+		szCount = (size_t) __builtin_popcountll(pu64Words[szWord]);
+		if (szRank < szCount)
+		{
+			return (szWord * BITS_PER_WORD) + word_select(pu64Words[szWord], szRank);
+		}
+		szRank -= szCount;
+	}
+}
+
+/**
+ * Intersect one bitset with another (bits beyond the end of the other bitset are cleared)
+ *
+ * @param[in]	pstContainer	Destination bitset container
+ * @param[in]	pstOther		Other bitset container
+ *
+ * @return True
+ */
+bool stdlib_bitset_and(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	uint64_t * pu64Words = bitset_words(pstContainer);
+	const uint64_t * pu64Others = bitset_words(pstOther);
+	size_t szNumWords = pstContainer->szNumItems;
+	size_t szNumCommon = (pstOther->szNumItems < szNumWords) ? pstOther->szNumItems : szNumWords;
+	size_t i;
+
+	for (i = 0; i < szNumCommon; i++)
+	{
+		pu64Words[i] &= pu64Others[i];
+	}
+	for (; i < szNumWords; i++)
+	{
+		pu64Words[i] = 0U;
+	}
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+/**
+ * Unite one bitset with another (growing it to at least the size of the other bitset)
+ *
+ * @param[in]	pstContainer	Destination bitset container
+ * @param[in]	pstOther		Other bitset container
+ *
+ * @return True if the bitsets were combined, false if memory ran out
+ */
+bool stdlib_bitset_or(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	const uint64_t * pu64Others = bitset_words(pstOther);
+	uint64_t * pu64Words;
+	size_t i;
+
+	if (	(CONTAINER_TO_BITSET(pstOther)->szNumBits > CONTAINER_TO_BITSET(pstContainer)->szNumBits)
+		&&	!bitset_resize(pstContainer, CONTAINER_TO_BITSET(pstOther)->szNumBits)	)
+	{
+		return false;
+	}
+
+	pu64Words = bitset_words(pstContainer);
+	for (i = 0; i < pstOther->szNumItems; i++)
+	{
+		pu64Words[i] |= pu64Others[i];
+	}
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+/**
+ * Exclusive-or one bitset with another (growing it to at least the size of the other bitset)
+ *
+ * @param[in]	pstContainer	Destination bitset container
+ * @param[in]	pstOther		Other bitset container
+ *
+ * @return True if the bitsets were combined, false if memory ran out
+ */
+bool stdlib_bitset_xor(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	const uint64_t * pu64Others = bitset_words(pstOther);
+	uint64_t * pu64Words;
+	size_t i;
+
+	if (	(CONTAINER_TO_BITSET(pstOther)->szNumBits > CONTAINER_TO_BITSET(pstContainer)->szNumBits)
+		&&	!bitset_resize(pstContainer, CONTAINER_TO_BITSET(pstOther)->szNumBits)	)
+	{
+		return false;
+	}
+
+	pu64Words = bitset_words(pstContainer);
+	for (i = 0; i < pstOther->szNumItems; i++)
+	{
+		pu64Words[i] ^= pu64Others[i];
+	}
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+/**
+ * Clear every bit in one bitset that is set in another (a set difference)
+ *
+ * @param[in]	pstContainer	Destination bitset container
+ * @param[in]	pstOther		Other bitset container
+ *
+ * @return True
+ */
+bool stdlib_bitset_andnot(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	uint64_t * pu64Words = bitset_words(pstContainer);
+	const uint64_t * pu64Others = bitset_words(pstOther);
+	size_t szNumCommon = (pstOther->szNumItems < pstContainer->szNumItems) ? pstOther->szNumItems : pstContainer->szNumItems;
+	size_t i;
+
+	for (i = 0; i < szNumCommon; i++)
+	{
+		pu64Words[i] &= ~pu64Others[i];
+	}
+	CONTAINER_TO_BITSET(pstContainer)->bRankValid = false;
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+static bool bitset_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_bitset_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_bitset_default_itemhandler =
+{
+	.szElementSize = sizeof(std_bitset_t),
+	.pfn_Destructor = &bitset_default_destruct,
+	.pfn_Relocator = NULL
+};
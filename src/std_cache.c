@@ -0,0 +1,769 @@
+/*
+ * src/std_cache.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The hash index is a linear-probing table of node indices, kept at most
+ * half full (it's rebuilt at twice the node array's size whenever the node
+ * array grows), so probe runs stay short. Erasing uses backward-shift
+ * deletion rather than tombstones: each entry after the hole that isn't
+ * already sitting at or after its home slot moves back into the hole, so
+ * the table never needs cleaning up.
+ *
+ * The recency ring is circular and doubly linked through u32Prev / u32Next,
+ * starting at u32Head. For LRU, u32Head is the most recently used node and
+ * its u32Prev is the victim. For CLOCK, u32Head is the hand: new nodes are
+ * linked in just behind it (so are the last that it reaches), and they start
+ * off referenced, so a sweep always gives them one full lap first.
+ */
+
+#include <string.h>
+
+#include "std/cache.h"
+#include "std/support/hash.h"
+
+#define NO_NODE			UINT32_MAX
+#define NO_SLOT			((size_t) -1)
+
+#define CONTAINER_TO_CACHE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_cache_t, stContainer)
+#define ITERATOR_TO_CACHEIT(IT)				STD_CONTAINER_OF(IT, std_cache_iterator_t, stIterator)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Hash a key
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	pvKey		Key
+ *
+ * @return Hash value
+ */
+static uint32_t key_hash(const std_cache_t * pstCache, const void * pvKey)
+{
+	if (pstCache->pfnHash != NULL)
+	{
+		return (uint32_t) std_hash_mix((uint64_t) (*pstCache->pfnHash)(pvKey));
+	}
+	return (uint32_t) std_hash_mix(std_hash_bytes(pvKey, pstCache->szKeySizeof));
+}
+
+/**
+ * Find out whether two keys are equal
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	pvA			First key
+ * @param[in]	pvB			Second key
+ *
+ * @return True if the keys are equal
+ */
+static bool key_equal(const std_cache_t * pstCache, const void * pvA, const void * pvB)
+{
+	if (pstCache->pfnEqual != NULL)
+	{
+		return (*pstCache->pfnEqual)(pvA, pvB);
+	}
+	return (memcmp(pvA, pvB, pstCache->szKeySizeof) == 0);
+}
+
+/**
+ * Find the address of a node's entry
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ *
+ * @return Address of the entry
+ */
+static void * entry_at(const std_cache_t * pstCache, uint32_t u32Node)
+{
+	return STD_LINEAR_ADD(pstCache->pvEntries, (size_t) u32Node * pstCache->stContainer.szSizeofItem);
+}
+
+/**
+ * Find the hash index slot holding a key's node
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	pvKey		Key
+ * @param[in]	u32Hash		Hash of the key
+ *
+ * @return Hash index slot (or NO_SLOT if the key isn't in the cache)
+ */
+static size_t index_find(const std_cache_t * pstCache, const void * pvKey, uint32_t u32Hash)
+{
+	size_t szMask = pstCache->szIndexCapacity - 1U;
+	size_t szSlot;
+	uint32_t u32Node;
+
+	if (pstCache->szIndexCapacity == 0)
+	{
+		return NO_SLOT;
+	}
+	for (szSlot = u32Hash & szMask; (u32Node = pstCache->pu32Index[szSlot]) != NO_NODE; szSlot = (szSlot + 1U) & szMask)
+	{
+		if (	(pstCache->pstNodes[u32Node].u32Hash == u32Hash)
+			&&	key_equal(pstCache, entry_at(pstCache, u32Node), pvKey)	)
+		{
+			return szSlot;
+		}
+	}
+	return NO_SLOT;
+}
+
+/**
+ * Add a node to the hash index (which must have room for it)
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ */
+static void index_insert(std_cache_t * pstCache, uint32_t u32Node)
+{
+	size_t szMask = pstCache->szIndexCapacity - 1U;
+	size_t szSlot = pstCache->pstNodes[u32Node].u32Hash & szMask;
+
+	while (pstCache->pu32Index[szSlot] != NO_NODE)
+	{
+		szSlot = (szSlot + 1U) & szMask;
+	}
+	pstCache->pu32Index[szSlot] = u32Node;
+}
+
+/**
+ * Remove a node from the hash index (shifting back any entries that probed past it)
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ */
+static void index_remove(std_cache_t * pstCache, uint32_t u32Node)
+{
+	size_t szMask = pstCache->szIndexCapacity - 1U;
+	size_t szHole = pstCache->pstNodes[u32Node].u32Hash & szMask;
+	size_t szSlot;
+	size_t szHome;
+
+	while (pstCache->pu32Index[szHole] != u32Node)
+	{
+		szHole = (szHole + 1U) & szMask;
+	}
+
+	for (szSlot = (szHole + 1U) & szMask; pstCache->pu32Index[szSlot] != NO_NODE; szSlot = (szSlot + 1U) & szMask)
+	{
+		// An entry can fill the hole only if its home slot isn't cyclically in (hole, slot]
+		szHome = pstCache->pstNodes[pstCache->pu32Index[szSlot]].u32Hash & szMask;
+		if (((szSlot - szHome) & szMask) >= ((szSlot - szHole) & szMask))
+		{
+			pstCache->pu32Index[szHole] = pstCache->pu32Index[szSlot];
+			szHole = szSlot;
+		}
+	}
+	pstCache->pu32Index[szHole] = NO_NODE;
+}
+
+/**
+ * Link a node into the recency ring, just before another node
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ * @param[in]	u32Before	Node to link it in before (or NO_NODE if the ring is empty)
+ */
+static void ring_link(std_cache_t * pstCache, uint32_t u32Node, uint32_t u32Before)
+{
+	std_cache_node_t * pstNode = &pstCache->pstNodes[u32Node];
+
+	if (u32Before == NO_NODE)
+	{
+		pstNode->u32Prev = u32Node;
+		pstNode->u32Next = u32Node;
+		pstCache->u32Head = u32Node;
+		return;
+	}
+	pstNode->u32Next = u32Before;
+	pstNode->u32Prev = pstCache->pstNodes[u32Before].u32Prev;
+	pstCache->pstNodes[pstNode->u32Prev].u32Next = u32Node;
+	pstCache->pstNodes[u32Before].u32Prev = u32Node;
+}
+
+/**
+ * Unlink a node from the recency ring (moving the head / hand on, if it's the node)
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ */
+static void ring_unlink(std_cache_t * pstCache, uint32_t u32Node)
+{
+	std_cache_node_t * pstNode = &pstCache->pstNodes[u32Node];
+
+	if (pstNode->u32Next == u32Node)
+	{
+		pstCache->u32Head = NO_NODE;
+		return;
+	}
+	if (pstCache->u32Head == u32Node)
+	{
+		pstCache->u32Head = pstNode->u32Next;
+	}
+	pstCache->pstNodes[pstNode->u32Prev].u32Next = pstNode->u32Next;
+	pstCache->pstNodes[pstNode->u32Next].u32Prev = pstNode->u32Prev;
+}
+
+/**
+ * Mark a node's entry as just used
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ */
+static void node_touch(std_cache_t * pstCache, uint32_t u32Node)
+{
+	if (pstCache->ePolicy == std_cache_policy_clock)
+	{
+		pstCache->pstNodes[u32Node].bReferenced = true;
+	}
+	else if (pstCache->u32Head != u32Node)
+	{
+		ring_unlink(pstCache, u32Node);
+		ring_link(pstCache, u32Node, pstCache->u32Head);
+		pstCache->u32Head = u32Node;
+	}
+}
+
+/**
+ * Destruct an entry (if the cache has an item handler with a destructor)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pvEntry			Entry
+ */
+static void entry_destruct(std_container_t * pstContainer, void * pvEntry)
+{
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, pvEntry);
+	}
+}
+
+/**
+ * Remove (and destruct) a node's entry, returning the node to the free list
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Node		Node index
+ */
+static void node_remove(std_cache_t * pstCache, uint32_t u32Node)
+{
+	std_container_t * pstContainer = &pstCache->stContainer;
+	std_cache_node_t * pstNode = &pstCache->pstNodes[u32Node];
+
+	index_remove(pstCache, u32Node);
+	ring_unlink(pstCache, u32Node);
+	entry_destruct(pstContainer, entry_at(pstCache, u32Node));
+	pstCache->szNumBytes -= pstNode->szCost;
+	pstContainer->szNumItems--;
+
+	pstNode->u32Next = pstCache->u32FreeNode;
+	pstCache->u32FreeNode = u32Node;
+}
+
+/**
+ * Pick the next victim to evict (which must not be the only node besides the one being kept)
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Keep		Node that mustn't be picked (or NO_NODE)
+ *
+ * @return Victim's node index
+ */
+static uint32_t victim_select(std_cache_t * pstCache, uint32_t u32Keep)
+{
+	std_cache_node_t * pstNodes = pstCache->pstNodes;
+	uint32_t u32Node;
+
+	if (pstCache->ePolicy != std_cache_policy_clock)
+	{
+		u32Node = pstNodes[pstCache->u32Head].u32Prev;
+		return (u32Node == u32Keep) ? pstNodes[u32Node].u32Prev : u32Node;
+	}
+
+	// Sweep the hand round, clearing referenced bits, until it finds an unreferenced node
+	for (;;)
+	{
+		u32Node = pstCache->u32Head;
+		pstCache->u32Head = pstNodes[u32Node].u32Next;
+		if (u32Node != u32Keep)
+		{
+			if (!pstNodes[u32Node].bReferenced)
+			{
+				return u32Node;
+			}
+			pstNodes[u32Node].bReferenced = false;
+		}
+	}
+}
+
+/**
+ * Evict entries until a cache is back within its capacity
+ *
+ * @param[in]	pstCache	Cache
+ * @param[in]	u32Keep		Node that mustn't be evicted (or NO_NODE)
+ */
+static void evict_to_fit(std_cache_t * pstCache, uint32_t u32Keep)
+{
+	std_container_t * pstContainer = &pstCache->stContainer;
+	size_t szMinItems = (u32Keep == NO_NODE) ? 0U : 1U;
+
+	while (		(pstContainer->szNumItems > szMinItems)
+			&&	(	((pstCache->szMaxItems > 0) && (pstContainer->szNumItems > pstCache->szMaxItems))
+				||	((pstCache->szMaxBytes > 0) && (pstCache->szNumBytes > pstCache->szMaxBytes))	)	)
+	{
+		node_remove(pstCache, victim_select(pstCache, u32Keep));
+	}
+}
+
+/**
+ * Grow a cache's node array (and rebuild its hash index to match)
+ *
+ * @param[in]	pstCache		Cache
+ * @param[in]	szNumNodes		Number of nodes needed
+ *
+ * @return True if the cache now has room for that many nodes, false if memory ran out
+ */
+static bool nodes_grow(std_cache_t * pstCache, size_t szNumNodes)
+{
+	std_container_t * pstContainer = &pstCache->stContainer;
+	size_t szNewSize = (pstCache->szNumNodesAlloced > 0) ? pstCache->szNumNodesAlloced : 8U;
+	std_cache_node_t * pstNodes;
+	uint32_t * pu32Index;
+	void * pvEntries;
+	uint32_t u32Node;
+	size_t i;
+
+	if (szNumNodes <= pstCache->szNumNodesAlloced)
+	{
+		return true;
+	}
+	while (szNewSize < szNumNodes)
+	{
+		szNewSize *= 2U;
+	}
+
+	// Node indices must fit in a uint32_t (with NO_NODE to spare)
+	if (szNewSize >= NO_NODE)
+	{
+		return false;
+	}
+
+	pstNodes = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pstNodes, szNewSize * sizeof(std_cache_node_t));
+	if (pstNodes == NULL)
+	{
+		return false;
+	}
+	pstCache->pstNodes = pstNodes;
+
+	pvEntries = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pvEntries, szNewSize * pstContainer->szSizeofItem);
+	if (pvEntries == NULL)
+	{
+		return false;
+	}
+	if (pstContainer->eHas & std_container_has_itemhandler)
+	{
+		stdlib_item_relocate(pstContainer->pstItemHandler, pvEntries, pstCache->pvEntries, (size_t) pstCache->u32NumUsedNodes * pstContainer->szSizeofItem);
+	}
+	pstCache->pvEntries = pvEntries;
+
+	pu32Index = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, 2U * szNewSize * sizeof(uint32_t));
+	if (pu32Index == NULL)
+	{
+		return false;
+	}
+	if (pstCache->pu32Index != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pu32Index);
+	}
+	memset(pu32Index, 0xFF, 2U * szNewSize * sizeof(uint32_t));
+	pstCache->pu32Index = pu32Index;
+	pstCache->szIndexCapacity = 2U * szNewSize;
+	pstCache->szNumNodesAlloced = szNewSize;
+
+	// Re-index every live node (by walking round the ring)
+	for (i = 0, u32Node = pstCache->u32Head; i < pstContainer->szNumItems; i++, u32Node = pstNodes[u32Node].u32Next)
+	{
+		index_insert(pstCache, u32Node);
+	}
+	return true;
+}
+
+/**
+ * Take a node for a new entry (from the free list, if possible)
+ *
+ * @param[in]	pstCache	Cache
+ *
+ * @return Node index (or NO_NODE if memory ran out)
+ */
+static uint32_t node_alloc(std_cache_t * pstCache)
+{
+	uint32_t u32Node = pstCache->u32FreeNode;
+
+	if (u32Node != NO_NODE)
+	{
+		pstCache->u32FreeNode = pstCache->pstNodes[u32Node].u32Next;
+		return u32Node;
+	}
+	if (!nodes_grow(pstCache, (size_t) pstCache->u32NumUsedNodes + 1U))
+	{
+		return NO_NODE;
+	}
+	return pstCache->u32NumUsedNodes++;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a cache container
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	szSizeof		Size of an entry
+ * @param[in]	szKeySizeof		Size of an entry's key
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_cache_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+
+	if (szValueOffset) { /* Unused parameter (the typed macros add it on) */ }
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstCache->pfnHash = NULL;
+	pstCache->pfnEqual = NULL;
+	pstCache->szKeySizeof = szKeySizeof;
+	pstCache->ePolicy = std_cache_policy_lru;
+	pstCache->szMaxItems = 0;
+	pstCache->szMaxBytes = 0;
+	pstCache->szNumBytes = 0;
+	pstCache->pvEntries = NULL;
+	pstCache->pstNodes = NULL;
+	pstCache->szNumNodesAlloced = 0;
+	pstCache->pu32Index = NULL;
+	pstCache->szIndexCapacity = 0;
+	pstCache->u32Head = NO_NODE;
+	pstCache->u32FreeNode = NO_NODE;
+	pstCache->u32NumUsedNodes = 0;
+}
+
+/**
+ * Destruct a cache container (and all the entries inside it)
+ *
+ * @param[in]	pstContainer	Cache container to destruct
+ *
+ * @return True if the cache was able to be destructed, else false
+ */
+bool stdlib_cache_destruct(std_container_t * pstContainer)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+	uint32_t u32Node;
+	size_t i;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	for (i = 0, u32Node = pstCache->u32Head; i < pstContainer->szNumItems; i++, u32Node = pstCache->pstNodes[u32Node].u32Next)
+	{
+		entry_destruct(pstContainer, entry_at(pstCache, u32Node));
+	}
+
+	if (pstCache->pstNodes != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pstNodes);
+	}
+	if (pstCache->pvEntries != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pvEntries);
+	}
+	if (pstCache->pu32Index != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstCache->pu32Index);
+	}
+	pstCache->pstNodes = NULL;
+	pstCache->pvEntries = NULL;
+	pstCache->pu32Index = NULL;
+	pstCache->szNumNodesAlloced = 0;
+	pstCache->szIndexCapacity = 0;
+	pstCache->szNumBytes = 0;
+	pstCache->u32Head = NO_NODE;
+	pstCache->u32FreeNode = NO_NODE;
+	pstCache->u32NumUsedNodes = 0;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve room in a cache for a number of entries (e.g. its capacity, up front)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	szNewSize		Number of entries
+ *
+ * @return True if the room was reserved OK, else false
+ */
+bool stdlib_cache_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	return nodes_grow(CONTAINER_TO_CACHE(pstContainer), szNewSize);
+}
+
+/**
+ * Set the hash and equality functions that a cache uses on its keys
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pfnHash			Hash function (or NULL to hash the key's bytes)
+ * @param[in]	pfnEqual		Equality function (or NULL to compare the key's bytes)
+ */
+void stdlib_cache_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+
+	pstCache->pfnHash = pfnHash;
+	pstCache->pfnEqual = pfnEqual;
+}
+
+/**
+ * Set a cache's eviction policy
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	ePolicy			Eviction policy
+ */
+void stdlib_cache_policy_set(std_container_t * pstContainer, std_cache_policy_t ePolicy)
+{
+	CONTAINER_TO_CACHE(pstContainer)->ePolicy = ePolicy;
+}
+
+/**
+ * Set a cache's capacity (evicting entries straight away, if it now holds too many)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	szMaxItems		Capacity in entries (or zero for no limit)
+ * @param[in]	szMaxBytes		Capacity in bytes (or zero for no limit)
+ */
+void stdlib_cache_capacity_set(std_container_t * pstContainer, size_t szMaxItems, size_t szMaxBytes)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+
+	pstCache->szMaxItems = szMaxItems;
+	pstCache->szMaxBytes = szMaxBytes;
+	evict_to_fit(pstCache, NO_NODE);
+}
+
+/**
+ * Find the entry holding a key in a cache
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pvKey			Key
+ * @param[in]	bTouch			If true, mark the entry as just used
+ *
+ * @return Pointer to the entry (or NULL if the key isn't in the cache)
+ */
+void * stdlib_cache_find(std_container_t * pstContainer, const void * pvKey, bool bTouch)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+	size_t szSlot;
+	uint32_t u32Node;
+
+	if (pstContainer->szNumItems == 0)
+	{
+		return NULL;
+	}
+	szSlot = index_find(pstCache, pvKey, key_hash(pstCache, pvKey));
+	if (szSlot == NO_SLOT)
+	{
+		return NULL;
+	}
+	u32Node = pstCache->pu32Index[szSlot];
+	if (bTouch)
+	{
+		node_touch(pstCache, u32Node);
+	}
+	return entry_at(pstCache, u32Node);
+}
+
+/**
+ * Put an entry into a cache, replacing (and destructing) any entry already there with the same key
+ *
+ * Note: if this takes the cache over its capacity, other entries are evicted (never this one)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pvEntry			Entry to put
+ * @param[in]	szCost			Bytes to charge for the entry
+ *
+ * @return Pointer to the stored entry (or NULL if memory ran out)
+ */
+void * stdlib_cache_put(std_container_t * pstContainer, const void * pvEntry, size_t szCost)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+	uint32_t u32Hash = key_hash(pstCache, pvEntry);
+	size_t szSlot = index_find(pstCache, pvEntry, u32Hash);
+	std_cache_node_t * pstNode;
+	uint32_t u32Node;
+
+	if (szSlot != NO_SLOT)
+	{
+		u32Node = pstCache->pu32Index[szSlot];
+		pstNode = &pstCache->pstNodes[u32Node];
+		entry_destruct(pstContainer, entry_at(pstCache, u32Node));
+		pstCache->szNumBytes -= pstNode->szCost;
+		node_touch(pstCache, u32Node);
+	}
+	else
+	{
+		u32Node = node_alloc(pstCache);
+		if (u32Node == NO_NODE)
+		{
+			return NULL;
+		}
+		pstNode = &pstCache->pstNodes[u32Node];
+		pstNode->u32Hash = u32Hash;
+		pstNode->bReferenced = true;
+		index_insert(pstCache, u32Node);
+		ring_link(pstCache, u32Node, pstCache->u32Head);
+		if (pstCache->ePolicy != std_cache_policy_clock)
+		{
+			pstCache->u32Head = u32Node;
+		}
+		pstContainer->szNumItems++;
+	}
+
+	stdlib_container_relocate_items(pstContainer, entry_at(pstCache, u32Node), pvEntry, 1U);
+	pstNode->szCost = szCost;
+	pstCache->szNumBytes += szCost;
+	evict_to_fit(pstCache, u32Node);
+	return entry_at(pstCache, u32Node);
+}
+
+/**
+ * Erase (and destruct) the entry holding a key from a cache
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pvKey			Key
+ *
+ * @return True if an entry was erased, false if there wasn't one
+ */
+bool stdlib_cache_erase(std_container_t * pstContainer, const void * pvKey)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+	size_t szSlot;
+
+	if (pstContainer->szNumItems == 0)
+	{
+		return false;
+	}
+	szSlot = index_find(pstCache, pvKey, key_hash(pstCache, pvKey));
+	if (szSlot == NO_SLOT)
+	{
+		return false;
+	}
+	node_remove(pstCache, pstCache->pu32Index[szSlot]);
+	return true;
+}
+
+/**
+ * Evict (and destruct) the eviction policy's next victim from a cache
+ *
+ * @param[in]	pstContainer	Cache container
+ *
+ * @return True if an entry was evicted, false if the cache was empty
+ */
+bool stdlib_cache_evict(std_container_t * pstContainer)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+
+	if (pstContainer->szNumItems == 0)
+	{
+		return false;
+	}
+	node_remove(pstCache, victim_select(pstCache, NO_NODE));
+	return true;
+}
+
+/**
+ * Construct a forward iterator for a cache (which walks round its recency ring)
+ *
+ * @param[in]	pstContainer	Cache container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Unused (caches can only be iterated from start to end)
+ * @param[in]	szLast			Unused
+ */
+void stdlib_cache_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstContainer);
+	std_cache_iterator_t * pstCacheIt = ITERATOR_TO_CACHEIT(pstIterator);
+
+	if (szFirst || szLast) { /* Caches can only be iterated from start to end */ }
+
+	if (pstContainer->szNumItems == 0)
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		stdlib_iterator_construct(pstIterator, pstContainer, entry_at(pstCache, pstCache->u32Head));
+		pstIterator->pvBegin = pstCache->pvEntries;
+		pstIterator->pvEnd = NULL;
+		pstIterator->pvNext = NULL;
+		pstCacheIt->u32Node = pstCache->u32Head;
+		pstCacheIt->szNumLeft = pstContainer->szNumItems;
+	}
+}
+
+/**
+ * Step a cache iterator forwards to the next entry round the ring
+ *
+ * @param[in]	pstIterator		Cache iterator
+ */
+void stdlib_cache_forwarditerator_next(std_iterator_t * pstIterator)
+{
+	std_cache_t * pstCache = CONTAINER_TO_CACHE(pstIterator->pstContainer);
+	std_cache_iterator_t * pstCacheIt = ITERATOR_TO_CACHEIT(pstIterator);
+
+	if (--pstCacheIt->szNumLeft == 0)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstCacheIt->u32Node = pstCache->pstNodes[pstCacheIt->u32Node].u32Next;
+		pstIterator->pvRef = entry_at(pstCache, pstCacheIt->u32Node);
+	}
+}
+
+// -------------------------------------------------------------------------
+
+static bool cache_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_cache_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_cache_default_itemhandler =
+{
+	.szElementSize = sizeof(std_cache_t),
+	.pfn_Destructor = &cache_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -0,0 +1,436 @@
+/*
+ * src/std_calendar_queue.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The calendar queue keeps every item on the level given by the highest bit
+ * in which its expiry time differs from the queue's current time, in the slot
+ * given by its expiry time's digit (of STD_CALENDAR_QUEUE_SLOT_BITS bits) on
+ * that level. So on every level above level 0, each item's slot is strictly
+ * later than the current time's digit, and the level 0 slots hold exactly the
+ * items due in the current time's block of 64 ticks.
+ *
+ * This means that the earliest items are always in the lowest non-empty
+ * level's first non-empty slot (found with a bitmap and a count of trailing
+ * zeros), and that a node's level and slot can always be recomputed from its
+ * expiry time, so nodes don't need to remember where they are.
+ *
+ * Each slot is a circular doubly-linked list of nodes, so that any node can
+ * be unlinked in O(1).
+ */
+
+#include "std/calendar_queue.h"
+
+#define CONTAINER_TO_CALENDAR_QUEUE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_calendar_queue_t, stContainer)
+
+#define SLOT_MASK		((uint64_t)STD_CALENDAR_QUEUE_NUM_SLOTS - 1U)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find which level a node with a particular expiry time belongs on
+ *
+ * @param[in]	pstQueue	Calendar queue
+ * @param[in]	u64Expiry	Expiry time (no earlier than the queue's current time)
+ *
+ * @return Level
+ */
+static size_t expiry_level(const std_calendar_queue_t * pstQueue, uint64_t u64Expiry)
+{
+	uint64_t u64Diff = u64Expiry ^ pstQueue->u64Now;
+
+	if (u64Diff == 0U)
+	{
+		return 0U;
+	}
+	return (size_t)(63 - __builtin_clzll(u64Diff)) / STD_CALENDAR_QUEUE_SLOT_BITS;
+}
+
+/**
+ * Find which slot a node with a particular expiry time belongs in on a level
+ *
+ * @param[in]	u64Expiry	Expiry time
+ * @param[in]	szLevel		Level
+ *
+ * @return Slot
+ */
+static size_t expiry_slot(uint64_t u64Expiry, size_t szLevel)
+{
+	return (size_t)((u64Expiry >> (szLevel * STD_CALENDAR_QUEUE_SLOT_BITS)) & SLOT_MASK);
+}
+
+/**
+ * Link a node into the slot where its expiry time belongs
+ *
+ * @param[in]	pstQueue	Calendar queue
+ * @param[in]	pstNode		Node (with its expiry time already set)
+ */
+static void node_insert(std_calendar_queue_t * pstQueue, std_calendar_queue_node_t * pstNode)
+{
+	size_t szLevel = expiry_level(pstQueue, pstNode->u64Expiry);
+	size_t szSlot = expiry_slot(pstNode->u64Expiry, szLevel);
+	std_calendar_queue_node_t * pstHead = pstQueue->apstSlots[szLevel][szSlot];
+
+	if (pstHead == NULL)
+	{
+		pstNode->pstPrev = pstNode;
+		pstNode->pstNext = pstNode;
+		pstQueue->apstSlots[szLevel][szSlot] = pstNode;
+		pstQueue->au64Occupied[szLevel] |= (1ULL << szSlot);
+	}
+	else
+	{
+		// Append to the end of the slot
+		pstNode->pstPrev = pstHead->pstPrev;
+		pstNode->pstNext = pstHead;
+		pstHead->pstPrev->pstNext = pstNode;
+		pstHead->pstPrev = pstNode;
+	}
+}
+
+/**
+ * Unlink a node from the slot that it is in
+ *
+ * @param[in]	pstQueue	Calendar queue
+ * @param[in]	pstNode		Node
+ */
+static void node_remove(std_calendar_queue_t * pstQueue, std_calendar_queue_node_t * pstNode)
+{
+	size_t szLevel = expiry_level(pstQueue, pstNode->u64Expiry);
+	size_t szSlot = expiry_slot(pstNode->u64Expiry, szLevel);
+
+	if (pstNode->pstNext == pstNode)
+	{
+		pstQueue->apstSlots[szLevel][szSlot] = NULL;
+		pstQueue->au64Occupied[szLevel] &= ~(1ULL << szSlot);
+	}
+	else
+	{
+		pstNode->pstPrev->pstNext = pstNode->pstNext;
+		pstNode->pstNext->pstPrev = pstNode->pstPrev;
+		if (pstQueue->apstSlots[szLevel][szSlot] == pstNode)
+		{
+			pstQueue->apstSlots[szLevel][szSlot] = pstNode->pstNext;
+		}
+	}
+}
+
+/**
+ * Empty all the slots on every level
+ *
+ * @param[in]	pstQueue	Calendar queue
+ */
+static void slots_clear(std_calendar_queue_t * pstQueue)
+{
+	size_t szLevel;
+	size_t szSlot;
+
+	for (szLevel = 0; szLevel < STD_CALENDAR_QUEUE_NUM_LEVELS; szLevel++)
+	{
+		pstQueue->au64Occupied[szLevel] = 0U;
+		for (szSlot = 0; szSlot < STD_CALENDAR_QUEUE_NUM_SLOTS; szSlot++)
+		{
+			pstQueue->apstSlots[szLevel][szSlot] = NULL;
+		}
+	}
+}
+
+/**
+ * Move all the nodes in a slot down to the levels where they now belong (after the queue's time has advanced)
+ *
+ * @param[in]	pstQueue	Calendar queue
+ * @param[in]	szLevel		Level
+ * @param[in]	szSlot		Slot
+ */
+static void slot_cascade(std_calendar_queue_t * pstQueue, size_t szLevel, size_t szSlot)
+{
+	std_calendar_queue_node_t * pstNode = pstQueue->apstSlots[szLevel][szSlot];
+	std_calendar_queue_node_t * pstLast = pstNode->pstPrev;
+	std_calendar_queue_node_t * pstNext;
+
+	pstQueue->apstSlots[szLevel][szSlot] = NULL;
+	pstQueue->au64Occupied[szLevel] &= ~(1ULL << szSlot);
+
+	for (;;)
+	{
+		pstNext = pstNode->pstNext;
+		node_insert(pstQueue, pstNode);
+		if (pstNode == pstLast)
+		{
+			break;
+		}
+		pstNode = pstNext;
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a calendar queue container
+ *
+ * @param[in]	pstContainer	Calendar queue to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (i.e. including its node header)
+ * @param[in]	szPayloadOffset	Offset of a raw (payload) item inside a wrapped (node) item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_calendar_queue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstQueue->szPayloadOffset = szPayloadOffset;
+	pstQueue->u64Now = 0U;
+	slots_clear(pstQueue);
+	stdlib_node_pool_construct(&pstQueue->stPool, szWrappedSizeof);
+}
+
+/**
+ * Destruct a calendar queue container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Calendar queue container to destruct
+ *
+ * @return True if the calendar queue was able to be destructed, else false
+ */
+bool stdlib_calendar_queue_destruct(std_container_t * pstContainer)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+	std_calendar_queue_node_t * pstNode;
+	size_t szLevel;
+	size_t szSlot;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// If an item handler is attached AND that item handler has a destructor, destruct each item in the container
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (szLevel = 0; szLevel < STD_CALENDAR_QUEUE_NUM_LEVELS; szLevel++)
+		{
+			for (szSlot = 0; szSlot < STD_CALENDAR_QUEUE_NUM_SLOTS; szSlot++)
+			{
+				pstNode = pstQueue->apstSlots[szLevel][szSlot];
+				if (pstNode != NULL)
+				{
+					do
+					{
+						(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, STD_LINEAR_ADD(pstNode, pstQueue->szPayloadOffset));
+						pstNode = pstNode->pstNext;
+					} while (pstNode != pstQueue->apstSlots[szLevel][szSlot]);
+				}
+			}
+		}
+	}
+
+	// Freeing the pool frees all the nodes at once
+	stdlib_node_pool_destruct(&pstQueue->stPool, pstContainer);
+	slots_clear(pstQueue);
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Push an item into a calendar queue
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	u64Expiry		Time at which the item is due
+ * @param[in]	pvItem			Item to push
+ *
+ * @return Handle of the item (or NULL if it couldn't be pushed)
+ */
+std_calendar_queue_handle_t stdlib_calendar_queue_push(std_container_t * pstContainer, uint64_t u64Expiry, const void * pvItem)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+	std_calendar_queue_node_t * pstNode;
+
+	pstNode = stdlib_node_pool_alloc(&pstQueue->stPool, pstContainer);
+	if (pstNode == NULL)
+	{
+		return NULL;
+	}
+
+	stdlib_container_relocate_items(pstContainer, STD_LINEAR_ADD(pstNode, pstQueue->szPayloadOffset), pvItem, 1U);
+	pstNode->u64Expiry = (u64Expiry < pstQueue->u64Now) ? pstQueue->u64Now : u64Expiry;
+	node_insert(pstQueue, pstNode);
+	pstContainer->szNumItems++;
+	return pstNode;
+}
+
+/**
+ * Cancel (i.e. erase) an item before it is due
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	pstHandle		Handle of the item
+ *
+ * @return True if the item was cancelled, else false
+ */
+bool stdlib_calendar_queue_cancel(std_container_t * pstContainer, std_calendar_queue_handle_t pstHandle)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+
+	if (pstHandle == NULL)
+	{
+		return false;
+	}
+
+	node_remove(pstQueue, pstHandle);
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, NULL, STD_LINEAR_ADD(pstHandle, pstQueue->szPayloadOffset), pstContainer->szSizeofItem);
+	stdlib_node_pool_free(&pstQueue->stPool, pstHandle);
+	pstContainer->szNumItems--;
+	return true;
+}
+
+/**
+ * Change the time at which an item is due
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	pstHandle		Handle of the item
+ * @param[in]	u64Expiry		New time at which the item is due
+ *
+ * @return True if the item was rescheduled, else false
+ */
+bool stdlib_calendar_queue_reschedule(std_container_t * pstContainer, std_calendar_queue_handle_t pstHandle, uint64_t u64Expiry)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+
+	if (pstHandle == NULL)
+	{
+		return false;
+	}
+
+	node_remove(pstQueue, pstHandle);
+	pstHandle->u64Expiry = (u64Expiry < pstQueue->u64Now) ? pstQueue->u64Now : u64Expiry;
+	node_insert(pstQueue, pstHandle);
+	return true;
+}
+
+/**
+ * Advance a calendar queue's time, popping the items that are due by then
+ *
+ * If szMaxItems items are popped, the queue's time only advances as far as
+ * the last of those items, so that the rest of the items due by u64Time can
+ * be popped by a further call.
+ *
+ * @param[in]	pstContainer	Calendar queue container
+ * @param[in]	u64Time			Time to advance to
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_calendar_queue_pop_due(std_container_t * pstContainer, uint64_t u64Time, void * pvResult, size_t szMaxItems)
+{
+	std_calendar_queue_t * pstQueue = CONTAINER_TO_CALENDAR_QUEUE(pstContainer);
+	std_calendar_queue_node_t * pstNode;
+	uint64_t u64Occupied;
+	uint64_t u64Due;
+	size_t szNum = 0;
+	size_t szLevel;
+	size_t szSlot;
+	size_t szShift;
+
+	while (szNum < szMaxItems)
+	{
+		// Level 0 holds the items due in the current block of ticks
+		u64Occupied = pstQueue->au64Occupied[0];
+		if (u64Occupied != 0U)
+		{
+			szSlot = (size_t)__builtin_ctzll(u64Occupied);
+			u64Due = (pstQueue->u64Now & ~SLOT_MASK) | szSlot;
+			if (u64Due > u64Time)
+			{
+				break;
+			}
+			pstQueue->u64Now = u64Due;
+
+			while ((szNum < szMaxItems) && (pstQueue->apstSlots[0][szSlot] != NULL))
+			{
+				pstNode = pstQueue->apstSlots[0][szSlot];
+				node_remove(pstQueue, pstNode);
+				stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, STD_LINEAR_ADD(pstNode, pstQueue->szPayloadOffset), pstContainer->szSizeofItem);
+				stdlib_node_pool_free(&pstQueue->stPool, pstNode);
+				pstContainer->szNumItems--;
+				szNum++;
+				if (pvResult != NULL)
+				{
+					pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+				}
+			}
+			continue;
+		}
+
+		// Otherwise, find the first non-empty slot on the lowest non-empty level...
+		for (szLevel = 1; (szLevel < STD_CALENDAR_QUEUE_NUM_LEVELS) && (pstQueue->au64Occupied[szLevel] == 0U); szLevel++)
+		{
+		}
+		if (szLevel == STD_CALENDAR_QUEUE_NUM_LEVELS)
+		{
+			break;
+		}
+		szSlot = (size_t)__builtin_ctzll(pstQueue->au64Occupied[szLevel]);
+
+		// ...and if the time at which that slot starts is due, advance to it and cascade its items down
+		szShift = szLevel * STD_CALENDAR_QUEUE_SLOT_BITS;
+		u64Due = ((uint64_t)szSlot << szShift);
+		if (szShift + STD_CALENDAR_QUEUE_SLOT_BITS < 64U)
+		{
+			u64Due |= pstQueue->u64Now & ~((1ULL << (szShift + STD_CALENDAR_QUEUE_SLOT_BITS)) - 1U);
+		}
+		if (u64Due > u64Time)
+		{
+			break;
+		}
+		pstQueue->u64Now = u64Due;
+		slot_cascade(pstQueue, szLevel, szSlot);
+	}
+
+	// Nothing else is due by u64Time, so the time can advance all the way without any item changing slot
+	if ((szNum < szMaxItems) && (u64Time > pstQueue->u64Now))
+	{
+		pstQueue->u64Now = u64Time;
+	}
+
+	return szNum;
+}
+
+// -------------------------------------------------------------------------
+
+static bool calendar_queue_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_calendar_queue_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_calendar_queue_default_itemhandler =
+{
+	.szElementSize = sizeof(std_calendar_queue_t),
+	.pfn_Destructor = &calendar_queue_default_destruct,
+	.pfn_Relocator = NULL
+};
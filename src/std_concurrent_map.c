@@ -0,0 +1,448 @@
+/*
+ * src/std_concurrent_map.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "std/concurrent_map.h"
+
+#define CONTAINER_TO_CONCURRENT_MAP(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_concurrent_map_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the address of a segment
+ *
+ * @param[in]	pstMap		Concurrent map
+ * @param[in]	szIndex		Segment index
+ *
+ * @return Address of the segment
+ */
+static std_concurrent_map_segment_t * segment_at(const std_concurrent_map_t * pstMap, size_t szIndex)
+{
+	return (std_concurrent_map_segment_t *) STD_LINEAR_ADD(pstMap->pvSegments, szIndex * pstMap->szSegmentStride);
+}
+
+/**
+ * Hash a key, and find the segment that it belongs in (picked by the top bits of its hash)
+ *
+ * @param[in]	pstMap		Concurrent map
+ * @param[in]	pvKey		Key
+ * @param[out]	pu64Hash	Key's hash (for the segment's table to use, rather than hashing the key again)
+ *
+ * @return The key's segment (or NULL if the map has no segments)
+ */
+static std_concurrent_map_segment_t * segment_for(const std_concurrent_map_t * pstMap, const void * pvKey, uint64_t * pu64Hash)
+{
+	if (pstMap->szNumSegments == 0)
+	{
+		return NULL;
+	}
+
+	// Every segment hashes keys the same way, so the first one can hash for them all
+	*pu64Hash = stdlib_unorderedset_hash(&segment_at(pstMap, 0)->stTable.stContainer, pvKey);
+	return segment_at(pstMap, (size_t) ((*pu64Hash >> 32) * pstMap->szNumSegments >> 32));
+}
+
+/**
+ * Lock a segment
+ *
+ * @param[in]	pstMap			Concurrent map
+ * @param[in]	pstSegment		Segment
+ * @param[in]	bReadOnly		True to lock the segment for reading, else for writing
+ *
+ * @return Lock state to restore afterwards
+ */
+static std_lock_state_t segment_lock(const std_concurrent_map_t * pstMap, std_concurrent_map_segment_t * pstSegment, bool bReadOnly)
+{
+	const std_container_t * pstContainer = &pstMap->stContainer;
+
+	if (pstContainer->eHas & std_container_has_lockhandler)
+	{
+		return (bReadOnly)
+			? std_lock_for_reading(pstContainer->pstLockHandler, pstSegment->hLock, CONTAINER_TIMEOUT_DEFAULT)
+			: std_lock_for_writing(pstContainer->pstLockHandler, pstSegment->hLock, CONTAINER_TIMEOUT_DEFAULT);
+	}
+	return e_std_lock_NoRestoreNeeded;
+}
+
+/**
+ * Restore a segment's previous lock state
+ *
+ * @param[in]	pstMap			Concurrent map
+ * @param[in]	pstSegment		Segment
+ * @param[in]	eOldState		Lock state to restore
+ */
+static void segment_unlock(const std_concurrent_map_t * pstMap, std_concurrent_map_segment_t * pstSegment, std_lock_state_t eOldState)
+{
+	const std_container_t * pstContainer = &pstMap->stContainer;
+
+	if (	(pstContainer->eHas & std_container_has_lockhandler)
+		&&	(eOldState != e_std_lock_NoRestoreNeeded)	)
+	{
+		std_lock_update(pstContainer->pstLockHandler, pstSegment->hLock, eOldState, CONTAINER_TIMEOUT_DEFAULT);
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a concurrent map container (and its segments, and their locks)
+ *
+ * Note: if the segments can't be allocated, the map is left with none, and every insert fails
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	szSizeof		Size of an entry
+ * @param[in]	szKeySizeof		Size of an entry's key
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_concurrent_map_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	std_container_has_t eSegmentHas = (std_container_has_t) (eHas & ~std_container_has_lockhandler);
+	std_concurrent_map_segment_t * pstSegment;
+	size_t szLine = STD_CONCURRENT_MAP_CACHE_LINE;
+	uintptr_t uAddr;
+	size_t i;
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+
+	pstMap->szSegmentStride = (sizeof(std_concurrent_map_segment_t) + szLine - 1U) & ~(szLine - 1U);
+	pstMap->szNumSegments = 0;
+	pstMap->pvSegments = NULL;
+
+	// Over-allocate by a cache line, so that the segments can start on a cache line boundary
+	pstMap->pvSegmentAlloc = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, eHas, (STD_CONCURRENT_MAP_SEGMENTS * pstMap->szSegmentStride) + szLine);
+	if (pstMap->pvSegmentAlloc == NULL)
+	{
+		return;
+	}
+	uAddr = ((uintptr_t) pstMap->pvSegmentAlloc + szLine - 1U) & ~(uintptr_t) (szLine - 1U);
+	pstMap->pvSegments = (void *) uAddr;
+
+	// Each segment is an unordered map, sharing the container's item & memory handlers (but not its lock)
+	for (i = 0; i < STD_CONCURRENT_MAP_SEGMENTS; i++)
+	{
+		pstSegment = segment_at(pstMap, i);
+		pstSegment->stTable.stContainer.pstItemHandler = pstContainer->pstItemHandler;
+		pstSegment->stTable.stContainer.pstMemoryHandler = pstContainer->pstMemoryHandler;
+		pstSegment->stTable.stContainer.pstLockHandler = NULL;
+		pstSegment->stTable.stContainer.phLock = NULL;
+		stdlib_unorderedmap_construct(&pstSegment->stTable.stContainer, szSizeof, szKeySizeof, szValueOffset, eSegmentHas);
+		pstSegment->hLock = NULL;
+		if (eHas & std_container_has_lockhandler)
+		{
+			std_lock_construct(pstContainer->pstLockHandler, &pstSegment->hLock);
+		}
+	}
+	pstMap->szNumSegments = STD_CONCURRENT_MAP_SEGMENTS;
+}
+
+/**
+ * Destruct a concurrent map container (and all the entries inside it)
+ *
+ * Note: no other thread may be using the map by now
+ *
+ * @param[in]	pstContainer	Concurrent map container to destruct
+ *
+ * @return True if the concurrent map was able to be destructed, else false
+ */
+bool stdlib_concurrent_map_destruct(std_container_t * pstContainer)
+{
+	std_concurrent_map_t * pstMap;
+	std_concurrent_map_segment_t * pstSegment;
+	size_t i;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+	pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+
+	for (i = 0; i < pstMap->szNumSegments; i++)
+	{
+		pstSegment = segment_at(pstMap, i);
+		stdlib_unorderedset_destruct(&pstSegment->stTable.stContainer);
+		if (pstContainer->eHas & std_container_has_lockhandler)
+		{
+			std_lock_destruct(pstContainer->pstLockHandler, &pstSegment->hLock);
+		}
+	}
+	if (pstMap->pvSegmentAlloc != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstMap->pvSegmentAlloc);
+	}
+	pstMap->pvSegmentAlloc = NULL;
+	pstMap->pvSegments = NULL;
+	pstMap->szNumSegments = 0;
+	pstContainer->szNumItems = 0;
+
+	return true;
+}
+
+/**
+ * Reserve room in a concurrent map for a number of entries (spread evenly over its segments)
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	szNewSize		Number of entries
+ *
+ * @return True if the room was reserved OK, else false
+ */
+bool stdlib_concurrent_map_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	std_concurrent_map_segment_t * pstSegment;
+	std_lock_state_t eOldState;
+	bool bResult = (pstMap->szNumSegments > 0);
+	size_t szPerSegment;
+	size_t i;
+
+	if (!bResult)
+	{
+		return false;
+	}
+
+	// Allow some slack, as keys never spread out perfectly evenly
+	szPerSegment = (szNewSize / pstMap->szNumSegments) + (szNewSize / (4U * pstMap->szNumSegments)) + 1U;
+	for (i = 0; i < pstMap->szNumSegments; i++)
+	{
+		pstSegment = segment_at(pstMap, i);
+		eOldState = segment_lock(pstMap, pstSegment, false);
+		bResult &= stdlib_unorderedset_reserve(&pstSegment->stTable.stContainer, szPerSegment);
+		segment_unlock(pstMap, pstSegment, eOldState);
+	}
+	return bResult;
+}
+
+/**
+ * Set the hash and equality functions that a concurrent map uses on its keys
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pfnHash			Hash function (or NULL to hash the key's bytes)
+ * @param[in]	pfnEqual		Equality function (or NULL to compare the key's bytes)
+ */
+void stdlib_concurrent_map_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	size_t i;
+
+	for (i = 0; i < pstMap->szNumSegments; i++)
+	{
+		stdlib_unorderedset_hash_set(&segment_at(pstMap, i)->stTable.stContainer, pfnHash, pfnEqual);
+	}
+}
+
+/**
+ * Copy out the value stored against a key in a concurrent map
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pvKey			Key
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[out]	pvValue			Where to copy the value to (or NULL, just to find out whether the key is there)
+ * @param[in]	szValueSizeof	Size of the value
+ *
+ * @return True if the key was found, else false
+ */
+bool stdlib_concurrent_map_find(std_container_t * pstContainer, const void * pvKey, size_t szValueOffset, void * pvValue, size_t szValueSizeof)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	uint64_t u64Hash;
+	std_concurrent_map_segment_t * pstSegment = segment_for(pstMap, pvKey, &u64Hash);
+	std_lock_state_t eOldState;
+	void * pvEntry;
+
+	if (pstSegment == NULL)
+	{
+		return false;
+	}
+	eOldState = segment_lock(pstMap, pstSegment, true);
+	pvEntry = stdlib_unorderedset_find_hashed(&pstSegment->stTable.stContainer, pvKey, u64Hash);
+	if ((pvEntry != NULL) && (pvValue != NULL))
+	{
+		memcpy(pvValue, STD_LINEAR_ADD(pvEntry, szValueOffset), szValueSizeof);
+	}
+	segment_unlock(pstMap, pstSegment, eOldState);
+	return (pvEntry != NULL);
+}
+
+/**
+ * Insert an entry into a concurrent map
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pvEntry			Entry to insert
+ * @param[in]	bReplace		If true, replace any entry already there with the same key
+ *
+ * @return True if the entry was stored, false if its key was already there (and not replaced) or memory ran out
+ */
+bool stdlib_concurrent_map_insert(std_container_t * pstContainer, const void * pvEntry, bool bReplace)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	uint64_t u64Hash;
+	std_concurrent_map_segment_t * pstSegment = segment_for(pstMap, pvEntry, &u64Hash);
+	std_container_t * pstTable;
+	std_lock_state_t eOldState;
+	void * pvSlot;
+
+	if (pstSegment == NULL)
+	{
+		return false;
+	}
+	pstTable = &pstSegment->stTable.stContainer;
+	eOldState = segment_lock(pstMap, pstSegment, false);
+	pvSlot = stdlib_unorderedmap_insert_hashed(pstTable, pvEntry, u64Hash, bReplace);
+	segment_unlock(pstMap, pstSegment, eOldState);
+	return (pvSlot != NULL);
+}
+
+/**
+ * Run a callback on the value stored against a key in a concurrent map, under its segment's write lock
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pvKey			Key
+ * @param[in]	szValueOffset	Offset of the value inside an entry
+ * @param[in]	pfnUpdate		Callback (which must not call back into the map)
+ * @param[in]	pvContext		Context passed to the callback
+ *
+ * @return True if the key was found (and its value updated), else false
+ */
+bool stdlib_concurrent_map_update(std_container_t * pstContainer, const void * pvKey, size_t szValueOffset, pfn_std_concurrent_map_update_t pfnUpdate, void * pvContext)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	uint64_t u64Hash;
+	std_concurrent_map_segment_t * pstSegment = segment_for(pstMap, pvKey, &u64Hash);
+	std_lock_state_t eOldState;
+	void * pvEntry;
+
+	if (pstSegment == NULL)
+	{
+		return false;
+	}
+	eOldState = segment_lock(pstMap, pstSegment, false);
+	pvEntry = stdlib_unorderedset_find_hashed(&pstSegment->stTable.stContainer, pvKey, u64Hash);
+	if (pvEntry != NULL)
+	{
+		(*pfnUpdate)(pvContext, STD_LINEAR_ADD(pvEntry, szValueOffset));
+	}
+	segment_unlock(pstMap, pstSegment, eOldState);
+	return (pvEntry != NULL);
+}
+
+/**
+ * Erase (and destruct) the entry holding a key from a concurrent map
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pvKey			Key
+ *
+ * @return True if an entry was erased, false if there wasn't one
+ */
+bool stdlib_concurrent_map_erase(std_container_t * pstContainer, const void * pvKey)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	uint64_t u64Hash;
+	std_concurrent_map_segment_t * pstSegment = segment_for(pstMap, pvKey, &u64Hash);
+	std_lock_state_t eOldState;
+	bool bResult;
+
+	if (pstSegment == NULL)
+	{
+		return false;
+	}
+	eOldState = segment_lock(pstMap, pstSegment, false);
+	bResult = stdlib_unorderedset_erase_hashed(&pstSegment->stTable.stContainer, pvKey, u64Hash, NULL);
+	segment_unlock(pstMap, pstSegment, eOldState);
+	return bResult;
+}
+
+/**
+ * Count the entries in a concurrent map (segment by segment)
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ *
+ * @return Number of entries
+ */
+size_t stdlib_concurrent_map_size(std_container_t * pstContainer)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	std_concurrent_map_segment_t * pstSegment;
+	std_lock_state_t eOldState;
+	size_t szTotal = 0;
+	size_t i;
+
+	for (i = 0; i < pstMap->szNumSegments; i++)
+	{
+		pstSegment = segment_at(pstMap, i);
+		eOldState = segment_lock(pstMap, pstSegment, true);
+		szTotal += pstSegment->stTable.stContainer.szNumItems;
+		segment_unlock(pstMap, pstSegment, eOldState);
+	}
+	return szTotal;
+}
+
+/**
+ * Visit every entry in a concurrent map, one segment at a time (under each segment's read lock)
+ *
+ * @param[in]	pstContainer	Concurrent map container
+ * @param[in]	pfnVisit		Callback (which must not call back into the map)
+ * @param[in]	pvContext		Context passed to the callback
+ */
+void stdlib_concurrent_map_visit(std_container_t * pstContainer, pfn_std_concurrent_map_visit_t pfnVisit, void * pvContext)
+{
+	std_concurrent_map_t * pstMap = CONTAINER_TO_CONCURRENT_MAP(pstContainer);
+	std_concurrent_map_segment_t * pstSegment;
+	std_iterator_t * pstIterator;
+	std_unorderedset_iterator_t stIt;
+	std_lock_state_t eOldState;
+	size_t i;
+
+	pstIterator = &stIt.stIterator;
+	for (i = 0; i < pstMap->szNumSegments; i++)
+	{
+		pstSegment = segment_at(pstMap, i);
+		eOldState = segment_lock(pstMap, pstSegment, true);
+		for (stdlib_unorderedset_forwarditerator_construct(&pstSegment->stTable.stContainer, pstIterator, 0, 0); !pstIterator->bDone; stdlib_unorderedset_forwarditerator_next(pstIterator))
+		{
+			(*pfnVisit)(pvContext, pstIterator->pvRef);
+		}
+		segment_unlock(pstMap, pstSegment, eOldState);
+	}
+}
+
+// -------------------------------------------------------------------------
+
+static bool concurrent_map_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_concurrent_map_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_concurrent_map_default_itemhandler =
+{
+	.szElementSize = sizeof(std_concurrent_map_t),
+	.pfn_Destructor = &concurrent_map_default_destruct,
+	.pfn_Relocator = NULL
+};
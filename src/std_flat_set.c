@@ -0,0 +1,697 @@
+/*
+ * src/std_flat_set.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Galloping (as in Timsort, and Hwang & Lin's merging algorithm): rather than
+ * stepping through a run one item at a time, probe 1, 2, 4, 8... items ahead
+ * until the probe passes the key, then binary search the last gap. Finding
+ * a position d items away takes O(log d) comparisons, so merging m items
+ * into n takes O(m log(n/m)) comparisons, never more than a linear merge
+ * by more than a constant factor.
+ */
+
+#include "std/flat_set.h"
+
+#define CONTAINER_TO_FLAT_SET(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_flat_set_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the address of an item in a run of items
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvBase			Start of the run of items
+ * @param[in]	szIndex			Index of the item
+ *
+ * @return Address of the item
+ */
+static void * run_item(const std_container_t * pstContainer, const void * pvBase, size_t szIndex)
+{
+	return STD_LINEAR_ADD(pvBase, szIndex * pstContainer->szSizeofItem);
+}
+
+/**
+ * Find out whether one item (or key) is ranked after another
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvA			First item
+ * @param[in]	pvB			Second item
+ *
+ * @return True if the first item is ranked strictly after the second item
+ */
+static bool item_is_after(const std_flat_set_t * pstFlatSet, const void * pvA, const void * pvB)
+{
+	return ((*pstFlatSet->pfnCompare)(pvA, pvB) > 0);
+}
+
+/**
+ * Move a run of items (possibly overlapping)
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvDst			Where to move the items to
+ * @param[in]	pvSrc			Where to move the items from
+ * @param[in]	szNumItems		Number of items
+ */
+static void items_move(std_container_t * pstContainer, void * pvDst, const void * pvSrc, size_t szNumItems)
+{
+	if ((szNumItems > 0) && (pvDst != pvSrc))
+	{
+		stdlib_container_relocate_items(pstContainer, pvDst, pvSrc, szNumItems);
+	}
+}
+
+/**
+ * Destruct a run of items
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvItems			Start of the run of items
+ * @param[in]	szNumItems		Number of items
+ */
+static void items_destruct(std_container_t * pstContainer, void * pvItems, size_t szNumItems)
+{
+	if (pstContainer->eHas & std_container_has_itemhandler)
+	{
+		stdlib_item_destruct(pstContainer->pstItemHandler, pvItems, szNumItems);
+	}
+}
+
+/**
+ * Binary search a sorted run of items for a key
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvBase		Start of the run of items
+ * @param[in]	szNumItems	Number of items in the run
+ * @param[in]	pvKey		Key
+ * @param[in]	bUpper		If true, find the first item ranked after the key, else the first item not ranked before it
+ *
+ * @return Index of the item (or szNumItems, if there is no such item)
+ */
+static size_t run_bound(const std_flat_set_t * pstFlatSet, const void * pvBase, size_t szNumItems, const void * pvKey, bool bUpper)
+{
+	const std_container_t * pstContainer = &pstFlatSet->stContainer;
+	size_t szLo = 0;
+	size_t szHi = szNumItems;
+	size_t szMid;
+	const void * pvItem;
+
+	while (szLo < szHi)
+	{
+		szMid = szLo + ((szHi - szLo) / 2U);
+		pvItem = run_item(pstContainer, pvBase, szMid);
+		if (bUpper ? !item_is_after(pstFlatSet, pvItem, pvKey) : item_is_after(pstFlatSet, pvKey, pvItem))
+		{
+			szLo = szMid + 1U;
+		}
+		else
+		{
+			szHi = szMid;
+		}
+	}
+	return szLo;
+}
+
+/**
+ * Gallop forwards through a sorted run of items to the first item not ranked before a key
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvBase		Start of the run of items
+ * @param[in]	szStart		Index to start from (every item before it must be ranked before the key)
+ * @param[in]	szNumItems	Number of items in the run
+ * @param[in]	pvKey		Key
+ *
+ * @return Index of the item (or szNumItems, if there is no such item)
+ */
+static size_t gallop_lower_bound(const std_flat_set_t * pstFlatSet, const void * pvBase, size_t szStart, size_t szNumItems, const void * pvKey)
+{
+	const std_container_t * pstContainer = &pstFlatSet->stContainer;
+	size_t szStep = 1U;
+	size_t szHi = szStart;
+
+	while ((szHi < szNumItems) && item_is_after(pstFlatSet, pvKey, run_item(pstContainer, pvBase, szHi)))
+	{
+		szStart = szHi + 1U;
+		szHi = (szNumItems - szHi > szStep) ? szHi + szStep : szNumItems;
+		szStep <<= 1;
+	}
+	return szStart + run_bound(pstFlatSet, run_item(pstContainer, pvBase, szStart), szHi - szStart, pvKey, false);
+}
+
+/**
+ * Gallop backwards through a sorted run of items to the first item ranked after a key
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvBase		Start of the run of items
+ * @param[in]	szEnd		Index to start from (every item from it onwards must be ranked after the key)
+ * @param[in]	pvKey		Key
+ *
+ * @return Index of the item (or szEnd, if there is no such item before it)
+ */
+static size_t gallop_upper_bound_back(const std_flat_set_t * pstFlatSet, const void * pvBase, size_t szEnd, const void * pvKey)
+{
+	const std_container_t * pstContainer = &pstFlatSet->stContainer;
+	size_t szStep = 1U;
+	size_t szLo;
+
+	while (szEnd > 0)
+	{
+		szLo = (szEnd > szStep) ? szEnd - szStep : 0;
+		if (!item_is_after(pstFlatSet, run_item(pstContainer, pvBase, szLo), pvKey))
+		{
+			szLo++;
+			return szLo + run_bound(pstFlatSet, run_item(pstContainer, pvBase, szLo), szEnd - szLo, pvKey, true);
+		}
+		szEnd = szLo;
+		szStep <<= 1;
+	}
+	return 0;
+}
+
+/**
+ * Stably sort a run of items (a bottom-up merge sort)
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvRun		Run of items
+ * @param[in]	pvScratch	Scratch space for as many items
+ * @param[in]	szNumItems	Number of items in the run
+ *
+ * @return Where the sorted items ended up (either the run or the scratch space)
+ */
+static void * run_sort(std_flat_set_t * pstFlatSet, void * pvRun, void * pvScratch, size_t szNumItems)
+{
+	std_container_t * pstContainer = &pstFlatSet->stContainer;
+	size_t szWidth;
+	size_t szStart;
+	size_t szMid;
+	size_t szEnd;
+	size_t i;
+	size_t j;
+	size_t k;
+	void * pvSwap;
+
+	for (szWidth = 1U; szWidth < szNumItems; szWidth *= 2U)
+	{
+		for (szStart = 0; szStart < szNumItems; szStart += 2U * szWidth)
+		{
+			szMid = (szNumItems - szStart > szWidth) ? szStart + szWidth : szNumItems;
+			szEnd = (szNumItems - szMid > szWidth) ? szMid + szWidth : szNumItems;
+
+			// Merge the two halves, taking from the left on ties (so that the sort is stable)
+			for (i = szStart, j = szMid, k = szStart; (i < szMid) && (j < szEnd); k++)
+			{
+				if (item_is_after(pstFlatSet, run_item(pstContainer, pvRun, i), run_item(pstContainer, pvRun, j)))
+				{
+					items_move(pstContainer, run_item(pstContainer, pvScratch, k), run_item(pstContainer, pvRun, j++), 1U);
+				}
+				else
+				{
+					items_move(pstContainer, run_item(pstContainer, pvScratch, k), run_item(pstContainer, pvRun, i++), 1U);
+				}
+			}
+			items_move(pstContainer, run_item(pstContainer, pvScratch, k), run_item(pstContainer, pvRun, i), szMid - i);
+			k += szMid - i;
+			items_move(pstContainer, run_item(pstContainer, pvScratch, k), run_item(pstContainer, pvRun, j), szEnd - j);
+		}
+		pvSwap = pvRun;
+		pvRun = pvScratch;
+		pvScratch = pvSwap;
+	}
+	return pvRun;
+}
+
+/**
+ * Remove all but the first of each run of equal items in a sorted run (the removed items are left alone)
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvRun		Sorted run of items
+ * @param[in]	szNumItems	Number of items in the run
+ *
+ * @return Number of items left in the run
+ */
+static size_t run_unique(std_flat_set_t * pstFlatSet, void * pvRun, size_t szNumItems)
+{
+	std_container_t * pstContainer = &pstFlatSet->stContainer;
+	size_t szKept = 0;
+	size_t i;
+
+	for (i = 0; i < szNumItems; i++)
+	{
+		if ((i == 0) || item_is_after(pstFlatSet, run_item(pstContainer, pvRun, i), run_item(pstContainer, pvRun, szKept - 1U)))
+		{
+			items_move(pstContainer, run_item(pstContainer, pvRun, szKept++), run_item(pstContainer, pvRun, i), 1U);
+		}
+	}
+	return szKept;
+}
+
+/**
+ * Merge a sorted run of unique items into a flat set (whose vector must already have room for them all)
+ *
+ * @param[in]	pstFlatSet	Flat set
+ * @param[in]	pvRun		Sorted run of unique items (outside the set's vector)
+ * @param[in]	szNumItems	Number of items in the run
+ * @param[in]	bDestruct	If true, run items whose keys the set already holds are destructed (else they're left alone)
+ *
+ * @return Number of items merged into the set
+ */
+static size_t run_merge(std_flat_set_t * pstFlatSet, void * pvRun, size_t szNumItems, bool bDestruct)
+{
+	std_container_t * pstContainer = &pstFlatSet->stContainer;
+	void * pvItems = pstFlatSet->pvStartAddr;
+	size_t szNumOld = pstContainer->szNumItems;
+	size_t szKept = 0;
+	size_t szIndex = 0;
+	size_t szDst;
+	size_t i;
+
+	// First drop the run's items that the set already holds
+	for (i = 0; i < szNumItems; i++)
+	{
+		void * pvItem = run_item(pstContainer, pvRun, i);
+
+		szIndex = gallop_lower_bound(pstFlatSet, pvItems, szIndex, szNumOld, pvItem);
+		if ((szIndex < szNumOld) && !item_is_after(pstFlatSet, run_item(pstContainer, pvItems, szIndex), pvItem))
+		{
+			if (bDestruct)
+			{
+				items_destruct(pstContainer, pvItem, 1U);
+			}
+		}
+		else
+		{
+			items_move(pstContainer, run_item(pstContainer, pvRun, szKept++), pvItem, 1U);
+		}
+	}
+
+	// Then merge from the back, moving each block of the set's items that sorts after a run item in one go
+	szDst = szNumOld + szKept;
+	szIndex = szNumOld;
+	for (i = szKept; i > 0; i--)
+	{
+		void * pvItem = run_item(pstContainer, pvRun, i - 1U);
+		size_t szFirst = gallop_upper_bound_back(pstFlatSet, pvItems, szIndex, pvItem);
+
+		szDst -= szIndex - szFirst;
+		items_move(pstContainer, run_item(pstContainer, pvItems, szDst), run_item(pstContainer, pvItems, szFirst), szIndex - szFirst);
+		szIndex = szFirst;
+		items_move(pstContainer, run_item(pstContainer, pvItems, --szDst), pvItem, 1U);
+	}
+
+	pstContainer->szNumItems = szNumOld + szKept;
+	return szKept;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a flat set container
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset of a raw item inside a wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_flat_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	CONTAINER_TO_FLAT_SET(pstContainer)->pfnCompare = NULL;
+}
+
+/**
+ * Set the comparison function that a flat set orders its items by
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_flat_set_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_FLAT_SET(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Find the index of the first item in a flat set that isn't ranked before a key
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+size_t stdlib_flat_set_lower_bound(std_container_t * pstContainer, const void * pvKey)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+
+	if (pstFlatSet->pfnCompare == NULL)
+	{
+		return pstContainer->szNumItems;
+	}
+	return run_bound(pstFlatSet, pstFlatSet->pvStartAddr, pstContainer->szNumItems, pvKey, false);
+}
+
+/**
+ * Find the index of the first item in a flat set that is ranked after a key
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+size_t stdlib_flat_set_upper_bound(std_container_t * pstContainer, const void * pvKey)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+
+	if (pstFlatSet->pfnCompare == NULL)
+	{
+		return pstContainer->szNumItems;
+	}
+	return run_bound(pstFlatSet, pstFlatSet->pvStartAddr, pstContainer->szNumItems, pvKey, true);
+}
+
+/**
+ * Find an item matching a key in a flat set
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Pointer to the matching item (or NULL if there isn't one)
+ */
+void * stdlib_flat_set_find(std_container_t * pstContainer, const void * pvKey)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	size_t szIndex = stdlib_flat_set_lower_bound(pstContainer, pvKey);
+	void * pvItem;
+
+	if (szIndex >= pstContainer->szNumItems)
+	{
+		return NULL;
+	}
+	pvItem = run_item(pstContainer, pstFlatSet->pvStartAddr, szIndex);
+	return item_is_after(pstFlatSet, pvItem, pvKey) ? NULL : pvItem;
+}
+
+/**
+ * Insert an item into a flat set
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvItem			Item to insert
+ * @param[in]	bReplace		If true, an item already in the set with an equal key is replaced (and destructed)
+ * @param[out]	pbInserted		Set to true if the item was inserted (or replaced an existing item)
+ *
+ * @return Pointer to the set's item with the key (or NULL if memory ran out)
+ */
+void * stdlib_flat_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	size_t szIndex = stdlib_flat_set_lower_bound(pstContainer, pvItem);
+	void * pvSlot;
+
+	*pbInserted = false;
+	if (pstFlatSet->pfnCompare == NULL)
+	{
+		return NULL;
+	}
+
+	if (szIndex < pstContainer->szNumItems)
+	{
+		pvSlot = run_item(pstContainer, pstFlatSet->pvStartAddr, szIndex);
+		if (!item_is_after(pstFlatSet, pvSlot, pvItem))
+		{
+			if (bReplace)
+			{
+				items_destruct(pstContainer, pvSlot, 1U);
+				stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+				*pbInserted = true;
+			}
+			return pvSlot;
+		}
+	}
+
+	if (!stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + 1U))
+	{
+		return NULL;
+	}
+	pvSlot = run_item(pstContainer, pstFlatSet->pvStartAddr, szIndex);
+	items_move(pstContainer, run_item(pstContainer, pvSlot, 1U), pvSlot, pstContainer->szNumItems - szIndex);
+	stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+	pstContainer->szNumItems++;
+	*pbInserted = true;
+	return pvSlot;
+}
+
+/**
+ * Erase the item matching a key from a flat set
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pvKey			Key
+ * @param[out]	pvResult		Where to move the erased item to (or NULL to destruct it)
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+bool stdlib_flat_set_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	size_t szIndex = stdlib_flat_set_lower_bound(pstContainer, pvKey);
+	void * pvItem;
+
+	if (szIndex >= pstContainer->szNumItems)
+	{
+		return false;
+	}
+	pvItem = run_item(pstContainer, pstFlatSet->pvStartAddr, szIndex);
+	if (item_is_after(pstFlatSet, pvItem, pvKey))
+	{
+		return false;
+	}
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
+	items_move(pstContainer, pvItem, run_item(pstContainer, pvItem, 1U), pstContainer->szNumItems - szIndex - 1U);
+	pstContainer->szNumItems--;
+	return true;
+}
+
+/**
+ * Push (bulk-load) a series of items into a flat set container
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * Note: items whose keys the set already holds (or that repeat a key earlier in the series) aren't pushed,
+ * and are left alone (like the other sets)
+ *
+ * @return Number of items pushed
+ */
+size_t stdlib_flat_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	size_t szNumItems = pstSeries->szNumItems;
+	std_linear_series_iterator_t stIt;
+	void * pvBuffer;
+	void * pvRun;
+	size_t i;
+	bool bInserted;
+
+	if ((pstFlatSet->pfnCompare == NULL) || (szNumItems == 0) || (pstSeries->pvStart == NULL))
+	{
+		return 0;
+	}
+	if (szNumItems == 1U)
+	{
+		stdlib_flat_set_insert(pstContainer, pstSeries->pvStart, false, &bInserted);
+		return bInserted ? 1U : 0U;
+	}
+
+	// Make room for the whole series up front, so that the merge itself can't fail
+	if (!stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + szNumItems))
+	{
+		return 0;
+	}
+	pvBuffer = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, 2U * szNumItems * pstContainer->szSizeofItem);
+	if (pvBuffer == NULL)
+	{
+		return 0;
+	}
+
+	// Sort the series (in a buffer of its own), remove its duplicates, then merge it in
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt), i++)
+	{
+		stdlib_container_relocate_items(pstContainer, run_item(pstContainer, pvBuffer, i), stIt.pvData, 1U);
+	}
+	pvRun = run_sort(pstFlatSet, pvBuffer, run_item(pstContainer, pvBuffer, szNumItems), szNumItems);
+	szNumItems = run_merge(pstFlatSet, pvRun, run_unique(pstFlatSet, pvRun, szNumItems), false);
+
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pvBuffer);
+	return szNumItems;
+}
+
+/**
+ * Move all the items of one flat set into another (a union), leaving the source flat set empty
+ *
+ * Note: source items whose keys the destination already holds are destructed
+ *
+ * @param[in]	pstContainer	Destination flat set container
+ * @param[in]	pstSource		Source flat set container
+ *
+ * @return True if the flat sets were merged, false if memory ran out (in which case neither changes)
+ */
+bool stdlib_flat_set_merge(std_container_t * pstContainer, std_container_t * pstSource)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	std_flat_set_t * pstSourceSet = CONTAINER_TO_FLAT_SET(pstSource);
+
+	// (Merging a flat set into itself leaves it as it is, rather than destructing every item as a duplicate)
+	if ((pstFlatSet->pfnCompare == NULL) || (pstSource->szNumItems == 0) || (pstSource == pstContainer))
+	{
+		return (pstFlatSet->pfnCompare != NULL);
+	}
+	if (!stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + pstSource->szNumItems))
+	{
+		return false;
+	}
+
+	// The source's items are already a sorted run of unique items
+	run_merge(pstFlatSet, pstSourceSet->pvStartAddr, pstSource->szNumItems, true);
+	pstSource->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Erase (and destruct) every item of a flat set whose key isn't in another flat set (an intersection)
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pstOther		Other flat set container (unchanged)
+ *
+ * @return True (unless no comparison function has been set)
+ */
+bool stdlib_flat_set_intersect(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	void * pvItems = pstFlatSet->pvStartAddr;
+	void * pvOthers = CONTAINER_TO_FLAT_SET(pstOther)->pvStartAddr;
+	size_t szNumItems = pstContainer->szNumItems;
+	size_t szNumOthers = pstOther->szNumItems;
+	size_t szKept = 0;
+	size_t szOther = 0;
+	size_t szNext;
+	size_t i = 0;
+
+	if (pstFlatSet->pfnCompare == NULL)
+	{
+		return false;
+	}
+
+	while (i < szNumItems)
+	{
+		szOther = gallop_lower_bound(pstFlatSet, pvOthers, szOther, szNumOthers, run_item(pstContainer, pvItems, i));
+		if (szOther == szNumOthers)
+		{
+			break;
+		}
+		if (!item_is_after(pstFlatSet, run_item(pstContainer, pvOthers, szOther), run_item(pstContainer, pvItems, i)))
+		{
+			// In both sets: keep it
+			items_move(pstContainer, run_item(pstContainer, pvItems, szKept++), run_item(pstContainer, pvItems, i++), 1U);
+			szOther++;
+		}
+		else
+		{
+			// Everything up to the other set's next item isn't in the other set
+			szNext = gallop_lower_bound(pstFlatSet, pvItems, i, szNumItems, run_item(pstContainer, pvOthers, szOther));
+			items_destruct(pstContainer, run_item(pstContainer, pvItems, i), szNext - i);
+			i = szNext;
+		}
+	}
+	items_destruct(pstContainer, run_item(pstContainer, pvItems, i), szNumItems - i);
+	pstContainer->szNumItems = szKept;
+	return true;
+}
+
+/**
+ * Erase (and destruct) every item of a flat set whose key is in another flat set (a difference)
+ *
+ * @param[in]	pstContainer	Flat set container
+ * @param[in]	pstOther		Other flat set container (unchanged)
+ *
+ * @return True (unless no comparison function has been set)
+ */
+bool stdlib_flat_set_subtract(std_container_t * pstContainer, std_container_t * pstOther)
+{
+	std_flat_set_t * pstFlatSet = CONTAINER_TO_FLAT_SET(pstContainer);
+	void * pvItems = pstFlatSet->pvStartAddr;
+	void * pvOthers = CONTAINER_TO_FLAT_SET(pstOther)->pvStartAddr;
+	size_t szNumItems = pstContainer->szNumItems;
+	size_t szNumOthers = pstOther->szNumItems;
+	size_t szKept = 0;
+	size_t szOther = 0;
+	size_t szNext;
+	size_t i = 0;
+
+	if (pstFlatSet->pfnCompare == NULL)
+	{
+		return false;
+	}
+
+	while (i < szNumItems)
+	{
+		szOther = gallop_lower_bound(pstFlatSet, pvOthers, szOther, szNumOthers, run_item(pstContainer, pvItems, i));
+		if (szOther == szNumOthers)
+		{
+			break;
+		}
+		if (!item_is_after(pstFlatSet, run_item(pstContainer, pvOthers, szOther), run_item(pstContainer, pvItems, i)))
+		{
+			// In both sets: erase it
+			items_destruct(pstContainer, run_item(pstContainer, pvItems, i++), 1U);
+			szOther++;
+		}
+		else
+		{
+			// Everything up to the other set's next item is kept (as a block)
+			szNext = gallop_lower_bound(pstFlatSet, pvItems, i, szNumItems, run_item(pstContainer, pvOthers, szOther));
+			items_move(pstContainer, run_item(pstContainer, pvItems, szKept), run_item(pstContainer, pvItems, i), szNext - i);
+			szKept += szNext - i;
+			i = szNext;
+		}
+	}
+	items_move(pstContainer, run_item(pstContainer, pvItems, szKept), run_item(pstContainer, pvItems, i), szNumItems - i);
+	pstContainer->szNumItems = szKept + (szNumItems - i);
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+static bool flat_set_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_vector_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_flat_set_default_itemhandler =
+{
+	.szElementSize = sizeof(std_flat_set_t),
+	.pfn_Destructor = &flat_set_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -68,6 +68,84 @@ static void node_push_after(std_forward_list_t* pstList, std_forward_list_node_t
 	pstList->stContainer.szNumItems++;
 }
 
+/**
+ * Merge two sorted (NULL-terminated) runs of nodes into one
+ *
+ * @param[in]	pstList		Forward list that the nodes belong to
+ * @param[in]	pstA		First run (all of whose nodes came before the second run)
+ * @param[in]	pstB		Second run
+ * @param[in]	pfnCompare	Comparison function
+ *
+ * @return First node of the merged run
+ */
+static std_forward_list_node_t* node_merge(std_forward_list_t* pstList, std_forward_list_node_t* pstA, std_forward_list_node_t* pstB, pfn_std_compare_t pfnCompare)
+{
+	std_forward_list_node_t* pstHead = NULL;
+	std_forward_list_node_t** ppstLink = &pstHead;
+
+	while ((pstA != NULL) && (pstB != NULL))
+	{
+		// Only take from the second run if strictly less, so that the sort is stable
+		if ((*pfnCompare)(STD_LINEAR_ADD(pstA, pstList->szPayloadOffset), STD_LINEAR_ADD(pstB, pstList->szPayloadOffset)) > 0)
+		{
+			*ppstLink = pstB;
+			pstB = pstB->pstNext;
+		}
+		else
+		{
+			*ppstLink = pstA;
+			pstA = pstA->pstNext;
+		}
+		ppstLink = &(*ppstLink)->pstNext;
+	}
+	*ppstLink = (pstA != NULL) ? pstA : pstB;
+
+	return pstHead;
+}
+
+/**
+ * Stable bottom-up merge sort a (NULL-terminated) run of nodes
+ *
+ * @param[in]	pstList		Forward list that the nodes belong to
+ * @param[in]	pstNode		First node of the run
+ * @param[in]	pfnCompare	Comparison function
+ *
+ * @return First node of the sorted run
+ */
+static std_forward_list_node_t* node_sort(std_forward_list_t* pstList, std_forward_list_node_t* pstNode, pfn_std_compare_t pfnCompare)
+{
+	std_forward_list_node_t* apstBins[64] = { NULL };		// apstBins[k] is either empty or a sorted run of 2^k nodes
+	std_forward_list_node_t* pstCarry;
+	std_forward_list_node_t* pstNext;
+	size_t k;
+
+	for (; pstNode != NULL; pstNode = pstNext)
+	{
+		pstNext = pstNode->pstNext;
+		pstNode->pstNext = NULL;
+
+		pstCarry = pstNode;
+		for (k = 0; apstBins[k] != NULL; k++)
+		{
+			pstCarry = node_merge(pstList, apstBins[k], pstCarry, pfnCompare);
+			apstBins[k] = NULL;
+		}
+		apstBins[k] = pstCarry;
+	}
+
+	// Higher bins hold earlier nodes, so merge them in front of the lower ones
+	pstCarry = NULL;
+	for (k = 0; k < STD_NUM_ELEMENTS(apstBins); k++)
+	{
+		if (apstBins[k] != NULL)
+		{
+			pstCarry = node_merge(pstList, apstBins[k], pstCarry, pfnCompare);
+		}
+	}
+
+	return pstCarry;
+}
+
 // --------------------------------------------------------------------------
 // Public functions
 // --------------------------------------------------------------------------
@@ -89,6 +167,7 @@ void stdlib_forward_list_construct(std_container_t* pstContainer, size_t szSizeo
 	pstList->szPayloadOffset = szPayloadOffset;
 	pstList->pstHead = NULL;
 	pstList->pstLast = NULL;
+	stdlib_node_pool_construct_movable(&pstList->stPool, szWrappedSizeof);
 }
 
 /**
@@ -106,6 +185,7 @@ bool stdlib_forward_list_destruct(std_container_t* pstContainer)
 	}
 
 	stdlib_forward_list_pop_front(pstContainer, NULL, pstContainer->szNumItems);
+	stdlib_node_pool_destruct(&CONTAINER_TO_FORWARD_LIST(pstContainer)->stPool, pstContainer);
 
 	return true;
 }
@@ -126,10 +206,12 @@ size_t stdlib_forward_list_push_front(std_container_t* pstContainer, const std_l
 	void* pvItem;
 	size_t i;
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -159,10 +241,12 @@ size_t stdlib_forward_list_push_back(std_container_t* pstContainer, const std_li
 	void* pvItem;
 	size_t i;
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -219,7 +303,7 @@ size_t stdlib_forward_list_pop_front(std_container_t* pstContainer, void* pvResu
 		}
 		pvItem = STD_LINEAR_ADD(pstNode, pstList->szPayloadOffset);
 		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
-		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstNode);
+		stdlib_node_pool_free(&pstList->stPool, pstNode);
 		pstContainer->szNumItems--;
 		if (pvResult != NULL)
 		{
@@ -230,6 +314,249 @@ size_t stdlib_forward_list_pop_front(std_container_t* pstContainer, void* pvResu
 	return i;
 }
 
+/**
+ * Sort a range of items within a forward list (stably, by relinking the nodes in place)
+ *
+ * @param[in]	pstContainer	Forward list to sort
+ * @param[in]	szFirst			Index of first element in range to sort
+ * @param[in]	szLast			Index of last  element in range to sort
+ * @param[in]	pfnCompare		Comparison function to use when sorting
+ */
+void stdlib_forward_list_ranged_sort(std_container_t* pstContainer, size_t szFirst, size_t szLast, pfn_std_compare_t pfnCompare)
+{
+	std_forward_list_t* pstList = CONTAINER_TO_FORWARD_LIST(pstContainer);
+	std_forward_list_node_t* pstBefore = NULL;
+	std_forward_list_node_t* pstAfter;
+	std_forward_list_node_t* pstFirst;
+	std_forward_list_node_t* pstLast;
+	size_t i;
+
+	if (szLast >= pstContainer->szNumItems)
+	{
+		szLast = pstContainer->szNumItems - 1U;
+	}
+	if ((pstContainer->szNumItems < 2U) || (szFirst >= szLast))
+	{
+		return;
+	}
+
+	// Detach the range from the rest of the forward list
+	pstFirst = pstList->pstHead;
+	for (i = 0; i < szFirst; i++)
+	{
+		pstBefore = pstFirst;
+		pstFirst = pstFirst->pstNext;
+	}
+	for (pstLast = pstFirst; i < szLast; i++)
+	{
+		pstLast = pstLast->pstNext;
+	}
+	pstAfter = pstLast->pstNext;
+	pstLast->pstNext = NULL;
+
+	pstFirst = node_sort(pstList, pstFirst, pfnCompare);
+
+	// Reattach the sorted range
+	if (pstBefore == NULL)
+	{
+		pstList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstBefore->pstNext = pstFirst;
+	}
+	for (pstLast = pstFirst; pstLast->pstNext != NULL; pstLast = pstLast->pstNext) { }
+	pstLast->pstNext = pstAfter;
+	if (pstAfter == NULL)
+	{
+		pstList->pstLast = pstLast;
+	}
+}
+
+/**
+ * Move a range of items from one forward list onto the back of another forward list (by relinking their nodes)
+ *
+ * Note: the relinking is O(1), but the range's nodes are found by walking from the front, which is O(n)
+ *
+ * @param[in]	pstContainer	Destination forward list
+ * @param[in]	pstSource		Source forward list
+ * @param[in]	szFirst			Index of first item in source range
+ * @param[in]	szLast			Index of last  item in source range
+ *
+ * @return Number of items moved
+ */
+size_t stdlib_forward_list_splice(std_container_t* pstContainer, std_container_t* pstSource, size_t szFirst, size_t szLast)
+{
+	std_forward_list_t* pstList = CONTAINER_TO_FORWARD_LIST(pstContainer);
+	std_forward_list_t* pstSourceList = CONTAINER_TO_FORWARD_LIST(pstSource);
+	std_forward_list_node_t* pstBefore = NULL;
+	std_forward_list_node_t* pstFirst;
+	std_forward_list_node_t* pstLast;
+	size_t szNumItems;
+	size_t i;
+
+	if (szLast >= pstSource->szNumItems)
+	{
+		szLast = pstSource->szNumItems - 1U;
+	}
+	if (	(pstSource->szNumItems == 0U)
+		||	(szFirst > szLast)
+		||	(stdlib_node_pool_lend(&pstSourceList->stPool, pstSource, &pstList->stPool, pstContainer) == false)	)
+	{
+		return 0;
+	}
+
+	// Find the range (a range that runs to the end of the list needs no walking to find its last node)
+	pstFirst = pstSourceList->pstHead;
+	for (i = 0; i < szFirst; i++)
+	{
+		pstBefore = pstFirst;
+		pstFirst = pstFirst->pstNext;
+	}
+	if (szLast == pstSource->szNumItems - 1U)
+	{
+		pstLast = pstSourceList->pstLast;
+	}
+	else
+	{
+		for (pstLast = pstFirst; i < szLast; i++)
+		{
+			pstLast = pstLast->pstNext;
+		}
+	}
+
+	// Detach the range from the source forward list
+	if (pstBefore == NULL)
+	{
+		pstSourceList->pstHead = pstLast->pstNext;
+	}
+	else
+	{
+		pstBefore->pstNext = pstLast->pstNext;
+	}
+	if (pstLast->pstNext == NULL)
+	{
+		pstSourceList->pstLast = pstBefore;
+	}
+	szNumItems = szLast + 1U - szFirst;
+	pstSource->szNumItems -= szNumItems;
+
+	// ...and attach it to the back of the destination forward list
+	if (pstList->pstHead == NULL)
+	{
+		pstList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstList->pstLast->pstNext = pstFirst;
+	}
+	pstLast->pstNext = NULL;
+	pstList->pstLast = pstLast;
+	pstContainer->szNumItems += szNumItems;
+
+	return szNumItems;
+}
+
+/**
+ * Merge a sorted forward list into another sorted forward list (by relinking their nodes)
+ *
+ * @param[in]	pstContainer	Destination forward list
+ * @param[in]	pstSource		Source forward list (left empty afterwards)
+ * @param[in]	pfnCompare		Comparison function
+ *
+ * @return True if the forward lists were merged, else false
+ */
+bool stdlib_forward_list_merge(std_container_t* pstContainer, std_container_t* pstSource, pfn_std_compare_t pfnCompare)
+{
+	std_forward_list_t* pstList = CONTAINER_TO_FORWARD_LIST(pstContainer);
+	std_forward_list_t* pstSourceList = CONTAINER_TO_FORWARD_LIST(pstSource);
+
+	if ((pstContainer == pstSource) || (pstSource->szNumItems == 0U))
+	{
+		return true;
+	}
+	if (stdlib_node_pool_lend(&pstSourceList->stPool, pstSource, &pstList->stPool, pstContainer) == false)
+	{
+		return false;
+	}
+
+	// Whichever run's final node sorts later ends up as the final node of the merged list
+	if (	(pstList->pstHead == NULL)
+		||	((*pfnCompare)(STD_LINEAR_ADD(pstList->pstLast, pstList->szPayloadOffset), STD_LINEAR_ADD(pstSourceList->pstLast, pstList->szPayloadOffset)) <= 0)	)
+	{
+		pstList->pstLast = pstSourceList->pstLast;
+	}
+	pstList->pstHead = node_merge(pstList, pstList->pstHead, pstSourceList->pstHead, pfnCompare);
+	pstContainer->szNumItems += pstSource->szNumItems;
+
+	pstSourceList->pstHead = pstSourceList->pstLast = NULL;
+	pstSource->szNumItems = 0;
+
+	return true;
+}
+
+/**
+ * Split a forward list at an iterator, moving the current item and all the
+ * items after it onto the back of another forward list (by relinking their nodes)
+ *
+ * @param[in]	pstIterator		Forward list iterator
+ * @param[in]	pstDestination	Destination forward list
+ *
+ * @return Number of items moved
+ */
+size_t stdlib_forward_list_split(std_iterator_t* pstIterator, std_container_t* pstDestination)
+{
+	std_container_t* pstContainer = pstIterator->pstContainer;
+	std_forward_list_t* pstList = CONTAINER_TO_FORWARD_LIST(pstContainer);
+	std_forward_list_t* pstDestList = CONTAINER_TO_FORWARD_LIST(pstDestination);
+	std_forward_list_iterator_t* pstIt = ITERATOR_TO_FORWARDLISTIT(pstIterator);
+	std_forward_list_node_t* pstFirst = pstIt->pstNode;
+	std_forward_list_node_t* pstNode;
+	size_t szNumItems = 0;
+
+	if (	(pstIterator->bDone)
+		||	(pstFirst == NULL)
+		||	(pstContainer == pstDestination)
+		||	(stdlib_node_pool_lend(&pstList->stPool, pstContainer, &pstDestList->stPool, pstDestination) == false)	)
+	{
+		return 0;
+	}
+
+	for (pstNode = pstFirst; pstNode != NULL; pstNode = pstNode->pstNext)
+	{
+		szNumItems++;
+	}
+
+	// Detach the tail of the forward list...
+	if (pstIt->pstPrev == NULL)
+	{
+		pstList->pstHead = NULL;
+	}
+	else
+	{
+		pstIt->pstPrev->pstNext = NULL;
+	}
+	pstNode = pstList->pstLast;
+	pstList->pstLast = pstIt->pstPrev;
+	pstContainer->szNumItems -= szNumItems;
+
+	// ...and attach it to the back of the destination forward list
+	if (pstDestList->pstHead == NULL)
+	{
+		pstDestList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstDestList->pstLast->pstNext = pstFirst;
+	}
+	pstDestList->pstLast = pstNode;
+	pstDestination->szNumItems += szNumItems;
+
+	pstIterator->bDone = true;
+
+	return szNumItems;
+}
+
 /**
  * Set up a forward list iterator to step forwards through a forward list
  *
@@ -283,10 +610,12 @@ size_t stdlib_forward_list_push_after(std_iterator_t* pstIterator, const std_lin
 
 	pstItNode = STD_LINEAR_SUB(pstIterator->pvRef, pstList->szPayloadOffset);
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -321,10 +650,12 @@ size_t stdlib_forward_list_push_before(std_iterator_t* pstIterator, const std_li
 
 	pstItNode = pstIt->pstPrev;
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -365,8 +696,15 @@ void stdlib_forward_list_pop_at(std_iterator_t* pstIterator, void * pvResult)
 		pstIt->pstPrev->pstNext = pstIterator->pvNext;
 	}
 
+	// If this is the final item in the forward list
+	if (pstIterator->pvNext == NULL)
+	{
+		pstList->pstLast = pstIt->pstPrev;
+	}
+
 	pvItem = STD_LINEAR_ADD(pstIt->pstNode, pstList->szPayloadOffset);
 	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
+	stdlib_node_pool_free(&pstList->stPool, pstIt->pstNode);
 	pstIt->pstNode = NULL;
 	pstContainer->szNumItems--;
 }
@@ -0,0 +1,478 @@
+/*
+ * src/std_graph.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>		// for memset
+
+#include "std/graph.h"
+
+#define CONTAINER_TO_GRAPH(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_graph_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the address of an edge in an array of edges
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	pvBase			Start of the array of edges
+ * @param[in]	szIndex			Index of the edge
+ *
+ * @return Address of the edge
+ */
+static void * edge_at(const std_container_t * pstContainer, const void * pvBase, size_t szIndex)
+{
+	return STD_LINEAR_ADD(pvBase, szIndex * pstContainer->szSizeofItem);
+}
+
+/**
+ * Move a run of edges (possibly overlapping)
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	pvDst			Where to move the edges to
+ * @param[in]	pvSrc			Where to move the edges from
+ * @param[in]	szNumEdges		Number of edges
+ */
+static void edges_move(std_container_t * pstContainer, void * pvDst, const void * pvSrc, size_t szNumEdges)
+{
+	if ((szNumEdges > 0) && (pvDst != pvSrc))
+	{
+		stdlib_container_relocate_items(pstContainer, pvDst, pvSrc, szNumEdges);
+	}
+}
+
+/**
+ * Destruct a run of edges
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	pvEdges			Start of the run of edges
+ * @param[in]	szNumEdges		Number of edges
+ */
+static void edges_destruct(std_container_t * pstContainer, void * pvEdges, size_t szNumEdges)
+{
+	size_t i;
+
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (i = 0; i < szNumEdges; i++)
+		{
+			(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, edge_at(pstContainer, pvEdges, i));
+		}
+	}
+}
+
+/**
+ * Round a capacity up to the next power of two that can hold a number of entries
+ *
+ * @param[in]	szNumAlloced	Current capacity
+ * @param[in]	szNeeded		Number of entries needed
+ *
+ * @return New capacity
+ */
+static size_t grown_capacity(size_t szNumAlloced, size_t szNeeded)
+{
+	size_t szCapacity = (szNumAlloced < 8U) ? 8U : szNumAlloced;
+	while (szCapacity < szNeeded)
+	{
+		szCapacity <<= 1;
+	}
+	return szCapacity;
+}
+
+/**
+ * Grow a graph's vertex arrays (offsets and payloads) to hold a number of vertices
+ *
+ * New vertices have no edges, and their payloads are zeroed.
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	szNumVertices	New number of vertices
+ *
+ * @return True if the vertices were added, false if memory ran out
+ */
+static bool vertices_grow(std_container_t * pstContainer, size_t szNumVertices)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+	size_t szCapacity;
+	size_t * pszOffsets;
+	void * pvVertices;
+	size_t i;
+
+	if (szNumVertices <= pstGraph->szNumVertices)
+	{
+		return true;
+	}
+
+	if (szNumVertices > pstGraph->szVerticesAlloced)
+	{
+		szCapacity = grown_capacity(pstGraph->szVerticesAlloced, szNumVertices);
+
+		pszOffsets = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pszOffsets, (szCapacity + 1U) * sizeof(size_t));
+		if (pszOffsets == NULL)
+		{
+			return false;
+		}
+		if (pstGraph->pszOffsets == NULL)
+		{
+			pszOffsets[0] = 0U;
+		}
+		pstGraph->pszOffsets = pszOffsets;
+
+		if (pstGraph->szSizeofVertex > 0U)
+		{
+			pvVertices = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pvVertices, szCapacity * pstGraph->szSizeofVertex);
+			if (pvVertices == NULL)
+			{
+				return false;
+			}
+			pstGraph->pvVertices = pvVertices;
+		}
+		pstGraph->szVerticesAlloced = szCapacity;
+	}
+
+	// The new vertices' edge spans are all empty (and sit at the end of the edge array)
+	for (i = pstGraph->szNumVertices; i < szNumVertices; i++)
+	{
+		pstGraph->pszOffsets[i + 1U] = pstContainer->szNumItems;
+	}
+	if (pstGraph->szSizeofVertex > 0U)
+	{
+		memset(STD_LINEAR_ADD(pstGraph->pvVertices, pstGraph->szNumVertices * pstGraph->szSizeofVertex), 0, (szNumVertices - pstGraph->szNumVertices) * pstGraph->szSizeofVertex);
+	}
+	pstGraph->szNumVertices = szNumVertices;
+
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a graph container
+ *
+ * @param[in]	pstContainer	Graph to initialise
+ * @param[in]	szSizeof		Size of an edge
+ * @param[in]	szWrappedSizeof	Size of a vertex payload
+ * @param[in]	szPayloadOffset	Offset to the value within an edge
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_graph_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+
+	pstGraph->pszOffsets		= NULL;
+	pstGraph->pvVertices		= NULL;
+	pstGraph->szSizeofVertex	= szWrappedSizeof;
+	pstGraph->szNumVertices		= 0U;
+	pstGraph->szVerticesAlloced	= 0U;
+
+	pstGraph->pszPendingSources	= NULL;
+	pstGraph->pvPendingEdges	= NULL;
+	pstGraph->szNumPending		= 0U;
+	pstGraph->szPendingAlloced	= 0U;
+}
+
+/**
+ * Destruct a graph container
+ *
+ * @param[in]	pstContainer	Graph container to destruct
+ *
+ * @return True if destruction was successful, else false
+ */
+bool stdlib_graph_destruct(std_container_t * pstContainer)
+{
+	std_graph_t * pstGraph;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+
+	edges_destruct(pstContainer, pstGraph->pvPendingEdges, pstGraph->szNumPending);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pvPendingEdges);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pszPendingSources);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pvVertices);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pszOffsets);
+
+	pstGraph->pszOffsets		= NULL;
+	pstGraph->pvVertices		= NULL;
+	pstGraph->szNumVertices		= 0U;
+	pstGraph->szVerticesAlloced	= 0U;
+	pstGraph->pszPendingSources	= NULL;
+	pstGraph->pvPendingEdges	= NULL;
+	pstGraph->szNumPending		= 0U;
+	pstGraph->szPendingAlloced	= 0U;
+
+	// The committed edges are held in a vector
+	return stdlib_vector_destruct(pstContainer);
+}
+
+/**
+ * Add a number of (isolated) vertices to a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	szNumVertices	Number of vertices to add
+ *
+ * @return Index of the first vertex added (or SIZE_MAX if memory ran out)
+ */
+size_t stdlib_graph_add_vertices(std_container_t * pstContainer, size_t szNumVertices)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+	size_t szFirst = pstGraph->szNumVertices;
+
+	if (!vertices_grow(pstContainer, szFirst + szNumVertices))
+	{
+		return SIZE_MAX;
+	}
+	return szFirst;
+}
+
+/**
+ * Add a series of edges to a graph's pending buffer
+ *
+ * The edges don't appear in the graph until it is next committed.
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	pszSources		Source vertex of each edge
+ * @param[in]	pvEdges			Edges (each holding its target vertex and its value)
+ * @param[in]	szNumEdges		Number of edges
+ *
+ * @return True if the edges were added, false if memory ran out
+ */
+bool stdlib_graph_add_edges(std_container_t * pstContainer, const size_t * pszSources, const void * pvEdges, size_t szNumEdges)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+	size_t szNeeded = pstGraph->szNumPending + szNumEdges;
+	size_t szCapacity;
+	size_t * pszSourcesNew;
+	void * pvEdgesNew;
+
+	if (szNeeded > pstGraph->szPendingAlloced)
+	{
+		szCapacity = grown_capacity(pstGraph->szPendingAlloced, szNeeded);
+
+		pszSourcesNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pszPendingSources, szCapacity * sizeof(size_t));
+		if (pszSourcesNew == NULL)
+		{
+			return false;
+		}
+		pstGraph->pszPendingSources = pszSourcesNew;
+
+		pvEdgesNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstGraph->pvPendingEdges, szCapacity * pstContainer->szSizeofItem);
+		if (pvEdgesNew == NULL)
+		{
+			return false;
+		}
+		if (pstContainer->eHas & std_container_has_itemhandler)
+		{
+			stdlib_item_relocate(pstContainer->pstItemHandler, pvEdgesNew, pstGraph->pvPendingEdges, pstGraph->szNumPending * pstContainer->szSizeofItem);
+		}
+		pstGraph->pvPendingEdges = pvEdgesNew;
+		pstGraph->szPendingAlloced = szCapacity;
+	}
+
+	memcpy(&pstGraph->pszPendingSources[pstGraph->szNumPending], pszSources, szNumEdges * sizeof(size_t));
+	memcpy(edge_at(pstContainer, pstGraph->pvPendingEdges, pstGraph->szNumPending), pvEdges, szNumEdges * pstContainer->szSizeofItem);
+	pstGraph->szNumPending = szNeeded;
+
+	return true;
+}
+
+/**
+ * Merge a graph's pending edges into its CSR arrays
+ *
+ * This is a counting sort of the pending edges by source vertex, done in
+ * place: count each vertex's pending edges, prefix-sum the counts to find
+ * how far each vertex's existing span has to shift up, shift the spans
+ * (last vertex first, so nothing is overwritten), then scatter the pending
+ * edges into the gaps opened up at the end of each span.
+ *
+ * @param[in]	pstContainer	Graph container
+ *
+ * @return True if the edges were merged, false if memory ran out (in which case they are still pending)
+ */
+bool stdlib_graph_commit(std_container_t * pstContainer)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+	size_t szNumPending = pstGraph->szNumPending;
+	size_t szNumVertices = pstGraph->szNumVertices;
+	size_t * pszOffsets;
+	size_t * pszCursors;
+	void * pvEdges;
+	void * pvPending;
+	size_t szSource;
+	size_t szTarget;
+	size_t szRunning;
+	size_t szCount;
+	size_t szShift;
+	size_t szNextShift;
+	size_t szStart;
+	size_t szEnd;
+	size_t i;
+
+	if (szNumPending == 0U)
+	{
+		return true;
+	}
+
+	// Every vertex that a pending edge refers to must exist
+	for (i = 0; i < szNumPending; i++)
+	{
+		szSource = pstGraph->pszPendingSources[i];
+		szTarget = ((const size_t *) edge_at(pstContainer, pstGraph->pvPendingEdges, i))[0];
+		if (szSource >= szNumVertices)
+		{
+			szNumVertices = szSource + 1U;
+		}
+		if (szTarget >= szNumVertices)
+		{
+			szNumVertices = szTarget + 1U;
+		}
+	}
+	if (	!vertices_grow(pstContainer, szNumVertices)
+		||	!stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + szNumPending)	)
+	{
+		return false;
+	}
+
+	pszCursors = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, szNumVertices * sizeof(size_t));
+	if (pszCursors == NULL)
+	{
+		return false;
+	}
+
+	// Histogram: count each vertex's pending edges...
+	memset(pszCursors, 0, szNumVertices * sizeof(size_t));
+	for (i = 0; i < szNumPending; i++)
+	{
+		pszCursors[pstGraph->pszPendingSources[i]]++;
+	}
+
+	// ...prefix sum: turn the counts into the number of pending edges belonging to earlier vertices...
+	szRunning = 0U;
+	for (i = 0; i < szNumVertices; i++)
+	{
+		szCount = pszCursors[i];
+		pszCursors[i] = szRunning;
+		szRunning += szCount;
+	}
+
+	// ...shift each existing span up by that much (last first), leaving each cursor at its span's gap...
+	pszOffsets = pstGraph->pszOffsets;
+	pvEdges = pstGraph->pvStartAddr;
+	szNextShift = szRunning;
+	for (i = szNumVertices; i-- > 0U; )
+	{
+		szShift = pszCursors[i];
+		szStart = pszOffsets[i];
+		szEnd = pszOffsets[i + 1U];
+		edges_move(pstContainer, edge_at(pstContainer, pvEdges, szStart + szShift), edge_at(pstContainer, pvEdges, szStart), szEnd - szStart);
+		pszOffsets[i + 1U] = szEnd + szNextShift;
+		pszCursors[i] = szEnd + szShift;
+		szNextShift = szShift;
+	}
+
+	// ...and scatter the pending edges into the gaps (in the order they were added)
+	pvPending = pstGraph->pvPendingEdges;
+	for (i = 0; i < szNumPending; i++)
+	{
+		szSource = pstGraph->pszPendingSources[i];
+		edges_move(pstContainer, edge_at(pstContainer, pvEdges, pszCursors[szSource]++), edge_at(pstContainer, pvPending, i), 1U);
+	}
+
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pszCursors);
+	pstContainer->szNumItems += szNumPending;
+	pstGraph->szNumPending = 0U;
+
+	return true;
+}
+
+/**
+ * Find a vertex's payload in a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	szVertex		Vertex index
+ *
+ * @return Pointer to the vertex's payload (or NULL if there is no such vertex)
+ */
+void * stdlib_graph_vertex(std_container_t * pstContainer, size_t szVertex)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+
+	if (szVertex >= pstGraph->szNumVertices)
+	{
+		return NULL;
+	}
+	return STD_LINEAR_ADD(pstGraph->pvVertices, szVertex * pstGraph->szSizeofVertex);
+}
+
+/**
+ * Find the span of (committed) edges leading out of a vertex in a graph
+ *
+ * @param[in]	pstContainer	Graph container
+ * @param[in]	szVertex		Vertex index
+ * @param[out]	pszNumEdges		Number of edges in the span (can be NULL)
+ *
+ * @return Pointer to the vertex's first edge (or NULL if it has none)
+ */
+void * stdlib_graph_neighbours(std_container_t * pstContainer, size_t szVertex, size_t * pszNumEdges)
+{
+	std_graph_t * pstGraph = CONTAINER_TO_GRAPH(pstContainer);
+	size_t szNumEdges = 0U;
+	void * pvEdges = NULL;
+
+	if (szVertex < pstGraph->szNumVertices)
+	{
+		szNumEdges = pstGraph->pszOffsets[szVertex + 1U] - pstGraph->pszOffsets[szVertex];
+		if (szNumEdges > 0U)
+		{
+			pvEdges = edge_at(pstContainer, pstGraph->pvStartAddr, pstGraph->pszOffsets[szVertex]);
+		}
+	}
+	if (pszNumEdges != NULL)
+	{
+		*pszNumEdges = szNumEdges;
+	}
+	return pvEdges;
+}
+
+// -------------------------------------------------------------------------
+
+static bool graph_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_graph_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_graph_default_itemhandler =
+{
+	.szElementSize = sizeof(std_graph_t),
+	.pfn_Destructor = &graph_default_destruct,
+	.pfn_Relocator = NULL
+};
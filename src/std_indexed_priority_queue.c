@@ -0,0 +1,565 @@
+/*
+ * src/std_indexed_priority_queue.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The indexed priority queue is a 4-ary heap held in a vector (see
+ * std_priority_queue.c), where every move of an item from one heap slot to
+ * another also updates the two arrays that map between heap indices and
+ * handles. A handle is a slot number (in its low half) and that slot's
+ * generation (in its high half): the heap-to-handle array holds whole
+ * handles, so a handle is only live if its slot's heap index maps back to
+ * exactly the same handle. Like a slot map's, a slot's generation is bumped
+ * whenever its item is pushed or removed (so live handles have odd
+ * generations). Free slots are chained together through the handle-to-heap
+ * array, each entry holding the next free slot and the slot's generation, so
+ * that slots can be reused without any extra memory.
+ *
+ * Every item that is pushed reserves one extra slot just past the end of the
+ * heap, which is where an item is parked while it is being sifted down.
+ */
+
+#include "std/indexed_priority_queue.h"
+
+#define CONTAINER_TO_INDEXED_PRIORITYQUEUE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_indexed_priorityqueue_t, stContainer)
+
+#define HEAP_FANOUT_SHIFT	2U
+
+// Each handle holds its slot in its low bits, and the slot's generation in the rest
+#define HANDLE_SLOT_BITS			(STD_INDEXED_PRIORITYQUEUE_SLOT_BITS)
+#define HANDLE_SLOT_MASK			(((size_t) 1U << HANDLE_SLOT_BITS) - 1U)	// (Also marks the end of the free slot chain)
+#define HANDLE_SLOT(HANDLE)			((HANDLE) & HANDLE_SLOT_MASK)
+#define HANDLE_GENERATION(HANDLE)	((HANDLE) >> HANDLE_SLOT_BITS)
+#define HANDLE_MAKE(SLOT,GEN)		(((size_t)(GEN) << HANDLE_SLOT_BITS) | (SLOT))
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find out whether one item should sit above another item in the heap
+ *
+ * @param[in]	pstPriorityQueue	Indexed priority queue
+ * @param[in]	pvA					First item
+ * @param[in]	pvB					Second item
+ *
+ * @return True if the first item ranks strictly later than the second
+ */
+static bool heap_is_better(const std_indexed_priorityqueue_t * pstPriorityQueue, const void * pvA, const void * pvB)
+{
+	return ((*pstPriorityQueue->pfnCompare)(pvA, pvB) > 0);
+}
+
+/**
+ * Store a handle's heap index (and the heap index's handle)
+ *
+ * @param[in]	pstPriorityQueue	Indexed priority queue
+ * @param[in]	szIndex				Heap index
+ * @param[in]	szHandle			Handle
+ */
+static void heap_link(std_indexed_priorityqueue_t * pstPriorityQueue, size_t szIndex, size_t szHandle)
+{
+	pstPriorityQueue->pszHeapToHandle[szIndex] = szHandle;
+	pstPriorityQueue->pszHandleToHeap[HANDLE_SLOT(szHandle)] = szIndex;
+}
+
+/**
+ * Move an item from one heap slot to another (empty) heap slot
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szTo			Index of destination slot
+ * @param[in]	szFrom			Index of source slot
+ */
+static void heap_move(std_container_t * pstContainer, size_t szTo, size_t szFrom)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szTo), stdlib_vector_at(pstContainer, szFrom), 1U);
+	heap_link(pstPriorityQueue, szTo, pstPriorityQueue->pszHeapToHandle[szFrom]);
+}
+
+/**
+ * Move an item up through the heap (from an empty slot) and store it
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHole			Index of empty slot
+ * @param[in]	pvItem			Item (either outside the heap or parked just past its end)
+ * @param[in]	szHandle		Handle of the item
+ */
+static void heap_sift_up(std_container_t * pstContainer, size_t szHole, const void * pvItem, size_t szHandle)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szParent;
+
+	while (szHole != 0U)
+	{
+		szParent = (szHole - 1U) >> HEAP_FANOUT_SHIFT;
+		if (!heap_is_better(pstPriorityQueue, pvItem, stdlib_vector_at(pstContainer, szParent)))
+		{
+			break;
+		}
+		heap_move(pstContainer, szHole, szParent);
+		szHole = szParent;
+	}
+
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szHole), pvItem, 1U);
+	heap_link(pstPriorityQueue, szHole, szHandle);
+}
+
+/**
+ * Move the item parked just past the end of the heap down into the heap (starting at an empty slot)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHole			Index of empty slot
+ */
+static void heap_sift_down(std_container_t * pstContainer, size_t szHole)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szNumItems = pstContainer->szNumItems;
+	size_t szParked = szNumItems;
+	void * pvParked = stdlib_vector_at(pstContainer, szParked);
+	size_t szBest;
+	size_t szIndex;
+	size_t szLast;
+
+	for (;;)
+	{
+		szIndex = (szHole << HEAP_FANOUT_SHIFT) + 1U;
+		if (szIndex >= szNumItems)
+		{
+			break;
+		}
+		szLast = szIndex + (1U << HEAP_FANOUT_SHIFT);
+		if (szLast > szNumItems)
+		{
+			szLast = szNumItems;
+		}
+
+		szBest = szIndex;
+		for (szIndex++; szIndex < szLast; szIndex++)
+		{
+			if (heap_is_better(pstPriorityQueue, stdlib_vector_at(pstContainer, szIndex), stdlib_vector_at(pstContainer, szBest)))
+			{
+				szBest = szIndex;
+			}
+		}
+
+		// Stop once the parked item is at least as good as all of them
+		if (!heap_is_better(pstPriorityQueue, stdlib_vector_at(pstContainer, szBest), pvParked))
+		{
+			break;
+		}
+		heap_move(pstContainer, szHole, szBest);
+		szHole = szBest;
+	}
+
+	heap_move(pstContainer, szHole, szParked);
+}
+
+/**
+ * Put the item parked just past the end of the heap into an empty heap slot, moving it up or down as needed
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHole			Index of empty slot
+ */
+static void heap_fix(std_container_t * pstContainer, size_t szHole)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szParked = pstContainer->szNumItems;
+	void * pvParked = stdlib_vector_at(pstContainer, szParked);
+
+	if (	(szHole != 0U)
+		&&	heap_is_better(pstPriorityQueue, pvParked, stdlib_vector_at(pstContainer, (szHole - 1U) >> HEAP_FANOUT_SHIFT))	)
+	{
+		heap_sift_up(pstContainer, szHole, pvParked, pstPriorityQueue->pszHeapToHandle[szParked]);
+	}
+	else
+	{
+		heap_sift_down(pstContainer, szHole);
+	}
+}
+
+/**
+ * Find the heap index of a handle's item
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHandle		Handle
+ *
+ * @return Heap index (or STD_INDEXED_PRIORITYQUEUE_NO_HANDLE if the handle isn't live)
+ */
+static size_t handle_to_index(std_container_t * pstContainer, size_t szHandle)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szSlot = HANDLE_SLOT(szHandle);
+	size_t szIndex;
+
+	// A free slot's entry holds the next free slot, and a reused slot has moved on a generation,
+	// so check that the slot maps back to exactly this handle
+	if (szSlot < pstPriorityQueue->szNumSlots)
+	{
+		szIndex = pstPriorityQueue->pszHandleToHeap[szSlot];
+		if (	(szIndex < pstContainer->szNumItems)
+			&&	(pstPriorityQueue->pszHeapToHandle[szIndex] == szHandle)	)
+		{
+			return szIndex;
+		}
+	}
+	return STD_INDEXED_PRIORITYQUEUE_NO_HANDLE;
+}
+
+/**
+ * Allocate a handle (reusing a free slot if there is one)
+ *
+ * @param[in]	pstPriorityQueue	Indexed priority queue
+ *
+ * @return Handle (or STD_INDEXED_PRIORITYQUEUE_NO_HANDLE if every slot is in use)
+ */
+static size_t handle_alloc(std_indexed_priorityqueue_t * pstPriorityQueue)
+{
+	size_t szSlot = pstPriorityQueue->szFreeSlot;
+	size_t szFree;
+
+	if (szSlot == HANDLE_SLOT_MASK)
+	{
+		if (pstPriorityQueue->szNumSlots == HANDLE_SLOT_MASK)
+		{
+			return STD_INDEXED_PRIORITYQUEUE_NO_HANDLE;
+		}
+		return HANDLE_MAKE(pstPriorityQueue->szNumSlots++, 1U);
+	}
+	szFree = pstPriorityQueue->pszHandleToHeap[szSlot];
+	pstPriorityQueue->szFreeSlot = HANDLE_SLOT(szFree);
+	return HANDLE_MAKE(szSlot, HANDLE_GENERATION(szFree) + 1U);
+}
+
+/**
+ * Free a handle (moving its slot on a generation)
+ *
+ * @param[in]	pstPriorityQueue	Indexed priority queue
+ * @param[in]	szHandle			Handle
+ */
+static void handle_free(std_indexed_priorityqueue_t * pstPriorityQueue, size_t szHandle)
+{
+	pstPriorityQueue->pszHandleToHeap[HANDLE_SLOT(szHandle)] = HANDLE_MAKE(pstPriorityQueue->szFreeSlot, HANDLE_GENERATION(szHandle) + 1U);
+	pstPriorityQueue->szFreeSlot = HANDLE_SLOT(szHandle);
+}
+
+/**
+ * Remove the item at a heap index (freeing its handle)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[out]	pvResult		Where to pop the item to (or NULL to erase it)
+ * @param[in]	szIndex			Heap index
+ */
+static void heap_remove(std_container_t * pstContainer, void * pvResult, size_t szIndex)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, stdlib_vector_at(pstContainer, szIndex), pstContainer->szSizeofItem);
+	handle_free(pstPriorityQueue, pstPriorityQueue->pszHeapToHandle[szIndex]);
+
+	// Unless the item was the final item in the heap, refill its slot with the final item
+	if (--pstContainer->szNumItems != szIndex)
+	{
+		heap_fix(pstContainer, szIndex);
+	}
+}
+
+/**
+ * Make room for an item to be pushed, plus a slot to park items in
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ *
+ * @return True if there is room, else false
+ */
+static bool heap_make_room(std_container_t * pstContainer)
+{
+	return	(CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer)->pfnCompare != NULL)
+		&&	stdlib_indexed_priorityqueue_reserve(pstContainer, pstContainer->szNumItems + 2U);
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct an indexed priority queue container
+ *
+ * @param[in]	pstContainer	Indexed priority queue to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the payload within the wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_indexed_priorityqueue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	pstPriorityQueue->pfnCompare		= NULL;
+	pstPriorityQueue->pszHeapToHandle	= NULL;
+	pstPriorityQueue->pszHandleToHeap	= NULL;
+	pstPriorityQueue->szNumIndexAlloced	= 0;
+	pstPriorityQueue->szNumSlots		= 0;
+	pstPriorityQueue->szFreeSlot		= HANDLE_SLOT_MASK;
+}
+
+/**
+ * Destruct an indexed priority queue container
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ *
+ * @return True if destruction was successful, else false
+ */
+bool stdlib_indexed_priorityqueue_destruct(std_container_t * pstContainer)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+
+	if (!stdlib_vector_destruct(pstContainer))
+	{
+		return false;
+	}
+
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPriorityQueue->pszHeapToHandle);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPriorityQueue->pszHandleToHeap);
+	pstPriorityQueue->pszHeapToHandle	= NULL;
+	pstPriorityQueue->pszHandleToHeap	= NULL;
+	pstPriorityQueue->szNumIndexAlloced	= 0;
+	pstPriorityQueue->szNumSlots		= 0;
+	pstPriorityQueue->szFreeSlot		= HANDLE_SLOT_MASK;
+	return true;
+}
+
+/**
+ * Reserve space within an indexed priority queue container for a number of items
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_indexed_priorityqueue_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szNumAlloced;
+	size_t * pszNew;
+
+	if (!stdlib_vector_reserve(pstContainer, szNewSize))
+	{
+		return false;
+	}
+
+	// There can never be more live handles than heap slots, so both arrays simply track the vector's capacity
+	szNumAlloced = pstPriorityQueue->szNumAlloced;
+	if (szNumAlloced > pstPriorityQueue->szNumIndexAlloced)
+	{
+		pszNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPriorityQueue->pszHeapToHandle, szNumAlloced * sizeof(size_t));
+		if (pszNew == NULL)
+		{
+			return false;
+		}
+		pstPriorityQueue->pszHeapToHandle = pszNew;
+
+		pszNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPriorityQueue->pszHandleToHeap, szNumAlloced * sizeof(size_t));
+		if (pszNew == NULL)
+		{
+			return false;
+		}
+		pstPriorityQueue->pszHandleToHeap = pszNew;
+		pstPriorityQueue->szNumIndexAlloced = szNumAlloced;
+	}
+
+	return true;
+}
+
+/**
+ * Set the comparison function that an indexed priority queue orders its items by
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_indexed_priorityqueue_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Push an item into an indexed priority queue container
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	pvItem			Item to push
+ *
+ * @return Handle of the item (or STD_INDEXED_PRIORITYQUEUE_NO_HANDLE if it couldn't be pushed)
+ */
+size_t stdlib_indexed_priorityqueue_push_handle(std_container_t * pstContainer, const void * pvItem)
+{
+	size_t szHandle;
+
+	if (!heap_make_room(pstContainer))
+	{
+		return STD_INDEXED_PRIORITYQUEUE_NO_HANDLE;
+	}
+
+	szHandle = handle_alloc(CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer));
+	if (szHandle == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE)
+	{
+		return STD_INDEXED_PRIORITYQUEUE_NO_HANDLE;
+	}
+	heap_sift_up(pstContainer, pstContainer->szNumItems, pvItem, szHandle);
+	pstContainer->szNumItems++;
+	return szHandle;
+}
+
+/**
+ * Push a series of items into an indexed priority queue container (without returning their handles)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (zero if no comparison function has been set)
+ */
+size_t stdlib_indexed_priorityqueue_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t i;
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		if (stdlib_indexed_priorityqueue_push_handle(pstContainer, stIt.pvData) == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE)
+		{
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * Pop the last-ranked items off an indexed priority queue (freeing their handles)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_indexed_priorityqueue_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		heap_remove(pstContainer, pvResult, 0U);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+/**
+ * Find the item that a handle refers to
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHandle		Handle
+ *
+ * @return Pointer to the item (or NULL if the handle isn't live)
+ */
+void * stdlib_indexed_priorityqueue_handle_at(std_container_t * pstContainer, size_t szHandle)
+{
+	size_t szIndex = handle_to_index(pstContainer, szHandle);
+
+	return (szIndex == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE) ? NULL : stdlib_vector_at(pstContainer, szIndex);
+}
+
+/**
+ * Replace the item that a handle refers to, then move it up or down the heap as needed
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHandle		Handle
+ * @param[in]	pvItem			Replacement item
+ *
+ * @return True if the item was replaced, false if the handle isn't live
+ */
+bool stdlib_indexed_priorityqueue_update(std_container_t * pstContainer, size_t szHandle, const void * pvItem)
+{
+	std_indexed_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_INDEXED_PRIORITYQUEUE(pstContainer);
+	size_t szIndex = handle_to_index(pstContainer, szHandle);
+	size_t szParked = pstContainer->szNumItems;
+
+	if (szIndex == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE)
+	{
+		return false;
+	}
+
+	// Destroy the old item, then park the replacement and let it find its place starting from the old item's slot
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, NULL, stdlib_vector_at(pstContainer, szIndex), pstContainer->szSizeofItem);
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szParked), pvItem, 1U);
+	pstPriorityQueue->pszHeapToHandle[szParked] = szHandle;
+	heap_fix(pstContainer, szIndex);
+	return true;
+}
+
+/**
+ * Erase the item that a handle refers to (freeing the handle)
+ *
+ * @param[in]	pstContainer	Indexed priority queue container
+ * @param[in]	szHandle		Handle
+ *
+ * @return True if the item was erased, false if the handle isn't live
+ */
+bool stdlib_indexed_priorityqueue_erase(std_container_t * pstContainer, size_t szHandle)
+{
+	size_t szIndex = handle_to_index(pstContainer, szHandle);
+
+	if (szIndex == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE)
+	{
+		return false;
+	}
+
+	heap_remove(pstContainer, NULL, szIndex);
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+static bool indexed_priorityqueue_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_indexed_priorityqueue_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_indexed_priorityqueue_default_itemhandler =
+{
+	.szElementSize = sizeof(std_indexed_priorityqueue_t),
+	.pfn_Destructor = &indexed_priorityqueue_default_destruct,
+	.pfn_Relocator = NULL
+};
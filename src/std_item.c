@@ -51,7 +51,7 @@ void stdlib_item_pop(std_container_has_t eHas, const std_item_handler_t* pstItem
 	{
 		if (eHas & std_container_has_itemhandler)
 		{
-			stdlib_item_destruct(pstItemHandler, pvItem, szSizeof);
+			stdlib_item_destruct(pstItemHandler, pvItem, 1U);
 		}
 	}
 }
@@ -127,6 +127,137 @@ static void node_push_before(std_list_t * pstList, std_list_node_t * pstPosition
 	pstList->stContainer.szNumItems++;
 }
 
+/**
+ * Merge two sorted (NULL-terminated, forward-linked) runs of nodes into one
+ *
+ * @param[in]	pstList		List that the nodes belong to
+ * @param[in]	pstA		First run (all of whose nodes came before the second run)
+ * @param[in]	pstB		Second run
+ * @param[in]	pfnCompare	Comparison function
+ *
+ * @return First node of the merged run
+ */
+static std_list_node_t * node_merge(std_list_t * pstList, std_list_node_t * pstA, std_list_node_t * pstB, pfn_std_compare_t pfnCompare)
+{
+	std_list_node_t * pstHead = NULL;
+	std_list_node_t ** ppstLink = &pstHead;
+
+	while ((pstA != NULL) && (pstB != NULL))
+	{
+		// Only take from the second run if strictly less, so that the sort is stable
+		if ((*pfnCompare)(STD_LINEAR_ADD(pstA, pstList->szPayloadOffset), STD_LINEAR_ADD(pstB, pstList->szPayloadOffset)) > 0)
+		{
+			*ppstLink = pstB;
+			pstB = pstB->pstNext;
+		}
+		else
+		{
+			*ppstLink = pstA;
+			pstA = pstA->pstNext;
+		}
+		ppstLink = &(*ppstLink)->pstNext;
+	}
+	*ppstLink = (pstA != NULL) ? pstA : pstB;
+
+	return pstHead;
+}
+
+/**
+ * Stable bottom-up merge sort a (NULL-terminated, forward-linked) run of nodes
+ *
+ * @param[in]	pstList		List that the nodes belong to
+ * @param[in]	pstNode		First node of the run
+ * @param[in]	pfnCompare	Comparison function
+ *
+ * @return First node of the sorted run
+ */
+static std_list_node_t * node_sort(std_list_t * pstList, std_list_node_t * pstNode, pfn_std_compare_t pfnCompare)
+{
+	std_list_node_t * apstBins[64] = { NULL };		// apstBins[k] is either empty or a sorted run of 2^k nodes
+	std_list_node_t * pstCarry;
+	std_list_node_t * pstNext;
+	size_t k;
+
+	for (; pstNode != NULL; pstNode = pstNext)
+	{
+		pstNext = pstNode->pstNext;
+		pstNode->pstNext = NULL;
+
+		// Add a single-node run, merging equal-sized runs together like a binary counter
+		pstCarry = pstNode;
+		for (k = 0; apstBins[k] != NULL; k++)
+		{
+			pstCarry = node_merge(pstList, apstBins[k], pstCarry, pfnCompare);
+			apstBins[k] = NULL;
+		}
+		apstBins[k] = pstCarry;
+	}
+
+	// Higher bins hold earlier nodes, so merge them in front of the lower ones
+	pstCarry = NULL;
+	for (k = 0; k < STD_NUM_ELEMENTS(apstBins); k++)
+	{
+		if (apstBins[k] != NULL)
+		{
+			pstCarry = node_merge(pstList, apstBins[k], pstCarry, pfnCompare);
+		}
+	}
+
+	return pstCarry;
+}
+
+/**
+ * Find the node at a given index within a list
+ *
+ * @param[in]	pstList		List
+ * @param[in]	szIndex		Index (must be less than the number of items)
+ *
+ * @return Node at that index
+ */
+static std_list_node_t * node_at(std_list_t * pstList, size_t szIndex)
+{
+	std_list_node_t * pstNode;
+	size_t szNumItems = pstList->stContainer.szNumItems;
+
+	// Walk in from whichever end is nearer
+	if (szIndex < szNumItems / 2U)
+	{
+		for (pstNode = pstList->pstHead; szIndex--; pstNode = pstNode->pstNext) { }
+	}
+	else
+	{
+		for (pstNode = pstList->pstTail, szIndex = szNumItems - 1U - szIndex; szIndex--; pstNode = pstNode->pstPrev) { }
+	}
+	return pstNode;
+}
+
+/**
+ * Link a (forward-linked) chain of nodes onto the back of a list, rebuilding its backward links
+ *
+ * @param[in]	pstList		List
+ * @param[in]	pstFirst	First node in chain
+ */
+static void node_chain_append(std_list_t * pstList, std_list_node_t * pstFirst)
+{
+	std_list_node_t * pstPrev = pstList->pstTail;
+	std_list_node_t * pstNode;
+
+	if (pstPrev == NULL)
+	{
+		pstList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstPrev->pstNext = pstFirst;
+	}
+	for (pstNode = pstFirst; pstNode != NULL; pstNode = pstNode->pstNext)
+	{
+		pstNode->pstPrev = pstPrev;
+		pstPrev = pstNode;
+	}
+	pstList->pstTail = pstPrev;
+}
+
 // --------------------------------------------------------------------------
 // Public functions
 // --------------------------------------------------------------------------
@@ -148,6 +279,7 @@ void stdlib_list_construct(std_container_t* pstContainer, size_t szSizeof, size_
 	pstList->szPayloadOffset	= szPayloadOffset;
 	pstList->pstHead			= NULL;
 	pstList->pstTail			= NULL;
+	stdlib_node_pool_construct_movable(&pstList->stPool, szWrappedSizeof);
 }
 
 /**
@@ -165,6 +297,7 @@ bool stdlib_list_destruct(std_container_t* pstContainer)
 	}
 
 	stdlib_list_pop_front(pstContainer, NULL, pstContainer->szNumItems);
+	stdlib_node_pool_destruct(&CONTAINER_TO_LIST(pstContainer)->stPool, pstContainer);
 
 	return true;
 }
@@ -185,10 +318,12 @@ size_t stdlib_list_push_front(std_container_t * pstContainer, const std_linear_s
 	void * pvItem;
 	size_t i;
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -216,10 +351,12 @@ size_t stdlib_list_push_back(std_container_t * pstContainer, const std_linear_se
 	void * pvItem;
 	size_t i;
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -260,7 +397,7 @@ size_t stdlib_list_pop_front(std_container_t * pstContainer, void * pvResult, si
 		node_disconnect(pstList, pstNode);
 		pvItem = STD_LINEAR_ADD(pstNode, pstList->szPayloadOffset);
 		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
-		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstNode);
+		stdlib_node_pool_free(&pstList->stPool, pstNode);
 		pstContainer->szNumItems--;
 		if (pvResult != NULL)
 		{
@@ -298,7 +435,7 @@ size_t stdlib_list_pop_back(std_container_t * pstContainer, void * pvResult, siz
 		node_disconnect(pstList, pstNode);
 		pvItem = STD_LINEAR_ADD(pstNode, pstList->szPayloadOffset);
 		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
-		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstNode);
+		stdlib_node_pool_free(&pstList->stPool, pstNode);
 		pstContainer->szNumItems--;
 		if (pvResult != NULL)
 		{
@@ -309,6 +446,237 @@ size_t stdlib_list_pop_back(std_container_t * pstContainer, void * pvResult, siz
 	return szMaxItems;
 }
 
+/**
+ * Sort a range of items within a list (stably, by relinking the nodes in place)
+ *
+ * @param[in]	pstContainer	List to sort
+ * @param[in]	szFirst			Index of first element in range to sort
+ * @param[in]	szLast			Index of last  element in range to sort
+ * @param[in]	pfnCompare		Comparison function to use when sorting
+ */
+void stdlib_list_ranged_sort(std_container_t * pstContainer, size_t szFirst, size_t szLast, pfn_std_compare_t pfnCompare)
+{
+	std_list_t * pstList = CONTAINER_TO_LIST(pstContainer);
+	std_list_node_t * pstBefore;
+	std_list_node_t * pstAfter;
+	std_list_node_t * pstFirst;
+	std_list_node_t * pstLast;
+	std_list_node_t * pstNode;
+	std_list_node_t * pstPrev;
+
+	if (szLast >= pstContainer->szNumItems)
+	{
+		szLast = pstContainer->szNumItems - 1U;
+	}
+	if ((pstContainer->szNumItems < 2U) || (szFirst >= szLast))
+	{
+		return;
+	}
+
+	// Detach the range from the rest of the list
+	pstFirst	= node_at(pstList, szFirst);
+	pstLast		= node_at(pstList, szLast);
+	pstBefore	= pstFirst->pstPrev;
+	pstAfter	= pstLast->pstNext;
+	pstLast->pstNext = NULL;
+
+	pstFirst = node_sort(pstList, pstFirst, pfnCompare);
+
+	// Reattach the sorted range, rebuilding its backward links as we go
+	if (pstBefore == NULL)
+	{
+		pstList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstBefore->pstNext = pstFirst;
+	}
+	pstPrev = pstBefore;
+	for (pstNode = pstFirst; pstNode != NULL; pstNode = pstNode->pstNext)
+	{
+		pstNode->pstPrev = pstPrev;
+		pstPrev = pstNode;
+	}
+	pstPrev->pstNext = pstAfter;
+	if (pstAfter == NULL)
+	{
+		pstList->pstTail = pstPrev;
+	}
+	else
+	{
+		pstAfter->pstPrev = pstPrev;
+	}
+}
+
+/**
+ * Move a range of items from one list onto the back of another list (by relinking their nodes)
+ *
+ * Note: the relinking is O(1), but the range's nodes are found by walking (see node_at()), which is O(n)
+ *
+ * @param[in]	pstContainer	Destination list
+ * @param[in]	pstSource		Source list
+ * @param[in]	szFirst			Index of first item in source range
+ * @param[in]	szLast			Index of last  item in source range
+ *
+ * @return Number of items moved
+ */
+size_t stdlib_list_splice(std_container_t * pstContainer, std_container_t * pstSource, size_t szFirst, size_t szLast)
+{
+	std_list_t * pstList = CONTAINER_TO_LIST(pstContainer);
+	std_list_t * pstSourceList = CONTAINER_TO_LIST(pstSource);
+	std_list_node_t * pstFirst;
+	std_list_node_t * pstLast;
+	size_t szNumItems;
+	size_t i;
+
+	if (szLast >= pstSource->szNumItems)
+	{
+		szLast = pstSource->szNumItems - 1U;
+	}
+	if (	(pstSource->szNumItems == 0U)
+		||	(szFirst > szLast)
+		||	(stdlib_node_pool_lend(&pstSourceList->stPool, pstSource, &pstList->stPool, pstContainer) == false)	)
+	{
+		return 0;
+	}
+
+	// Find the range (walking on from its first node to its last, if that's nearer than either end of the list)
+	szNumItems	= szLast + 1U - szFirst;
+	pstFirst	= node_at(pstSourceList, szFirst);
+	if (	(szNumItems - 1U < szLast)
+		&&	(szNumItems - 1U < pstSource->szNumItems - 1U - szLast)	)
+	{
+		for (pstLast = pstFirst, i = szNumItems - 1U; i--; pstLast = pstLast->pstNext) { }
+	}
+	else
+	{
+		pstLast = node_at(pstSourceList, szLast);
+	}
+
+	// Detach the range from the source list
+	if (pstFirst->pstPrev == NULL)
+	{
+		pstSourceList->pstHead = pstLast->pstNext;
+	}
+	else
+	{
+		pstFirst->pstPrev->pstNext = pstLast->pstNext;
+	}
+	if (pstLast->pstNext == NULL)
+	{
+		pstSourceList->pstTail = pstFirst->pstPrev;
+	}
+	else
+	{
+		pstLast->pstNext->pstPrev = pstFirst->pstPrev;
+	}
+	pstSource->szNumItems -= szNumItems;
+
+	// ...and attach it to the back of the destination list
+	pstFirst->pstPrev = pstList->pstTail;
+	if (pstList->pstTail == NULL)
+	{
+		pstList->pstHead = pstFirst;
+	}
+	else
+	{
+		pstList->pstTail->pstNext = pstFirst;
+	}
+	pstLast->pstNext = NULL;
+	pstList->pstTail = pstLast;
+	pstContainer->szNumItems += szNumItems;
+
+	return szNumItems;
+}
+
+/**
+ * Merge a sorted list into another sorted list (by relinking their nodes)
+ *
+ * @param[in]	pstContainer	Destination list
+ * @param[in]	pstSource		Source list (left empty afterwards)
+ * @param[in]	pfnCompare		Comparison function
+ *
+ * @return True if the lists were merged, else false
+ */
+bool stdlib_list_merge(std_container_t * pstContainer, std_container_t * pstSource, pfn_std_compare_t pfnCompare)
+{
+	std_list_t * pstList = CONTAINER_TO_LIST(pstContainer);
+	std_list_t * pstSourceList = CONTAINER_TO_LIST(pstSource);
+	std_list_node_t * pstFirst;
+
+	if ((pstContainer == pstSource) || (pstSource->szNumItems == 0U))
+	{
+		return true;
+	}
+	if (stdlib_node_pool_lend(&pstSourceList->stPool, pstSource, &pstList->stPool, pstContainer) == false)
+	{
+		return false;
+	}
+
+	pstFirst = node_merge(pstList, pstList->pstHead, pstSourceList->pstHead, pfnCompare);
+	pstList->pstHead = pstList->pstTail = NULL;
+	node_chain_append(pstList, pstFirst);
+	pstContainer->szNumItems += pstSource->szNumItems;
+
+	pstSourceList->pstHead = pstSourceList->pstTail = NULL;
+	pstSource->szNumItems = 0;
+
+	return true;
+}
+
+/**
+ * Split a list at an iterator, moving the current item and all the items
+ * after it onto the back of another list (by relinking their nodes)
+ *
+ * @param[in]	pstIterator		List (forward) iterator
+ * @param[in]	pstDestination	Destination list
+ *
+ * @return Number of items moved
+ */
+size_t stdlib_list_split(std_iterator_t * pstIterator, std_container_t * pstDestination)
+{
+	std_container_t * pstContainer = pstIterator->pstContainer;
+	std_list_t * pstList = CONTAINER_TO_LIST(pstContainer);
+	std_list_t * pstDestList = CONTAINER_TO_LIST(pstDestination);
+	std_list_iterator_t * pstIt = ITERATOR_TO_LISTIT(pstIterator);
+	std_list_node_t * pstFirst = pstIt->pstNode;
+	std_list_node_t * pstNode;
+	size_t szNumItems = 0;
+
+	if (	(pstIterator->bDone)
+		||	(pstFirst == NULL)
+		||	(pstContainer == pstDestination)
+		||	(stdlib_node_pool_lend(&pstList->stPool, pstContainer, &pstDestList->stPool, pstDestination) == false)	)
+	{
+		return 0;
+	}
+
+	for (pstNode = pstFirst; pstNode != NULL; pstNode = pstNode->pstNext)
+	{
+		szNumItems++;
+	}
+
+	// Detach the tail of the list...
+	pstList->pstTail = pstFirst->pstPrev;
+	if (pstFirst->pstPrev == NULL)
+	{
+		pstList->pstHead = NULL;
+	}
+	else
+	{
+		pstFirst->pstPrev->pstNext = NULL;
+	}
+	pstContainer->szNumItems -= szNumItems;
+
+	// ...and attach it to the back of the destination list
+	node_chain_append(pstDestList, pstFirst);
+	pstDestination->szNumItems += szNumItems;
+
+	pstIterator->bDone = true;
+
+	return szNumItems;
+}
+
 /**
  * Set up a list iterator to step forwards through a list
  *
@@ -393,10 +761,12 @@ size_t stdlib_list_push_after(std_iterator_t* pstIterator, const std_linear_seri
 
 	pstItNode = STD_LINEAR_SUB(pstIterator->pvRef, pstList->szPayloadOffset);
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -430,10 +800,12 @@ size_t stdlib_list_push_before(std_iterator_t* pstIterator, const std_linear_ser
 
 	pstItNode = STD_LINEAR_SUB(pstIterator->pvRef, pstList->szPayloadOffset);
 
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, pstSeries->szNumItems);
+
 	std_linear_series_iterator_construct(&stIt, pstSeries);
 	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
 	{
-		pstNode = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstList->szLinkSize);
+		pstNode = stdlib_node_pool_alloc(&pstList->stPool, pstContainer);
 		if (pstNode == NULL)
 		{
 			break;
@@ -464,6 +836,7 @@ void stdlib_list_pop_at(std_iterator_t* pstIterator, void *pvResult)
 
 	pvItem = STD_LINEAR_ADD(pstIt->pstNode, pstList->szPayloadOffset);
 	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, pvItem, pstContainer->szSizeofItem);
+	stdlib_node_pool_free(&pstList->stPool, pstIt->pstNode);
 	pstIt->pstNode = NULL;
 
 	pstContainer->szNumItems--;
@@ -0,0 +1,810 @@
+/*
+ * src/std_lock_handlers.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Every lock starts with an owner record: the thread holding it exclusively
+ * (identified by the address of a thread-local variable), and what that
+ * thread holds it for. Only the owner ever writes its own tag there, and a
+ * thread only ever compares the owner against its own tag, so relaxed
+ * atomic accesses are enough: a thread can't see its own tag unless it put
+ * it there itself.
+ *
+ * Exclusive locks (mutex, spinlock, ticket lock) set the owner for readers
+ * and writers alike, so a thread holding one for reading can re-lock it for
+ * writing for free. The rwlock only sets the owner for writers (readers
+ * share it, so can't be told apart).
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "std/lock_handlers.h"
+
+#if defined(STD_LOCK_HAS_ATOMICS)
+
+#include <stdatomic.h>
+
+#if defined(STD_LOCK_HAS_PTHREADS)
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define CPU_RELAX()		_mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX()		__asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX()		do { } while (0)
+#endif
+
+// Give up the rest of the time slice (so that a preempted lock holder can run, when threads outnumber cores)
+#if defined(STD_LOCK_HAS_PTHREADS)
+#define THREAD_YIELD()	sched_yield()
+#else
+#define THREAD_YIELD()	do { } while (0)
+#endif
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL	__declspec(thread)
+#else
+#define THREAD_LOCAL	_Thread_local
+#endif
+
+// Each thread's own copy of this has a different address, which identifies the thread
+static THREAD_LOCAL char cThreadTag;
+
+typedef struct
+{
+	_Atomic(const void *) pvOwner;		// Tag of the thread holding the lock exclusively (or NULL)
+	std_lock_state_t eHeldState;		// What the owner holds the lock for (only ever touched by the owner)
+} lock_owner_t;
+
+typedef bool (*pfn_lock_acquire_t)(void * pvLock, uint32_t u32Timeout_msec);
+typedef void (*pfn_lock_release_t)(void * pvLock);
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Read the current time, in milliseconds
+ *
+ * @return Current time (from an arbitrary epoch)
+ */
+static uint64_t time_now_msec(void)
+{
+	struct timespec stNow;
+
+	timespec_get(&stNow, TIME_UTC);
+	return ((uint64_t) stNow.tv_sec * 1000U) + ((uint64_t) stNow.tv_nsec / 1000000U);
+}
+
+/**
+ * Find out whether a lock state is one that a lock can be updated to
+ *
+ * @param[in]	eState		Lock state
+ *
+ * @return True for unlocked, read-locked or write-locked, else false
+ */
+static bool state_is_valid(std_lock_state_t eState)
+{
+	return (eState == e_std_lock_Unlocked) || (eState == e_std_lock_ReadLocked) || (eState == e_std_lock_WriteLocked);
+}
+
+/**
+ * Update an exclusive lock (one that readers and writers both take exclusively) to a new state
+ *
+ * @param[in]	pvLock			Lock (starting with its owner record)
+ * @param[in]	pfnAcquire		Function to acquire the lock
+ * @param[in]	pfnRelease		Function to release the lock
+ * @param[in]	eNewState		State to update to (for the calling thread)
+ * @param[in]	u32Timeout_msec	Longest time to wait for the lock
+ *
+ * @return The calling thread's previous state (or e_std_lock_Invalid if the lock timed out)
+ */
+static std_lock_state_t exclusive_update(void * pvLock, pfn_lock_acquire_t pfnAcquire, pfn_lock_release_t pfnRelease, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	lock_owner_t * pstOwner = (lock_owner_t *) pvLock;
+	const void * pvSelf = &cThreadTag;
+	std_lock_state_t eOldState;
+
+	if (!state_is_valid(eNewState))
+	{
+		return e_std_lock_Invalid;
+	}
+
+	// A thread that already holds the lock just changes what it holds it for (releasing it when it gets back to unlocked)
+	if (atomic_load_explicit(&pstOwner->pvOwner, memory_order_relaxed) == pvSelf)
+	{
+		eOldState = pstOwner->eHeldState;
+		pstOwner->eHeldState = eNewState;
+		if (eNewState == e_std_lock_Unlocked)
+		{
+			atomic_store_explicit(&pstOwner->pvOwner, NULL, memory_order_relaxed);
+			(*pfnRelease)(pvLock);
+		}
+		return eOldState;
+	}
+
+	if (eNewState == e_std_lock_Unlocked)
+	{
+		return e_std_lock_Unlocked;
+	}
+	if (!(*pfnAcquire)(pvLock, u32Timeout_msec))
+	{
+		return e_std_lock_Invalid;
+	}
+	atomic_store_explicit(&pstOwner->pvOwner, pvSelf, memory_order_relaxed);
+	pstOwner->eHeldState = eNewState;
+	return e_std_lock_Unlocked;
+}
+
+/**
+ * Allocate a lock (with an empty owner record)
+ *
+ * @param[out]	ppstvLock	Where to put the lock's handle
+ * @param[in]	szSizeof	Size of the lock
+ *
+ * @return The lock (or NULL if memory ran out)
+ */
+static void * lock_alloc(std_lock_handle_t * ppstvLock, size_t szSizeof)
+{
+	lock_owner_t * pstOwner = malloc(szSizeof);
+
+	*ppstvLock = pstOwner;
+	if (pstOwner != NULL)
+	{
+		atomic_init(&pstOwner->pvOwner, NULL);
+		pstOwner->eHeldState = e_std_lock_Unlocked;
+	}
+	return pstOwner;
+}
+
+/**
+ * Free a lock
+ *
+ * @param[in,out]	ppstvLock	Handle of the lock (set to NULL)
+ *
+ * @return True
+ */
+static bool lock_free(std_lock_handle_t * ppstvLock)
+{
+	free(*ppstvLock);
+	*ppstvLock = NULL;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// Test-and-test-and-set spinlock
+// --------------------------------------------------------------------------
+
+typedef struct
+{
+	lock_owner_t stOwner;
+	atomic_bool bLocked;
+} lock_spin_t;
+
+/**
+ * Acquire a spinlock (waiting with exponential backoff)
+ *
+ * @param[in]	pvLock			Spinlock
+ * @param[in]	u32Timeout_msec	Longest time to wait
+ *
+ * @return True if the spinlock was acquired, false if it timed out
+ */
+static bool spin_acquire(void * pvLock, uint32_t u32Timeout_msec)
+{
+	lock_spin_t * pstLock = (lock_spin_t *) pvLock;
+	uint32_t u32Backoff = 1U;
+	uint32_t u32Spins = 0;
+	uint64_t u64Deadline = 0;
+	uint32_t i;
+
+	for (;;)
+	{
+		// Only try the (cache line stealing) exchange when a plain load says it might succeed
+		if (	!atomic_load_explicit(&pstLock->bLocked, memory_order_relaxed)
+			&&	!atomic_exchange_explicit(&pstLock->bLocked, true, memory_order_acquire)	)
+		{
+			return true;
+		}
+		if (u32Timeout_msec == 0)
+		{
+			return false;
+		}
+		if (u64Deadline == 0)
+		{
+			u64Deadline = time_now_msec() + u32Timeout_msec;
+		}
+
+		for (i = 0; i < u32Backoff; i++)
+		{
+			CPU_RELAX();
+		}
+		u32Spins += u32Backoff;
+		if (u32Backoff < STD_LOCK_SPIN_BACKOFF_MAX)
+		{
+			u32Backoff *= 2U;
+		}
+		else
+		{
+			THREAD_YIELD();
+		}
+		if (	(u32Spins >= STD_LOCK_SPINS_PER_CLOCK_CHECK)
+			&&	(u32Timeout_msec != STD_LOCK_TIMEOUT_INFINITE)	)
+		{
+			u32Spins = 0;
+			if (time_now_msec() >= u64Deadline)
+			{
+				return false;
+			}
+		}
+	}
+}
+
+static void spin_release(void * pvLock)
+{
+	atomic_store_explicit(&((lock_spin_t *) pvLock)->bLocked, false, memory_order_release);
+}
+
+static bool spin_construct(std_lock_handle_t * ppstvLock)
+{
+	lock_spin_t * pstLock = lock_alloc(ppstvLock, sizeof(lock_spin_t));
+
+	if (pstLock == NULL)
+	{
+		return false;
+	}
+	atomic_init(&pstLock->bLocked, false);
+	return true;
+}
+
+static std_lock_state_t spin_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	return exclusive_update(pstvLock, &spin_acquire, &spin_release, eNewState, u32Timeout_msec);
+}
+
+const std_lock_handler_t std_lock_handler_spinlock =
+{
+	.pfnLock_Construct = &spin_construct,
+	.pfnLock_Destruct = &lock_free,
+	.pfnLock_Update = &spin_update
+};
+
+// --------------------------------------------------------------------------
+// Ticket lock
+// --------------------------------------------------------------------------
+
+typedef struct
+{
+	lock_owner_t stOwner;
+	atomic_uint uNextTicket;		// Ticket that the next thread to arrive takes
+	atomic_uint uNowServing;		// Ticket that currently holds the lock
+} lock_ticket_t;
+
+/**
+ * Acquire a ticket lock (waiting for the ticket's turn, however long it takes, unless the timeout is zero)
+ *
+ * @param[in]	pvLock			Ticket lock
+ * @param[in]	u32Timeout_msec	Zero to only take the lock if it's free, else wait
+ *
+ * @return True if the ticket lock was acquired, false if it wasn't free (for a zero timeout)
+ */
+static bool ticket_acquire(void * pvLock, uint32_t u32Timeout_msec)
+{
+	lock_ticket_t * pstLock = (lock_ticket_t *) pvLock;
+	unsigned uServing = atomic_load_explicit(&pstLock->uNowServing, memory_order_acquire);
+	unsigned uTicket;
+	unsigned uAhead;
+	uint32_t u32Spins = 0;
+
+	if (u32Timeout_msec == 0)
+	{
+		// Only take a ticket if it would be served straight away
+		uTicket = uServing;
+		return atomic_compare_exchange_strong_explicit(&pstLock->uNextTicket, &uTicket, uServing + 1U, memory_order_acquire, memory_order_relaxed);
+	}
+
+	uTicket = atomic_fetch_add_explicit(&pstLock->uNextTicket, 1U, memory_order_relaxed);
+	while ((uServing = atomic_load_explicit(&pstLock->uNowServing, memory_order_acquire)) != uTicket)
+	{
+		// Back off in proportion to the number of threads ahead in the queue
+		for (uAhead = uTicket - uServing; uAhead > 0; uAhead--)
+		{
+			CPU_RELAX();
+			u32Spins++;
+		}
+		if (u32Spins >= STD_LOCK_SPIN_BACKOFF_MAX)
+		{
+			THREAD_YIELD();
+		}
+	}
+	return true;
+}
+
+static void ticket_release(void * pvLock)
+{
+	lock_ticket_t * pstLock = (lock_ticket_t *) pvLock;
+	unsigned uServing = atomic_load_explicit(&pstLock->uNowServing, memory_order_relaxed);
+
+	atomic_store_explicit(&pstLock->uNowServing, uServing + 1U, memory_order_release);
+}
+
+static bool ticket_construct(std_lock_handle_t * ppstvLock)
+{
+	lock_ticket_t * pstLock = lock_alloc(ppstvLock, sizeof(lock_ticket_t));
+
+	if (pstLock == NULL)
+	{
+		return false;
+	}
+	atomic_init(&pstLock->uNextTicket, 0U);
+	atomic_init(&pstLock->uNowServing, 0U);
+	return true;
+}
+
+static std_lock_state_t ticket_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	return exclusive_update(pstvLock, &ticket_acquire, &ticket_release, eNewState, u32Timeout_msec);
+}
+
+const std_lock_handler_t std_lock_handler_ticketlock =
+{
+	.pfnLock_Construct = &ticket_construct,
+	.pfnLock_Destruct = &lock_free,
+	.pfnLock_Update = &ticket_update
+};
+
+// --------------------------------------------------------------------------
+// Seqlock
+// --------------------------------------------------------------------------
+
+typedef struct
+{
+	lock_spin_t stSpin;						// Writers exclude each other with a spinlock
+	atomic_uint uSequence;					// Bumped as each write starts and as it ends (so odd while one is in progress)
+	_Atomic(const void *) pvLastWriter;		// Tag of the thread that wrote most recently
+	atomic_uint uLastWriterSince;			// Sequence number before the first of that thread's latest run of writes
+} lock_seq_t;
+
+/**
+ * Wait for the write in progress on a seqlock (if any) to finish
+ *
+ * @param[in]	pstLock			Seqlock
+ * @param[in]	u32Timeout_msec	Longest time to wait
+ * @param[out]	puSequence		Where to put the sequence number (even, unless it timed out)
+ *
+ * @return True if no write is in progress, false if it timed out
+ */
+static bool seqlock_wait_for_writer(lock_seq_t * pstLock, uint32_t u32Timeout_msec, unsigned * puSequence)
+{
+	uint32_t u32Spins = 0;
+	uint64_t u64Deadline = 0;
+
+	// (Acquire: the reads that follow can't be made before the sequence is loaded)
+	while ((*puSequence = atomic_load_explicit(&pstLock->uSequence, memory_order_acquire)) & 1U)
+	{
+		if (u32Timeout_msec == 0)
+		{
+			return false;
+		}
+		if (u64Deadline == 0)
+		{
+			u64Deadline = time_now_msec() + u32Timeout_msec;
+		}
+
+		CPU_RELAX();
+		if (++u32Spins >= STD_LOCK_SPIN_BACKOFF_MAX)
+		{
+			u32Spins = 0;
+			THREAD_YIELD();
+			if (	(u32Timeout_msec != STD_LOCK_TIMEOUT_INFINITE)
+				&&	(time_now_msec() >= u64Deadline)	)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool seqlock_acquire(void * pvLock, uint32_t u32Timeout_msec)
+{
+	lock_seq_t * pstLock = (lock_seq_t *) pvLock;
+	unsigned uSequence;
+
+	if (!spin_acquire(&pstLock->stSpin, u32Timeout_msec))
+	{
+		return false;
+	}
+
+	// Note where this thread's run of writes started (for seqlock_read_validate())
+	uSequence = atomic_load_explicit(&pstLock->uSequence, memory_order_relaxed);
+	if (atomic_load_explicit(&pstLock->pvLastWriter, memory_order_relaxed) != &cThreadTag)
+	{
+		atomic_store_explicit(&pstLock->uLastWriterSince, uSequence, memory_order_relaxed);
+		atomic_store_explicit(&pstLock->pvLastWriter, &cThreadTag, memory_order_relaxed);
+	}
+
+	// Make the sequence odd (before any of the writer's stores)
+	atomic_store_explicit(&pstLock->uSequence, uSequence + 1U, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	return true;
+}
+
+static void seqlock_release(void * pvLock)
+{
+	lock_seq_t * pstLock = (lock_seq_t *) pvLock;
+
+	// Make the sequence even again (after all of the writer's stores)
+	atomic_fetch_add_explicit(&pstLock->uSequence, 1U, memory_order_release);
+	spin_release(&pstLock->stSpin);
+}
+
+static bool seqlock_construct(std_lock_handle_t * ppstvLock)
+{
+	lock_seq_t * pstLock = lock_alloc(ppstvLock, sizeof(lock_seq_t));
+
+	if (pstLock == NULL)
+	{
+		return false;
+	}
+	atomic_init(&pstLock->stSpin.bLocked, false);
+	atomic_init(&pstLock->uSequence, 0U);
+	atomic_init(&pstLock->pvLastWriter, NULL);
+	atomic_init(&pstLock->uLastWriterSince, 0U);
+	return true;
+}
+
+static std_lock_state_t seqlock_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	lock_seq_t * pstLock = (lock_seq_t *) pstvLock;
+	unsigned uSequence;
+
+	// Readers (other than the writer itself) take no lock: they only wait for the write in progress to finish
+	if (	(eNewState == e_std_lock_ReadLocked)
+		&&	(atomic_load_explicit(&pstLock->stSpin.stOwner.pvOwner, memory_order_relaxed) != &cThreadTag)	)
+	{
+		return seqlock_wait_for_writer(pstLock, u32Timeout_msec, &uSequence) ? e_std_lock_NoRestoreNeeded : e_std_lock_Invalid;
+	}
+	return exclusive_update(pstvLock, &seqlock_acquire, &seqlock_release, eNewState, u32Timeout_msec);
+}
+
+/**
+ * Start an optimistic read (once any write in progress has finished)
+ *
+ * @param[in]	pstvLock	Seqlock
+ *
+ * @return Sequence number to validate the read against
+ */
+static uint32_t seqlock_read_begin(std_lock_handle_t pstvLock)
+{
+	lock_seq_t * pstLock = (lock_seq_t *) pstvLock;
+	unsigned uSequence;
+
+	// (The writer itself can read whatever it likes)
+	if (atomic_load_explicit(&pstLock->stSpin.stOwner.pvOwner, memory_order_relaxed) == &cThreadTag)
+	{
+		return atomic_load_explicit(&pstLock->uSequence, memory_order_relaxed);
+	}
+	seqlock_wait_for_writer(pstLock, STD_LOCK_TIMEOUT_INFINITE, &uSequence);
+	return uSequence;
+}
+
+/**
+ * Finish an optimistic read
+ *
+ * @param[in]	pstvLock	Seqlock
+ * @param[in]	u32Sequence	Sequence number that the read started with
+ *
+ * @return True if no other thread wrote during the read, false if it has to be retried
+ */
+static bool seqlock_read_validate(std_lock_handle_t pstvLock, uint32_t u32Sequence)
+{
+	lock_seq_t * pstLock = (lock_seq_t *) pstvLock;
+	unsigned uSequence;
+	unsigned uSince;
+
+	if (atomic_load_explicit(&pstLock->stSpin.stOwner.pvOwner, memory_order_relaxed) == &cThreadTag)
+	{
+		return true;
+	}
+
+	// (Keep the read's loads before the sequence is loaded again)
+	atomic_thread_fence(memory_order_acquire);
+	uSequence = atomic_load_explicit(&pstLock->uSequence, memory_order_acquire);
+	if (u32Sequence & 1U)
+	{
+		return false;
+	}
+	if (uSequence == u32Sequence)
+	{
+		return true;
+	}
+
+	// A thread that wrote in the middle of its own read only has to retry it if another thread wrote too
+	if (	(uSequence & 1U)
+		||	(atomic_load_explicit(&pstLock->pvLastWriter, memory_order_relaxed) != &cThreadTag)	)
+	{
+		return false;
+	}
+	uSince = atomic_load_explicit(&pstLock->uLastWriterSince, memory_order_relaxed);
+	return (uSequence - uSince) >= (uSequence - (unsigned) u32Sequence);
+}
+
+const std_lock_handler_t std_lock_handler_seqlock =
+{
+	.pfnLock_Construct = &seqlock_construct,
+	.pfnLock_Destruct = &lock_free,
+	.pfnLock_Update = &seqlock_update,
+	.pfnLock_ReadBegin = &seqlock_read_begin,
+	.pfnLock_ReadValidate = &seqlock_read_validate
+};
+
+#if defined(STD_LOCK_HAS_PTHREADS)
+
+// --------------------------------------------------------------------------
+// POSIX threads helpers
+// --------------------------------------------------------------------------
+
+#if !defined(_POSIX_TIMEOUTS) || (_POSIX_TIMEOUTS <= 0)
+
+/**
+ * Wait for a try-lock function to succeed (for platforms without timed locks)
+ *
+ * @param[in]	pfnTryLock		Try-lock function (returning zero on success)
+ * @param[in]	pvLock			Lock passed to it
+ * @param[in]	u64Deadline		Time to give up at
+ *
+ * @return Zero if the lock was acquired, else ETIMEDOUT
+ */
+static int trylock_until(int (*pfnTryLock)(void *), void * pvLock, uint64_t u64Deadline)
+{
+	while ((*pfnTryLock)(pvLock) != 0)
+	{
+		if (time_now_msec() >= u64Deadline)
+		{
+			return ETIMEDOUT;
+		}
+		sched_yield();
+	}
+	return 0;
+}
+
+static int mutex_trylock(void * pvMutex)		{ return pthread_mutex_trylock((pthread_mutex_t *) pvMutex); }
+static int rwlock_tryrdlock(void * pvRwLock)	{ return pthread_rwlock_tryrdlock((pthread_rwlock_t *) pvRwLock); }
+static int rwlock_trywrlock(void * pvRwLock)	{ return pthread_rwlock_trywrlock((pthread_rwlock_t *) pvRwLock); }
+
+#else
+
+/**
+ * Convert a timeout into the absolute (CLOCK_REALTIME) deadline that pthread's timed locks take
+ *
+ * @param[in]	u32Timeout_msec		Timeout
+ *
+ * @return Deadline
+ */
+static struct timespec deadline_from_timeout(uint32_t u32Timeout_msec)
+{
+	struct timespec stDeadline;
+
+	timespec_get(&stDeadline, TIME_UTC);
+	stDeadline.tv_sec += (time_t) (u32Timeout_msec / 1000U);
+	stDeadline.tv_nsec += (long) (u32Timeout_msec % 1000U) * 1000000L;
+	if (stDeadline.tv_nsec >= 1000000000L)
+	{
+		stDeadline.tv_sec++;
+		stDeadline.tv_nsec -= 1000000000L;
+	}
+	return stDeadline;
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+// pthread mutex
+// --------------------------------------------------------------------------
+
+typedef struct
+{
+	lock_owner_t stOwner;
+	pthread_mutex_t stMutex;
+} lock_mutex_t;
+
+static bool mutex_acquire(void * pvLock, uint32_t u32Timeout_msec)
+{
+	pthread_mutex_t * pstMutex = &((lock_mutex_t *) pvLock)->stMutex;
+
+	if (u32Timeout_msec == 0)
+	{
+		return (pthread_mutex_trylock(pstMutex) == 0);
+	}
+	if (u32Timeout_msec == STD_LOCK_TIMEOUT_INFINITE)
+	{
+		return (pthread_mutex_lock(pstMutex) == 0);
+	}
+#if !defined(_POSIX_TIMEOUTS) || (_POSIX_TIMEOUTS <= 0)
+	return (trylock_until(&mutex_trylock, pstMutex, time_now_msec() + u32Timeout_msec) == 0);
+#else
+	struct timespec stDeadline = deadline_from_timeout(u32Timeout_msec);
+	return (pthread_mutex_timedlock(pstMutex, &stDeadline) == 0);
+#endif
+}
+
+static void mutex_release(void * pvLock)
+{
+	pthread_mutex_unlock(&((lock_mutex_t *) pvLock)->stMutex);
+}
+
+static bool mutex_construct(std_lock_handle_t * ppstvLock)
+{
+	lock_mutex_t * pstLock = lock_alloc(ppstvLock, sizeof(lock_mutex_t));
+
+	if (pstLock == NULL)
+	{
+		return false;
+	}
+	if (pthread_mutex_init(&pstLock->stMutex, NULL) != 0)
+	{
+		return !lock_free(ppstvLock);
+	}
+	return true;
+}
+
+static bool mutex_destruct(std_lock_handle_t * ppstvLock)
+{
+	if (*ppstvLock != NULL)
+	{
+		pthread_mutex_destroy(&((lock_mutex_t *) *ppstvLock)->stMutex);
+	}
+	return lock_free(ppstvLock);
+}
+
+static std_lock_state_t mutex_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	return exclusive_update(pstvLock, &mutex_acquire, &mutex_release, eNewState, u32Timeout_msec);
+}
+
+const std_lock_handler_t std_lock_handler_pthread_mutex =
+{
+	.pfnLock_Construct = &mutex_construct,
+	.pfnLock_Destruct = &mutex_destruct,
+	.pfnLock_Update = &mutex_update
+};
+
+// --------------------------------------------------------------------------
+// pthread rwlock
+// --------------------------------------------------------------------------
+
+typedef struct
+{
+	lock_owner_t stOwner;			// (Only set for writers)
+	pthread_rwlock_t stRwLock;
+} lock_rw_t;
+
+/**
+ * Acquire a pthread rwlock for reading or writing
+ *
+ * @param[in]	pstRwLock		rwlock
+ * @param[in]	bWrite			True to acquire it for writing, else for reading
+ * @param[in]	u32Timeout_msec	Longest time to wait
+ *
+ * @return True if the rwlock was acquired, false if it timed out
+ */
+static bool rwlock_acquire(pthread_rwlock_t * pstRwLock, bool bWrite, uint32_t u32Timeout_msec)
+{
+	if (u32Timeout_msec == 0)
+	{
+		return ((bWrite ? pthread_rwlock_trywrlock(pstRwLock) : pthread_rwlock_tryrdlock(pstRwLock)) == 0);
+	}
+	if (u32Timeout_msec == STD_LOCK_TIMEOUT_INFINITE)
+	{
+		return ((bWrite ? pthread_rwlock_wrlock(pstRwLock) : pthread_rwlock_rdlock(pstRwLock)) == 0);
+	}
+#if !defined(_POSIX_TIMEOUTS) || (_POSIX_TIMEOUTS <= 0)
+	return (trylock_until(bWrite ? &rwlock_trywrlock : &rwlock_tryrdlock, pstRwLock, time_now_msec() + u32Timeout_msec) == 0);
+#else
+	struct timespec stDeadline = deadline_from_timeout(u32Timeout_msec);
+	return ((bWrite ? pthread_rwlock_timedwrlock(pstRwLock, &stDeadline) : pthread_rwlock_timedrdlock(pstRwLock, &stDeadline)) == 0);
+#endif
+}
+
+static bool rwlock_construct(std_lock_handle_t * ppstvLock)
+{
+	lock_rw_t * pstLock = lock_alloc(ppstvLock, sizeof(lock_rw_t));
+
+	if (pstLock == NULL)
+	{
+		return false;
+	}
+	if (pthread_rwlock_init(&pstLock->stRwLock, NULL) != 0)
+	{
+		return !lock_free(ppstvLock);
+	}
+	return true;
+}
+
+static bool rwlock_destruct(std_lock_handle_t * ppstvLock)
+{
+	if (*ppstvLock != NULL)
+	{
+		pthread_rwlock_destroy(&((lock_rw_t *) *ppstvLock)->stRwLock);
+	}
+	return lock_free(ppstvLock);
+}
+
+static std_lock_state_t rwlock_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	lock_rw_t * pstLock = (lock_rw_t *) pstvLock;
+	const void * pvSelf = &cThreadTag;
+
+	if (!state_is_valid(eNewState))
+	{
+		return e_std_lock_Invalid;
+	}
+
+	// A writer can nest any lock inside its write lock, which it only releases when it gets back to unlocked
+	if (atomic_load_explicit(&pstLock->stOwner.pvOwner, memory_order_relaxed) == pvSelf)
+	{
+		if (eNewState == e_std_lock_Unlocked)
+		{
+			atomic_store_explicit(&pstLock->stOwner.pvOwner, NULL, memory_order_relaxed);
+			pthread_rwlock_unlock(&pstLock->stRwLock);
+		}
+		return e_std_lock_WriteLocked;
+	}
+
+	switch (eNewState)
+	{
+		case e_std_lock_Unlocked:
+			// (Restoring a reader back to unlocked: readers are counted by the rwlock itself)
+			pthread_rwlock_unlock(&pstLock->stRwLock);
+			return e_std_lock_ReadLocked;
+
+		case e_std_lock_ReadLocked:
+			return rwlock_acquire(&pstLock->stRwLock, false, u32Timeout_msec) ? e_std_lock_Unlocked : e_std_lock_Invalid;
+
+		default:
+			if (!rwlock_acquire(&pstLock->stRwLock, true, u32Timeout_msec))
+			{
+				return e_std_lock_Invalid;
+			}
+			atomic_store_explicit(&pstLock->stOwner.pvOwner, pvSelf, memory_order_relaxed);
+			return e_std_lock_Unlocked;
+	}
+}
+
+const std_lock_handler_t std_lock_handler_pthread_rwlock =
+{
+	.pfnLock_Construct = &rwlock_construct,
+	.pfnLock_Destruct = &rwlock_destruct,
+	.pfnLock_Update = &rwlock_update
+};
+
+#endif /* STD_LOCK_HAS_PTHREADS */
+
+#endif /* STD_LOCK_HAS_ATOMICS */
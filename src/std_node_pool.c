@@ -0,0 +1,463 @@
+/*
+ * src/std_node_pool.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "std/node_pool.h"
+
+// Nodes of a movable pool can be released by other threads' containers, so their blocks are counted atomically where possible
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define NODE_POOL_ATOMIC(T)		_Atomic(T)
+#else
+#define NODE_POOL_ATOMIC(T)		T
+#endif
+
+// Bias added to a movable block's count of nodes in use elsewhere while its owning pool is alive
+#define NODE_POOL_OWNED			(SIZE_MAX / 2U)
+
+typedef struct
+{
+	size_t szOwnerId;									// Id of the pool that owns this block
+	size_t szNumOut;									// Nodes the owner has handed out and not had back (only touched by the owner)
+	const std_memoryhandler_t * pstMemoryHandler;		// Memory handler that the block was allocated with (or NULL if none)
+	NODE_POOL_ATOMIC(std_node_pool_free_t *) pstReturned;	// Nodes released into other pools, waiting for the owner to reuse them
+	NODE_POOL_ATOMIC(size_t) szNumRefs;				// NODE_POOL_OWNED (until the owner is destructed) less nodes in use elsewhere
+} node_pool_header_t;
+
+// Header at the start of every block (padded so that the nodes following it are fully aligned)
+union std_node_pool_block_u
+{
+	node_pool_header_t stHeader;
+	max_align_t stAlign;
+};
+
+// Each node of a movable pool is preceded by a pointer to its block
+typedef struct
+{
+	std_node_pool_block_t * pstBlock;
+} node_pool_prefix_t;
+
+// Id for the next movable pool
+static NODE_POOL_ATOMIC(size_t) szNextPoolId = 1U;
+
+/**
+ * Find the block that a node of a movable pool came from
+ *
+ * @param[in]	pvNode			Node
+ *
+ * @return Block
+ */
+static std_node_pool_block_t * node_pool_block_of(void * pvNode)
+{
+	return ((node_pool_prefix_t *) STD_LINEAR_SUB(pvNode, sizeof(node_pool_prefix_t)))->pstBlock;
+}
+
+/**
+ * Subtract from a movable block's reference count
+ *
+ * @param[in]	pstBlock		Block
+ * @param[in]	szCount			Amount to subtract
+ *
+ * @return True if that was the last reference (so the block should be freed), else false
+ */
+static bool node_pool_block_unref(std_node_pool_block_t * pstBlock, size_t szCount)
+{
+#if !defined(__STDC_NO_ATOMICS__)
+	return (atomic_fetch_sub_explicit(&pstBlock->stHeader.szNumRefs, szCount, memory_order_acq_rel) == szCount);
+#else
+	pstBlock->stHeader.szNumRefs -= szCount;
+	return (pstBlock->stHeader.szNumRefs == 0U);
+#endif
+}
+
+/**
+ * Free a movable block with the memory handler that allocated it
+ *
+ * @param[in]	pstBlock		Block
+ */
+static void node_pool_block_free(std_node_pool_block_t * pstBlock)
+{
+	const std_memoryhandler_t * pstMemoryHandler = pstBlock->stHeader.pstMemoryHandler;
+
+	std_memoryhandler_free(pstMemoryHandler, (pstMemoryHandler != NULL) ? std_container_has_memoryhandler : std_container_has_no_handlers, pstBlock);
+}
+
+/**
+ * Send a node back to the block that it came from, for the block's owner to reuse
+ *
+ * @param[in]	pstBlock		Block
+ * @param[in]	pstNode			Node
+ */
+static void node_pool_block_return(std_node_pool_block_t * pstBlock, std_node_pool_free_t * pstNode)
+{
+#if !defined(__STDC_NO_ATOMICS__)
+	std_node_pool_free_t * pstHead = atomic_load_explicit(&pstBlock->stHeader.pstReturned, memory_order_relaxed);
+
+	do
+	{
+		pstNode->pstNext = pstHead;
+	} while (!atomic_compare_exchange_weak_explicit(&pstBlock->stHeader.pstReturned, &pstHead, pstNode, memory_order_release, memory_order_relaxed));
+#else
+	pstNode->pstNext = pstBlock->stHeader.pstReturned;
+	pstBlock->stHeader.pstReturned = pstNode;
+#endif
+
+	if (node_pool_block_unref(pstBlock, 1U))
+	{
+		node_pool_block_free(pstBlock);
+	}
+}
+
+/**
+ * Move the nodes that other pools have sent back to a movable pool's blocks onto its freelist
+ *
+ * @param[in]	pstPool			Node pool
+ */
+static void node_pool_reclaim(std_node_pool_t * pstPool)
+{
+	std_node_pool_block_t * pstBlock;
+	std_node_pool_free_t * pstNode;
+	std_node_pool_free_t * pstNext;
+	size_t szCount;
+	size_t i;
+
+	for (i = 0; i < pstPool->szNumBlocks; i++)
+	{
+		pstBlock = pstPool->ppstBlocks[i];
+#if !defined(__STDC_NO_ATOMICS__)
+		pstNode = atomic_exchange_explicit(&pstBlock->stHeader.pstReturned, NULL, memory_order_acquire);
+#else
+		pstNode = pstBlock->stHeader.pstReturned;
+		pstBlock->stHeader.pstReturned = NULL;
+#endif
+		for (szCount = 0; pstNode != NULL; szCount++)
+		{
+			pstNext = pstNode->pstNext;
+			pstNode->pstNext = pstPool->pstFree;
+			pstPool->pstFree = pstNode;
+			pstNode = pstNext;
+		}
+		if (szCount != 0U)
+		{
+#if !defined(__STDC_NO_ATOMICS__)
+			atomic_fetch_add_explicit(&pstBlock->stHeader.szNumRefs, szCount, memory_order_relaxed);
+#else
+			pstBlock->stHeader.szNumRefs += szCount;
+#endif
+			pstBlock->stHeader.szNumOut -= szCount;
+			pstPool->szNumFree += szCount;
+		}
+	}
+}
+
+/**
+ * Add a block to the array of blocks that a node pool owns
+ *
+ * @param[in]	pstPool			Node pool
+ * @param[in]	pstContainer	Container that owns the node pool (and its memory handler)
+ * @param[in]	pstBlock		Block to add
+ *
+ * @return True if the block was added, else false
+ */
+static bool node_pool_block_add(std_node_pool_t * pstPool, std_container_t * pstContainer, std_node_pool_block_t * pstBlock)
+{
+	std_node_pool_block_t ** ppstBlocks;
+	size_t szNewAlloced;
+
+	if (pstPool->szNumBlocks == pstPool->szBlocksAlloced)
+	{
+		szNewAlloced = (pstPool->szBlocksAlloced == 0U) ? 8U : (2U * pstPool->szBlocksAlloced);
+		ppstBlocks = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPool->ppstBlocks, szNewAlloced * sizeof(ppstBlocks[0]));
+		if (ppstBlocks == NULL)
+		{
+			return false;
+		}
+		pstPool->ppstBlocks = ppstBlocks;
+		pstPool->szBlocksAlloced = szNewAlloced;
+	}
+
+	pstPool->ppstBlocks[pstPool->szNumBlocks++] = pstBlock;
+
+	return true;
+}
+
+/**
+ * Initialise an empty node pool
+ *
+ * @param[in]	pstPool			Node pool to initialise
+ * @param[in]	szNodeSize		Size of each node
+ */
+void stdlib_node_pool_construct(std_node_pool_t * pstPool, size_t szNodeSize)
+{
+	// Every free node has to be big enough (and aligned enough) to hold a freelist link
+	if (szNodeSize < sizeof(std_node_pool_free_t))
+	{
+		szNodeSize = sizeof(std_node_pool_free_t);
+	}
+	szNodeSize = (szNodeSize + sizeof(void *) - 1U) & ~(sizeof(void *) - 1U);
+
+	pstPool->szNodeSize			= szNodeSize;
+	pstPool->szStride			= szNodeSize;
+	pstPool->szId				= 0;
+	pstPool->bLent				= false;
+	pstPool->szNumNodes			= 0;
+	pstPool->szNumFree			= 0;
+	pstPool->pstFree			= NULL;
+	pstPool->ppstBlocks			= NULL;
+	pstPool->szNumBlocks		= 0;
+	pstPool->szBlocksAlloced	= 0;
+}
+
+/**
+ * Initialise an empty node pool, whose nodes can move into other movable pools' containers
+ *
+ * @param[in]	pstPool			Node pool to initialise
+ * @param[in]	szNodeSize		Size of each node
+ */
+void stdlib_node_pool_construct_movable(std_node_pool_t * pstPool, size_t szNodeSize)
+{
+	stdlib_node_pool_construct(pstPool, szNodeSize);
+
+	pstPool->szStride	= sizeof(node_pool_prefix_t) + pstPool->szNodeSize;
+#if !defined(__STDC_NO_ATOMICS__)
+	pstPool->szId		= atomic_fetch_add_explicit(&szNextPoolId, 1U, memory_order_relaxed);
+#else
+	pstPool->szId		= szNextPoolId++;
+#endif
+}
+
+/**
+ * Release all the blocks owned by a node pool (freeing those that have no nodes in use elsewhere)
+ *
+ * Note: the pool's container must already have released every node that it holds
+ *
+ * @param[in]	pstPool			Node pool
+ * @param[in]	pstContainer	Container that owns the node pool (and its memory handler)
+ */
+void stdlib_node_pool_destruct(std_node_pool_t * pstPool, std_container_t * pstContainer)
+{
+	std_node_pool_block_t * pstBlock;
+	size_t szId = pstPool->szId;
+	size_t i;
+
+	for (i = 0; i < pstPool->szNumBlocks; i++)
+	{
+		pstBlock = pstPool->ppstBlocks[i];
+		if (pstPool->bLent == false)
+		{
+			std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstBlock);
+		}
+		else if (node_pool_block_unref(pstBlock, NODE_POOL_OWNED - pstBlock->stHeader.szNumOut))
+		{
+			// Every node that left this pool has already come back
+			node_pool_block_free(pstBlock);
+		}
+	}
+	if (pstPool->ppstBlocks != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstPool->ppstBlocks);
+	}
+
+	if (szId != 0U)
+	{
+		stdlib_node_pool_construct_movable(pstPool, pstPool->szNodeSize);
+	}
+	else
+	{
+		stdlib_node_pool_construct(pstPool, pstPool->szNodeSize);
+	}
+}
+
+/**
+ * Make sure that a node pool has at least a given number of free nodes
+ *
+ * @param[in]	pstPool			Node pool
+ * @param[in]	pstContainer	Container that owns the node pool (and its memory handler)
+ * @param[in]	szNumNodes		Number of free nodes needed
+ *
+ * @return True if that many free nodes are available, else false
+ */
+bool stdlib_node_pool_reserve(std_node_pool_t * pstPool, std_container_t * pstContainer, size_t szNumNodes)
+{
+	std_node_pool_block_t * pstBlock;
+	std_node_pool_free_t * pstNode;
+	void * pvSlot;
+	size_t szBatch;
+	size_t i;
+
+	// Reuse the nodes that other pools have sent back before carving out any more
+	if (	(szNumNodes > pstPool->szNumFree)
+		&&	(pstPool->bLent)	)
+	{
+		node_pool_reclaim(pstPool);
+	}
+	if (szNumNodes <= pstPool->szNumFree)
+	{
+		return true;
+	}
+	szNumNodes -= pstPool->szNumFree;
+
+	// Grow geometrically (within limits), but always by at least as many nodes as were asked for
+	szBatch = pstPool->szNumNodes;
+	if (szBatch < STD_NODE_POOL_BATCH_MIN)
+	{
+		szBatch = STD_NODE_POOL_BATCH_MIN;
+	}
+	if (szBatch > STD_NODE_POOL_BATCH_MAX)
+	{
+		szBatch = STD_NODE_POOL_BATCH_MAX;
+	}
+	if (szBatch < szNumNodes)
+	{
+		szBatch = szNumNodes;
+	}
+
+	pstBlock = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, sizeof(std_node_pool_block_t) + (szBatch * pstPool->szStride));
+	if (pstBlock == NULL)
+	{
+		return false;
+	}
+	if (node_pool_block_add(pstPool, pstContainer, pstBlock) == false)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstBlock);
+		return false;
+	}
+	pstBlock->stHeader.szOwnerId		= pstPool->szId;
+	pstBlock->stHeader.szNumOut			= 0;
+	pstBlock->stHeader.pstMemoryHandler	= (pstContainer->eHas & std_container_has_memoryhandler) ? pstContainer->pstMemoryHandler : NULL;
+#if !defined(__STDC_NO_ATOMICS__)
+	atomic_init(&pstBlock->stHeader.pstReturned, NULL);
+	atomic_init(&pstBlock->stHeader.szNumRefs, NODE_POOL_OWNED);
+#else
+	pstBlock->stHeader.pstReturned		= NULL;
+	pstBlock->stHeader.szNumRefs		= NODE_POOL_OWNED;
+#endif
+
+	// Thread the new nodes onto the freelist so that they get handed out in address order
+	pvSlot = STD_LINEAR_ADD(pstBlock, sizeof(std_node_pool_block_t) + (szBatch * pstPool->szStride));
+	for (i = 0; i < szBatch; i++)
+	{
+		pvSlot = STD_LINEAR_SUB(pvSlot, pstPool->szStride);
+		if (pstPool->szId != 0U)
+		{
+			((node_pool_prefix_t *) pvSlot)->pstBlock = pstBlock;
+		}
+		pstNode = STD_LINEAR_ADD(pvSlot, pstPool->szStride - pstPool->szNodeSize);
+		pstNode->pstNext = pstPool->pstFree;
+		pstPool->pstFree = pstNode;
+	}
+	pstPool->szNumNodes	+= szBatch;
+	pstPool->szNumFree	+= szBatch;
+
+	return true;
+}
+
+/**
+ * Take a node from a node pool
+ *
+ * @param[in]	pstPool			Node pool
+ * @param[in]	pstContainer	Container that owns the node pool (and its memory handler)
+ *
+ * @return Node (or NULL if no memory was available)
+ */
+void * stdlib_node_pool_alloc(std_node_pool_t * pstPool, std_container_t * pstContainer)
+{
+	std_node_pool_free_t * pstNode;
+
+	if (	(pstPool->pstFree == NULL)
+		&&	(stdlib_node_pool_reserve(pstPool, pstContainer, 1U) == false)	)
+	{
+		return NULL;
+	}
+
+	pstNode = pstPool->pstFree;
+	pstPool->pstFree = pstNode->pstNext;
+	pstPool->szNumFree--;
+	if (pstPool->szId != 0U)
+	{
+		node_pool_block_of(pstNode)->stHeader.szNumOut++;
+	}
+
+	return pstNode;
+}
+
+/**
+ * Return a node to a node pool (or, for a movable pool, to the pool that owns its block)
+ *
+ * @param[in]	pstPool			Node pool
+ * @param[in]	pvNode			Node to return
+ */
+void stdlib_node_pool_free(std_node_pool_t * pstPool, void * pvNode)
+{
+	std_node_pool_free_t * pstNode = pvNode;
+	std_node_pool_block_t * pstBlock;
+
+	if (pstPool->szId != 0U)
+	{
+		pstBlock = node_pool_block_of(pstNode);
+		if (pstBlock->stHeader.szOwnerId != pstPool->szId)
+		{
+			node_pool_block_return(pstBlock, pstNode);
+			return;
+		}
+		pstBlock->stHeader.szNumOut--;
+	}
+
+	pstNode->pstNext = pstPool->pstFree;
+	pstPool->pstFree = pstNode;
+	pstPool->szNumFree++;
+}
+
+/**
+ * Check that nodes can move from a node pool's container into another pool's container
+ * (i.e. that both pools are movable, with the same node size and memory handler)
+ *
+ * @param[in]	pstPool			Node pool that the nodes are coming from
+ * @param[in]	pstContainer	Container that owns that node pool (and its memory handler)
+ * @param[in]	pstOther		Node pool whose container is receiving the nodes
+ * @param[in]	pstOtherContainer	Container that owns that node pool (and its memory handler)
+ *
+ * @return True if the nodes can move, else false
+ */
+bool stdlib_node_pool_lend(std_node_pool_t * pstPool, const std_container_t * pstContainer, const std_node_pool_t * pstOther, const std_container_t * pstOtherContainer)
+{
+	const std_memoryhandler_t * pstMemoryHandler = (pstContainer->eHas & std_container_has_memoryhandler) ? pstContainer->pstMemoryHandler : NULL;
+	const std_memoryhandler_t * pstOtherMemoryHandler = (pstOtherContainer->eHas & std_container_has_memoryhandler) ? pstOtherContainer->pstMemoryHandler : NULL;
+
+	if (pstPool == pstOther)
+	{
+		return true;
+	}
+
+	if (	(pstPool->szId == 0U)
+		||	(pstOther->szId == 0U)
+		||	(pstPool->szNodeSize != pstOther->szNodeSize)
+		||	(pstMemoryHandler != pstOtherMemoryHandler)	)
+	{
+		return false;
+	}
+
+	pstPool->bLent = true;
+
+	return true;
+}
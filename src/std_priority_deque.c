@@ -22,14 +22,362 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+
 /*
- * The central idea of a deque is to make a container that is largely linear
- * but that is able to push/pop items at the start or end.
+ * The priority deque is a min-max heap (Atkinson, Sack, Santoro & Strothotte,
+ * "Min-Max Heaps and Generalized Priority Queues", CACM 1986) held in a vector.
  *
- * It achieves this by allocating blocks of items known as "buckets", and
- * iterating by stepping linearly through the items in each bucket.
+ * Items are moved around using a "hole": rather than repeatedly swapping an
+ * item down (or up) the heap, the items it passes are moved into the hole
+ * that it leaves behind, and the item is only written once it has found its
+ * final place. While an item is being trickled down after a pop, it is parked
+ * in the (now unused) slot just past the end of the heap.
  */
 
 #include "std/priority_deque.h"
-#include "std/deque.h"
 
+#define CONTAINER_TO_PRIORITYDEQUE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_prioritydeque_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find out whether a heap index is on one of the heap's max levels
+ *
+ * @param[in]	szIndex		Index
+ *
+ * @return True if on a max level, false if on a min level
+ */
+static bool heap_is_max_level(size_t szIndex)
+{
+	// The root (level 0) is a min level, and the levels then alternate
+	return ((63 - __builtin_clzll((unsigned long long)szIndex + 1ULL)) & 1) != 0;
+}
+
+/**
+ * Find out whether an item should sit above another item in a particular kind of heap level
+ *
+ * @param[in]	pstPriorityDeque	Priority deque
+ * @param[in]	pvA					First item
+ * @param[in]	pvB					Second item
+ * @param[in]	bMax				True if comparing for a max level, false if for a min level
+ *
+ * @return True if the first item is strictly better (i.e. ranks earlier on a min level, or later on a max level)
+ */
+static bool heap_is_better(const std_prioritydeque_t * pstPriorityDeque, const void * pvA, const void * pvB, bool bMax)
+{
+	// Comparison functions only need to return > 0 when their first item ranks later
+	return bMax ? ((*pstPriorityDeque->pfnCompare)(pvA, pvB) > 0) : ((*pstPriorityDeque->pfnCompare)(pvB, pvA) > 0);
+}
+
+/**
+ * Move an item from one heap slot to another (empty) heap slot
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	szTo			Index of destination slot
+ * @param[in]	szFrom			Index of source slot
+ */
+static void heap_move(std_container_t * pstContainer, size_t szTo, size_t szFrom)
+{
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szTo), stdlib_vector_at(pstContainer, szFrom), 1U);
+}
+
+/**
+ * Find the index of the last-ranked item in a (non-empty) min-max heap
+ *
+ * @param[in]	pstContainer	Priority deque container
+ *
+ * @return Index of the item
+ */
+static size_t heap_max_index(std_container_t * pstContainer)
+{
+	if (pstContainer->szNumItems < 3U)
+	{
+		return pstContainer->szNumItems - 1U;
+	}
+
+	// The last-ranked item is whichever of the root's two children ranks later
+	return heap_is_better(CONTAINER_TO_PRIORITYDEQUE(pstContainer), stdlib_vector_at(pstContainer, 2U), stdlib_vector_at(pstContainer, 1U), true) ? 2U : 1U;
+}
+
+/**
+ * Move a new item up through a min-max heap (from an empty slot at its end) and store it
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	szHole			Index of empty slot
+ * @param[in]	pvItem			New item (outside the heap)
+ */
+static void heap_bubble_up(std_container_t * pstContainer, size_t szHole, const void * pvItem)
+{
+	std_prioritydeque_t * pstPriorityDeque = CONTAINER_TO_PRIORITYDEQUE(pstContainer);
+	bool bMax;
+	size_t szParent;
+	size_t szGrandparent;
+
+	if (szHole != 0U)
+	{
+		// If the new item belongs on the other kind of level, swap it with its parent first
+		bMax = heap_is_max_level(szHole);
+		szParent = (szHole - 1U) / 2U;
+		if (heap_is_better(pstPriorityDeque, pvItem, stdlib_vector_at(pstContainer, szParent), !bMax))
+		{
+			heap_move(pstContainer, szHole, szParent);
+			szHole = szParent;
+			bMax = !bMax;
+		}
+
+		// ...then move it up through the levels of its own kind
+		while (szHole >= 3U)
+		{
+			szGrandparent = (((szHole - 1U) / 2U) - 1U) / 2U;
+			if (!heap_is_better(pstPriorityDeque, pvItem, stdlib_vector_at(pstContainer, szGrandparent), bMax))
+			{
+				break;
+			}
+			heap_move(pstContainer, szHole, szGrandparent);
+			szHole = szGrandparent;
+		}
+	}
+
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szHole), pvItem, 1U);
+}
+
+/**
+ * Move the item parked just past the end of a min-max heap down into the heap (starting at an empty slot)
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	szHole			Index of empty slot
+ */
+static void heap_trickle_down(std_container_t * pstContainer, size_t szHole)
+{
+	std_prioritydeque_t * pstPriorityDeque = CONTAINER_TO_PRIORITYDEQUE(pstContainer);
+	size_t szNumItems = pstContainer->szNumItems;
+	size_t szParked = szNumItems;
+	void * pvParked = stdlib_vector_at(pstContainer, szParked);
+	bool bMax = heap_is_max_level(szHole);
+	size_t szBest;
+	size_t szParent;
+	size_t szIndex;
+	size_t szLast;
+
+	for (;;)
+	{
+		// Find the best of the hole's children and grandchildren
+		szIndex = (2U * szHole) + 1U;
+		if (szIndex >= szNumItems)
+		{
+			break;
+		}
+		szBest = szIndex;
+		if ((szIndex + 1U < szNumItems) && heap_is_better(pstPriorityDeque, stdlib_vector_at(pstContainer, szIndex + 1U), stdlib_vector_at(pstContainer, szBest), bMax))
+		{
+			szBest = szIndex + 1U;
+		}
+		szLast = (4U * szHole) + 6U;
+		for (szIndex = (4U * szHole) + 3U; (szIndex <= szLast) && (szIndex < szNumItems); szIndex++)
+		{
+			if (heap_is_better(pstPriorityDeque, stdlib_vector_at(pstContainer, szIndex), stdlib_vector_at(pstContainer, szBest), bMax))
+			{
+				szBest = szIndex;
+			}
+		}
+
+		// Stop once the parked item is at least as good as all of them
+		if (!heap_is_better(pstPriorityDeque, stdlib_vector_at(pstContainer, szBest), pvParked, bMax))
+		{
+			break;
+		}
+		heap_move(pstContainer, szHole, szBest);
+
+		// If the best was a child, nothing below it ranks any better than it, so the parked item can go there
+		if (szBest <= (2U * szHole) + 2U)
+		{
+			szHole = szBest;
+			break;
+		}
+		szHole = szBest;
+
+		// If the parked item belongs on the other kind of level, swap it with the grandchild's parent
+		szParent = (szBest - 1U) / 2U;
+		if (heap_is_better(pstPriorityDeque, stdlib_vector_at(pstContainer, szParent), pvParked, bMax))
+		{
+			heap_move(pstContainer, szHole, szParent);
+			heap_move(pstContainer, szParent, szParked);
+			heap_move(pstContainer, szParked, szHole);
+		}
+	}
+
+	heap_move(pstContainer, szHole, szParked);
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a priority deque container
+ *
+ * @param[in]	pstContainer	Priority deque to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the payload within the wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_prioritydeque_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	CONTAINER_TO_PRIORITYDEQUE(pstContainer)->pfnCompare = NULL;
+}
+
+/**
+ * Set the comparison function that a priority deque orders its items by
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_prioritydeque_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_PRIORITYDEQUE(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Push a series of items into a priority deque container
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (zero if no comparison function has been set)
+ */
+size_t stdlib_prioritydeque_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t i;
+
+	if (	(CONTAINER_TO_PRIORITYDEQUE(pstContainer)->pfnCompare == NULL)
+		||	(pstSeries->szNumItems == 0U)
+		||	(stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + pstSeries->szNumItems) == false)	)
+	{
+		return 0;
+	}
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		heap_bubble_up(pstContainer, pstContainer->szNumItems, stIt.pvData);
+		pstContainer->szNumItems++;
+	}
+
+	return i;
+}
+
+/**
+ * Find the first-ranked item in a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ *
+ * @return Pointer to the item (or NULL if the priority deque is empty)
+ */
+void * stdlib_prioritydeque_min(std_container_t * pstContainer)
+{
+	return (pstContainer->szNumItems == 0U) ? NULL : stdlib_vector_at(pstContainer, 0U);
+}
+
+/**
+ * Find the last-ranked item in a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ *
+ * @return Pointer to the item (or NULL if the priority deque is empty)
+ */
+void * stdlib_prioritydeque_max(std_container_t * pstContainer)
+{
+	return (pstContainer->szNumItems == 0U) ? NULL : stdlib_vector_at(pstContainer, heap_max_index(pstContainer));
+}
+
+/**
+ * Pop the first-ranked items off a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_prioritydeque_pop_min(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, stdlib_vector_at(pstContainer, 0U), pstContainer->szSizeofItem);
+		if (--pstContainer->szNumItems != 0U)
+		{
+			heap_trickle_down(pstContainer, 0U);
+		}
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+/**
+ * Pop the last-ranked items off a priority deque
+ *
+ * @param[in]	pstContainer	Priority deque container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_prioritydeque_pop_max(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t szIndex;
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		szIndex = heap_max_index(pstContainer);
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, stdlib_vector_at(pstContainer, szIndex), pstContainer->szSizeofItem);
+
+		// Unless the popped item was the final item in the heap, refill its slot
+		if (--pstContainer->szNumItems != szIndex)
+		{
+			heap_trickle_down(pstContainer, szIndex);
+		}
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+// -------------------------------------------------------------------------
+
+static bool prioritydeque_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_vector_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_prioritydeque_default_itemhandler =
+{
+	.szElementSize = sizeof(std_prioritydeque_t),
+	.pfn_Destructor = &prioritydeque_default_destruct,
+	.pfn_Relocator = NULL
+};
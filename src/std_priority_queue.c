@@ -22,29 +22,314 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+/*
+ * The priority queue is a d-ary heap held in a vector, where d (the fan-out)
+ * is a power of two so that finding a parent or first child is just a shift.
+ *
+ * As in the priority deque, items are moved using a "hole" rather than being
+ * swapped level by level, and an item being sifted down is parked in the
+ * (unused) slot just past the end of the heap until it finds its final place.
+ */
+
 #include "std/priority_queue.h"
 
 #define CONTAINER_TO_PRIORITYQUEUE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_priorityqueue_t, stContainer)
-#define PRIORITYQUEUE_TO_CONTAINER(PRIORITYQUEUE)	&PRIORITYQUEUE->stContainer
 
-#define ITERATOR_TO_VECTORIT(IT)					STD_CONTAINER_OF(IT, std_vector_iterator_t, stIterator)
-#define VECTORIT_TO_ITERATOR(PRIORITYQUEUEIT)		&PRIORITYQUEUEIT->stIterator
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
 
-void stdlib_priorityqueue_compare_set(std_priorityqueue_t* pstPriorityQueue, pfn_std_compare_t pfnCompare)
+/**
+ * Find out whether one item should sit above another item in the heap
+ *
+ * @param[in]	pstPriorityQueue	Priority queue
+ * @param[in]	pvA					First item
+ * @param[in]	pvB					Second item
+ *
+ * @return True if the first item ranks strictly later than the second
+ */
+static bool heap_is_better(const std_priorityqueue_t * pstPriorityQueue, const void * pvA, const void * pvB)
 {
-	pstPriorityQueue->pfnCompare = pfnCompare;
+	return ((*pstPriorityQueue->pfnCompare)(pvA, pvB) > 0);
 }
 
 /**
- * Push a series of items onto a priority queue container
+ * Move an item from one heap slot to another (empty) heap slot
  *
- * @param[in]	pstContainer	Priority queue container to push the series of items onto
- * @param[in]	pstSeries		Linear series of items to push onto the container
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	szTo			Index of destination slot
+ * @param[in]	szFrom			Index of source slot
+ */
+static void heap_move(std_container_t * pstContainer, size_t szTo, size_t szFrom)
+{
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szTo), stdlib_vector_at(pstContainer, szFrom), 1U);
+}
+
+/**
+ * Move a new item up through a d-ary heap (from an empty slot at its end) and store it
  *
- * @return Number of items inserted into the priority queue container
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	szHole			Index of empty slot
+ * @param[in]	pvItem			New item (outside the heap)
  */
-size_t stdlib_priorityqueue_push(std_container_t* pstContainer, std_linear_series_t* pstSeries)
+static void heap_sift_up(std_container_t * pstContainer, size_t szHole, const void * pvItem)
 {
-	std_priorityqueue_t* pstPriorityQueue = CONTAINER_TO_PRIORITYQUEUE(pstContainer);
-	return stdlib_vector_heap_insert(pstContainer, pstSeries, pstPriorityQueue->pfnCompare);
+	std_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_PRIORITYQUEUE(pstContainer);
+	size_t szShift = pstPriorityQueue->szFanoutShift;
+	size_t szParent;
+
+	while (szHole != 0U)
+	{
+		szParent = (szHole - 1U) >> szShift;
+		if (!heap_is_better(pstPriorityQueue, pvItem, stdlib_vector_at(pstContainer, szParent)))
+		{
+			break;
+		}
+		heap_move(pstContainer, szHole, szParent);
+		szHole = szParent;
+	}
+
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szHole), pvItem, 1U);
 }
+
+/**
+ * Move the item parked just past the end of a d-ary heap down into the heap (starting at an empty slot)
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	szHole			Index of empty slot
+ */
+static void heap_sift_down(std_container_t * pstContainer, size_t szHole)
+{
+	std_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_PRIORITYQUEUE(pstContainer);
+	size_t szShift = pstPriorityQueue->szFanoutShift;
+	size_t szNumItems = pstContainer->szNumItems;
+	size_t szParked = szNumItems;
+	void * pvParked = stdlib_vector_at(pstContainer, szParked);
+	void * pvBest;
+	void * pvChild;
+	size_t szBest;
+	size_t szIndex;
+	size_t szLast;
+
+	for (;;)
+	{
+		// The children of a hole are contiguous, so walk them with a pointer rather than indexing each one
+		szIndex = (szHole << szShift) + 1U;
+		if (szIndex >= szNumItems)
+		{
+			break;
+		}
+		szLast = szIndex + ((size_t)1U << szShift);
+		if (szLast > szNumItems)
+		{
+			szLast = szNumItems;
+		}
+
+		szBest = szIndex;
+		pvBest = stdlib_vector_at(pstContainer, szIndex);
+		pvChild = pvBest;
+		for (szIndex++; szIndex < szLast; szIndex++)
+		{
+			pvChild = STD_LINEAR_ADD(pvChild, pstContainer->szSizeofItem);
+			if (heap_is_better(pstPriorityQueue, pvChild, pvBest))
+			{
+				szBest = szIndex;
+				pvBest = pvChild;
+			}
+		}
+
+		// Stop once the parked item is at least as good as all of them
+		if (!heap_is_better(pstPriorityQueue, pvBest, pvParked))
+		{
+			break;
+		}
+		heap_move(pstContainer, szHole, szBest);
+		szHole = szBest;
+	}
+
+	heap_move(pstContainer, szHole, szParked);
+}
+
+/**
+ * Rebuild a d-ary heap from its items in place (Floyd's method)
+ *
+ * @param[in]	pstContainer	Priority queue container (with room for one more item)
+ */
+static void heap_rebuild(std_container_t * pstContainer)
+{
+	size_t szShift = CONTAINER_TO_PRIORITYQUEUE(pstContainer)->szFanoutShift;
+	size_t szIndex;
+
+	if (pstContainer->szNumItems < 2U)
+	{
+		return;
+	}
+
+	// Sift down every item that has children, starting from the last one
+	szIndex = ((pstContainer->szNumItems - 2U) >> szShift) + 1U;
+	while (szIndex-- != 0U)
+	{
+		heap_move(pstContainer, pstContainer->szNumItems, szIndex);
+		heap_sift_down(pstContainer, szIndex);
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a priority queue container
+ *
+ * @param[in]	pstContainer	Priority queue to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the payload within the wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_priorityqueue_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_PRIORITYQUEUE(pstContainer);
+	size_t szShift = 0U;
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	pstPriorityQueue->pfnCompare = NULL;
+
+	while (((size_t)1U << szShift) < STD_PRIORITYQUEUE_DEFAULT_FANOUT)
+	{
+		szShift++;
+	}
+	pstPriorityQueue->szFanoutShift = szShift;
+}
+
+/**
+ * Set the comparison function that a priority queue orders its items by
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_priorityqueue_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_PRIORITYQUEUE(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Set the fan-out of a priority queue's heap (rebuilding the heap if it already holds items)
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	szFanout		Fan-out (a power of two, from 2 to STD_PRIORITYQUEUE_MAX_FANOUT)
+ *
+ * @return True if the fan-out was set, else false
+ */
+bool stdlib_priorityqueue_fanout_set(std_container_t * pstContainer, size_t szFanout)
+{
+	std_priorityqueue_t * pstPriorityQueue = CONTAINER_TO_PRIORITYQUEUE(pstContainer);
+	size_t szShift = 0U;
+
+	if (	(szFanout < 2U)
+		||	(szFanout > STD_PRIORITYQUEUE_MAX_FANOUT)
+		||	((szFanout & (szFanout - 1U)) != 0U)	)
+	{
+		return false;
+	}
+
+	while (((size_t)1U << szShift) < szFanout)
+	{
+		szShift++;
+	}
+	if (szShift == pstPriorityQueue->szFanoutShift)
+	{
+		return true;
+	}
+
+	// Rebuilding the heap needs a spare slot to park items in
+	if (	(pstContainer->szNumItems != 0U)
+		&&	(	(pstPriorityQueue->pfnCompare == NULL)
+			||	(stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + 1U) == false)	)	)
+	{
+		return false;
+	}
+
+	pstPriorityQueue->szFanoutShift = szShift;
+	heap_rebuild(pstContainer);
+	return true;
+}
+
+/**
+ * Push a series of items into a priority queue container
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (zero if no comparison function has been set)
+ */
+size_t stdlib_priorityqueue_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t i;
+
+	if (	(CONTAINER_TO_PRIORITYQUEUE(pstContainer)->pfnCompare == NULL)
+		||	(pstSeries->szNumItems == 0U)
+		||	(stdlib_vector_reserve(pstContainer, pstContainer->szNumItems + pstSeries->szNumItems) == false)	)
+	{
+		return 0;
+	}
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		heap_sift_up(pstContainer, pstContainer->szNumItems, stIt.pvData);
+		pstContainer->szNumItems++;
+	}
+
+	return i;
+}
+
+/**
+ * Pop the last-ranked items off a priority queue
+ *
+ * @param[in]	pstContainer	Priority queue container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_priorityqueue_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, stdlib_vector_at(pstContainer, 0U), pstContainer->szSizeofItem);
+		if (--pstContainer->szNumItems != 0U)
+		{
+			heap_sift_down(pstContainer, 0U);
+		}
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+// -------------------------------------------------------------------------
+
+static bool priorityqueue_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_vector_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_priorityqueue_default_itemhandler =
+{
+	.szElementSize = sizeof(std_priorityqueue_t),
+	.pfn_Destructor = &priorityqueue_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -0,0 +1,283 @@
+/*
+ * src/std_radix_heap.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Each bucket of the radix heap is a singly-linked stack of nodes, so that
+ * emptying a bucket into lower buckets only ever relinks nodes (without any
+ * items being copied, or any memory being allocated).
+ */
+
+#include "std/radix_heap.h"
+
+#define CONTAINER_TO_RADIX_HEAP(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_radix_heap_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find which bucket a key belongs in
+ *
+ * @param[in]	pstHeap		Radix heap
+ * @param[in]	u64Key		Key (no smaller than the last key popped)
+ *
+ * @return Bucket index (0 if the key equals the last key popped, else 1 + the highest bit in which they differ)
+ */
+static size_t key_bucket(const std_radix_heap_t * pstHeap, uint64_t u64Key)
+{
+	uint64_t u64Diff = u64Key ^ pstHeap->u64LastKey;
+
+	if (u64Diff == 0U)
+	{
+		return 0U;
+	}
+	return (size_t)(64 - __builtin_clzll(u64Diff));
+}
+
+/**
+ * Push a node onto the bucket where its key belongs
+ *
+ * @param[in]	pstHeap		Radix heap
+ * @param[in]	pstNode		Node (with its key already set)
+ */
+static void node_insert(std_radix_heap_t * pstHeap, std_radix_heap_node_t * pstNode)
+{
+	size_t szBucket = key_bucket(pstHeap, pstNode->u64Key);
+
+	pstNode->pstNext = pstHeap->apstBuckets[szBucket];
+	pstHeap->apstBuckets[szBucket] = pstNode;
+	if (szBucket != 0U)
+	{
+		pstHeap->u64Occupied |= 1ULL << (szBucket - 1U);
+	}
+}
+
+/**
+ * Refill bucket 0 by emptying the lowest non-empty bucket into the buckets below it
+ *
+ * @param[in]	pstHeap		Radix heap (with an empty bucket 0, but not completely empty)
+ */
+static void buckets_redistribute(std_radix_heap_t * pstHeap)
+{
+	size_t szBucket = (size_t)__builtin_ctzll(pstHeap->u64Occupied) + 1U;
+	std_radix_heap_node_t * pstNode = pstHeap->apstBuckets[szBucket];
+	std_radix_heap_node_t * pstNext;
+	uint64_t u64MinKey = pstNode->u64Key;
+
+	pstHeap->apstBuckets[szBucket] = NULL;
+	pstHeap->u64Occupied &= ~(1ULL << (szBucket - 1U));
+
+	// The smallest key in the bucket becomes the new reference point, so every node in it moves to a lower bucket
+	for (pstNext = pstNode->pstNext; pstNext != NULL; pstNext = pstNext->pstNext)
+	{
+		if (pstNext->u64Key < u64MinKey)
+		{
+			u64MinKey = pstNext->u64Key;
+		}
+	}
+	pstHeap->u64LastKey = u64MinKey;
+
+	while (pstNode != NULL)
+	{
+		pstNext = pstNode->pstNext;
+		node_insert(pstHeap, pstNode);
+		pstNode = pstNext;
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a radix heap container
+ *
+ * @param[in]	pstContainer	Radix heap to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (i.e. including its node header)
+ * @param[in]	szPayloadOffset	Offset of a raw (payload) item inside a wrapped (node) item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_radix_heap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_radix_heap_t * pstHeap = CONTAINER_TO_RADIX_HEAP(pstContainer);
+	size_t i;
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstHeap->szPayloadOffset = szPayloadOffset;
+	pstHeap->u64LastKey = 0U;
+	pstHeap->u64Occupied = 0U;
+	for (i = 0; i < STD_RADIX_HEAP_NUM_BUCKETS; i++)
+	{
+		pstHeap->apstBuckets[i] = NULL;
+	}
+	stdlib_node_pool_construct(&pstHeap->stPool, szWrappedSizeof);
+}
+
+/**
+ * Destruct a radix heap container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Radix heap container to destruct
+ *
+ * @return True if the radix heap was able to be destructed, else false
+ */
+bool stdlib_radix_heap_destruct(std_container_t * pstContainer)
+{
+	std_radix_heap_t * pstHeap = CONTAINER_TO_RADIX_HEAP(pstContainer);
+	std_radix_heap_node_t * pstNode;
+	size_t i;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// If an item handler is attached AND that item handler has a destructor, destruct each item in the container
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (i = 0; i < STD_RADIX_HEAP_NUM_BUCKETS; i++)
+		{
+			for (pstNode = pstHeap->apstBuckets[i]; pstNode != NULL; pstNode = pstNode->pstNext)
+			{
+				(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset));
+			}
+		}
+	}
+
+	// Freeing the pool frees all the nodes at once
+	stdlib_node_pool_destruct(&pstHeap->stPool, pstContainer);
+	for (i = 0; i < STD_RADIX_HEAP_NUM_BUCKETS; i++)
+	{
+		pstHeap->apstBuckets[i] = NULL;
+	}
+	pstHeap->u64Occupied = 0U;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve space within a radix heap container for a number of items
+ *
+ * @param[in]	pstContainer	Radix heap container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_radix_heap_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	if (szNewSize <= pstContainer->szNumItems)
+	{
+		return true;
+	}
+	return stdlib_node_pool_reserve(&CONTAINER_TO_RADIX_HEAP(pstContainer)->stPool, pstContainer, szNewSize - pstContainer->szNumItems);
+}
+
+/**
+ * Push an item into a radix heap
+ *
+ * @param[in]	pstContainer	Radix heap container
+ * @param[in]	u64Key			Key to push the item with
+ * @param[in]	pvItem			Item to push
+ *
+ * @return True if the item was pushed, false if out of memory or its key is smaller than the last key popped
+ */
+bool stdlib_radix_heap_push(std_container_t * pstContainer, uint64_t u64Key, const void * pvItem)
+{
+	std_radix_heap_t * pstHeap = CONTAINER_TO_RADIX_HEAP(pstContainer);
+	std_radix_heap_node_t * pstNode;
+
+	if (u64Key < pstHeap->u64LastKey)
+	{
+		return false;
+	}
+
+	pstNode = stdlib_node_pool_alloc(&pstHeap->stPool, pstContainer);
+	if (pstNode == NULL)
+	{
+		return false;
+	}
+
+	stdlib_container_relocate_items(pstContainer, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset), pvItem, 1U);
+	pstNode->u64Key = u64Key;
+	node_insert(pstHeap, pstNode);
+	pstContainer->szNumItems++;
+	return true;
+}
+
+/**
+ * Pop the items with the smallest keys off a radix heap
+ *
+ * @param[in]	pstContainer	Radix heap container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_radix_heap_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_radix_heap_t * pstHeap = CONTAINER_TO_RADIX_HEAP(pstContainer);
+	std_radix_heap_node_t * pstNode;
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		if (pstHeap->apstBuckets[0] == NULL)
+		{
+			buckets_redistribute(pstHeap);
+		}
+
+		pstNode = pstHeap->apstBuckets[0];
+		pstHeap->apstBuckets[0] = pstNode->pstNext;
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset), pstContainer->szSizeofItem);
+		stdlib_node_pool_free(&pstHeap->stPool, pstNode);
+		pstContainer->szNumItems--;
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+// -------------------------------------------------------------------------
+
+static bool radix_heap_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_radix_heap_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_radix_heap_default_itemhandler =
+{
+	.szElementSize = sizeof(std_radix_heap_t),
+	.pfn_Destructor = &radix_heap_default_destruct,
+	.pfn_Relocator = NULL
+};
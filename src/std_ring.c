@@ -150,7 +150,7 @@ bool stdlib_ring_destruct(std_container_t * pstContainer)
  * @param[in]	pstContainer	Ring container to reserve space for
  * @param[in]	szNewSize		New number of items
  * 
- * @return True if was able to reserve the memory OK, else false
+ * @return True if was able to reserve the memory OK, else false (also when optimistic reads pin the existing memory in place)
  */
 bool stdlib_ring_reserve(std_container_t * pstContainer, size_t szNewSize)
 {
@@ -174,6 +174,12 @@ bool stdlib_ring_reserve(std_container_t * pstContainer, size_t szNewSize)
 
 		if (szNewCapacity != szOldCapacity)
 		{
+			// Optimistic readers may be looking at the items, so once allocated they can't move
+			if (	(szOldCapacity != 0U)
+				&&	std_container_has_optimistic_reads(pstContainer, pstContainer->eHas)	)
+			{
+				return false;
+			}
 			pstRing->szNumAlloced = szNewCapacity;
 			size_t szTotalSize = szNewCapacity * pstContainer->szSizeofItem;
 			pvNewStart = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, szTotalSize);
@@ -0,0 +1,1204 @@
+/*
+ * src/std_set.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The B-tree follows Cormen et al ("Introduction to Algorithms", ch. 18):
+ * with t = szMinItems + 1, every node but the root holds between t - 1 and
+ * 2t - 1 items. Inserting splits any full node on the way down, and erasing
+ * tops up any minimal node on the way down (by borrowing an item through the
+ * parent from a sibling, or else merging with a sibling), so both are done
+ * in a single pass from the root.
+ *
+ * Items are erased by their index (found from each node's subtree count),
+ * so erasing by key is a lower-bound search followed by an erase by index.
+ */
+
+#include <string.h>
+
+#include "std/set.h"
+
+// Limits on t (the B-tree's minimum degree)
+#define MIN_DEGREE_MIN	2U
+#define MIN_DEGREE_MAX	64U
+
+#define CONTAINER_TO_SET(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_set_t, stContainer)
+#define ITERATOR_TO_SETIT(IT)			STD_CONTAINER_OF(IT, std_set_iterator_t, stIterator)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Round a size up to a multiple of an alignment
+ *
+ * @param[in]	szSize		Size
+ * @param[in]	szAlign		Alignment (a power of two)
+ *
+ * @return Rounded-up size
+ */
+static size_t round_up(size_t szSize, size_t szAlign)
+{
+	return (szSize + szAlign - 1U) & ~(szAlign - 1U);
+}
+
+/**
+ * Find the address of an item inside a node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Node
+ * @param[in]	szIndex		Index of the item inside the node
+ *
+ * @return Address of the item
+ */
+static void * node_item(const std_set_t * pstSet, const std_set_node_t * pstNode, size_t szIndex)
+{
+	return STD_LINEAR_ADD(pstNode, pstSet->szItemsOffset + (szIndex * pstSet->stContainer.szSizeofItem));
+}
+
+/**
+ * Find the child pointers of an internal node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Internal node
+ *
+ * @return Array of child pointers
+ */
+static std_set_node_t ** node_children(const std_set_t * pstSet, const std_set_node_t * pstNode)
+{
+	return (std_set_node_t **) STD_LINEAR_ADD(pstNode, pstSet->szChildrenOffset);
+}
+
+/**
+ * Find out whether one item (or key) is ranked after another
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pvA			First item
+ * @param[in]	pvB			Second item
+ *
+ * @return True if the first item is ranked strictly after the second item
+ */
+static bool item_is_after(const std_set_t * pstSet, const void * pvA, const void * pvB)
+{
+	return ((*pstSet->pfnCompare)(pvA, pvB) > 0);
+}
+
+/**
+ * Find the first item in a node that isn't ranked before a key
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Node
+ * @param[in]	pvKey		Key
+ *
+ * @return Index of the item (or the node's number of items, if there is none)
+ */
+static size_t node_lower_bound(const std_set_t * pstSet, const std_set_node_t * pstNode, const void * pvKey)
+{
+	size_t szLo = 0;
+	size_t szHi = pstNode->szNumItems;
+	size_t szMid;
+
+	while (szLo < szHi)
+	{
+		szMid = szLo + ((szHi - szLo) / 2U);
+		if (item_is_after(pstSet, pvKey, node_item(pstSet, pstNode, szMid)))
+		{
+			szLo = szMid + 1U;
+		}
+		else
+		{
+			szHi = szMid;
+		}
+	}
+	return szLo;
+}
+
+/**
+ * Find the first item in a node that is ranked after a key
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Node
+ * @param[in]	pvKey		Key
+ *
+ * @return Index of the item (or the node's number of items, if there is none)
+ */
+static size_t node_upper_bound(const std_set_t * pstSet, const std_set_node_t * pstNode, const void * pvKey)
+{
+	size_t szLo = 0;
+	size_t szHi = pstNode->szNumItems;
+	size_t szMid;
+
+	while (szLo < szHi)
+	{
+		szMid = szLo + ((szHi - szLo) / 2U);
+		if (item_is_after(pstSet, node_item(pstSet, pstNode, szMid), pvKey))
+		{
+			szHi = szMid;
+		}
+		else
+		{
+			szLo = szMid + 1U;
+		}
+	}
+	return szLo;
+}
+
+/**
+ * Allocate an empty node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	bLeaf		True for a leaf node, false for an internal node
+ *
+ * @return Node (or NULL if memory ran out)
+ */
+static std_set_node_t * node_alloc(std_set_t * pstSet, bool bLeaf)
+{
+	std_set_node_t * pstNode = stdlib_node_pool_alloc(bLeaf ? &pstSet->stLeafPool : &pstSet->stBranchPool, &pstSet->stContainer);
+
+	if (pstNode != NULL)
+	{
+		pstNode->pstParent = NULL;
+		pstNode->szCount = 0;
+		pstNode->szNumItems = 0;
+		pstNode->bLeaf = bLeaf;
+	}
+	return pstNode;
+}
+
+/**
+ * Free a node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Node
+ */
+static void node_free(std_set_t * pstSet, std_set_node_t * pstNode)
+{
+	stdlib_node_pool_free(pstNode->bLeaf ? &pstSet->stLeafPool : &pstSet->stBranchPool, pstNode);
+}
+
+/**
+ * Move a run of items (possibly within the same node)
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pvDst		Where to move the items to
+ * @param[in]	pvSrc		Where to move the items from
+ * @param[in]	szNumItems	Number of items
+ */
+static void items_move(std_set_t * pstSet, void * pvDst, const void * pvSrc, size_t szNumItems)
+{
+	if (szNumItems > 0)
+	{
+		stdlib_container_relocate_items(&pstSet->stContainer, pvDst, pvSrc, szNumItems);
+	}
+}
+
+/**
+ * Move a run of child pointers from one node to another, re-parenting them
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstDst		Node to move the children to
+ * @param[in]	szDst		Index of the first child in the destination node
+ * @param[in]	pstSrc		Node to move the children from
+ * @param[in]	szSrc		Index of the first child in the source node
+ * @param[in]	szNum		Number of children
+ */
+static void children_move(std_set_t * pstSet, std_set_node_t * pstDst, size_t szDst, const std_set_node_t * pstSrc, size_t szSrc, size_t szNum)
+{
+	std_set_node_t ** ppstDst = &node_children(pstSet, pstDst)[szDst];
+	size_t i;
+
+	memmove(ppstDst, &node_children(pstSet, pstSrc)[szSrc], szNum * sizeof(*ppstDst));
+	for (i = 0; i < szNum; i++)
+	{
+		ppstDst[i]->pstParent = pstDst;
+	}
+}
+
+/**
+ * Split the (full) child of a non-full internal node into two, moving its median item up into the node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Internal node
+ * @param[in]	szIndex		Index of the child to split
+ *
+ * @return True if the child was split, false if memory ran out
+ */
+static bool node_split_child(std_set_t * pstSet, std_set_node_t * pstNode, size_t szIndex)
+{
+	std_set_node_t ** ppstChildren = node_children(pstSet, pstNode);
+	std_set_node_t * pstLeft = ppstChildren[szIndex];
+	std_set_node_t * pstRight = node_alloc(pstSet, pstLeft->bLeaf);
+	size_t szMin = pstSet->szMinItems;
+	size_t i;
+
+	if (pstRight == NULL)
+	{
+		return false;
+	}
+
+	// The upper half of the child's items (and children) move to the new right-hand node
+	items_move(pstSet, node_item(pstSet, pstRight, 0), node_item(pstSet, pstLeft, szMin + 1U), szMin);
+	pstRight->szNumItems = szMin;
+	pstRight->szCount = szMin;
+	if (!pstLeft->bLeaf)
+	{
+		children_move(pstSet, pstRight, 0, pstLeft, szMin + 1U, szMin + 1U);
+		for (i = 0; i <= szMin; i++)
+		{
+			pstRight->szCount += node_children(pstSet, pstRight)[i]->szCount;
+		}
+	}
+	pstLeft->szNumItems = szMin;
+	pstLeft->szCount -= pstRight->szCount + 1U;
+
+	// ...and the median item moves up between them
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex + 1U), node_item(pstSet, pstNode, szIndex), pstNode->szNumItems - szIndex);
+	memmove(&ppstChildren[szIndex + 2U], &ppstChildren[szIndex + 1U], (pstNode->szNumItems - szIndex) * sizeof(*ppstChildren));
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex), node_item(pstSet, pstLeft, szMin), 1U);
+	ppstChildren[szIndex + 1U] = pstRight;
+	pstRight->pstParent = pstNode;
+	pstNode->szNumItems++;
+	return true;
+}
+
+/**
+ * Merge a child of an internal node, the item following it, and the next child into a single node
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Internal node
+ * @param[in]	szIndex		Index of the left-hand child (and of the item that moves down)
+ */
+static void node_merge_children(std_set_t * pstSet, std_set_node_t * pstNode, size_t szIndex)
+{
+	std_set_node_t ** ppstChildren = node_children(pstSet, pstNode);
+	std_set_node_t * pstLeft = ppstChildren[szIndex];
+	std_set_node_t * pstRight = ppstChildren[szIndex + 1U];
+	size_t szNumLeft = pstLeft->szNumItems;
+
+	items_move(pstSet, node_item(pstSet, pstLeft, szNumLeft), node_item(pstSet, pstNode, szIndex), 1U);
+	items_move(pstSet, node_item(pstSet, pstLeft, szNumLeft + 1U), node_item(pstSet, pstRight, 0), pstRight->szNumItems);
+	if (!pstLeft->bLeaf)
+	{
+		children_move(pstSet, pstLeft, szNumLeft + 1U, pstRight, 0, pstRight->szNumItems + 1U);
+	}
+	pstLeft->szNumItems += pstRight->szNumItems + 1U;
+	pstLeft->szCount += pstRight->szCount + 1U;
+
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex), node_item(pstSet, pstNode, szIndex + 1U), pstNode->szNumItems - szIndex - 1U);
+	memmove(&ppstChildren[szIndex + 1U], &ppstChildren[szIndex + 2U], (pstNode->szNumItems - szIndex - 1U) * sizeof(*ppstChildren));
+	pstNode->szNumItems--;
+
+	node_free(pstSet, pstRight);
+}
+
+/**
+ * Move an item from a child's left-hand sibling (through the parent) into the child
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Internal node
+ * @param[in]	szIndex		Index of the child (must be > 0)
+ *
+ * @return Number of items that the child gained in front of its existing items
+ */
+static size_t node_borrow_from_left(std_set_t * pstSet, std_set_node_t * pstNode, size_t szIndex)
+{
+	std_set_node_t ** ppstChildren = node_children(pstSet, pstNode);
+	std_set_node_t * pstLeft = ppstChildren[szIndex - 1U];
+	std_set_node_t * pstChild = ppstChildren[szIndex];
+	size_t szMoved = 1U;
+
+	items_move(pstSet, node_item(pstSet, pstChild, 1U), node_item(pstSet, pstChild, 0), pstChild->szNumItems);
+	items_move(pstSet, node_item(pstSet, pstChild, 0), node_item(pstSet, pstNode, szIndex - 1U), 1U);
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex - 1U), node_item(pstSet, pstLeft, pstLeft->szNumItems - 1U), 1U);
+	if (!pstChild->bLeaf)
+	{
+		memmove(&node_children(pstSet, pstChild)[1], &node_children(pstSet, pstChild)[0], (pstChild->szNumItems + 1U) * sizeof(*ppstChildren));
+		children_move(pstSet, pstChild, 0, pstLeft, pstLeft->szNumItems, 1U);
+		szMoved += node_children(pstSet, pstChild)[0]->szCount;
+	}
+	pstLeft->szNumItems--;
+	pstLeft->szCount -= szMoved;
+	pstChild->szNumItems++;
+	pstChild->szCount += szMoved;
+	return szMoved;
+}
+
+/**
+ * Move an item from a child's right-hand sibling (through the parent) into the child
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Internal node
+ * @param[in]	szIndex		Index of the child (must be < the node's number of items)
+ */
+static void node_borrow_from_right(std_set_t * pstSet, std_set_node_t * pstNode, size_t szIndex)
+{
+	std_set_node_t ** ppstChildren = node_children(pstSet, pstNode);
+	std_set_node_t * pstChild = ppstChildren[szIndex];
+	std_set_node_t * pstRight = ppstChildren[szIndex + 1U];
+	size_t szMoved = 1U;
+
+	items_move(pstSet, node_item(pstSet, pstChild, pstChild->szNumItems), node_item(pstSet, pstNode, szIndex), 1U);
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex), node_item(pstSet, pstRight, 0), 1U);
+	items_move(pstSet, node_item(pstSet, pstRight, 0), node_item(pstSet, pstRight, 1U), pstRight->szNumItems - 1U);
+	if (!pstChild->bLeaf)
+	{
+		children_move(pstSet, pstChild, pstChild->szNumItems + 1U, pstRight, 0, 1U);
+		szMoved += node_children(pstSet, pstChild)[pstChild->szNumItems + 1U]->szCount;
+		memmove(&node_children(pstSet, pstRight)[0], &node_children(pstSet, pstRight)[1], pstRight->szNumItems * sizeof(*ppstChildren));
+	}
+	pstRight->szNumItems--;
+	pstRight->szCount -= szMoved;
+	pstChild->szNumItems++;
+	pstChild->szCount += szMoved;
+}
+
+/**
+ * Find the node (and the index inside it) holding the item with a given index
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	szRank		Index of the item in the whole set (must be < the number of items)
+ * @param[out]	pszIndex	Index of the item inside the node
+ *
+ * @return Node holding the item
+ */
+static std_set_node_t * node_at_rank(const std_set_t * pstSet, size_t szRank, size_t * pszIndex)
+{
+	std_set_node_t * pstNode = pstSet->pstRoot;
+	std_set_node_t ** ppstChildren;
+	size_t i;
+
+	while (!pstNode->bLeaf)
+	{
+		ppstChildren = node_children(pstSet, pstNode);
+		for (i = 0; ; i++)
+		{
+			if (szRank < ppstChildren[i]->szCount)
+			{
+				break;
+			}
+			szRank -= ppstChildren[i]->szCount;
+			if (szRank == 0)
+			{
+				*pszIndex = i;
+				return pstNode;
+			}
+			szRank--;
+		}
+		pstNode = ppstChildren[i];
+	}
+	*pszIndex = szRank;
+	return pstNode;
+}
+
+/**
+ * Find the index of a child inside its parent
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	pstNode		Child node (must have a parent)
+ *
+ * @return Index of the child
+ */
+static size_t node_index_in_parent(const std_set_t * pstSet, const std_set_node_t * pstNode)
+{
+	std_set_node_t ** ppstChildren = node_children(pstSet, pstNode->pstParent);
+	size_t i = 0;
+
+	while (ppstChildren[i] != pstNode)
+	{
+		i++;
+	}
+	return i;
+}
+
+/**
+ * Step from an item to the next item in order
+ *
+ * @param[in]		pstSet		Set
+ * @param[in,out]	ppstNode	Node holding the item
+ * @param[in,out]	pszIndex	Index of the item inside its node
+ */
+static void step_next(const std_set_t * pstSet, std_set_node_t ** ppstNode, size_t * pszIndex)
+{
+	std_set_node_t * pstNode = *ppstNode;
+	size_t szIndex = *pszIndex + 1U;
+
+	if (!pstNode->bLeaf)
+	{
+		// Down to the first item of the subtree to the item's right
+		pstNode = node_children(pstSet, pstNode)[szIndex];
+		while (!pstNode->bLeaf)
+		{
+			pstNode = node_children(pstSet, pstNode)[0];
+		}
+		szIndex = 0;
+	}
+	else
+	{
+		// Up until the subtree just finished isn't the last child
+		while ((szIndex >= pstNode->szNumItems) && (pstNode->pstParent != NULL))
+		{
+			szIndex = node_index_in_parent(pstSet, pstNode);
+			pstNode = pstNode->pstParent;
+		}
+	}
+	*ppstNode = pstNode;
+	*pszIndex = szIndex;
+}
+
+/**
+ * Step from an item to the previous item in order
+ *
+ * @param[in]		pstSet		Set
+ * @param[in,out]	ppstNode	Node holding the item
+ * @param[in,out]	pszIndex	Index of the item inside its node
+ */
+static void step_prev(const std_set_t * pstSet, std_set_node_t ** ppstNode, size_t * pszIndex)
+{
+	std_set_node_t * pstNode = *ppstNode;
+	size_t szIndex = *pszIndex;
+
+	if (!pstNode->bLeaf)
+	{
+		// Down to the last item of the subtree to the item's left
+		pstNode = node_children(pstSet, pstNode)[szIndex];
+		while (!pstNode->bLeaf)
+		{
+			pstNode = node_children(pstSet, pstNode)[pstNode->szNumItems];
+		}
+		szIndex = pstNode->szNumItems;
+	}
+	else
+	{
+		// Up until the subtree just finished isn't the first child
+		while ((szIndex == 0) && (pstNode->pstParent != NULL))
+		{
+			szIndex = node_index_in_parent(pstSet, pstNode);
+			pstNode = pstNode->pstParent;
+		}
+	}
+	*ppstNode = pstNode;
+	*pszIndex = szIndex - 1U;
+}
+
+/**
+ * Erase the item with a given index from a set
+ *
+ * @param[in]	pstSet		Set
+ * @param[in]	szRank		Index of the item in the whole set (must be < the number of items)
+ * @param[out]	pvResult	Where to move the erased item to (or NULL to destruct it)
+ */
+static void erase_at_rank(std_set_t * pstSet, size_t szRank, void * pvResult)
+{
+	std_container_t * pstContainer = &pstSet->stContainer;
+	std_set_node_t * pstNode = pstSet->pstRoot;
+	std_set_node_t ** ppstChildren;
+	std_set_node_t * pstChild;
+	size_t szMin = pstSet->szMinItems;
+	size_t i;
+
+	for (;;)
+	{
+		// Exactly one item is leaving this node's subtree
+		pstNode->szCount--;
+
+		if (pstNode->bLeaf)
+		{
+			stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_item(pstSet, pstNode, szRank), pstContainer->szSizeofItem);
+			items_move(pstSet, node_item(pstSet, pstNode, szRank), node_item(pstSet, pstNode, szRank + 1U), pstNode->szNumItems - szRank - 1U);
+			pstNode->szNumItems--;
+			break;
+		}
+
+		// Find the child subtree (or the item in this node) holding the item
+		ppstChildren = node_children(pstSet, pstNode);
+		for (i = 0; szRank > ppstChildren[i]->szCount; i++)
+		{
+			szRank -= ppstChildren[i]->szCount + 1U;
+		}
+
+		if (szRank == ppstChildren[i]->szCount)
+		{
+			// The item is in this node: replace it with its predecessor or successor, else merge around it
+			if (ppstChildren[i]->szNumItems > szMin)
+			{
+				stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_item(pstSet, pstNode, i), pstContainer->szSizeofItem);
+				pvResult = node_item(pstSet, pstNode, i);
+				pstNode = ppstChildren[i];
+				szRank = pstNode->szCount - 1U;
+			}
+			else if (ppstChildren[i + 1U]->szNumItems > szMin)
+			{
+				stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_item(pstSet, pstNode, i), pstContainer->szSizeofItem);
+				pvResult = node_item(pstSet, pstNode, i);
+				pstNode = ppstChildren[i + 1U];
+				szRank = 0;
+			}
+			else
+			{
+				pstChild = ppstChildren[i];
+				node_merge_children(pstSet, pstNode, i);
+				pstNode = pstChild;
+			}
+			continue;
+		}
+
+		// The item is inside a child subtree: make sure that child can lose an item before descending
+		pstChild = ppstChildren[i];
+		if (pstChild->szNumItems == szMin)
+		{
+			if ((i > 0) && (ppstChildren[i - 1U]->szNumItems > szMin))
+			{
+				szRank += node_borrow_from_left(pstSet, pstNode, i);
+			}
+			else if ((i < pstNode->szNumItems) && (ppstChildren[i + 1U]->szNumItems > szMin))
+			{
+				node_borrow_from_right(pstSet, pstNode, i);
+			}
+			else if (i < pstNode->szNumItems)
+			{
+				node_merge_children(pstSet, pstNode, i);
+			}
+			else
+			{
+				pstChild = ppstChildren[i - 1U];
+				szRank += pstChild->szCount + 1U;
+				node_merge_children(pstSet, pstNode, i - 1U);
+			}
+		}
+		pstNode = pstChild;
+	}
+
+	// The root can be left empty by a merge (or by erasing the set's last item)
+	pstNode = pstSet->pstRoot;
+	if (pstNode->szNumItems == 0)
+	{
+		pstSet->pstRoot = pstNode->bLeaf ? NULL : node_children(pstSet, pstNode)[0];
+		if (pstSet->pstRoot != NULL)
+		{
+			pstSet->pstRoot->pstParent = NULL;
+		}
+		node_free(pstSet, pstNode);
+	}
+	pstContainer->szNumItems--;
+}
+
+/**
+ * Construct a set or multiset container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ * @param[in]	bMulti			True if items with equal keys are allowed
+ */
+static void set_construct(std_container_t * pstContainer, size_t szSizeof, std_container_has_t eHas, bool bMulti)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	size_t szAlign = STD_ALIGNOF(max_align_t);
+	size_t szDegree = ((STD_SET_NODE_BYTES / szSizeof) + 1U) / 2U;
+
+	if (szDegree < MIN_DEGREE_MIN)
+	{
+		szDegree = MIN_DEGREE_MIN;
+	}
+	if (szDegree > MIN_DEGREE_MAX)
+	{
+		szDegree = MIN_DEGREE_MAX;
+	}
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstSet->pfnCompare = NULL;
+	pstSet->pstRoot = NULL;
+	pstSet->bMulti = bMulti;
+	pstSet->szMinItems = szDegree - 1U;
+	pstSet->szMaxItems = (2U * szDegree) - 1U;
+	pstSet->szItemsOffset = round_up(sizeof(std_set_node_t), szAlign);
+	pstSet->szChildrenOffset = round_up(pstSet->szItemsOffset + (pstSet->szMaxItems * szSizeof), sizeof(std_set_node_t *));
+
+	stdlib_node_pool_construct(&pstSet->stLeafPool, round_up(pstSet->szItemsOffset + (pstSet->szMaxItems * szSizeof), szAlign));
+	stdlib_node_pool_construct(&pstSet->stBranchPool, round_up(pstSet->szChildrenOffset + ((pstSet->szMaxItems + 1U) * sizeof(std_set_node_t *)), szAlign));
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (unused)
+ * @param[in]	szPayloadOffset	Offset of a raw item inside a wrapped item (unused)
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	if (szWrappedSizeof || szPayloadOffset) { /* Unused parameters */ }
+	set_construct(pstContainer, szSizeof, eHas, false);
+}
+
+/**
+ * Construct a multiset container
+ *
+ * @param[in]	pstContainer	Multiset container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (unused)
+ * @param[in]	szPayloadOffset	Offset of a raw item inside a wrapped item (unused)
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_multiset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	if (szWrappedSizeof || szPayloadOffset) { /* Unused parameters */ }
+	set_construct(pstContainer, szSizeof, eHas, true);
+}
+
+/**
+ * Destruct a set container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Set container to destruct
+ *
+ * @return True if the set was able to be destructed, else false
+ */
+bool stdlib_set_destruct(std_container_t * pstContainer)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode;
+	size_t szIndex;
+	size_t i;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// If an item handler is attached AND that item handler has a destructor, destruct each item in the container
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)
+		&&	(pstContainer->szNumItems > 0)	)
+	{
+		pstNode = node_at_rank(pstSet, 0, &szIndex);
+		for (i = 0; i < pstContainer->szNumItems; i++)
+		{
+			(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, node_item(pstSet, pstNode, szIndex));
+			if (i + 1U < pstContainer->szNumItems)
+			{
+				step_next(pstSet, &pstNode, &szIndex);
+			}
+		}
+	}
+
+	// Freeing the pools frees all the nodes at once
+	stdlib_node_pool_destruct(&pstSet->stLeafPool, pstContainer);
+	stdlib_node_pool_destruct(&pstSet->stBranchPool, pstContainer);
+	pstSet->pstRoot = NULL;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve space within a set container for a number of items
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_set_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+
+	if (szNewSize <= pstContainer->szNumItems)
+	{
+		return true;
+	}
+
+	// Enough leaves for the new items even if every leaf ends up only just over half-full
+	return stdlib_node_pool_reserve(&pstSet->stLeafPool, pstContainer, ((szNewSize - pstContainer->szNumItems) / (pstSet->szMinItems + 1U)) + 1U);
+}
+
+/**
+ * Set the comparison function that a set orders its items by
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_set_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_SET(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Find an item matching a key in a set
+ *
+ * Note: in a multiset, this is the first of the items with an equal key
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Pointer to a matching item (or NULL if there isn't one)
+ */
+void * stdlib_set_find(std_container_t * pstContainer, const void * pvKey)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode = pstSet->pstRoot;
+	void * pvFound = NULL;
+	size_t szIndex;
+
+	if (pstSet->pfnCompare == NULL)
+	{
+		return NULL;
+	}
+
+	while (pstNode != NULL)
+	{
+		szIndex = node_lower_bound(pstSet, pstNode, pvKey);
+		if (	(szIndex < pstNode->szNumItems)
+			&&	!item_is_after(pstSet, node_item(pstSet, pstNode, szIndex), pvKey)	)
+		{
+			pvFound = node_item(pstSet, pstNode, szIndex);
+
+			// Earlier equal items in a multiset can only be down the child to the left
+			if (!pstSet->bMulti)
+			{
+				break;
+			}
+		}
+		pstNode = pstNode->bLeaf ? NULL : node_children(pstSet, pstNode)[szIndex];
+	}
+	return pvFound;
+}
+
+/**
+ * Insert an item into a set
+ *
+ * Note: multisets always insert the item (after any items with an equal key)
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pvItem			Item to insert
+ * @param[in]	bReplace		If true, an item with an equal key in a set is replaced (and destructed)
+ * @param[out]	pbInserted		Set to true if the item was inserted (or replaced an existing item)
+ *
+ * @return Pointer to the set's item with the key (or NULL if memory ran out)
+ */
+void * stdlib_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode;
+	std_set_node_t * pstRoot;
+	void * pvSlot;
+	size_t szIndex;
+
+	*pbInserted = false;
+	if (pstSet->pfnCompare == NULL)
+	{
+		return NULL;
+	}
+
+	if (!pstSet->bMulti)
+	{
+		pvSlot = stdlib_set_find(pstContainer, pvItem);
+		if (pvSlot != NULL)
+		{
+			if (bReplace)
+			{
+				stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, NULL, pvSlot, pstContainer->szSizeofItem);
+				stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+				*pbInserted = true;
+			}
+			return pvSlot;
+		}
+	}
+
+	if (pstSet->pstRoot == NULL)
+	{
+		pstSet->pstRoot = node_alloc(pstSet, true);
+		if (pstSet->pstRoot == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	// A full root gets split by growing a new root above it
+	if (pstSet->pstRoot->szNumItems == pstSet->szMaxItems)
+	{
+		pstRoot = node_alloc(pstSet, false);
+		if (pstRoot == NULL)
+		{
+			return NULL;
+		}
+		node_children(pstSet, pstRoot)[0] = pstSet->pstRoot;
+		pstRoot->szCount = pstSet->pstRoot->szCount;
+		pstSet->pstRoot->pstParent = pstRoot;
+		pstSet->pstRoot = pstRoot;
+		if (!node_split_child(pstSet, pstRoot, 0))
+		{
+			// Put the old root back, rather than leave an empty root above it
+			pstSet->pstRoot = node_children(pstSet, pstRoot)[0];
+			pstSet->pstRoot->pstParent = NULL;
+			node_free(pstSet, pstRoot);
+			return NULL;
+		}
+	}
+
+	// Walk down to a leaf, splitting any full nodes on the way
+	pstNode = pstSet->pstRoot;
+	for (;;)
+	{
+		szIndex = node_upper_bound(pstSet, pstNode, pvItem);
+		if (pstNode->bLeaf)
+		{
+			break;
+		}
+		if (node_children(pstSet, pstNode)[szIndex]->szNumItems == pstSet->szMaxItems)
+		{
+			if (!node_split_child(pstSet, pstNode, szIndex))
+			{
+				return NULL;
+			}
+			if (!item_is_after(pstSet, node_item(pstSet, pstNode, szIndex), pvItem))
+			{
+				szIndex++;
+			}
+		}
+		pstNode = node_children(pstSet, pstNode)[szIndex];
+	}
+
+	pvSlot = node_item(pstSet, pstNode, szIndex);
+	items_move(pstSet, node_item(pstSet, pstNode, szIndex + 1U), pvSlot, pstNode->szNumItems - szIndex);
+	stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+	pstNode->szNumItems++;
+	for (; pstNode != NULL; pstNode = pstNode->pstParent)
+	{
+		pstNode->szCount++;
+	}
+	pstContainer->szNumItems++;
+	*pbInserted = true;
+	return pvSlot;
+}
+
+/**
+ * Find the index of the first item in a set that isn't ranked before a key
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+size_t stdlib_set_lower_bound(std_container_t * pstContainer, const void * pvKey)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode = pstSet->pstRoot;
+	size_t szRank = 0;
+	size_t szIndex;
+	size_t i;
+
+	while ((pstNode != NULL) && (pstSet->pfnCompare != NULL))
+	{
+		szIndex = node_lower_bound(pstSet, pstNode, pvKey);
+		szRank += szIndex;
+		if (pstNode->bLeaf)
+		{
+			return szRank;
+		}
+		for (i = 0; i < szIndex; i++)
+		{
+			szRank += node_children(pstSet, pstNode)[i]->szCount;
+		}
+		pstNode = node_children(pstSet, pstNode)[szIndex];
+	}
+	return pstContainer->szNumItems;
+}
+
+/**
+ * Find the index of the first item in a set that is ranked after a key
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Index of the item (or the number of items in the set, if there is no such item)
+ */
+size_t stdlib_set_upper_bound(std_container_t * pstContainer, const void * pvKey)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode = pstSet->pstRoot;
+	size_t szRank = 0;
+	size_t szIndex;
+	size_t i;
+
+	while ((pstNode != NULL) && (pstSet->pfnCompare != NULL))
+	{
+		szIndex = node_upper_bound(pstSet, pstNode, pvKey);
+		szRank += szIndex;
+		if (pstNode->bLeaf)
+		{
+			return szRank;
+		}
+		for (i = 0; i < szIndex; i++)
+		{
+			szRank += node_children(pstSet, pstNode)[i]->szCount;
+		}
+		pstNode = node_children(pstSet, pstNode)[szIndex];
+	}
+	return pstContainer->szNumItems;
+}
+
+/**
+ * Erase the first item matching a key from a set
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pvKey			Key
+ * @param[out]	pvResult		Where to move the erased item to (or NULL to destruct it)
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+bool stdlib_set_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	size_t szRank = stdlib_set_lower_bound(pstContainer, pvKey);
+
+	if (	(szRank >= pstContainer->szNumItems)
+		||	item_is_after(pstSet, stdlib_set_at(pstContainer, szRank), pvKey)	)
+	{
+		return false;
+	}
+	erase_at_rank(pstSet, szRank, pvResult);
+	return true;
+}
+
+/**
+ * Push a series of items into a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (a set doesn't push items whose key it already holds)
+ */
+size_t stdlib_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t szNumPushed = 0;
+	bool bInserted;
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		stdlib_set_insert(pstContainer, stIt.pvData, false, &bInserted);
+		if (bInserted)
+		{
+			szNumPushed++;
+		}
+	}
+	return szNumPushed;
+}
+
+/**
+ * Pop the first-ranked (e.g. smallest) items from a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_set_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	for (i = 0; (i < szMaxItems) && (pstContainer->szNumItems > 0); i++)
+	{
+		erase_at_rank(CONTAINER_TO_SET(pstContainer), 0, pvResult);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	return i;
+}
+
+/**
+ * Pop the last-ranked (e.g. largest) items from a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_set_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	for (i = 0; (i < szMaxItems) && (pstContainer->szNumItems > 0); i++)
+	{
+		erase_at_rank(CONTAINER_TO_SET(pstContainer), pstContainer->szNumItems - 1U, pvResult);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	return i;
+}
+
+/**
+ * Find the item with a given index (in sorted order) in a set
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	szIndex			Index
+ *
+ * @return Pointer to the item (or NULL if the index is out of range)
+ */
+void * stdlib_set_at(std_container_t * pstContainer, size_t szIndex)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_node_t * pstNode;
+
+	if (szIndex >= pstContainer->szNumItems)
+	{
+		return NULL;
+	}
+	pstNode = node_at_rank(pstSet, szIndex, &szIndex);
+	return node_item(pstSet, pstNode, szIndex);
+}
+
+/**
+ * Construct a forward iterator for a range of items in a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item
+ * @param[in]	szLast			Index of the last item
+ */
+void stdlib_set_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_iterator_t * pstSetIt = ITERATOR_TO_SETIT(pstIterator);
+
+	if (szLast >= pstContainer->szNumItems)
+	{
+		szLast = pstContainer->szNumItems - 1U;
+	}
+	if ((pstContainer->szNumItems == 0) || (szLast < szFirst))
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		pstSetIt->pstNode = node_at_rank(pstSet, szFirst, &pstSetIt->szIndex);
+		stdlib_iterator_construct(pstIterator, pstContainer, node_item(pstSet, pstSetIt->pstNode, pstSetIt->szIndex));
+		pstIterator->pvBegin = NULL;
+		pstIterator->pvEnd = NULL;
+		pstIterator->pvNext = NULL;
+		pstSetIt->szRemaining = szLast - szFirst;
+	}
+}
+
+/**
+ * Construct a reverse iterator for a range of items in a set container
+ *
+ * @param[in]	pstContainer	Set container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item (counting back from the last item)
+ * @param[in]	szLast			Index of the last item (counting back from the last item)
+ */
+void stdlib_set_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstContainer);
+	std_set_iterator_t * pstSetIt = ITERATOR_TO_SETIT(pstIterator);
+
+	if (szLast >= pstContainer->szNumItems)
+	{
+		szLast = pstContainer->szNumItems - 1U;
+	}
+	if ((pstContainer->szNumItems == 0) || (szLast < szFirst))
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		pstSetIt->pstNode = node_at_rank(pstSet, (pstContainer->szNumItems - 1U) - szFirst, &pstSetIt->szIndex);
+		stdlib_iterator_construct(pstIterator, pstContainer, node_item(pstSet, pstSetIt->pstNode, pstSetIt->szIndex));
+		pstIterator->pvBegin = NULL;
+		pstIterator->pvEnd = NULL;
+		pstIterator->pvNext = NULL;
+		pstSetIt->szRemaining = szLast - szFirst;
+	}
+}
+
+/**
+ * Step a set iterator forwards to the next item
+ *
+ * @param[in]	pstIterator		Set iterator
+ */
+void stdlib_set_forwarditerator_next(std_iterator_t * pstIterator)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstIterator->pstContainer);
+	std_set_iterator_t * pstSetIt = ITERATOR_TO_SETIT(pstIterator);
+
+	if (pstSetIt->szRemaining == 0)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		step_next(pstSet, &pstSetIt->pstNode, &pstSetIt->szIndex);
+		pstIterator->pvRef = node_item(pstSet, pstSetIt->pstNode, pstSetIt->szIndex);
+		pstSetIt->szRemaining--;
+	}
+}
+
+/**
+ * Step a set iterator backwards to the previous item
+ *
+ * @param[in]	pstIterator		Set iterator
+ */
+void stdlib_set_reverseiterator_next(std_iterator_t * pstIterator)
+{
+	std_set_t * pstSet = CONTAINER_TO_SET(pstIterator->pstContainer);
+	std_set_iterator_t * pstSetIt = ITERATOR_TO_SETIT(pstIterator);
+
+	if (pstSetIt->szRemaining == 0)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		step_prev(pstSet, &pstSetIt->pstNode, &pstSetIt->szIndex);
+		pstIterator->pvRef = node_item(pstSet, pstSetIt->pstNode, pstSetIt->szIndex);
+		pstSetIt->szRemaining--;
+	}
+}
+
+// -------------------------------------------------------------------------
+
+static bool set_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_set_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_set_default_itemhandler =
+{
+	.szElementSize = sizeof(std_set_t),
+	.pfn_Destructor = &set_default_destruct,
+	.pfn_Relocator = NULL
+};
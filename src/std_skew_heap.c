@@ -0,0 +1,328 @@
+/*
+ * src/std_skew_heap.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The skew heap is melded top-down (Sleator & Tarjan, "Self-Adjusting Heaps",
+ * SIAM J. Comput. 1986): walking down the right-hand paths of both heaps,
+ * the better of the two current nodes is linked in next, its old left child
+ * becomes its right child, and the rest of the meld continues down its left.
+ * This needs no recursion (and so no stack) however unbalanced the tree is.
+ */
+
+#include "std/skew_heap.h"
+
+#define CONTAINER_TO_SKEW_HEAP(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_skew_heap_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find out whether one node should sit above another node in the heap
+ *
+ * @param[in]	pstHeap		Skew heap
+ * @param[in]	pstA		First node
+ * @param[in]	pstB		Second node
+ *
+ * @return True if the first node's item ranks strictly later than the second node's item
+ */
+static bool node_is_better(const std_skew_heap_t * pstHeap, const std_skew_heap_node_t * pstA, const std_skew_heap_node_t * pstB)
+{
+	return ((*pstHeap->pfnCompare)(STD_LINEAR_ADD(pstA, pstHeap->szPayloadOffset), STD_LINEAR_ADD(pstB, pstHeap->szPayloadOffset)) > 0);
+}
+
+/**
+ * Meld two heaps of nodes together
+ *
+ * @param[in]	pstHeap		Skew heap (for its comparison function)
+ * @param[in]	pstA		Root of first heap (or NULL)
+ * @param[in]	pstB		Root of second heap (or NULL)
+ *
+ * @return Root of the melded heap
+ */
+static std_skew_heap_node_t * node_meld(const std_skew_heap_t * pstHeap, std_skew_heap_node_t * pstA, std_skew_heap_node_t * pstB)
+{
+	std_skew_heap_node_t * pstRoot = NULL;
+	std_skew_heap_node_t ** ppstLink = &pstRoot;
+	std_skew_heap_node_t * pstNext;
+
+	while ((pstA != NULL) && (pstB != NULL))
+	{
+		// Keep the better node in pstA
+		if (node_is_better(pstHeap, pstB, pstA))
+		{
+			pstNext = pstA;
+			pstA = pstB;
+			pstB = pstNext;
+		}
+
+		*ppstLink = pstA;
+		pstNext = pstA->pstRight;
+		pstA->pstRight = pstA->pstLeft;
+		ppstLink = &pstA->pstLeft;
+		pstA = pstNext;
+	}
+	*ppstLink = (pstA != NULL) ? pstA : pstB;
+
+	return pstRoot;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a skew heap container
+ *
+ * @param[in]	pstContainer	Skew heap to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (i.e. including its node header)
+ * @param[in]	szPayloadOffset	Offset of a raw (payload) item inside a wrapped (node) item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_skew_heap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstHeap->szPayloadOffset = szPayloadOffset;
+	pstHeap->pfnCompare = NULL;
+	pstHeap->pstRoot = NULL;
+	stdlib_node_pool_construct_movable(&pstHeap->stPool, szWrappedSizeof);
+}
+
+/**
+ * Destruct a skew heap container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Skew heap container to destruct
+ *
+ * @return True if the skew heap was able to be destructed, else false
+ */
+bool stdlib_skew_heap_destruct(std_container_t * pstContainer)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+	std_skew_heap_node_t * pstNode;
+	std_skew_heap_node_t * pstLeft;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// Rotate left children up until there are none, so that the tree can be walked as a list
+	pstNode = pstHeap->pstRoot;
+	while (pstNode != NULL)
+	{
+		pstLeft = pstNode->pstLeft;
+		if (pstLeft != NULL)
+		{
+			pstNode->pstLeft = pstLeft->pstRight;
+			pstLeft->pstRight = pstNode;
+			pstNode = pstLeft;
+		}
+		else
+		{
+			// If an item handler is attached AND that item handler has a destructor, destruct the item
+			if (	(pstContainer->eHas & std_container_has_itemhandler)
+				&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+			{
+				(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset));
+			}
+
+			// Nodes melded in from another heap have to go back to their own pool, so free each node rather than the whole pool at once
+			pstLeft = pstNode->pstRight;
+			stdlib_node_pool_free(&pstHeap->stPool, pstNode);
+			pstNode = pstLeft;
+		}
+	}
+	stdlib_node_pool_destruct(&pstHeap->stPool, pstContainer);
+	pstHeap->pstRoot = NULL;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve space within a skew heap container for a number of items
+ *
+ * @param[in]	pstContainer	Skew heap container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_skew_heap_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	if (szNewSize <= pstContainer->szNumItems)
+	{
+		return true;
+	}
+	return stdlib_node_pool_reserve(&CONTAINER_TO_SKEW_HEAP(pstContainer)->stPool, pstContainer, szNewSize - pstContainer->szNumItems);
+}
+
+/**
+ * Set the comparison function that a skew heap orders its items by
+ *
+ * @param[in]	pstContainer	Skew heap container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_skew_heap_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_SKEW_HEAP(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Push a series of items into a skew heap container
+ *
+ * @param[in]	pstContainer	Skew heap container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (zero if no comparison function has been set)
+ */
+size_t stdlib_skew_heap_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+	std_linear_series_iterator_t stIt;
+	std_skew_heap_node_t * pstNode;
+	size_t i;
+
+	if (pstHeap->pfnCompare == NULL)
+	{
+		return 0;
+	}
+
+	stdlib_node_pool_reserve(&pstHeap->stPool, pstContainer, pstSeries->szNumItems);
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		pstNode = stdlib_node_pool_alloc(&pstHeap->stPool, pstContainer);
+		if (pstNode == NULL)
+		{
+			break;
+		}
+		stdlib_container_relocate_items(pstContainer, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset), stIt.pvData, 1U);
+		pstNode->pstLeft = NULL;
+		pstNode->pstRight = NULL;
+		pstHeap->pstRoot = node_meld(pstHeap, pstHeap->pstRoot, pstNode);
+		pstContainer->szNumItems++;
+	}
+
+	return i;
+}
+
+/**
+ * Pop the last-ranked items off a skew heap
+ *
+ * @param[in]	pstContainer	Skew heap container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_skew_heap_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+	std_skew_heap_node_t * pstNode;
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		pstNode = pstHeap->pstRoot;
+		pstHeap->pstRoot = node_meld(pstHeap, pstNode->pstLeft, pstNode->pstRight);
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, STD_LINEAR_ADD(pstNode, pstHeap->szPayloadOffset), pstContainer->szSizeofItem);
+		stdlib_node_pool_free(&pstHeap->stPool, pstNode);
+		pstContainer->szNumItems--;
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+/**
+ * Find the item that a skew heap would pop next
+ *
+ * @param[in]	pstContainer	Skew heap container
+ *
+ * @return Pointer to the item (or NULL if the skew heap is empty)
+ */
+void * stdlib_skew_heap_top(std_container_t * pstContainer)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+
+	return (pstHeap->pstRoot == NULL) ? NULL : STD_LINEAR_ADD(pstHeap->pstRoot, pstHeap->szPayloadOffset);
+}
+
+/**
+ * Meld all the items of one skew heap into another (by relinking their nodes), leaving the source skew heap empty
+ *
+ * @param[in]	pstContainer	Destination skew heap container
+ * @param[in]	pstSource		Source skew heap container
+ *
+ * @return True if the skew heaps were melded, else false
+ */
+bool stdlib_skew_heap_meld(std_container_t * pstContainer, std_container_t * pstSource)
+{
+	std_skew_heap_t * pstHeap = CONTAINER_TO_SKEW_HEAP(pstContainer);
+	std_skew_heap_t * pstSourceHeap = CONTAINER_TO_SKEW_HEAP(pstSource);
+
+	if ((pstContainer == pstSource) || (pstSource->szNumItems == 0U))
+	{
+		return true;
+	}
+	if (	(pstHeap->pfnCompare == NULL)
+		||	(stdlib_node_pool_lend(&pstSourceHeap->stPool, pstSource, &pstHeap->stPool, pstContainer) == false)	)
+	{
+		return false;
+	}
+
+	pstHeap->pstRoot = node_meld(pstHeap, pstHeap->pstRoot, pstSourceHeap->pstRoot);
+	pstContainer->szNumItems += pstSource->szNumItems;
+
+	pstSourceHeap->pstRoot = NULL;
+	pstSource->szNumItems = 0;
+
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+static bool skew_heap_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_skew_heap_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_skew_heap_default_itemhandler =
+{
+	.szElementSize = sizeof(std_skew_heap_t),
+	.pfn_Destructor = &skew_heap_default_destruct,
+	.pfn_Relocator = NULL
+};
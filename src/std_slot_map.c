@@ -0,0 +1,386 @@
+/*
+ * src/std_slot_map.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The slot map's items live in a vector, alongside two arrays: one holding
+ * every slot (its item's vector index and its generation), the other holding
+ * the slot of the item at each vector index. Free slots are chained together
+ * through their index fields, so that slots can be reused without any extra
+ * memory.
+ */
+
+#include "std/slot_map.h"
+
+#define CONTAINER_TO_SLOT_MAP(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_slot_map_t, stContainer)
+
+#define NO_SLOT		UINT32_MAX
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Store a slot's vector index (and the vector index's slot)
+ *
+ * @param[in]	pstSlotMap		Slot map
+ * @param[in]	szIndex			Vector index
+ * @param[in]	u32Slot			Slot
+ */
+static void slot_link(std_slot_map_t * pstSlotMap, size_t szIndex, uint32_t u32Slot)
+{
+	pstSlotMap->pu32IndexToSlot[szIndex] = u32Slot;
+	pstSlotMap->pstSlots[u32Slot].u32Index = (uint32_t) szIndex;
+}
+
+/**
+ * Find the vector index of a handle's item
+ *
+ * @param[in]	pstSlotMap		Slot map
+ * @param[in]	stHandle		Handle
+ *
+ * @return Vector index (or SIZE_MAX if the handle is stale)
+ */
+static size_t handle_to_index(const std_slot_map_t * pstSlotMap, std_slot_map_handle_t stHandle)
+{
+	// Live slots have odd generations, which a free slot (or the null handle) never matches
+	if (	(stHandle.u32Slot < pstSlotMap->u32NumSlots)
+		&&	(pstSlotMap->pstSlots[stHandle.u32Slot].u32Generation == stHandle.u32Generation)
+		&&	(stHandle.u32Generation & 1U)	)
+	{
+		return pstSlotMap->pstSlots[stHandle.u32Slot].u32Index;
+	}
+	return SIZE_MAX;
+}
+
+/**
+ * Allocate a slot (reusing a free slot if there is one)
+ *
+ * @param[in]	pstSlotMap		Slot map
+ *
+ * @return Slot
+ */
+static uint32_t slot_alloc(std_slot_map_t * pstSlotMap)
+{
+	uint32_t u32Slot = pstSlotMap->u32FreeSlot;
+
+	if (u32Slot == NO_SLOT)
+	{
+		u32Slot = pstSlotMap->u32NumSlots++;
+		pstSlotMap->pstSlots[u32Slot].u32Generation = 0U;
+	}
+	else
+	{
+		pstSlotMap->u32FreeSlot = pstSlotMap->pstSlots[u32Slot].u32Index;
+	}
+	pstSlotMap->pstSlots[u32Slot].u32Generation++;
+	return u32Slot;
+}
+
+/**
+ * Free a slot (so that handles to it go stale)
+ *
+ * @param[in]	pstSlotMap		Slot map
+ * @param[in]	u32Slot			Slot
+ */
+static void slot_free(std_slot_map_t * pstSlotMap, uint32_t u32Slot)
+{
+	pstSlotMap->pstSlots[u32Slot].u32Generation++;
+	pstSlotMap->pstSlots[u32Slot].u32Index = pstSlotMap->u32FreeSlot;
+	pstSlotMap->u32FreeSlot = u32Slot;
+}
+
+/**
+ * Remove the item at a vector index (freeing its slot), moving the final item into its place
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[out]	pvResult		Where to pop the item to (or NULL to erase it)
+ * @param[in]	szIndex			Vector index
+ */
+static void item_remove(std_container_t * pstContainer, void * pvResult, size_t szIndex)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+	size_t szLast;
+
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, stdlib_vector_at(pstContainer, szIndex), pstContainer->szSizeofItem);
+	slot_free(pstSlotMap, pstSlotMap->pu32IndexToSlot[szIndex]);
+
+	// Unless the item was the final item, refill its place with the final item
+	szLast = --pstContainer->szNumItems;
+	if (szLast != szIndex)
+	{
+		stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szIndex), stdlib_vector_at(pstContainer, szLast), 1U);
+		slot_link(pstSlotMap, szIndex, pstSlotMap->pu32IndexToSlot[szLast]);
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a slot map container
+ *
+ * @param[in]	pstContainer	Slot map to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the payload within the wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_slot_map_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	pstSlotMap->pstSlots			= NULL;
+	pstSlotMap->pu32IndexToSlot		= NULL;
+	pstSlotMap->szNumIndexAlloced	= 0;
+	pstSlotMap->u32NumSlots			= 0;
+	pstSlotMap->u32FreeSlot			= NO_SLOT;
+}
+
+/**
+ * Destruct a slot map container
+ *
+ * @param[in]	pstContainer	Slot map container
+ *
+ * @return True if destruction was successful, else false
+ */
+bool stdlib_slot_map_destruct(std_container_t * pstContainer)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+
+	if (!stdlib_vector_destruct(pstContainer))
+	{
+		return false;
+	}
+
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSlotMap->pstSlots);
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSlotMap->pu32IndexToSlot);
+	pstSlotMap->pstSlots			= NULL;
+	pstSlotMap->pu32IndexToSlot		= NULL;
+	pstSlotMap->szNumIndexAlloced	= 0;
+	pstSlotMap->u32NumSlots			= 0;
+	pstSlotMap->u32FreeSlot			= NO_SLOT;
+	return true;
+}
+
+/**
+ * Reserve space within a slot map container for a number of items
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_slot_map_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+	size_t szNumAlloced;
+	void * pvNew;
+
+	// Slots (and vector indices) are 32 bits wide, and the largest value marks the end of the free list
+	if (	(szNewSize >= NO_SLOT)
+		||	!stdlib_vector_reserve(pstContainer, szNewSize)	)
+	{
+		return false;
+	}
+
+	// A new slot is only ever handed out when every existing slot is in use, so there can never be more slots than items
+	szNumAlloced = pstSlotMap->szNumAlloced;
+	if (szNumAlloced > pstSlotMap->szNumIndexAlloced)
+	{
+		pvNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSlotMap->pstSlots, szNumAlloced * sizeof(std_slot_map_slot_t));
+		if (pvNew == NULL)
+		{
+			return false;
+		}
+		pstSlotMap->pstSlots = pvNew;
+
+		pvNew = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSlotMap->pu32IndexToSlot, szNumAlloced * sizeof(uint32_t));
+		if (pvNew == NULL)
+		{
+			return false;
+		}
+		pstSlotMap->pu32IndexToSlot = pvNew;
+		pstSlotMap->szNumIndexAlloced = szNumAlloced;
+	}
+
+	return true;
+}
+
+/**
+ * Insert an item into a slot map container
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return Handle of the item (or STD_SLOT_MAP_NULL_HANDLE if it couldn't be inserted)
+ */
+std_slot_map_handle_t stdlib_slot_map_insert(std_container_t * pstContainer, const void * pvItem)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+	size_t szIndex = pstContainer->szNumItems;
+	uint32_t u32Slot;
+
+	if (!stdlib_slot_map_reserve(pstContainer, szIndex + 1U))
+	{
+		return STD_SLOT_MAP_NULL_HANDLE;
+	}
+
+	u32Slot = slot_alloc(pstSlotMap);
+	stdlib_container_relocate_items(pstContainer, stdlib_vector_at(pstContainer, szIndex), pvItem, 1U);
+	slot_link(pstSlotMap, szIndex, u32Slot);
+	pstContainer->szNumItems++;
+
+	return (std_slot_map_handle_t){ .u32Slot = u32Slot, .u32Generation = pstSlotMap->pstSlots[u32Slot].u32Generation };
+}
+
+/**
+ * Push a series of items into a slot map container (without returning their handles)
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed
+ */
+size_t stdlib_slot_map_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t i;
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		if (std_slot_map_handle_is_null(stdlib_slot_map_insert(pstContainer, stIt.pvData)))
+		{
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * Pop the final items off a slot map (freeing their slots)
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_slot_map_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		item_remove(pstContainer, pvResult, pstContainer->szNumItems - 1U);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	return szMaxItems;
+}
+
+/**
+ * Find the item that a handle refers to
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	stHandle		Handle
+ *
+ * @return Pointer to the item (or NULL if the handle is stale)
+ */
+void * stdlib_slot_map_handle_to_item(std_container_t * pstContainer, std_slot_map_handle_t stHandle)
+{
+	size_t szIndex = handle_to_index(CONTAINER_TO_SLOT_MAP(pstContainer), stHandle);
+
+	return (szIndex == SIZE_MAX) ? NULL : stdlib_vector_at(pstContainer, szIndex);
+}
+
+/**
+ * Find the handle of the item at a vector index
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	szIndex			Vector index
+ *
+ * @return Handle (or STD_SLOT_MAP_NULL_HANDLE if the index is out of range)
+ */
+std_slot_map_handle_t stdlib_slot_map_index_to_handle(std_container_t * pstContainer, size_t szIndex)
+{
+	std_slot_map_t * pstSlotMap = CONTAINER_TO_SLOT_MAP(pstContainer);
+	uint32_t u32Slot;
+
+	if (szIndex >= pstContainer->szNumItems)
+	{
+		return STD_SLOT_MAP_NULL_HANDLE;
+	}
+
+	u32Slot = pstSlotMap->pu32IndexToSlot[szIndex];
+	return (std_slot_map_handle_t){ .u32Slot = u32Slot, .u32Generation = pstSlotMap->pstSlots[u32Slot].u32Generation };
+}
+
+/**
+ * Erase (or pop) the item that a handle refers to (freeing its slot)
+ *
+ * @param[in]	pstContainer	Slot map container
+ * @param[in]	stHandle		Handle
+ * @param[out]	pvResult		Where to pop the item to (or NULL to erase it)
+ *
+ * @return True if the item was erased, false if the handle is stale
+ */
+bool stdlib_slot_map_erase(std_container_t * pstContainer, std_slot_map_handle_t stHandle, void * pvResult)
+{
+	size_t szIndex = handle_to_index(CONTAINER_TO_SLOT_MAP(pstContainer), stHandle);
+
+	if (szIndex == SIZE_MAX)
+	{
+		return false;
+	}
+
+	item_remove(pstContainer, pvResult, szIndex);
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+static bool slot_map_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_slot_map_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_slot_map_default_itemhandler =
+{
+	.szElementSize = sizeof(std_slot_map_t),
+	.pfn_Destructor = &slot_map_default_destruct,
+	.pfn_Relocator = NULL
+};
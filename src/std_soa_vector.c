@@ -0,0 +1,613 @@
+/*
+ * src/std_soa_vector.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <string.h>		// for memcpy/memmove/memset
+
+#include "std/item.h"
+#include "std/soa_vector.h"
+
+#define CONTAINER_TO_SOA_VECTOR(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_soa_vector_t, stContainer)
+#define SOA_VECTOR_TO_CONTAINER(SOA_VECTOR)		&SOA_VECTOR->stContainer
+
+#define ITERATOR_TO_SOA_VECTORIT(IT)			STD_CONTAINER_OF(IT, std_soa_vector_iterator_t, stIterator)
+#define SOA_VECTORIT_TO_ITERATOR(SOA_VECTORIT)	&SOA_VECTORIT->stIterator
+
+/**
+ * Calculate the address of an indexed entry within a column
+ *
+ * @param[in]	pstSoaVector	SoA vector
+ * @param[in]	szColumn		Column number
+ * @param[in]	szIndex			Index
+ *
+ * @return Address of the indexed entry
+ */
+static void * soa_vector_cell(std_soa_vector_t * pstSoaVector, size_t szColumn, size_t szIndex)
+{
+	return STD_LINEAR_ADD(pstSoaVector->pvStartAddr,
+				(pstSoaVector->szNumAlloced * pstSoaVector->aszColumnPrefix[szColumn])
+			+	(pstSoaVector->astColumns[szColumn].szSizeof * szIndex)	);
+}
+
+/**
+ * Scatter the fields of an item out to their columns
+ *
+ * @param[in]	pstSoaVector	SoA vector
+ * @param[in]	szIndex			Index to write to
+ * @param[in]	pvItem			Item to scatter
+ */
+static void soa_vector_scatter(std_soa_vector_t * pstSoaVector, size_t szIndex, const void * pvItem)
+{
+	size_t i;
+
+	for (i = 0; i < pstSoaVector->szNumColumns; i++)
+	{
+		memcpy(	soa_vector_cell(pstSoaVector, i, szIndex),
+				STD_LINEAR_ADD(pvItem, pstSoaVector->astColumns[i].szOffset),
+				pstSoaVector->astColumns[i].szSizeof	);
+	}
+}
+
+/**
+ * Gather the fields of an item in from their columns
+ *
+ * @param[in]	pstSoaVector	SoA vector
+ * @param[in]	szIndex			Index to read from
+ * @param[out]	pvItem			Where to gather the item to
+ */
+static void soa_vector_gather(std_soa_vector_t * pstSoaVector, size_t szIndex, void * pvItem)
+{
+	size_t i;
+
+	// Fields that aren't held in any column read back as zero
+	if (pstSoaVector->szRowBytes != pstSoaVector->stContainer.szSizeofItem)
+	{
+		memset(pvItem, 0, pstSoaVector->stContainer.szSizeofItem);
+	}
+
+	for (i = 0; i < pstSoaVector->szNumColumns; i++)
+	{
+		memcpy(	STD_LINEAR_ADD(pvItem, pstSoaVector->astColumns[i].szOffset),
+				soa_vector_cell(pstSoaVector, i, szIndex),
+				pstSoaVector->astColumns[i].szSizeof	);
+	}
+}
+
+/**
+ * Move a run of items within every column
+ *
+ * @param[in]	pstSoaVector	SoA vector
+ * @param[in]	szDst			Destination index
+ * @param[in]	szSrc			Source index
+ * @param[in]	szNumItems		Number of items to move
+ */
+static void soa_vector_move(std_soa_vector_t * pstSoaVector, size_t szDst, size_t szSrc, size_t szNumItems)
+{
+	size_t i;
+
+	for (i = 0; i < pstSoaVector->szNumColumns; i++)
+	{
+		memmove(soa_vector_cell(pstSoaVector, i, szDst),
+				soa_vector_cell(pstSoaVector, i, szSrc),
+				pstSoaVector->astColumns[i].szSizeof * szNumItems	);
+	}
+}
+
+/**
+ * Set up the column layout for a given set of columns
+ *
+ * @param[in]	pstSoaVector	SoA vector
+ * @param[in]	pastColumns		Array of column descriptions
+ * @param[in]	szNumColumns	Number of columns in the array
+ */
+static void soa_vector_layout(std_soa_vector_t * pstSoaVector, const std_soa_vector_column_t * pastColumns, size_t szNumColumns)
+{
+	size_t szRowBytes = 0;
+	size_t i;
+
+	for (i = 0; i < szNumColumns; i++)
+	{
+		pstSoaVector->astColumns[i] = pastColumns[i];
+		pstSoaVector->aszColumnPrefix[i] = szRowBytes;
+		szRowBytes += pastColumns[i].szSizeof;
+	}
+	pstSoaVector->szNumColumns	= szNumColumns;
+	pstSoaVector->szRowBytes	= szRowBytes;
+}
+
+/**
+ * Construct a SoA vector container
+ *
+ * @param[in]	pstContainer	SoA vector to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset to the gathered row within an iterator
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_soa_vector_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	std_soa_vector_column_t stWholeItem = { .szOffset = 0, .szSizeof = szSizeof };
+
+	if (szWrappedSizeof) { /* Unused parameter */ }
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstSoaVector->szNumAlloced	= 0;
+	pstSoaVector->pvStartAddr	= NULL;
+	pstSoaVector->szRowOffset	= szPayloadOffset;
+
+	// Until told otherwise, hold each item as a single column
+	soa_vector_layout(pstSoaVector, &stWholeItem, 1U);
+}
+
+/**
+ * Destruct a SoA vector container
+ *
+ * @param[in]	pstContainer	SoA vector container to destruct
+ *
+ * @return True if destruction was successful, else false
+ */
+bool stdlib_soa_vector_destruct(std_container_t * pstContainer)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// Free the memory allocated for this SoA vector (all its columns share one block)
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSoaVector->pvStartAddr);
+
+	// Clear out all the fields (just to be tidy)
+	pstContainer->szNumItems		= 0;
+	pstSoaVector->szNumAlloced		= 0;
+	pstSoaVector->pvStartAddr		= NULL;
+
+	return true;
+}
+
+/**
+ * Reserve space within a SoA vector container for a number of items
+ *
+ * @param[in]	pstContainer	SoA vector container to reserve space for
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_soa_vector_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t szOldCapacity = pstSoaVector->szNumAlloced;
+	size_t szNewCapacity;
+	void * pvNewStart;
+	size_t i;
+
+	if (szNewSize > szOldCapacity)
+	{
+		szNewCapacity = STD_SOA_VECTOR_MIN_CAPACITY;
+		if (szNewSize > szNewCapacity)
+		{
+			szNewCapacity = 1ULL << (64U - __builtin_clzll(szNewSize));
+			if (szNewCapacity < szNewSize)
+			{
+				szNewCapacity <<= 1;
+			}
+		}
+
+		pvNewStart = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSoaVector->pvStartAddr, szNewCapacity * pstSoaVector->szRowBytes);
+		if (pvNewStart == NULL)
+		{
+			return false;
+		}
+		pstSoaVector->pvStartAddr = pvNewStart;
+
+		// Spread the columns out to their new positions, starting from the last
+		// column (so that no column gets overwritten before it has been moved)
+		for (i = pstSoaVector->szNumColumns; i-- > 1U; )
+		{
+			memmove(STD_LINEAR_ADD(pvNewStart, szNewCapacity * pstSoaVector->aszColumnPrefix[i]),
+					STD_LINEAR_ADD(pvNewStart, szOldCapacity * pstSoaVector->aszColumnPrefix[i]),
+					pstContainer->szNumItems * pstSoaVector->astColumns[i].szSizeof	);
+		}
+		pstSoaVector->szNumAlloced = szNewCapacity;
+	}
+
+	return true;
+}
+
+/**
+ * Push a series of items onto the front of a SoA vector container
+ *
+ * @param[in]	pstContainer	SoA vector container to push the series of items onto
+ * @param[in]	pstSeries		Linear series of items
+ *
+ * @return Number of items pushed onto the SoA vector
+ */
+size_t stdlib_soa_vector_push_front(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t szOldCount = pstContainer->szNumItems;
+	size_t szNumItems = pstSeries->szNumItems;
+	std_linear_series_iterator_t stIt;
+	size_t szIndex;
+
+	if ((szNumItems == 0) || (pstSeries->pvStart == NULL))
+	{
+		return 0;
+	}
+
+	// Try to reserve space, exit early if that didn't succeed
+	if (stdlib_soa_vector_reserve(pstContainer, szOldCount + szNumItems) == false)
+	{
+		return 0;
+	}
+
+	if (szOldCount != 0U)
+	{
+		soa_vector_move(pstSoaVector, szNumItems, 0, szOldCount);
+	}
+
+	// As with a vector, each pushed item ends up in front of the previous one
+	szIndex = szNumItems;
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		soa_vector_scatter(pstSoaVector, --szIndex, stIt.pvData);
+	}
+
+	// Update the number of items
+	pstContainer->szNumItems = szOldCount + szNumItems;
+
+	// Return the number of items successfully pushed onto the container
+	return szNumItems;
+}
+
+/**
+ * Push a series of items onto the back of a SoA vector
+ *
+ * @param[in]	pstContainer	SoA vector container to push the series of items onto
+ * @param[in]	pstSeries		Linear series of items
+ *
+ * @return Number of items pushed onto the SoA vector
+ */
+size_t stdlib_soa_vector_push_back(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t szOldCount = pstContainer->szNumItems;
+	size_t szNumItems = pstSeries->szNumItems;
+	std_linear_series_iterator_t stIt;
+	size_t szIndex;
+
+	if ((szNumItems == 0) || (pstSeries->pvStart == NULL))
+	{
+		return 0;
+	}
+
+	// Try to reserve space, exit early if that didn't succeed
+	if (stdlib_soa_vector_reserve(pstContainer, szOldCount + szNumItems) == false)
+	{
+		return 0;
+	}
+
+	szIndex = szOldCount;
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		soa_vector_scatter(pstSoaVector, szIndex++, stIt.pvData);
+	}
+
+	// Update the number of items in the container
+	pstContainer->szNumItems = szOldCount + szNumItems;
+
+	// Return the number of items successfully pushed onto the container
+	return szNumItems;
+}
+
+/**
+ * Pop a series of items from the very front of a SoA vector
+ *
+ * @param[in]	pstContainer	SoA vector to pop a series of items from
+ * @param[out]	pvResult		Where to pop a series of items to (can be NULL)
+ * @param[in]	szMaxItems		Maximum number of items that can be popped
+ *
+ * @return	Number of items popped
+ */
+size_t stdlib_soa_vector_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	if (pvResult)
+	{
+		for (i = 0; i < szMaxItems; i++)
+		{
+			soa_vector_gather(pstSoaVector, i, pvResult);
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+
+	if (pstContainer->szNumItems > szMaxItems)
+	{
+		soa_vector_move(pstSoaVector, 0, szMaxItems, pstContainer->szNumItems - szMaxItems);
+	}
+	pstContainer->szNumItems -= szMaxItems;
+
+	return szMaxItems;
+}
+
+/**
+ * Pop a series of items from the very back of a SoA vector
+ *
+ * @param[in]	pstContainer	SoA vector to pop a series of items from
+ * @param[out]	pvResult		Where to pop a series of items to (can be NULL)
+ * @param[in]	szMaxItems		Maximum number of items that can be popped
+ *
+ * @return	Number of items popped
+ */
+size_t stdlib_soa_vector_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	if (pvResult)
+	{
+		for (i = 0; i < szMaxItems; i++)
+		{
+			soa_vector_gather(pstSoaVector, pstContainer->szNumItems - 1U - i, pvResult);
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	pstContainer->szNumItems -= szMaxItems;
+
+	return szMaxItems;
+}
+
+/**
+ * Set the columns that an (empty) SoA vector splits its items into
+ *
+ * @param[in]	pstContainer	SoA vector container
+ * @param[in]	pastColumns		Array of column descriptions
+ * @param[in]	szNumColumns	Number of columns in the array
+ *
+ * @return True if the columns were set, else false
+ */
+bool stdlib_soa_vector_columns_set(std_container_t * pstContainer, const std_soa_vector_column_t * pastColumns, size_t szNumColumns)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t i;
+
+	if (	(pstContainer->szNumItems != 0U)
+		||	(szNumColumns == 0U)
+		||	(szNumColumns > STD_SOA_VECTOR_MAX_COLUMNS)	)
+	{
+		return false;
+	}
+
+	for (i = 0; i < szNumColumns; i++)
+	{
+		if (	(pastColumns[i].szSizeof == 0U)
+			||	(pastColumns[i].szOffset + pastColumns[i].szSizeof > pstContainer->szSizeofItem)	)
+		{
+			return false;
+		}
+	}
+
+	// Any existing allocation was sized for the old layout, so release it
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSoaVector->pvStartAddr);
+	pstSoaVector->pvStartAddr	= NULL;
+	pstSoaVector->szNumAlloced	= 0;
+
+	soa_vector_layout(pstSoaVector, pastColumns, szNumColumns);
+
+	return true;
+}
+
+/**
+ * Calculate the address of an indexed entry within one of a SoA vector's columns
+ *
+ * @param[in]	pstContainer	SoA vector container
+ * @param[in]	szOffset		Offset of the column's field within the item
+ * @param[in]	szSizeof		Size of the column's field
+ * @param[in]	szIndex			Index
+ *
+ * @return Address of the indexed entry (or NULL if the field isn't a column)
+ */
+void * stdlib_soa_vector_column_at(std_container_t * pstContainer, size_t szOffset, size_t szSizeof, size_t szIndex)
+{
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+	size_t i;
+
+	if (pstSoaVector->pvStartAddr != NULL)
+	{
+		for (i = 0; i < pstSoaVector->szNumColumns; i++)
+		{
+			if (	(pstSoaVector->astColumns[i].szOffset == szOffset)
+				&&	(pstSoaVector->astColumns[i].szSizeof == szSizeof)	)
+			{
+				return soa_vector_cell(pstSoaVector, i, szIndex);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+// -------------------------------------------------------------------------
+
+/**
+ * Gather the iterator's current item into the row held inside the iterator
+ *
+ * @param[in]	pstIterator		SoA vector iterator
+ */
+static void soa_vector_iterator_gather(std_iterator_t * pstIterator)
+{
+	std_soa_vector_iterator_t * pstSoaVectorIt = ITERATOR_TO_SOA_VECTORIT(pstIterator);
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstIterator->pstContainer);
+
+	soa_vector_gather(pstSoaVector, pstSoaVectorIt->szIndex, pstIterator->pvRef);
+}
+
+/**
+ * Construct an iterator for a specified SoA vector container
+ *
+ * @param[in]	pstContainer		SoA vector container
+ * @param[in]	pstIterator			SoA vector iterator to construct
+ * @param[in]	szFirst				Index of the first row visited
+ * @param[in]	szLast				Index of the last row visited
+ */
+static void soa_vector_iterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_soa_vector_iterator_t * pstSoaVectorIt = ITERATOR_TO_SOA_VECTORIT(pstIterator);
+	std_soa_vector_t * pstSoaVector = CONTAINER_TO_SOA_VECTOR(pstContainer);
+
+	stdlib_iterator_construct(pstIterator, pstContainer, STD_LINEAR_ADD(pstIterator, pstSoaVector->szRowOffset));
+	pstSoaVectorIt->szIndex		= szFirst;
+	pstSoaVectorIt->szRangeEnd	= szLast;
+	soa_vector_iterator_gather(pstIterator);
+}
+
+/**
+ * Construct a forward iterator for a specified SoA vector container
+ *
+ * @param[in]	pstContainer		SoA vector container
+ * @param[in]	pstIterator			SoA vector forward iterator to construct
+ * @param[in]	szFirst				First entry (starting with 0)
+ * @param[in]	szLast				Last entry (e.g. if there are 10 entries, this should be 9)
+ */
+void stdlib_soa_vector_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	if ((szLast < szFirst) || (szLast >= pstContainer->szNumItems))
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		soa_vector_iterator_construct(pstContainer, pstIterator, szFirst, szLast);
+	}
+}
+
+/**
+ * Seek a SoA vector iterator to a given index inside the container
+ *
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szIndex			Index
+ */
+void stdlib_soa_vector_forwarditerator_seek(std_iterator_t * pstIterator, size_t szIndex)
+{
+	std_soa_vector_iterator_t * pstSoaVectorIt = ITERATOR_TO_SOA_VECTORIT(pstIterator);
+
+	pstSoaVectorIt->szIndex = szIndex;
+	soa_vector_iterator_gather(pstIterator);
+}
+
+/**
+ * Step a SoA vector iterator forwards
+ *
+ * @param[in]	pstIterator		SoA vector iterator
+ */
+void stdlib_soa_vector_forwarditerator_next(std_iterator_t * pstIterator)
+{
+	std_soa_vector_iterator_t * pstSoaVectorIt = ITERATOR_TO_SOA_VECTORIT(pstIterator);
+
+	if (pstSoaVectorIt->szIndex >= pstSoaVectorIt->szRangeEnd)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstSoaVectorIt->szIndex++;
+		soa_vector_iterator_gather(pstIterator);
+	}
+}
+
+/**
+ * Construct a reverse iterator for a specified SoA vector container
+ *
+ * @param[in]	pstContainer		SoA vector container
+ * @param[in]	pstIterator			SoA vector reverse iterator to construct
+ * @param[in]	szFirst				First entry (starting with 0), counting backwards from end
+ * @param[in]	szLast				Last entry (e.g. if there are 10 entries, this should be 9), counting backwards from end
+ */
+void stdlib_soa_vector_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	if ((szLast < szFirst) || (szLast >= pstContainer->szNumItems))
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		szFirst = (pstContainer->szNumItems - 1U) - szFirst;
+		szLast  = (pstContainer->szNumItems - 1U) - szLast;
+		soa_vector_iterator_construct(pstContainer, pstIterator, szFirst, szLast);
+	}
+}
+
+/**
+ * Step a SoA vector iterator backwards
+ *
+ * @param[in]	pstIterator		SoA vector iterator
+ */
+void stdlib_soa_vector_reverseiterator_next(std_iterator_t * pstIterator)
+{
+	std_soa_vector_iterator_t * pstSoaVectorIt = ITERATOR_TO_SOA_VECTORIT(pstIterator);
+
+	if (pstSoaVectorIt->szIndex <= pstSoaVectorIt->szRangeEnd)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstSoaVectorIt->szIndex--;
+		soa_vector_iterator_gather(pstIterator);
+	}
+}
+
+// -------------------------------------------------------------------------
+
+/**
+ * Destruct a SoA vector held as an item inside another container
+ */
+static bool soa_vector_default_destruct(const std_item_handler_t * pstItemHandler, void * pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_soa_vector_destruct((std_container_t *) pvData);
+}
+
+typedef std_soa_vector(int) soa_vector_int_t;
+
+const std_item_handler_t std_soa_vector_default_itemhandler =
+{
+	.szElementSize = sizeof(soa_vector_int_t),
+	.pfn_Destructor = &soa_vector_default_destruct,
+	.pfn_Relocator = NULL
+};
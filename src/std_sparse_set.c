@@ -0,0 +1,347 @@
+/*
+ * src/std_sparse_set.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "std/sparse_set.h"
+
+#define CONTAINER_TO_SPARSE_SET(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_sparse_set_t, stContainer)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the address of a dense item in a sparse set
+ *
+ * @param[in]	pstSparseSet	Sparse set
+ * @param[in]	szIndex			Dense index of the item
+ *
+ * @return Address of the item
+ */
+static void * dense_item(const std_sparse_set_t * pstSparseSet, size_t szIndex)
+{
+	return STD_LINEAR_ADD(pstSparseSet->pvStartAddr, szIndex * pstSparseSet->stContainer.szSizeofItem);
+}
+
+/**
+ * Read the key of an item (always its first field)
+ *
+ * @param[in]	pvItem	Item
+ *
+ * @return The item's key
+ */
+static size_t item_key(const void * pvItem)
+{
+	return *(const size_t *)pvItem;
+}
+
+/**
+ * Destruct an item (if the sparse set has an item handler with a destructor)
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	pvItem			Item
+ */
+static void item_destruct(std_container_t * pstContainer, void * pvItem)
+{
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, pvItem);
+	}
+}
+
+/**
+ * Find the dense index of a key's item in a sparse set
+ *
+ * @param[in]	pstSparseSet	Sparse set
+ * @param[in]	szKey			Key
+ *
+ * @return Dense index of the key's item (or the number of items, if the key isn't in the set)
+ */
+static size_t key_index(const std_sparse_set_t * pstSparseSet, size_t szKey)
+{
+	size_t szNumItems = pstSparseSet->stContainer.szNumItems;
+	size_t szIndex;
+
+	if (szKey >= pstSparseSet->szNumKeysAlloced)
+	{
+		return szNumItems;
+	}
+
+	// The index entry only counts if it points back at an item holding the same key
+	szIndex = pstSparseSet->pu32Sparse[szKey];
+	if ((szIndex < szNumItems) && (item_key(dense_item(pstSparseSet, szIndex)) == szKey))
+	{
+		return szIndex;
+	}
+	return szNumItems;
+}
+
+/**
+ * Grow a sparse set's index array so that it covers a key
+ *
+ * @param[in]	pstSparseSet	Sparse set
+ * @param[in]	szKey			Key
+ *
+ * @return True if the index array covers the key, false if memory ran out
+ */
+static bool sparse_reserve(std_sparse_set_t * pstSparseSet, size_t szKey)
+{
+	std_container_t * pstContainer = &pstSparseSet->stContainer;
+	size_t szNewSize = (pstSparseSet->szNumKeysAlloced > 0) ? pstSparseSet->szNumKeysAlloced : 16U;
+	uint32_t * pu32Sparse;
+
+	if (szKey < pstSparseSet->szNumKeysAlloced)
+	{
+		return true;
+	}
+	while (szNewSize <= szKey)
+	{
+		if (szNewSize > (SIZE_MAX / 2U) / sizeof(uint32_t))
+		{
+			return false;
+		}
+		szNewSize *= 2U;
+	}
+
+	pu32Sparse = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSparseSet->pu32Sparse, szNewSize * sizeof(uint32_t));
+	if (pu32Sparse == NULL)
+	{
+		return false;
+	}
+
+	// Zero the newly grown part once, so that lookups never read uninitialised memory
+	memset(&pu32Sparse[pstSparseSet->szNumKeysAlloced], 0, (szNewSize - pstSparseSet->szNumKeysAlloced) * sizeof(uint32_t));
+	pstSparseSet->pu32Sparse = pu32Sparse;
+	pstSparseSet->szNumKeysAlloced = szNewSize;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a sparse set container
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item
+ * @param[in]	szPayloadOffset	Offset of a raw item inside a wrapped item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_sparse_set_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+
+	stdlib_vector_construct(pstContainer, szSizeof, szWrappedSizeof, szPayloadOffset, eHas);
+	pstSparseSet->pu32Sparse = NULL;
+	pstSparseSet->szNumKeysAlloced = 0;
+}
+
+/**
+ * Destruct a sparse set container
+ *
+ * @param[in]	pstContainer	Sparse set container
+ *
+ * @return True if the sparse set was destructed OK, else false
+ */
+bool stdlib_sparse_set_destruct(std_container_t * pstContainer)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+
+	if (!stdlib_vector_destruct(pstContainer))
+	{
+		return false;
+	}
+	std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSparseSet->pu32Sparse);
+	pstSparseSet->pu32Sparse = NULL;
+	pstSparseSet->szNumKeysAlloced = 0;
+	return true;
+}
+
+/**
+ * Find the item holding a key in a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	szKey			Key
+ *
+ * @return Pointer to the item (or NULL if the key isn't in the set)
+ */
+void * stdlib_sparse_set_find(std_container_t * pstContainer, size_t szKey)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+	size_t szIndex = key_index(pstSparseSet, szKey);
+
+	return (szIndex < pstContainer->szNumItems) ? dense_item(pstSparseSet, szIndex) : NULL;
+}
+
+/**
+ * Insert an item into a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	pvItem			Item to insert
+ * @param[in]	bReplace		If true, an item already in the set with the same key is replaced (and destructed)
+ * @param[out]	pbInserted		Set to true if the item was inserted (or replaced an existing item)
+ *
+ * @return Pointer to the set's item with the key (or NULL if memory ran out)
+ */
+void * stdlib_sparse_set_insert(std_container_t * pstContainer, const void * pvItem, bool bReplace, bool * pbInserted)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+	size_t szKey = item_key(pvItem);
+	size_t szIndex = key_index(pstSparseSet, szKey);
+	void * pvSlot;
+
+	*pbInserted = false;
+	if (szIndex < pstContainer->szNumItems)
+	{
+		pvSlot = dense_item(pstSparseSet, szIndex);
+		if (bReplace)
+		{
+			item_destruct(pstContainer, pvSlot);
+			stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+			*pbInserted = true;
+		}
+		return pvSlot;
+	}
+
+	// Dense indices are held as uint32_t
+	if (	(szIndex >= UINT32_MAX)
+		||	!sparse_reserve(pstSparseSet, szKey)
+		||	!stdlib_vector_reserve(pstContainer, szIndex + 1U)	)
+	{
+		return NULL;
+	}
+	pvSlot = dense_item(pstSparseSet, szIndex);
+	stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+	pstSparseSet->pu32Sparse[szKey] = (uint32_t) szIndex;
+	pstContainer->szNumItems++;
+	*pbInserted = true;
+	return pvSlot;
+}
+
+/**
+ * Erase (and destruct) the item holding a key from a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	szKey			Key
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+bool stdlib_sparse_set_erase(std_container_t * pstContainer, size_t szKey)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+	size_t szIndex = key_index(pstSparseSet, szKey);
+	size_t szLast = pstContainer->szNumItems - 1U;
+	void * pvItem;
+
+	if (szIndex >= pstContainer->szNumItems)
+	{
+		return false;
+	}
+	pvItem = dense_item(pstSparseSet, szIndex);
+	item_destruct(pstContainer, pvItem);
+
+	// Move the final item into the hole (the erased key's index entry is left stale)
+	if (szIndex != szLast)
+	{
+		stdlib_container_relocate_items(pstContainer, pvItem, dense_item(pstSparseSet, szLast), 1U);
+		pstSparseSet->pu32Sparse[item_key(pvItem)] = (uint32_t) szIndex;
+	}
+	pstContainer->szNumItems = szLast;
+	return true;
+}
+
+/**
+ * Erase (and destruct) every item of a sparse set
+ *
+ * @param[in]	pstContainer	Sparse set container
+ */
+void stdlib_sparse_set_clear(std_container_t * pstContainer)
+{
+	std_sparse_set_t * pstSparseSet = CONTAINER_TO_SPARSE_SET(pstContainer);
+	size_t i;
+
+	// The index array is left as it is: its entries all go stale at once
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (i = 0; i < pstContainer->szNumItems; i++)
+		{
+			item_destruct(pstContainer, dense_item(pstSparseSet, i));
+		}
+	}
+	pstContainer->szNumItems = 0;
+}
+
+/**
+ * Push a series of items into a sparse set container
+ *
+ * @param[in]	pstContainer	Sparse set container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * Note: items whose keys the set already holds aren't pushed, and are left alone (like the other sets)
+ *
+ * @return Number of items pushed
+ */
+size_t stdlib_sparse_set_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t szNumPushed = 0;
+	bool bInserted;
+
+	if (pstSeries->pvStart == NULL)
+	{
+		return 0;
+	}
+	for (std_linear_series_iterator_construct(&stIt, pstSeries); !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		if (stdlib_sparse_set_insert(pstContainer, stIt.pvData, false, &bInserted) == NULL)
+		{
+			break;
+		}
+		if (bInserted)
+		{
+			szNumPushed++;
+		}
+	}
+	return szNumPushed;
+}
+
+// -------------------------------------------------------------------------
+
+static bool sparse_set_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_sparse_set_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_sparse_set_default_itemhandler =
+{
+	.szElementSize = sizeof(std_sparse_set_t),
+	.pfn_Destructor = &sparse_set_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -0,0 +1,669 @@
+/*
+ * src/std_splay_tree.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The splay tree is splayed bottom-up (Sleator & Tarjan, "Self-Adjusting
+ * Binary Search Trees", JACM 1985): after walking down to a node, it is
+ * rotated up two levels at a time (zig-zig or zig-zag, plus a final zig if
+ * needed) until it is the root. Nodes keep parent pointers, so splaying
+ * needs no stack and iterators can step to the next node in order.
+ */
+
+#include "std/splay_tree.h"
+
+#define CONTAINER_TO_SPLAY_TREE(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_splay_tree_t, stContainer)
+#define ITERATOR_TO_SPLAY_TREE_IT(IT)			STD_CONTAINER_OF(IT, std_splay_tree_iterator_t, stIterator)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Find the payload (item) inside a node
+ *
+ * @param[in]	pstTree		Splay tree
+ * @param[in]	pstNode		Node
+ *
+ * @return Address of the node's item
+ */
+static void * node_payload(const std_splay_tree_t * pstTree, const std_splay_tree_node_t * pstNode)
+{
+	return STD_LINEAR_ADD(pstNode, pstTree->szPayloadOffset);
+}
+
+/**
+ * Compare a key with the item in a node
+ *
+ * @param[in]	pstTree		Splay tree
+ * @param[in]	pvKey		Key
+ * @param[in]	pstNode		Node
+ *
+ * @return Negative if the key ranks before the node's item, positive if after, else zero
+ */
+static int key_compare(const std_splay_tree_t * pstTree, const void * pvKey, const std_splay_tree_node_t * pstNode)
+{
+	const void * pvItem = node_payload(pstTree, pstNode);
+
+	if ((*pstTree->pfnCompare)(pvKey, pvItem) > 0)
+	{
+		return 1;
+	}
+	if ((*pstTree->pfnCompare)(pvItem, pvKey) > 0)
+	{
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Rotate a node up above its parent
+ *
+ * @param[in]	pstNode		Node (must have a parent)
+ */
+static void node_rotate_up(std_splay_tree_node_t * pstNode)
+{
+	std_splay_tree_node_t * pstParent = pstNode->pstParent;
+	std_splay_tree_node_t * pstGrandparent = pstParent->pstParent;
+
+	if (pstParent->pstLeft == pstNode)
+	{
+		pstParent->pstLeft = pstNode->pstRight;
+		if (pstNode->pstRight != NULL)
+		{
+			pstNode->pstRight->pstParent = pstParent;
+		}
+		pstNode->pstRight = pstParent;
+	}
+	else
+	{
+		pstParent->pstRight = pstNode->pstLeft;
+		if (pstNode->pstLeft != NULL)
+		{
+			pstNode->pstLeft->pstParent = pstParent;
+		}
+		pstNode->pstLeft = pstParent;
+	}
+	pstParent->pstParent = pstNode;
+	pstNode->pstParent = pstGrandparent;
+	if (pstGrandparent != NULL)
+	{
+		if (pstGrandparent->pstLeft == pstParent)
+		{
+			pstGrandparent->pstLeft = pstNode;
+		}
+		else
+		{
+			pstGrandparent->pstRight = pstNode;
+		}
+	}
+}
+
+/**
+ * Splay a node up to the root of the tree
+ *
+ * @param[in]	pstTree		Splay tree
+ * @param[in]	pstNode		Node
+ */
+static void node_splay(std_splay_tree_t * pstTree, std_splay_tree_node_t * pstNode)
+{
+	std_splay_tree_node_t * pstParent;
+	std_splay_tree_node_t * pstGrandparent;
+
+	while (pstNode->pstParent != NULL)
+	{
+		pstParent = pstNode->pstParent;
+		pstGrandparent = pstParent->pstParent;
+		if (pstGrandparent != NULL)
+		{
+			if ((pstGrandparent->pstLeft == pstParent) == (pstParent->pstLeft == pstNode))
+			{
+				node_rotate_up(pstParent);		// zig-zig
+			}
+			else
+			{
+				node_rotate_up(pstNode);		// zig-zag
+			}
+		}
+		node_rotate_up(pstNode);
+	}
+	pstTree->pstRoot = pstNode;
+}
+
+/**
+ * Find the first or last node in a subtree
+ *
+ * @param[in]	pstNode		Root of the subtree (or NULL)
+ * @param[in]	bLast		True to find the last node, false to find the first
+ *
+ * @return First or last node (or NULL if the subtree is empty)
+ */
+static std_splay_tree_node_t * node_extreme(std_splay_tree_node_t * pstNode, bool bLast)
+{
+	std_splay_tree_node_t * pstChild;
+
+	if (pstNode != NULL)
+	{
+		for (pstChild = pstNode; pstChild != NULL; pstChild = bLast ? pstNode->pstRight : pstNode->pstLeft)
+		{
+			pstNode = pstChild;
+		}
+	}
+	return pstNode;
+}
+
+/**
+ * Step from a node to the next (or previous) node in order
+ *
+ * @param[in]	pstNode		Node
+ * @param[in]	bReverse	True to step to the previous node, false to step to the next
+ *
+ * @return Next (or previous) node, or NULL if there is none
+ */
+static std_splay_tree_node_t * node_step(std_splay_tree_node_t * pstNode, bool bReverse)
+{
+	std_splay_tree_node_t * pstChild = bReverse ? pstNode->pstLeft : pstNode->pstRight;
+
+	if (pstChild != NULL)
+	{
+		return node_extreme(pstChild, bReverse);
+	}
+	while ((pstNode->pstParent != NULL) && ((bReverse ? pstNode->pstParent->pstLeft : pstNode->pstParent->pstRight) == pstNode))
+	{
+		pstNode = pstNode->pstParent;
+	}
+	return pstNode->pstParent;
+}
+
+/**
+ * Walk down the tree looking for a key, then splay the last node visited to the root
+ *
+ * @param[in]	pstTree		Splay tree (must not be empty)
+ * @param[in]	pvKey		Key
+ *
+ * @return Comparison of the key with the new root's item (zero if it matches)
+ */
+static int tree_splay_key(std_splay_tree_t * pstTree, const void * pvKey)
+{
+	std_splay_tree_node_t * pstNode = pstTree->pstRoot;
+	std_splay_tree_node_t * pstNext;
+	int iCompare;
+
+	for (;;)
+	{
+		iCompare = key_compare(pstTree, pvKey, pstNode);
+		pstNext = (iCompare < 0) ? pstNode->pstLeft : pstNode->pstRight;
+		if ((iCompare == 0) || (pstNext == NULL))
+		{
+			break;
+		}
+		pstNode = pstNext;
+	}
+	node_splay(pstTree, pstNode);
+	return iCompare;
+}
+
+/**
+ * Remove the root node from the tree (joining its two subtrees), moving or destructing its item
+ *
+ * @param[in]	pstTree		Splay tree (must not be empty)
+ * @param[out]	pvResult	Where to move the item to (or NULL to destruct it)
+ */
+static void tree_pop_root(std_splay_tree_t * pstTree, void * pvResult)
+{
+	std_container_t * pstContainer = &pstTree->stContainer;
+	std_splay_tree_node_t * pstRoot = pstTree->pstRoot;
+	std_splay_tree_node_t * pstLeft = pstRoot->pstLeft;
+	std_splay_tree_node_t * pstRight = pstRoot->pstRight;
+
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_payload(pstTree, pstRoot), pstContainer->szSizeofItem);
+	stdlib_node_pool_free(&pstTree->stPool, pstRoot);
+
+	if (pstLeft == NULL)
+	{
+		pstTree->pstRoot = pstRight;
+		if (pstRight != NULL)
+		{
+			pstRight->pstParent = NULL;
+		}
+	}
+	else
+	{
+		// Splay the left subtree's last node to its root: it has no right child, so the right subtree goes there
+		pstLeft->pstParent = NULL;
+		node_splay(pstTree, node_extreme(pstLeft, true));
+		pstTree->pstRoot->pstRight = pstRight;
+		if (pstRight != NULL)
+		{
+			pstRight->pstParent = pstTree->pstRoot;
+		}
+	}
+	pstContainer->szNumItems--;
+}
+
+/**
+ * Pop items from one end of a splay tree
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ * @param[in]	bLast			True to pop the last-ranked items, false to pop the first-ranked items
+ *
+ * @return Number of items popped
+ */
+static size_t tree_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems, bool bLast)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+	size_t i;
+
+	for (i = 0; (i < szMaxItems) && (pstTree->pstRoot != NULL); i++)
+	{
+		node_splay(pstTree, node_extreme(pstTree->pstRoot, bLast));
+		tree_pop_root(pstTree, pvResult);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	return i;
+}
+
+/**
+ * Construct an iterator for a range of items in a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item
+ * @param[in]	szLast			Index of the last item
+ * @param[in]	bReverse		True to iterate from the last-ranked item backwards
+ */
+static void iterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast, bool bReverse)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+	std_splay_tree_iterator_t * pstTreeIt = ITERATOR_TO_SPLAY_TREE_IT(pstIterator);
+	std_splay_tree_node_t * pstNode;
+	size_t i;
+
+	if (szLast >= pstContainer->szNumItems)
+	{
+		szLast = pstContainer->szNumItems - 1U;
+	}
+	if ((pstContainer->szNumItems == 0) || (szLast < szFirst))
+	{
+		stdlib_iterator_construct_done(pstIterator);
+		return;
+	}
+
+	// Splay trees don't track ranks, so the first item has to be walked to
+	pstNode = node_extreme(pstTree->pstRoot, bReverse);
+	for (i = 0; i < szFirst; i++)
+	{
+		pstNode = node_step(pstNode, bReverse);
+	}
+	stdlib_iterator_construct(pstIterator, pstContainer, node_payload(pstTree, pstNode));
+	pstIterator->pvBegin = NULL;
+	pstIterator->pvEnd = NULL;
+	pstIterator->pvNext = NULL;
+	pstTreeIt->pstNode = pstNode;
+	pstTreeIt->szRemaining = szLast - szFirst;
+}
+
+/**
+ * Step a splay tree iterator to the next (or previous) item
+ *
+ * @param[in]	pstIterator		Splay tree iterator
+ * @param[in]	bReverse		True to step backwards, false to step forwards
+ */
+static void iterator_next(std_iterator_t * pstIterator, bool bReverse)
+{
+	std_splay_tree_iterator_t * pstTreeIt = ITERATOR_TO_SPLAY_TREE_IT(pstIterator);
+
+	if (pstTreeIt->szRemaining == 0)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstTreeIt->pstNode = node_step(pstTreeIt->pstNode, bReverse);
+		pstIterator->pvRef = node_payload(CONTAINER_TO_SPLAY_TREE(pstIterator->pstContainer), pstTreeIt->pstNode);
+		pstTreeIt->szRemaining--;
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree to initialise
+ * @param[in]	szSizeof		Size of an unwrapped item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (i.e. including its node header)
+ * @param[in]	szPayloadOffset	Offset of a raw (payload) item inside a wrapped (node) item
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_splay_tree_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstTree->szPayloadOffset = szPayloadOffset;
+	pstTree->pfnCompare = NULL;
+	pstTree->pstRoot = NULL;
+	stdlib_node_pool_construct(&pstTree->stPool, szWrappedSizeof);
+}
+
+/**
+ * Destruct a splay tree container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Splay tree container to destruct
+ *
+ * @return True if the splay tree was able to be destructed, else false
+ */
+bool stdlib_splay_tree_destruct(std_container_t * pstContainer)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+	std_splay_tree_node_t * pstNode;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// If an item handler is attached AND that item handler has a destructor, destruct each item in the container
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (pstNode = node_extreme(pstTree->pstRoot, false); pstNode != NULL; pstNode = node_step(pstNode, false))
+		{
+			(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, node_payload(pstTree, pstNode));
+		}
+	}
+
+	// Freeing the pool frees all the nodes at once
+	stdlib_node_pool_destruct(&pstTree->stPool, pstContainer);
+	pstTree->pstRoot = NULL;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve space within a splay tree container for a number of items
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_splay_tree_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	if (szNewSize <= pstContainer->szNumItems)
+	{
+		return true;
+	}
+	return stdlib_node_pool_reserve(&CONTAINER_TO_SPLAY_TREE(pstContainer)->stPool, pstContainer, szNewSize - pstContainer->szNumItems);
+}
+
+/**
+ * Set the comparison function that a splay tree orders its items by
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pfnCompare		Comparison function
+ */
+void stdlib_splay_tree_compare_set(std_container_t * pstContainer, pfn_std_compare_t pfnCompare)
+{
+	CONTAINER_TO_SPLAY_TREE(pstContainer)->pfnCompare = pfnCompare;
+}
+
+/**
+ * Find an item matching a key in a splay tree, splaying it to the root
+ *
+ * Note: if there is no matching item, the last item compared is splayed to the root instead
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pvKey			Key
+ *
+ * @return Pointer to the matching item (or NULL if there isn't one)
+ */
+void * stdlib_splay_tree_find(std_container_t * pstContainer, const void * pvKey)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+
+	if (	(pstTree->pfnCompare == NULL)
+		||	(pstTree->pstRoot == NULL)
+		||	(tree_splay_key(pstTree, pvKey) != 0)	)
+	{
+		return NULL;
+	}
+	return node_payload(pstTree, pstTree->pstRoot);
+}
+
+/**
+ * Insert an item into a splay tree (unless it already holds an item with the same key), splaying it to the root
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pvItem			Item to insert
+ * @param[out]	pbInserted		Set to true if the item was inserted
+ *
+ * @return Pointer to the tree's item with the key (or NULL if memory ran out)
+ */
+void * stdlib_splay_tree_insert(std_container_t * pstContainer, const void * pvItem, bool * pbInserted)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+	std_splay_tree_node_t * pstRoot = pstTree->pstRoot;
+	std_splay_tree_node_t * pstNode;
+	int iCompare = 0;
+
+	*pbInserted = false;
+	if (pstTree->pfnCompare == NULL)
+	{
+		return NULL;
+	}
+
+	if (pstRoot != NULL)
+	{
+		iCompare = tree_splay_key(pstTree, pvItem);
+		pstRoot = pstTree->pstRoot;
+		if (iCompare == 0)
+		{
+			return node_payload(pstTree, pstRoot);
+		}
+	}
+
+	pstNode = stdlib_node_pool_alloc(&pstTree->stPool, pstContainer);
+	if (pstNode == NULL)
+	{
+		return NULL;
+	}
+	stdlib_container_relocate_items(pstContainer, node_payload(pstTree, pstNode), pvItem, 1U);
+
+	// The splayed root is the new item's neighbour, so the new node simply becomes the root above it
+	pstNode->pstParent = NULL;
+	pstNode->pstLeft = NULL;
+	pstNode->pstRight = NULL;
+	if (pstRoot != NULL)
+	{
+		if (iCompare < 0)
+		{
+			pstNode->pstLeft = pstRoot->pstLeft;
+			pstNode->pstRight = pstRoot;
+			pstRoot->pstLeft = NULL;
+		}
+		else
+		{
+			pstNode->pstRight = pstRoot->pstRight;
+			pstNode->pstLeft = pstRoot;
+			pstRoot->pstRight = NULL;
+		}
+		pstRoot->pstParent = pstNode;
+		if (pstNode->pstLeft != NULL)
+		{
+			pstNode->pstLeft->pstParent = pstNode;
+		}
+		if (pstNode->pstRight != NULL)
+		{
+			pstNode->pstRight->pstParent = pstNode;
+		}
+	}
+	pstTree->pstRoot = pstNode;
+	pstContainer->szNumItems++;
+	*pbInserted = true;
+	return node_payload(pstTree, pstNode);
+}
+
+/**
+ * Erase the item matching a key from a splay tree
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pvKey			Key
+ * @param[out]	pvResult		Where to move the erased item to (or NULL to destruct it)
+ *
+ * @return True if an item was erased, false if there wasn't one
+ */
+bool stdlib_splay_tree_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult)
+{
+	std_splay_tree_t * pstTree = CONTAINER_TO_SPLAY_TREE(pstContainer);
+
+	if (stdlib_splay_tree_find(pstContainer, pvKey) == NULL)
+	{
+		return false;
+	}
+	tree_pop_root(pstTree, pvResult);
+	return true;
+}
+
+/**
+ * Push a series of items into a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (a splay tree doesn't push items whose key it already holds)
+ */
+size_t stdlib_splay_tree_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t szNumPushed = 0;
+	bool bInserted;
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		stdlib_splay_tree_insert(pstContainer, stIt.pvData, &bInserted);
+		if (bInserted)
+		{
+			szNumPushed++;
+		}
+	}
+	return szNumPushed;
+}
+
+/**
+ * Pop the first-ranked (e.g. smallest) items from a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_splay_tree_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	return tree_pop(pstContainer, pvResult, szMaxItems, false);
+}
+
+/**
+ * Pop the last-ranked (e.g. largest) items from a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_splay_tree_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	return tree_pop(pstContainer, pvResult, szMaxItems, true);
+}
+
+/**
+ * Construct a forward iterator for a range of items in a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item
+ * @param[in]	szLast			Index of the last item
+ */
+void stdlib_splay_tree_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	iterator_construct(pstContainer, pstIterator, szFirst, szLast, false);
+}
+
+/**
+ * Construct a reverse iterator for a range of items in a splay tree container
+ *
+ * @param[in]	pstContainer	Splay tree container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item (counting back from the last item)
+ * @param[in]	szLast			Index of the last item (counting back from the last item)
+ */
+void stdlib_splay_tree_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	iterator_construct(pstContainer, pstIterator, szFirst, szLast, true);
+}
+
+/**
+ * Step a splay tree iterator forwards to the next item
+ *
+ * @param[in]	pstIterator		Splay tree iterator
+ */
+void stdlib_splay_tree_forwarditerator_next(std_iterator_t * pstIterator)
+{
+	iterator_next(pstIterator, false);
+}
+
+/**
+ * Step a splay tree iterator backwards to the previous item
+ *
+ * @param[in]	pstIterator		Splay tree iterator
+ */
+void stdlib_splay_tree_reverseiterator_next(std_iterator_t * pstIterator)
+{
+	iterator_next(pstIterator, true);
+}
+
+// -------------------------------------------------------------------------
+
+static bool splay_tree_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_splay_tree_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_splay_tree_default_itemhandler =
+{
+	.szElementSize = sizeof(std_splay_tree_t),
+	.pfn_Destructor = &splay_tree_default_destruct,
+	.pfn_Relocator = NULL
+};
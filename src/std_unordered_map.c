@@ -0,0 +1,103 @@
+/*
+ * src/std_unordered_map.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "std/unordered_map.h"
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct an unordered map container
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	szSizeof		Size of an entry
+ * @param[in]	szKeySizeof		Size of the key at the start of each entry
+ * @param[in]	szValueOffset	Offset of the value inside an entry (unused)
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_unorderedmap_construct(std_container_t * pstContainer, size_t szSizeof, size_t szKeySizeof, size_t szValueOffset, std_container_has_t eHas)
+{
+	stdlib_unorderedset_construct(pstContainer, szSizeof, szSizeof, 0U, eHas);
+	STD_CONTAINER_OF(pstContainer, std_unorderedset_t, stContainer)->szKeySizeof = szKeySizeof;
+
+	if (szValueOffset) { /* Unused parameter (the typed macros add it on) */ }
+}
+
+/**
+ * Insert an entry into an unordered map (if its key isn't already in the map)
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	pvEntry			Entry to insert
+ *
+ * @return Pointer to the inserted entry (or NULL if the key was already present, or memory ran out)
+ */
+void * stdlib_unorderedmap_insert(std_container_t * pstContainer, const void * pvEntry)
+{
+	return stdlib_unorderedmap_insert_hashed(pstContainer, pvEntry, stdlib_unorderedset_hash(pstContainer, pvEntry), false);
+}
+
+/**
+ * Insert an entry into an unordered map, replacing (and destructing) any entry already there with the same key
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	pvEntry			Entry to insert
+ *
+ * @return Pointer to the stored entry (or NULL if memory ran out)
+ */
+void * stdlib_unorderedmap_upsert(std_container_t * pstContainer, const void * pvEntry)
+{
+	return stdlib_unorderedmap_insert_hashed(pstContainer, pvEntry, stdlib_unorderedset_hash(pstContainer, pvEntry), true);
+}
+
+/**
+ * Insert an entry whose key has already been hashed into an unordered map
+ *
+ * @param[in]	pstContainer	Unordered map container
+ * @param[in]	pvEntry			Entry to insert
+ * @param[in]	u64Hash			Hash of the entry's key (from stdlib_unorderedset_hash())
+ * @param[in]	bReplace		If true, replace (and destruct) any entry already there with the same key
+ *
+ * @return Pointer to the stored entry (or NULL if the key was already present and not replaced, or memory ran out)
+ */
+void * stdlib_unorderedmap_insert_hashed(std_container_t * pstContainer, const void * pvEntry, uint64_t u64Hash, bool bReplace)
+{
+	bool bInserted;
+	void * pvSlot = stdlib_unorderedset_insert_slot_hashed(pstContainer, pvEntry, u64Hash, &bInserted);
+
+	if (pvSlot == NULL)
+	{
+		return NULL;
+	}
+	if (!bInserted)
+	{
+		if (!bReplace)
+		{
+			return NULL;
+		}
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, NULL, pvSlot, pstContainer->szSizeofItem);
+	}
+	stdlib_container_relocate_items(pstContainer, pvSlot, pvEntry, 1U);
+	return pvSlot;
+}
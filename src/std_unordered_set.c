@@ -0,0 +1,840 @@
+/*
+ * src/std_unordered_set.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Each slot's control byte is one of:
+ *	0b0hhhhhhh	FULL (the low seven bits of the item's hash)
+ *	0b10000000	EMPTY
+ *	0b11111110	DELETED
+ *
+ * The slots are split into aligned groups of GROUP_WIDTH, and a key's probe
+ * sequence visits whole groups, starting at the group picked by the upper
+ * bits of its hash and stepping by 1, 2, 3... groups (which visits every
+ * group, because the number of groups is a power of two). A lookup stops at
+ * the first group that contains an EMPTY control byte.
+ *
+ * A group can only lose its last EMPTY control byte by being filled up: so
+ * if a group still has an EMPTY control byte, no probe sequence has ever run
+ * on past it, and an item erased from it can be marked EMPTY rather than
+ * DELETED. Only items erased from completely full groups leave a tombstone,
+ * and tombstones are cleared out whenever the table is rehashed.
+ */
+
+#include <string.h>
+
+#include "std/unordered_set.h"
+#include "std/support/hash.h"
+
+#if !defined(STD_UNORDEREDSET_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define GROUP_WIDTH		16U
+#define GROUP_SHIFT		0U		// Bit index -> slot index within a group
+typedef uint32_t group_mask_t;
+#else
+#define GROUP_WIDTH		8U
+#define GROUP_SHIFT		3U
+typedef uint64_t group_mask_t;
+#define SWAR_LSBS		0x0101010101010101ULL
+#define SWAR_MSBS		0x8080808080808080ULL
+#endif
+
+#define CTRL_EMPTY		((uint8_t) 0x80U)
+#define CTRL_DELETED	((uint8_t) 0xFEU)
+#define CTRL_IS_FULL(X)	((X) < 0x80U)
+
+#define NO_SLOT			((size_t) -1)
+
+#define CONTAINER_TO_UNORDEREDSET(CONTAINER)		STD_CONTAINER_OF(CONTAINER, std_unorderedset_t, stContainer)
+#define ITERATOR_TO_UNORDEREDSETIT(IT)				STD_CONTAINER_OF(IT, std_unorderedset_iterator_t, stIterator)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+#if GROUP_SHIFT == 0U
+
+/**
+ * Find which control bytes in a group match a hash tag
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ * @param[in]	u8Tag		Hash tag (or CTRL_EMPTY)
+ *
+ * @return Bitmask with one bit set for each matching control byte
+ */
+static group_mask_t group_match(const uint8_t * pu8Group, uint8_t u8Tag)
+{
+	__m128i xmmGroup = _mm_loadu_si128((const __m128i *) pu8Group);
+	return (group_mask_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char) u8Tag), xmmGroup));
+}
+
+/**
+ * Find which control bytes in a group are EMPTY
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ *
+ * @return Bitmask with one bit set for each EMPTY control byte
+ */
+static group_mask_t group_match_empty(const uint8_t * pu8Group)
+{
+	return group_match(pu8Group, CTRL_EMPTY);
+}
+
+/**
+ * Find which control bytes in a group are EMPTY or DELETED
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ *
+ * @return Bitmask with one bit set for each EMPTY or DELETED control byte
+ */
+static group_mask_t group_match_empty_or_deleted(const uint8_t * pu8Group)
+{
+	// Both EMPTY and DELETED have their top bit set, FULL never does
+	return (group_mask_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) pu8Group));
+}
+
+#else
+
+/**
+ * Load a group's control bytes into a word (first control byte lowest)
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ *
+ * @return The group's control bytes
+ */
+static uint64_t group_load(const uint8_t * pu8Group)
+{
+	uint64_t u64Word = 0;
+	size_t i;
+
+	for (i = GROUP_WIDTH; i > 0; i--)
+	{
+		u64Word = (u64Word << 8) | pu8Group[i - 1U];
+	}
+	return u64Word;
+}
+
+/**
+ * Find which control bytes in a group match a hash tag
+ *
+ * Note: this can report false positives (but only in a byte just above a
+ * real match), which get weeded out by the equality check that follows.
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ * @param[in]	u8Tag		Hash tag
+ *
+ * @return Bitmask with the top bit of each matching control byte set
+ */
+static group_mask_t group_match(const uint8_t * pu8Group, uint8_t u8Tag)
+{
+	uint64_t u64Word = group_load(pu8Group) ^ (SWAR_LSBS * u8Tag);
+	return (u64Word - SWAR_LSBS) & ~u64Word & SWAR_MSBS;
+}
+
+/**
+ * Find which control bytes in a group are EMPTY
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ *
+ * @return Bitmask with the top bit of each EMPTY control byte set
+ */
+static group_mask_t group_match_empty(const uint8_t * pu8Group)
+{
+	// EMPTY is the only control byte with its top bit set but bit 1 clear
+	uint64_t u64Word = group_load(pu8Group);
+	return u64Word & (~u64Word << 6) & SWAR_MSBS;
+}
+
+/**
+ * Find which control bytes in a group are EMPTY or DELETED
+ *
+ * @param[in]	pu8Group	Start of the group's control bytes
+ *
+ * @return Bitmask with the top bit of each EMPTY or DELETED control byte set
+ */
+static group_mask_t group_match_empty_or_deleted(const uint8_t * pu8Group)
+{
+	return group_load(pu8Group) & SWAR_MSBS;
+}
+
+#endif
+
+/**
+ * Find the index (within its group) of the lowest control byte in a group mask
+ *
+ * @param[in]	tMask		Non-zero group mask
+ *
+ * @return Index of the control byte
+ */
+static size_t group_mask_first(group_mask_t tMask)
+{
+	return (size_t) __builtin_ctzll((unsigned long long) tMask) >> GROUP_SHIFT;
+}
+
+/**
+ * Hash a key
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	pvKey		Key
+ *
+ * @return Hash value (the low seven bits are the control byte tag, the rest pick the first group)
+ */
+static uint64_t key_hash(const std_unorderedset_t * pstSet, const void * pvKey)
+{
+	if (pstSet->pfnHash != NULL)
+	{
+		return std_hash_mix((uint64_t) (*pstSet->pfnHash)(pvKey));
+	}
+	return std_hash_mix(std_hash_bytes(pvKey, pstSet->szKeySizeof));
+}
+
+/**
+ * Find out whether two keys are equal
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	pvA			First key
+ * @param[in]	pvB			Second key
+ *
+ * @return True if the keys are equal
+ */
+static bool key_equal(const std_unorderedset_t * pstSet, const void * pvA, const void * pvB)
+{
+	if (pstSet->pfnEqual != NULL)
+	{
+		return (*pstSet->pfnEqual)(pvA, pvB);
+	}
+	return (memcmp(pvA, pvB, pstSet->szKeySizeof) == 0);
+}
+
+/**
+ * Find the address of a slot
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	szSlot		Slot index
+ *
+ * @return Address of the slot
+ */
+static void * slot_at(const std_unorderedset_t * pstSet, size_t szSlot)
+{
+	return STD_LINEAR_ADD(pstSet->pvSlots, szSlot * pstSet->stContainer.szSizeofItem);
+}
+
+/**
+ * Find the most items a table of a given capacity may hold (7/8 of its slots)
+ *
+ * @param[in]	szCapacity	Number of slots
+ *
+ * @return Maximum number of items
+ */
+static size_t capacity_to_max_items(size_t szCapacity)
+{
+	return szCapacity - (szCapacity / 8U);
+}
+
+/**
+ * Find the smallest capacity that can hold a number of items
+ *
+ * @param[in]	szNumItems	Number of items
+ *
+ * @return Number of slots (a power of two, at least one group)
+ */
+static size_t capacity_for(size_t szNumItems)
+{
+	size_t szCapacity = GROUP_WIDTH;
+
+	while (capacity_to_max_items(szCapacity) < szNumItems)
+	{
+		szCapacity *= 2U;
+	}
+	return szCapacity;
+}
+
+/**
+ * Find the slot holding a key
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	pvKey		Key
+ * @param[in]	u64Hash		Hash of the key
+ *
+ * @return Slot index (or NO_SLOT if the key isn't in the set)
+ */
+static size_t find_slot(const std_unorderedset_t * pstSet, const void * pvKey, uint64_t u64Hash)
+{
+	size_t szGroupMask = (pstSet->szCapacity / GROUP_WIDTH) - 1U;
+	size_t szGroup = (size_t) (u64Hash >> 7) & szGroupMask;
+	uint8_t u8Tag = (uint8_t) (u64Hash & 0x7FU);
+	const uint8_t * pu8Group;
+	group_mask_t tMatch;
+	size_t szStep = 0;
+	size_t szSlot;
+
+	if (pstSet->szCapacity == 0)
+	{
+		return NO_SLOT;
+	}
+
+	for (;;)
+	{
+		pu8Group = &pstSet->pu8Control[szGroup * GROUP_WIDTH];
+		for (tMatch = group_match(pu8Group, u8Tag); tMatch != 0; tMatch &= tMatch - 1U)
+		{
+			szSlot = (szGroup * GROUP_WIDTH) + group_mask_first(tMatch);
+			if (key_equal(pstSet, pvKey, slot_at(pstSet, szSlot)))
+			{
+				return szSlot;
+			}
+		}
+		if (group_match_empty(pu8Group) != 0)
+		{
+			return NO_SLOT;
+		}
+		szStep++;
+		szGroup = (szGroup + szStep) & szGroupMask;
+	}
+}
+
+/**
+ * Find the first EMPTY or DELETED slot along a hash's probe sequence
+ *
+ * Note: the table must have at least one EMPTY or DELETED slot
+ *
+ * @param[in]	pu8Control	Control bytes
+ * @param[in]	szCapacity	Number of slots
+ * @param[in]	u64Hash		Hash of the key
+ *
+ * @return Slot index
+ */
+static size_t find_free_slot(const uint8_t * pu8Control, size_t szCapacity, uint64_t u64Hash)
+{
+	size_t szGroupMask = (szCapacity / GROUP_WIDTH) - 1U;
+	size_t szGroup = (size_t) (u64Hash >> 7) & szGroupMask;
+	group_mask_t tMatch;
+	size_t szStep = 0;
+
+	for (;;)
+	{
+		tMatch = group_match_empty_or_deleted(&pu8Control[szGroup * GROUP_WIDTH]);
+		if (tMatch != 0)
+		{
+			return (szGroup * GROUP_WIDTH) + group_mask_first(tMatch);
+		}
+		szStep++;
+		szGroup = (szGroup + szStep) & szGroupMask;
+	}
+}
+
+/**
+ * Move all the items of an unordered set into a freshly allocated table (dropping all tombstones)
+ *
+ * @param[in]	pstSet			Unordered set
+ * @param[in]	szNewCapacity	Number of slots in the new table (must be able to hold all the items)
+ *
+ * @return True if the table was rehashed, false if memory ran out
+ */
+static bool rehash(std_unorderedset_t * pstSet, size_t szNewCapacity)
+{
+	std_container_t * pstContainer = &pstSet->stContainer;
+	size_t szSlotsSize = szNewCapacity * pstContainer->szSizeofItem;
+	void * pvNewSlots;
+	uint8_t * pu8NewControl;
+	size_t szOld;
+	size_t szNew;
+	uint64_t u64Hash;
+	void * pvItem;
+
+	// The slots and their control bytes share one allocation (control bytes last)
+	pvNewSlots = std_memoryhandler_malloc(pstContainer->pstMemoryHandler, pstContainer->eHas, szSlotsSize + szNewCapacity);
+	if (pvNewSlots == NULL)
+	{
+		return false;
+	}
+	pu8NewControl = (uint8_t *) STD_LINEAR_ADD(pvNewSlots, szSlotsSize);
+	memset(pu8NewControl, CTRL_EMPTY, szNewCapacity);
+
+	for (szOld = 0; szOld < pstSet->szCapacity; szOld++)
+	{
+		if (CTRL_IS_FULL(pstSet->pu8Control[szOld]))
+		{
+			pvItem = slot_at(pstSet, szOld);
+			u64Hash = key_hash(pstSet, pvItem);
+			szNew = find_free_slot(pu8NewControl, szNewCapacity, u64Hash);
+			pu8NewControl[szNew] = (uint8_t) (u64Hash & 0x7FU);
+			stdlib_container_relocate_items(pstContainer, STD_LINEAR_ADD(pvNewSlots, szNew * pstContainer->szSizeofItem), pvItem, 1U);
+		}
+	}
+
+	if (pstSet->pvSlots != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSet->pvSlots);
+	}
+	pstSet->pvSlots = pvNewSlots;
+	pstSet->pu8Control = pu8NewControl;
+	pstSet->szCapacity = szNewCapacity;
+	pstSet->szGrowthLeft = capacity_to_max_items(szNewCapacity) - pstContainer->szNumItems;
+	return true;
+}
+
+/**
+ * Empty out a slot (leaving a tombstone only if it's in a group that has filled up)
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	szSlot		Slot index
+ */
+static void slot_clear(std_unorderedset_t * pstSet, size_t szSlot)
+{
+	if (group_match_empty(&pstSet->pu8Control[szSlot & ~(size_t) (GROUP_WIDTH - 1U)]) != 0)
+	{
+		pstSet->pu8Control[szSlot] = CTRL_EMPTY;
+		pstSet->szGrowthLeft++;
+	}
+	else
+	{
+		pstSet->pu8Control[szSlot] = CTRL_DELETED;
+	}
+	pstSet->stContainer.szNumItems--;
+}
+
+/**
+ * Find the first FULL slot at or after a given slot
+ *
+ * @param[in]	pstSet		Unordered set
+ * @param[in]	szSlot		Slot index to start looking at
+ *
+ * @return Slot index (or the capacity if there are no more FULL slots)
+ */
+static size_t next_full_slot(const std_unorderedset_t * pstSet, size_t szSlot)
+{
+	while ((szSlot < pstSet->szCapacity) && !CTRL_IS_FULL(pstSet->pu8Control[szSlot]))
+	{
+		szSlot++;
+	}
+	return szSlot;
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Construct an unordered set container
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	szSizeof		Size of an item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (the same as an item)
+ * @param[in]	szPayloadOffset	Offset of a raw item inside a wrapped item (zero)
+ * @param[in]	eHas			Enumeration saying which handlers to expect
+ */
+void stdlib_unorderedset_construct(std_container_t * pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+
+	if (szWrappedSizeof || szPayloadOffset) { /* Unused parameters */ }
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+	pstSet->pfnHash = NULL;
+	pstSet->pfnEqual = NULL;
+	pstSet->szKeySizeof = szSizeof;
+	pstSet->szCapacity = 0;
+	pstSet->szGrowthLeft = 0;
+	pstSet->pu8Control = NULL;
+	pstSet->pvSlots = NULL;
+}
+
+/**
+ * Destruct an unordered set container (and all the items inside it)
+ *
+ * @param[in]	pstContainer	Unordered set container to destruct
+ *
+ * @return True if the unordered set was able to be destructed, else false
+ */
+bool stdlib_unorderedset_destruct(std_container_t * pstContainer)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	size_t szSlot;
+
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	// If an item handler is attached AND that item handler has a destructor, destruct each item in the container
+	if (	(pstContainer->eHas & std_container_has_itemhandler)
+		&&	(pstContainer->pstItemHandler->pfn_Destructor != NULL)	)
+	{
+		for (szSlot = next_full_slot(pstSet, 0); szSlot < pstSet->szCapacity; szSlot = next_full_slot(pstSet, szSlot + 1U))
+		{
+			(*pstContainer->pstItemHandler->pfn_Destructor)(pstContainer->pstItemHandler, slot_at(pstSet, szSlot));
+		}
+	}
+
+	if (pstSet->pvSlots != NULL)
+	{
+		std_memoryhandler_free(pstContainer->pstMemoryHandler, pstContainer->eHas, pstSet->pvSlots);
+	}
+	pstSet->pvSlots = NULL;
+	pstSet->pu8Control = NULL;
+	pstSet->szCapacity = 0;
+	pstSet->szGrowthLeft = 0;
+	pstContainer->szNumItems = 0;
+	return true;
+}
+
+/**
+ * Reserve space within an unordered set container for a number of items
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	szNewSize		New number of items
+ *
+ * @return True if was able to reserve the memory OK, else false
+ */
+bool stdlib_unorderedset_reserve(std_container_t * pstContainer, size_t szNewSize)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+
+	if (szNewSize <= pstContainer->szNumItems + pstSet->szGrowthLeft)
+	{
+		return true;
+	}
+	return rehash(pstSet, capacity_for(szNewSize));
+}
+
+/**
+ * Set the hash and equality functions that an unordered set uses
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pfnHash			Hash function (or NULL to hash each key's bytes)
+ * @param[in]	pfnEqual		Equality function (or NULL to compare each key's bytes)
+ */
+void stdlib_unorderedset_hash_set(std_container_t * pstContainer, pfn_std_hash_t pfnHash, pfn_std_equal_t pfnEqual)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+
+	pstSet->pfnHash = pfnHash;
+	pstSet->pfnEqual = pfnEqual;
+}
+
+/**
+ * Hash a key the way an unordered set does (e.g. so that a sharded container can pick a shard)
+ *
+ * Note: the low bits pick the key's probe sequence, so shards should be picked with the top bits
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Hash value
+ */
+uint64_t stdlib_unorderedset_hash(const std_container_t * pstContainer, const void * pvKey)
+{
+	return key_hash(STD_CONTAINER_OF(pstContainer, const std_unorderedset_t, stContainer), pvKey);
+}
+
+/**
+ * Find the item matching a key in an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ *
+ * @return Pointer to the matching item (or NULL if there isn't one)
+ */
+void * stdlib_unorderedset_find(std_container_t * pstContainer, const void * pvKey)
+{
+	return stdlib_unorderedset_find_hashed(pstContainer, pvKey, stdlib_unorderedset_hash(pstContainer, pvKey));
+}
+
+/**
+ * Find the item matching an already-hashed key in an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ * @param[in]	u64Hash			Key's hash (from stdlib_unorderedset_hash())
+ *
+ * @return Pointer to the matching item (or NULL if there isn't one)
+ */
+void * stdlib_unorderedset_find_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	size_t szSlot;
+
+	if (pstContainer->szNumItems == 0)
+	{
+		return NULL;
+	}
+
+	szSlot = find_slot(pstSet, pvKey, u64Hash);
+	return (szSlot == NO_SLOT) ? NULL : slot_at(pstSet, szSlot);
+}
+
+/**
+ * Find the slot for a key in an unordered set, claiming a new slot for it if it isn't already present
+ *
+ * Note: a newly claimed slot is left for the caller to fill in (starting with the key)
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ * @param[out]	pbInserted		Set to true if a new slot was claimed, false if the key was already present
+ *
+ * @return Pointer to the slot (or NULL if memory ran out)
+ */
+void * stdlib_unorderedset_insert_slot(std_container_t * pstContainer, const void * pvKey, bool * pbInserted)
+{
+	return stdlib_unorderedset_insert_slot_hashed(pstContainer, pvKey, stdlib_unorderedset_hash(pstContainer, pvKey), pbInserted);
+}
+
+/**
+ * Find the slot for an already-hashed key in an unordered set, claiming a new slot for it if it isn't already present
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ * @param[in]	u64Hash			Key's hash (from stdlib_unorderedset_hash())
+ * @param[out]	pbInserted		Set to true if a new slot was claimed, false if the key was already present
+ *
+ * @return Pointer to the slot (or NULL if memory ran out)
+ */
+void * stdlib_unorderedset_insert_slot_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash, bool * pbInserted)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	size_t szSlot;
+
+	*pbInserted = false;
+
+	szSlot = find_slot(pstSet, pvKey, u64Hash);
+	if (szSlot != NO_SLOT)
+	{
+		return slot_at(pstSet, szSlot);
+	}
+
+	if (pstSet->szCapacity == 0)
+	{
+		if (!rehash(pstSet, GROUP_WIDTH))
+		{
+			return NULL;
+		}
+	}
+
+	szSlot = find_free_slot(pstSet->pu8Control, pstSet->szCapacity, u64Hash);
+	if ((pstSet->pu8Control[szSlot] == CTRL_EMPTY) && (pstSet->szGrowthLeft == 0))
+	{
+		// Out of EMPTY slots: grow if the table is more than half-full, else just clear out the tombstones
+		if (!rehash(pstSet, capacity_for((pstContainer->szNumItems + 1U) * 2U)))
+		{
+			return NULL;
+		}
+		szSlot = find_free_slot(pstSet->pu8Control, pstSet->szCapacity, u64Hash);
+	}
+
+	if (pstSet->pu8Control[szSlot] == CTRL_EMPTY)
+	{
+		pstSet->szGrowthLeft--;
+	}
+	pstSet->pu8Control[szSlot] = (uint8_t) (u64Hash & 0x7FU);
+	pstContainer->szNumItems++;
+	*pbInserted = true;
+	return slot_at(pstSet, szSlot);
+}
+
+/**
+ * Insert an item into an unordered set (if it isn't already present)
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvItem			Item to insert
+ *
+ * @return True if the item was inserted, false if it was already present (or memory ran out)
+ */
+bool stdlib_unorderedset_insert(std_container_t * pstContainer, const void * pvItem)
+{
+	bool bInserted;
+	void * pvSlot = stdlib_unorderedset_insert_slot(pstContainer, pvItem, &bInserted);
+
+	if (bInserted)
+	{
+		stdlib_container_relocate_items(pstContainer, pvSlot, pvItem, 1U);
+	}
+	return bInserted;
+}
+
+/**
+ * Erase the item matching a key from an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ * @param[out]	pvResult		Where to move the erased item to (or NULL to destruct it)
+ *
+ * @return True if an item was erased, false if the key wasn't present
+ */
+bool stdlib_unorderedset_erase(std_container_t * pstContainer, const void * pvKey, void * pvResult)
+{
+	return stdlib_unorderedset_erase_hashed(pstContainer, pvKey, stdlib_unorderedset_hash(pstContainer, pvKey), pvResult);
+}
+
+/**
+ * Erase the item matching an already-hashed key from an unordered set
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pvKey			Key
+ * @param[in]	u64Hash			Key's hash (from stdlib_unorderedset_hash())
+ * @param[out]	pvResult		Where to move the erased item to (or NULL to destruct it)
+ *
+ * @return True if an item was erased, false if the key wasn't present
+ */
+bool stdlib_unorderedset_erase_hashed(std_container_t * pstContainer, const void * pvKey, uint64_t u64Hash, void * pvResult)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	size_t szSlot;
+
+	if (pstContainer->szNumItems == 0)
+	{
+		return false;
+	}
+
+	szSlot = find_slot(pstSet, pvKey, u64Hash);
+	if (szSlot == NO_SLOT)
+	{
+		return false;
+	}
+
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, slot_at(pstSet, szSlot), pstContainer->szSizeofItem);
+	slot_clear(pstSet, szSlot);
+	return true;
+}
+
+/**
+ * Push a series of items into an unordered set container
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pstSeries		Linear series of items to push
+ *
+ * @return Number of items pushed (items already in the set aren't pushed)
+ */
+size_t stdlib_unorderedset_push(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_linear_series_iterator_t stIt;
+	size_t szNumPushed = 0;
+
+	stdlib_unorderedset_reserve(pstContainer, pstContainer->szNumItems + pstSeries->szNumItems);
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (; !std_linear_series_iterator_done(&stIt); std_linear_series_iterator_next(&stIt))
+	{
+		if (stdlib_unorderedset_insert(pstContainer, stIt.pvData))
+		{
+			szNumPushed++;
+		}
+	}
+	return szNumPushed;
+}
+
+/**
+ * Pop items (in no particular order) from an unordered set container
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[out]	pvResult		Where to pop the items to (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items to pop
+ *
+ * @return Number of items popped
+ */
+size_t stdlib_unorderedset_pop(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	size_t szSlot = 0;
+	size_t i;
+
+	for (i = 0; (i < szMaxItems) && (pstContainer->szNumItems > 0); i++)
+	{
+		szSlot = next_full_slot(pstSet, szSlot);
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, slot_at(pstSet, szSlot), pstContainer->szSizeofItem);
+		slot_clear(pstSet, szSlot);
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	return i;
+}
+
+/**
+ * Construct a forward iterator for an unordered set container
+ *
+ * @param[in]	pstContainer	Unordered set container
+ * @param[in]	pstIterator		Iterator
+ * @param[in]	szFirst			Index of the first item (unused)
+ * @param[in]	szLast			Index of the last item (unused)
+ */
+void stdlib_unorderedset_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstContainer);
+	std_unorderedset_iterator_t * pstSetIt = ITERATOR_TO_UNORDEREDSETIT(pstIterator);
+	size_t szSlot;
+
+	if (szFirst || szLast) { /* Unordered sets can only be iterated from start to end */ }
+
+	szSlot = next_full_slot(pstSet, 0);
+	if (szSlot >= pstSet->szCapacity)
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		stdlib_iterator_construct(pstIterator, pstContainer, slot_at(pstSet, szSlot));
+		pstIterator->pvBegin = pstSet->pvSlots;
+		pstIterator->pvEnd = NULL;
+		pstIterator->pvNext = NULL;
+		pstSetIt->szSlot = szSlot;
+	}
+}
+
+/**
+ * Step an unordered set iterator forwards to the next item
+ *
+ * @param[in]	pstIterator		Unordered set iterator
+ */
+void stdlib_unorderedset_forwarditerator_next(std_iterator_t * pstIterator)
+{
+	std_unorderedset_t * pstSet = CONTAINER_TO_UNORDEREDSET(pstIterator->pstContainer);
+	std_unorderedset_iterator_t * pstSetIt = ITERATOR_TO_UNORDEREDSETIT(pstIterator);
+	size_t szSlot = next_full_slot(pstSet, pstSetIt->szSlot + 1U);
+
+	if (szSlot >= pstSet->szCapacity)
+	{
+		pstIterator->bDone = true;
+	}
+	else
+	{
+		pstIterator->pvRef = slot_at(pstSet, szSlot);
+		pstSetIt->szSlot = szSlot;
+	}
+}
+
+// -------------------------------------------------------------------------
+
+static bool unorderedset_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_unorderedset_destruct((std_container_t *) pvData);
+}
+
+const std_item_handler_t std_unorderedset_default_itemhandler =
+{
+	.szElementSize = sizeof(std_unorderedset_t),
+	.pfn_Destructor = &unorderedset_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -0,0 +1,703 @@
+/*
+ * src/std_unrolled_list.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <string.h>		// for memcpy
+
+#include "std/unrolled_list.h"
+
+// Round a size up to a multiple of the strictest fundamental alignment
+#define ALIGN_UP(SIZE)	(((SIZE) + STD_ALIGNOF(max_align_t) - 1U) & ~(STD_ALIGNOF(max_align_t) - 1U))
+
+// Number of items currently held in a node
+#define NODE_COUNT(NODE)	((NODE)->szEnd - (NODE)->szStart)
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+/**
+ * Calculate the address of a slot within a node
+ *
+ * @param[in]	pstList		Unrolled list
+ * @param[in]	pstNode		Node
+ * @param[in]	szSlot		Slot index
+ *
+ * @return Address of the slot
+ */
+static void * node_slot(const std_unrolled_list_t * pstList, std_unrolled_list_node_t * pstNode, size_t szSlot)
+{
+	return STD_LINEAR_ADD(pstNode, pstList->szItemsOffset + (szSlot * pstList->stContainer.szSizeofItem));
+}
+
+/**
+ * Move a run of items between (possibly overlapping) runs of slots
+ *
+ * @param[in]	pstList		Unrolled list
+ * @param[in]	pvNewAddr	Destination slot
+ * @param[in]	pvOldAddr	Source slot
+ * @param[in]	szNumItems	Number of items to move
+ */
+static void items_move(std_unrolled_list_t * pstList, void * pvNewAddr, const void * pvOldAddr, size_t szNumItems)
+{
+	if (szNumItems != 0U)
+	{
+		stdlib_container_relocate_items(&pstList->stContainer, pvNewAddr, pvOldAddr, szNumItems);
+	}
+}
+
+/**
+ * Take a new (empty) node from the list's node pool
+ *
+ * @param[in]	pstList		Unrolled list
+ * @param[in]	szStart		Slot that the node's (empty) run of items starts at
+ *
+ * @return New node (or NULL if no memory was available)
+ */
+static std_unrolled_list_node_t * node_alloc(std_unrolled_list_t * pstList, size_t szStart)
+{
+	std_unrolled_list_node_t * pstNode = stdlib_node_pool_alloc(&pstList->stPool, &pstList->stContainer);
+	if (pstNode != NULL)
+	{
+		pstNode->pstPrev	= NULL;
+		pstNode->pstNext	= NULL;
+		pstNode->szStart	= szStart;
+		pstNode->szEnd		= szStart;
+	}
+	return pstNode;
+}
+
+/**
+ * Link a node into a list immediately after an existing node
+ *
+ * @param[in]	pstList		Unrolled list
+ * @param[in]	pstPosition	Existing node (or NULL to link the new node in at the head of the list)
+ * @param[in]	pstNode		New node
+ */
+static void node_link_after(std_unrolled_list_t * pstList, std_unrolled_list_node_t * pstPosition, std_unrolled_list_node_t * pstNode)
+{
+	pstNode->pstPrev = pstPosition;
+	pstNode->pstNext = (pstPosition == NULL) ? pstList->pstHead : pstPosition->pstNext;
+	if (pstNode->pstNext == NULL)
+	{
+		pstList->pstTail = pstNode;
+	}
+	else
+	{
+		pstNode->pstNext->pstPrev = pstNode;
+	}
+	if (pstPosition == NULL)
+	{
+		pstList->pstHead = pstNode;
+	}
+	else
+	{
+		pstPosition->pstNext = pstNode;
+	}
+}
+
+/**
+ * Unlink a (now empty) node from a list and return it to the list's node pool
+ *
+ * @param[in]	pstList		Unrolled list
+ * @param[in]	pstNode		Node to remove
+ */
+static void node_remove(std_unrolled_list_t * pstList, std_unrolled_list_node_t * pstNode)
+{
+	if (pstNode->pstPrev == NULL)
+	{
+		pstList->pstHead = pstNode->pstNext;
+	}
+	else
+	{
+		pstNode->pstPrev->pstNext = pstNode->pstNext;
+	}
+	if (pstNode->pstNext == NULL)
+	{
+		pstList->pstTail = pstNode->pstPrev;
+	}
+	else
+	{
+		pstNode->pstNext->pstPrev = pstNode->pstPrev;
+	}
+	stdlib_node_pool_free(&pstList->stPool, pstNode);
+}
+
+/**
+ * Open up a free slot inside a node's run of items, splitting the node in two if it is full
+ *
+ * Note: positions are given as offsets relative to the start of a node's run of items
+ *
+ * @param[in]		pstList		Unrolled list
+ * @param[in,out]	ppstNode	Node holding a tracked item (updated if that item moves to a different node)
+ * @param[in,out]	pszOffset	Offset of the tracked item (updated if that item moves)
+ * @param[in]		szGap		Offset (within the tracked item's node) that the new slot should be opened at
+ *
+ * @return Address of the new slot (or NULL if no memory was available)
+ */
+static void * node_open_gap(std_unrolled_list_t * pstList, std_unrolled_list_node_t ** ppstNode, size_t * pszOffset, size_t szGap)
+{
+	std_unrolled_list_node_t * pstNode = *ppstNode;
+	std_unrolled_list_node_t * pstSplit;
+	size_t szHalf;
+	size_t szSlot;
+
+	// If the node is full, move the top half of its items into a new node after it
+	if ((pstNode->szStart == 0U) && (pstNode->szEnd == pstList->szItemsPerNode))
+	{
+		pstSplit = node_alloc(pstList, 0U);
+		if (pstSplit == NULL)
+		{
+			return NULL;
+		}
+		szHalf = pstList->szItemsPerNode / 2U;
+		pstSplit->szEnd = pstList->szItemsPerNode - szHalf;
+		items_move(pstList, node_slot(pstList, pstSplit, 0U), node_slot(pstList, pstNode, szHalf), pstSplit->szEnd);
+		pstNode->szEnd = szHalf;
+		node_link_after(pstList, pstNode, pstSplit);
+
+		if (*pszOffset >= szHalf)
+		{
+			*ppstNode = pstSplit;
+			*pszOffset -= szHalf;
+		}
+		if (szGap > szHalf)
+		{
+			pstNode = pstSplit;
+			szGap -= szHalf;
+		}
+	}
+
+	// Shift whichever side of the gap is shorter (as long as there is room on that side)
+	szSlot = pstNode->szStart + szGap;
+	if (	(pstNode->szEnd < pstList->szItemsPerNode)
+		&&	((pstNode->szStart == 0U) || (pstNode->szEnd - szSlot <= szGap))	)
+	{
+		items_move(pstList, node_slot(pstList, pstNode, szSlot + 1U), node_slot(pstList, pstNode, szSlot), pstNode->szEnd - szSlot);
+		pstNode->szEnd++;
+	}
+	else
+	{
+		items_move(pstList, node_slot(pstList, pstNode, pstNode->szStart - 1U), node_slot(pstList, pstNode, pstNode->szStart), szGap);
+		pstNode->szStart--;
+		szSlot--;
+	}
+
+	if ((*ppstNode == pstNode) && (*pszOffset >= szGap))
+	{
+		(*pszOffset)++;
+	}
+
+	return node_slot(pstList, pstNode, szSlot);
+}
+
+/**
+ * Insert a linear series of items next to the current iterator item
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pstSeries		Linear series of items
+ * @param[in]	bAfter			True to insert each item immediately after the current item, false for immediately before it
+ *
+ * @return Number of items successfully inserted
+ */
+static size_t iterator_push(std_iterator_t * pstIterator, const std_linear_series_t * pstSeries, bool bAfter)
+{
+	std_container_t * pstContainer = pstIterator->pstContainer;
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_iterator_t * pstIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_linear_series_iterator_t stIt;
+	std_unrolled_list_node_t * pstNode = pstIt->pstNode;
+	size_t szOffset = pstIt->szSlot - pstNode->szStart;
+	void * pvItem;
+	size_t i;
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		pvItem = node_open_gap(pstList, &pstNode, &szOffset, bAfter ? (szOffset + 1U) : szOffset);
+		if (pvItem == NULL)
+		{
+			break;
+		}
+		stdlib_container_relocate_items(pstContainer, pvItem, stIt.pvData, 1U);
+		pstContainer->szNumItems++;
+	}
+
+	// The current item may have moved, so point the iterator back at it
+	pstIt->pstNode		= pstNode;
+	pstIt->szSlot		= pstNode->szStart + szOffset;
+	pstIterator->pvRef	= node_slot(pstList, pstNode, pstIt->szSlot);
+
+	return i;
+}
+
+/**
+ * Pop/erase the item at the current iterator, leaving the iterator ready to step on to the following item
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pvResult		Where to pop the item to (or NULL to erase it)
+ * @param[in]	bReverse		True if the iterator is stepping backwards through the list
+ */
+static void iterator_pop_at(std_iterator_t * pstIterator, void * pvResult, bool bReverse)
+{
+	std_container_t * pstContainer = pstIterator->pstContainer;
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_iterator_t * pstIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_unrolled_list_node_t * pstNode = pstIt->pstNode;
+	std_unrolled_list_node_t * pstNext;
+	size_t szOffset = pstIt->szSlot - pstNode->szStart;
+	size_t szCount;
+
+	stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_slot(pstList, pstNode, pstIt->szSlot), pstContainer->szSizeofItem);
+	pstContainer->szNumItems--;
+
+	// Close the gap by shifting whichever side of it is shorter
+	if (szOffset < NODE_COUNT(pstNode) - 1U - szOffset)
+	{
+		items_move(pstList, node_slot(pstList, pstNode, pstNode->szStart + 1U), node_slot(pstList, pstNode, pstNode->szStart), szOffset);
+		pstNode->szStart++;
+	}
+	else
+	{
+		items_move(pstList, node_slot(pstList, pstNode, pstIt->szSlot), node_slot(pstList, pstNode, pstIt->szSlot + 1U), pstNode->szEnd - pstIt->szSlot - 1U);
+		pstNode->szEnd--;
+	}
+
+	szCount = NODE_COUNT(pstNode);
+	if (szCount == 0U)
+	{
+		// The node is now empty, so the following item is at the near end of the neighbouring node
+		pstNext = bReverse ? pstNode->pstPrev : pstNode->pstNext;
+		node_remove(pstList, pstNode);
+		pstNode = pstNext;
+		if (pstNode != NULL)
+		{
+			szOffset = bReverse ? (NODE_COUNT(pstNode) - 1U) : 0U;
+		}
+	}
+	else
+	{
+		// Fold the next node into this one if both together would fit into half a node
+		// (so that every pair of adjacent nodes is always at least a quarter full)
+		pstNext = pstNode->pstNext;
+		if ((pstNext != NULL) && (szCount + NODE_COUNT(pstNext) <= pstList->szItemsPerNode / 2U))
+		{
+			if (pstNode->szEnd + NODE_COUNT(pstNext) > pstList->szItemsPerNode)
+			{
+				items_move(pstList, node_slot(pstList, pstNode, 0U), node_slot(pstList, pstNode, pstNode->szStart), szCount);
+				pstNode->szStart	= 0U;
+				pstNode->szEnd		= szCount;
+			}
+			items_move(pstList, node_slot(pstList, pstNode, pstNode->szEnd), node_slot(pstList, pstNext, pstNext->szStart), NODE_COUNT(pstNext));
+			pstNode->szEnd += NODE_COUNT(pstNext);
+			node_remove(pstList, pstNext);
+		}
+
+		if (bReverse)
+		{
+			if (szOffset == 0U)
+			{
+				pstNode = pstNode->pstPrev;
+				szOffset = (pstNode == NULL) ? 0U : (NODE_COUNT(pstNode) - 1U);
+			}
+			else
+			{
+				szOffset--;
+			}
+		}
+		else if (szOffset == NODE_COUNT(pstNode))
+		{
+			pstNode = pstNode->pstNext;
+			szOffset = 0U;
+		}
+	}
+
+	// Leave the iterator on the following item, and tell the next step not to move past it
+	pstIt->pstNode	= pstNode;
+	pstIt->bStay	= true;
+	if (pstNode != NULL)
+	{
+		pstIt->szSlot = pstNode->szStart + szOffset;
+	}
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+/**
+ * Initialise a newly-allocated unrolled list
+ *
+ * @param[in]	pstContainer	Unrolled list container to initialise
+ * @param[in]	szSizeof		Size of a raw (unwrapped) item
+ * @param[in]	szWrappedSizeof	Size of a wrapped item (unused)
+ * @param[in]	szPayloadOffset	Offset of a raw (payload) item inside a wrapped item (unused)
+ * @param[in]	eHas			Specifies which kinds of handlers this container uses
+ */
+void stdlib_unrolled_list_construct(std_container_t* pstContainer, size_t szSizeof, size_t szWrappedSizeof, size_t szPayloadOffset, std_container_has_t eHas)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	size_t szItemsPerNode;
+	size_t szItemsOffset;
+
+	if (szWrappedSizeof || szPayloadOffset) { /* Unused parameters */ }
+
+	std_container_constructor(pstContainer, szSizeof, eHas);
+
+	// Fit as many items as possible into a node of the target size (but always at least a few)
+	szItemsOffset = ALIGN_UP(sizeof(std_unrolled_list_node_t));
+	szItemsPerNode = (STD_UNROLLED_LIST_NODE_SIZE > szItemsOffset) ? ((STD_UNROLLED_LIST_NODE_SIZE - szItemsOffset) / szSizeof) : 0U;
+	if (szItemsPerNode < STD_UNROLLED_LIST_MIN_ITEMS_PER_NODE)
+	{
+		szItemsPerNode = STD_UNROLLED_LIST_MIN_ITEMS_PER_NODE;
+	}
+
+	pstList->szItemsPerNode	= szItemsPerNode;
+	pstList->szItemsOffset	= szItemsOffset;
+	pstList->pstHead		= NULL;
+	pstList->pstTail		= NULL;
+	stdlib_node_pool_construct(&pstList->stPool, ALIGN_UP(szItemsOffset + (szItemsPerNode * szSizeof)));
+}
+
+/**
+ * Destruct an unrolled list container (and all the things inside it)
+ *
+ * @param[in]	pstContainer		Unrolled list container to destruct
+ *
+ * @return		True if unrolled list container was able to be destructed, else false
+ */
+bool stdlib_unrolled_list_destruct(std_container_t* pstContainer)
+{
+	if (pstContainer == NULL)
+	{
+		return false;
+	}
+
+	stdlib_unrolled_list_pop_front(pstContainer, NULL, pstContainer->szNumItems);
+	stdlib_node_pool_destruct(&CONTAINER_TO_UNROLLED_LIST(pstContainer)->stPool, pstContainer);
+
+	return true;
+}
+
+/**
+ * Push a series of items onto the front of an unrolled list container
+ *
+ * @param[in]	pstContainer	Unrolled list container to push onto
+ * @param[in]	pstSeries		Linear series of items to push onto the list
+ *
+ * @return Number of items pushed onto the container
+ */
+size_t stdlib_unrolled_list_push_front(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_linear_series_iterator_t stIt;
+	std_unrolled_list_node_t * pstNode;
+	void * pvItem;
+	size_t i;
+
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, (pstSeries->szNumItems + pstList->szItemsPerNode - 1U) / pstList->szItemsPerNode);
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		// New nodes at the front fill from their last slot downwards
+		pstNode = pstList->pstHead;
+		if ((pstNode == NULL) || (pstNode->szStart == 0U))
+		{
+			pstNode = node_alloc(pstList, pstList->szItemsPerNode);
+			if (pstNode == NULL)
+			{
+				break;
+			}
+			node_link_after(pstList, NULL, pstNode);
+		}
+
+		pvItem = node_slot(pstList, pstNode, --pstNode->szStart);
+		stdlib_container_relocate_items(pstContainer, pvItem, stIt.pvData, 1U);
+		pstContainer->szNumItems++;
+	}
+
+	return i;
+}
+
+/**
+ * Push a series of items onto the back of an unrolled list container
+ *
+ * @param[in]	pstContainer	Unrolled list container to push items onto
+ * @param[in]	pstSeries		Linear series of items to push onto the list
+ *
+ * @return Number of items pushed onto the container
+ */
+size_t stdlib_unrolled_list_push_back(std_container_t * pstContainer, const std_linear_series_t * pstSeries)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_linear_series_iterator_t stIt;
+	std_unrolled_list_node_t * pstNode;
+	void * pvItem;
+	size_t i;
+
+	stdlib_node_pool_reserve(&pstList->stPool, pstContainer, (pstSeries->szNumItems + pstList->szItemsPerNode - 1U) / pstList->szItemsPerNode);
+
+	std_linear_series_iterator_construct(&stIt, pstSeries);
+	for (i = 0; !std_linear_series_iterator_done(&stIt); i++, std_linear_series_iterator_next(&stIt))
+	{
+		// New nodes at the back fill from their first slot upwards
+		pstNode = pstList->pstTail;
+		if ((pstNode == NULL) || (pstNode->szEnd == pstList->szItemsPerNode))
+		{
+			pstNode = node_alloc(pstList, 0U);
+			if (pstNode == NULL)
+			{
+				break;
+			}
+			node_link_after(pstList, pstList->pstTail, pstNode);
+		}
+
+		pvItem = node_slot(pstList, pstNode, pstNode->szEnd++);
+		stdlib_container_relocate_items(pstContainer, pvItem, stIt.pvData, 1U);
+		pstContainer->szNumItems++;
+	}
+
+	return i;
+}
+
+/**
+ * Pop a series of items off the front of an unrolled list container
+ *
+ * @param[in]	pstContainer	Unrolled list container to pop items off
+ * @param[in]	pvResult		Array to pop the items into (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items in the array
+ *
+ * @return Number of items popped off the front of the container
+ */
+size_t stdlib_unrolled_list_pop_front(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_node_t * pstNode;
+	size_t szNumItems;
+	size_t i;
+	size_t j;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	// Pop a node's worth of items at a time
+	for (i = 0; i < szMaxItems; i += szNumItems)
+	{
+		pstNode = pstList->pstHead;
+		szNumItems = NODE_COUNT(pstNode);
+		if (szNumItems > szMaxItems - i)
+		{
+			szNumItems = szMaxItems - i;
+		}
+
+		if (pstContainer->eHas & std_container_has_itemhandler)
+		{
+			for (j = 0; j < szNumItems; j++)
+			{
+				stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler,
+									(pvResult == NULL) ? NULL : STD_LINEAR_ADD(pvResult, j * pstContainer->szSizeofItem),
+									node_slot(pstList, pstNode, pstNode->szStart + j), pstContainer->szSizeofItem);
+			}
+		}
+		else if (pvResult != NULL)
+		{
+			memcpy(pvResult, node_slot(pstList, pstNode, pstNode->szStart), szNumItems * pstContainer->szSizeofItem);
+		}
+
+		pstNode->szStart += szNumItems;
+		if (pstNode->szStart == pstNode->szEnd)
+		{
+			node_remove(pstList, pstNode);
+		}
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, szNumItems * pstContainer->szSizeofItem);
+		}
+	}
+	pstContainer->szNumItems -= szMaxItems;
+
+	return szMaxItems;
+}
+
+/**
+ * Pop a series of items off the back of an unrolled list container
+ *
+ * @param[in]	pstContainer	Unrolled list container to pop items off
+ * @param[in]	pvResult		Array to pop the items into (or NULL to erase them)
+ * @param[in]	szMaxItems		Maximum number of items in the array
+ *
+ * @return Number of items popped off the back of the container
+ */
+size_t stdlib_unrolled_list_pop_back(std_container_t * pstContainer, void * pvResult, size_t szMaxItems)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_node_t * pstNode;
+	size_t i;
+
+	if (szMaxItems > pstContainer->szNumItems)
+	{
+		szMaxItems = pstContainer->szNumItems;
+	}
+
+	for (i = 0; i < szMaxItems; i++)
+	{
+		pstNode = pstList->pstTail;
+		pstNode->szEnd--;
+		stdlib_item_pop(pstContainer->eHas, pstContainer->pstItemHandler, pvResult, node_slot(pstList, pstNode, pstNode->szEnd), pstContainer->szSizeofItem);
+		if (pstNode->szStart == pstNode->szEnd)
+		{
+			node_remove(pstList, pstNode);
+		}
+		if (pvResult != NULL)
+		{
+			pvResult = STD_LINEAR_ADD(pvResult, pstContainer->szSizeofItem);
+		}
+	}
+	pstContainer->szNumItems -= szMaxItems;
+
+	return szMaxItems;
+}
+
+/**
+ * Set up an unrolled list iterator to step forwards through an unrolled list
+ *
+ * @param[in]	pstContainer	Unrolled list container
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	szFirst			Index of first item in range (ranges are not supported yet)
+ * @param[in]	szLast			Index of last item in range (ranges are not supported yet)
+ */
+void stdlib_unrolled_list_forwarditerator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_iterator_t * pstIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_unrolled_list_node_t * pstNode = pstList->pstHead;
+
+	if (szFirst || szLast) { /* FIXME Ranges don't work yet! */ }
+
+	if (pstNode == NULL)
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		stdlib_iterator_construct(pstIterator, pstContainer, node_slot(pstList, pstNode, pstNode->szStart));
+		pstIt->pstNode	= pstNode;
+		pstIt->szSlot	= pstNode->szStart;
+		pstIt->bStay	= false;
+	}
+}
+
+/**
+ * Set up an unrolled list iterator to step backwards through an unrolled list
+ *
+ * @param[in]	pstContainer	Unrolled list container
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	szFirst			Index of first item in range (ranges are not supported yet)
+ * @param[in]	szLast			Index of last item in range (ranges are not supported yet)
+ */
+void stdlib_unrolled_list_reverseiterator_construct(std_container_t * pstContainer, std_iterator_t * pstIterator, size_t szFirst, size_t szLast)
+{
+	std_unrolled_list_t * pstList = CONTAINER_TO_UNROLLED_LIST(pstContainer);
+	std_unrolled_list_iterator_t * pstIt = ITERATOR_TO_UNROLLED_LISTIT(pstIterator);
+	std_unrolled_list_node_t * pstNode = pstList->pstTail;
+
+	if (szFirst || szLast) { /* FIXME Ranges don't work yet! */ }
+
+	if (pstNode == NULL)
+	{
+		stdlib_iterator_construct_done(pstIterator);
+	}
+	else
+	{
+		stdlib_iterator_construct(pstIterator, pstContainer, node_slot(pstList, pstNode, pstNode->szEnd - 1U));
+		pstIt->pstNode	= pstNode;
+		pstIt->szSlot	= pstNode->szEnd - 1U;
+		pstIt->bStay	= false;
+	}
+}
+
+/**
+ * Insert a linear series of items immediately after the current iterator item
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pstSeries		Linear series of items
+ *
+ * @return Number of items successfully inserted
+ */
+size_t stdlib_unrolled_list_push_after(std_iterator_t* pstIterator, const std_linear_series_t* pstSeries)
+{
+	return iterator_push(pstIterator, pstSeries, true);
+}
+
+/**
+ * Insert a linear series of items immediately before the current iterator item
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pstSeries		Linear series of items
+ *
+ * @return Number of items successfully inserted
+ */
+size_t stdlib_unrolled_list_push_before(std_iterator_t* pstIterator, const std_linear_series_t* pstSeries)
+{
+	return iterator_push(pstIterator, pstSeries, false);
+}
+
+/**
+ * Pop/erase the item at the current (forward) iterator
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pvResult		Where to pop the item to (or NULL to erase it)
+ */
+void stdlib_unrolled_list_forward_pop_at(std_iterator_t* pstIterator, void * pvResult)
+{
+	iterator_pop_at(pstIterator, pvResult, false);
+}
+
+/**
+ * Pop/erase the item at the current (reverse) iterator
+ *
+ * @param[in]	pstIterator		Unrolled list iterator
+ * @param[in]	pvResult		Where to pop the item to (or NULL to erase it)
+ */
+void stdlib_unrolled_list_reverse_pop_at(std_iterator_t* pstIterator, void * pvResult)
+{
+	iterator_pop_at(pstIterator, pvResult, true);
+}
+
+// -------------------------------------------------------------------------
+
+static bool unrolled_list_default_destruct(const std_item_handler_t* pstItemHandler, void* pvData)
+{
+	if (pstItemHandler) { /* Unused parameter */ }
+	return stdlib_unrolled_list_destruct((std_container_t*)pvData);
+}
+
+const std_item_handler_t std_unrolled_list_default_itemhandler =
+{
+	.szElementSize = sizeof(std_unrolled_list_t),
+	.pfn_Destructor = &unrolled_list_default_destruct,
+	.pfn_Relocator = NULL
+};
@@ -114,7 +114,7 @@ bool stdlib_vector_destruct(std_container_t * pstContainer)
  * @param[in]	pstContainer	Vector container to reserve space for
  * @param[in]	szNewSize		New number of items
  * 
- * @return True if was able to reserve the memory OK, else false
+ * @return True if was able to reserve the memory OK, else false (also when optimistic reads pin the existing memory in place)
  */
 bool stdlib_vector_reserve(std_container_t * pstContainer, size_t szNewSize)
 {
@@ -132,6 +132,12 @@ bool stdlib_vector_reserve(std_container_t * pstContainer, size_t szNewSize)
 
 		if (szNewCapacity != pstVector->szNumAlloced)
 		{
+			// Optimistic readers may be looking at the items, so once allocated they can't move
+			if (	(pstVector->pvStartAddr != NULL)
+				&&	std_container_has_optimistic_reads(pstContainer, pstContainer->eHas)	)
+			{
+				return false;
+			}
 			pstVector->szNumAlloced = szNewCapacity;
 			size_t szTotalSize = pstVector->szNumAlloced * pstVector->stContainer.szSizeofItem;
 			pvNewStart = std_memoryhandler_realloc(pstContainer->pstMemoryHandler, pstContainer->eHas, pstVector->pvStartAddr, szTotalSize);
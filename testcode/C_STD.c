@@ -28,6 +28,16 @@ SOFTWARE.
 #include "std/container.h"
 #include "std/stack.h"
 #include "std/queue.h"
+#include "std/lock_handlers.h"
+
+#include "memory_counter.h"
+
+#if defined(STD_LOCK_HAS_PTHREADS) && defined(STD_LOCK_HAS_ATOMICS)
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#endif
 
 #define CRLF	"\r\n"
 
@@ -36,6 +46,11 @@ static int int_compare(const int* a, const int* b)
     return (*b < *a);
 }
 
+static int qsort_int_compare(const void* a, const void* b)
+{
+	return (*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b);
+}
+
 #define TEST_CONTAINER_NAME(CONTAINER,NAME)			\
 	do {											\
 		const char * pachContainerName = std_container_name(CONTAINER);	\
@@ -259,6 +274,117 @@ static bool vector_test(void)
 	return true;
 }
 
+typedef struct
+{
+	int x;
+	int y;
+} soa_point_t;
+
+static bool soa_vector_test(void)
+{
+	std_soa_vector(soa_point_t) v;
+	int aiPopped[10];
+	soa_point_t astPopped[5];
+	const int * piColumn;
+	size_t szNum;
+	size_t i;
+
+	// Construct a container, test the container name & that it starts empty
+	TEST_CONTAINER_NAME(v, "soa vector");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Split each point into an x column and a y column
+	if (!std_soa_vector_columns_set(v, STD_SOA_VECTOR_FIELD(v, x), STD_SOA_VECTOR_FIELD(v, y)))
+	{
+		printf("Failed to set SoA vector columns (line #%d)" CRLF, __LINE__);
+		return false;
+	}
+
+	// Push 1/2/3/4/5 onto the back of the container, and make sure size == 5
+	std_push_back(v, { 1, 10 }, { 2, 20 }, { 3, 30 }, { 4, 40 }, { 5, 50 });
+	TEST_SIZE(v, 5);
+
+	// The columns can't be changed while the container holds items
+	if (std_soa_vector_columns_set(v, STD_SOA_VECTOR_FIELD(v, x)))
+	{
+		printf("Set SoA vector columns on a non-empty container (line #%d)" CRLF, __LINE__);
+		return false;
+	}
+
+	// Each column should be held as a contiguous array
+	piColumn = std_soa_vector_column(v, x);
+	memcpy(aiPopped, piColumn, 5 * sizeof(int));
+	TEST_ARRAY(aiPopped, ai12345);
+	piColumn = std_soa_vector_column(v, y);
+	for (i = 0; i < 5; i++)
+	{
+		TEST_SAME(v, piColumn[i], 10 * ai12345[i]);
+	}
+
+	// Iterate forwards / backwards through the gathered rows
+	i = 0;
+	for (std_each_forward_const(v, it), i++)
+	{
+		aiPopped[i] = std_iterator_at(it)->x;
+		TEST_SAME(v, std_iterator_at(it)->y, 10 * aiPopped[i]);
+	}
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	i = 0;
+	for (std_each_reverse(v, it), i++)
+		aiPopped[i] = std_iterator_at(it)->x;
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Modify a single field in place
+	*std_soa_vector_at(v, y, 2) = 33;
+	i = 0;
+	for (std_for_range(v, it, 2, 2), i++)
+		TEST_SAME(v, std_iterator_at(it)->y, 33);
+	TEST_SAME(v, i, 1);
+
+	// Pop 5/4/3/2/1 from the back of the container
+	szNum = std_pop_back(v, astPopped, STD_NUM_ELEMENTS(astPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	for (i = 0; i < 5; i++)
+		aiPopped[i] = astPopped[i].x;
+	TEST_ARRAY(aiPopped, ai54321);
+	TEST_SAME(v, astPopped[2].y, 33);
+
+	// Push 1/2/3/4/5 onto the front of the container, then pop 5/4/3/2/1 from the front
+	std_push_front(v, { 1, 10 }, { 2, 20 }, { 3, 30 }, { 4, 40 }, { 5, 50 });
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, astPopped, STD_NUM_ELEMENTS(astPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	for (i = 0; i < 5; i++)
+		aiPopped[i] = astPopped[i].x;
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Grow the container through many reallocations
+	for (i = 0; i < 100000; i++)
+	{
+		std_push_back(v, { (int) i, -(int) i });
+	}
+	TEST_SIZE(v, 100000);
+	piColumn = std_soa_vector_column(v, y);
+	for (i = 0; i < 100000; i++)
+	{
+		if ((piColumn[i] != -(int) i) || (std_soa_vector_at(v, x, i)[0] != (int) i))
+		{
+			printf("Element #%d in SoA vector failed to match (line = %d)" CRLF, (int) i, __LINE__);
+			return false;
+		}
+	}
+
+	std_destruct(v);
+
+	return true;
+}
+
 static bool list_test(void)
 {
 	std_list(int) v;
@@ -534,14 +660,15 @@ static bool list_test(void)
 	return true;
 }
 
-static bool forward_list_test(void)
+static bool unrolled_list_test(void)
 {
-	std_forward_list(int) v;
+	std_unrolled_list(int) v;
+	int iValue;
 	int aiPopped[10];
 	size_t szNum;
 	size_t i;
 
-	TEST_CONTAINER_NAME(v, "forward list");
+	TEST_CONTAINER_NAME(v, "unrolled list");
 
 	// Construct a container, test the container name & that it starts empty
 	std_construct(v);
@@ -561,22 +688,101 @@ static bool forward_list_test(void)
 	TEST_SAME(v, i, 5);
 	TEST_ARRAY(aiPopped, ai12345);
 
+	// Iterate backwards
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Iterate backwards const
+	READ_CONTAINER(v, std_each_reverse_const);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
 	// Pop 5/4/3/2/1 from the back of the container
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	TEST_ARRAY(aiPopped, ai54321);
 
 	// Push 1/2/3/4/5 onto the front of the container, and make sure size == 5
 	std_push_front(v, 1, 2, 3, 4, 5);
 	TEST_SIZE(v, 5);
 
-	// Pop 5/4/3/2/1 from the back of the container
+	// Pop 5/4/3/2/1 from the front of the container
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push_back(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push_front(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
 	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai54321);
 
+	szNum = 0;
+	for (i = 0; i < 1000000; i++)
+	{
+		szNum += std_push_back(v, (int)i);
+	}
+	TEST_SIZE(v, 1000000);
+	TEST_SAME(v, szNum, 1000000);
+
+	for (i = 0; i < 1000000; i++)
+	{
+		if (std_pop_back(v, aiPopped, 1U) != 1U)
+		{
+			printf("Failed to pop element #%d from array (line = %d)" CRLF, (int)i, __LINE__);
+			return false;
+		}
+		if (aiPopped[0] != (int)(1000000U - 1U - i))
+		{
+			printf("Element #%d in vector failed to match (= %d) (line = %d)" CRLF, (int)i, aiPopped[0], __LINE__);
+			return false;
+		}
+	}
+	TEST_SIZE(v, 0);
+
+	std_push_back(v, 1, 2);
+	TEST_SIZE(v, 2);
+	std_append_reversed(v, 5, 4, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 4, 5);
+	TEST_SIZE(v, 2);
+	std_prepend(v, 1, 2, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
 	std_destruct(v);
 
 	std_construct(v);
@@ -594,10 +800,10 @@ static bool forward_list_test(void)
 			break;
 		}
 	}
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	TEST_ARRAY(aiPopped, ai54321);
 
 	std_push_back(v, 1, 5);
 	TEST_SIZE(v, 2);
@@ -612,10 +818,10 @@ static bool forward_list_test(void)
 			break;
 		}
 	}
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	TEST_ARRAY(aiPopped, ai54321);
 
 	std_push_back(v, 1, 5);
 	TEST_SIZE(v, 2);
@@ -630,10 +836,10 @@ static bool forward_list_test(void)
 			break;
 		}
 	}
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	TEST_ARRAY(aiPopped, ai54321);
 
 	std_push_back(v, 1, 5);
 	TEST_SIZE(v, 2);
@@ -648,10 +854,10 @@ static bool forward_list_test(void)
 			break;
 		}
 	}
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	TEST_ARRAY(aiPopped, ai54321);
 
 	std_push_back(v, 1, 100, 2, 3, 4, 5);
 	TEST_SIZE(v, 6);
@@ -704,20 +910,102 @@ static bool forward_list_test(void)
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai12345);
 
+	std_push_back(v, 100, 1, 100, 2, 100, 3, 100, 4, 100, 5, 100);
+	TEST_SIZE(v, 11);
+	for (std_each_forward(v, it))
+	{
+		if (std_iterator_at(it)[0] == 100)
+		{
+			std_erase(it);
+		}
+	}
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_destruct(v);
+
+	std_construct(v);
+	TEST_SIZE(v, 0);
+	std_push_back(v, 1, 2, 3, 4, 5);
+	std_destruct(v);
+
+	// Work across many nodes: push lots of items onto both ends...
+	std_construct(v);
+	for (iValue = 0; iValue < 1000; iValue++)
+	{
+		std_push_back(v, iValue + 1000);
+		std_push_front(v, 999 - iValue);
+	}
+	TEST_SIZE(v, 2000);
+	i = 0;
+	for (std_each_forward_const(v, it), i++)
+	{
+		if (std_iterator_at(it)[0] != (int)i)
+		{
+			printf("Item #%d in unrolled list failed to match (= %d) (line = %d)" CRLF, (int)i, std_iterator_at(it)[0], __LINE__);
+			return false;
+		}
+	}
+	TEST_SAME(v, i, 2000);
+
+	// ...erase all the odd items (so that sparse nodes get folded together)...
+	for (std_each_forward(v, it))
+	{
+		if (std_iterator_at(it)[0] & 1)
+		{
+			std_erase(it);
+		}
+	}
+	TEST_SIZE(v, 1000);
+
+	// ...put them back again (so that full nodes get split)...
+	for (std_each_forward(v, it))
+	{
+		iValue = std_iterator_at(it)[0] + 1;
+		std_push_after(it, iValue);
+		std_iterator_next(it);		// Step over the newly-inserted item
+	}
+	TEST_SIZE(v, 2000);
+
+	// ...erase every item but the multiples of 4 (backwards this time)...
+	for (std_each_reverse(v, it))
+	{
+		if (std_iterator_at(it)[0] & 3)
+		{
+			std_erase(it);
+		}
+	}
+	TEST_SIZE(v, 500);
 
+	// ...and check what is left
+	i = 2000;
+	for (std_each_reverse_const(v, it))
+	{
+		i -= 4;
+		if (std_iterator_at(it)[0] != (int)i)
+		{
+			printf("Item #%d in unrolled list failed to match (= %d) (line = %d)" CRLF, (int)i, std_iterator_at(it)[0], __LINE__);
+			return false;
+		}
+	}
+	TEST_SAME(v, i, 0);
 	std_destruct(v);
 
+
 	return true;
 }
 
-static bool deque_test(void)
+static bool forward_list_test(void)
 {
-	std_deque(int) v;
+	std_forward_list(int) v;
 	int aiPopped[10];
 	size_t szNum;
 	size_t i;
 
-	TEST_CONTAINER_NAME(v, "deque");
+	TEST_CONTAINER_NAME(v, "forward list");
 
 	// Construct a container, test the container name & that it starts empty
 	std_construct(v);
@@ -737,199 +1025,619 @@ static bool deque_test(void)
 	TEST_SAME(v, i, 5);
 	TEST_ARRAY(aiPopped, ai12345);
 
-	// Iterate backwards
-	READ_CONTAINER(v, std_each_reverse);
-	TEST_SAME(v, i, 5);
-	TEST_ARRAY(aiPopped, ai54321);
-
-	// Iterate backwards const
-	READ_CONTAINER(v, std_each_reverse_const);
-	TEST_SAME(v, i, 5);
-	TEST_ARRAY(aiPopped, ai54321);
-
 	// Pop 5/4/3/2/1 from the back of the container
-	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	TEST_ARRAY(aiPopped, ai12345);
 
 	// Push 1/2/3/4/5 onto the front of the container, and make sure size == 5
 	std_push_front(v, 1, 2, 3, 4, 5);
 	TEST_SIZE(v, 5);
 
-	// Pop 5/4/3/2/1 from the front of the container
+	// Pop 5/4/3/2/1 from the back of the container
 	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai54321);
 
-	szNum = 0;
-	for (i = 0; i < 5; i++)
-	{
-		szNum += std_push_back(v, ai12345[i]);
-	}
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
+	std_destruct(v);
 
-	memset(aiPopped, 0, sizeof(aiPopped));
-	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	std_construct(v);
 
-	szNum = 0;
-	for (i = 0; i < 5; i++)
+	std_push_back(v, 1, 5);
+	TEST_SIZE(v, 2);
+	i = 0;
+	for (std_each_forward(v, it), i++)
 	{
-		szNum += std_push_front(v, ai12345[i]);
+		if (i == 0)
+		{
+			szNum = std_push_after(it, 4, 3, 2);
+			TEST_SIZE(v, 5);
+			TEST_SAME(v, szNum, 3);
+			break;
+		}
 	}
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
-
-	memset(aiPopped, 0, sizeof(aiPopped));
 	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	TEST_ARRAY(aiPopped, ai12345);
 
-	szNum = 0;
-	for (i = 0; i < 1000000; i++)
+	std_push_back(v, 1, 5);
+	TEST_SIZE(v, 2);
+	i = 0;
+	for (std_each_forward(v, it), i++)
 	{
-		szNum += std_push_back(v, (int)i);
+		if (i == 1)
+		{
+			szNum = std_push_before(it, 2, 3, 4);
+			TEST_SIZE(v, 5);
+			TEST_SAME(v, szNum, 3);
+			break;
+		}
 	}
-	TEST_SIZE(v, 1000000);
-	TEST_SAME(v, szNum, 1000000);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
 
-	for (i = 0; i < 1000000; i++)
+	std_push_back(v, 1, 5);
+	TEST_SIZE(v, 2);
+	i = 0;
+	for (std_each_forward(v, it), i++)
 	{
-		if (std_pop_back(v, aiPopped, 1U) != 1U)
+		if (i == 0)
 		{
-			printf("Failed to pop element #%d from array (line = %d)" CRLF, (int)i, __LINE__);
-			return false;
+			szNum = std_push_after_reversed(it, 2, 3, 4);
+			TEST_SIZE(v, 5);
+			TEST_SAME(v, szNum, 3);
+			break;
 		}
-		if (aiPopped[0] != (int)(1000000U - 1U - i))
+	}
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 1, 5);
+	TEST_SIZE(v, 2);
+	i = 0;
+	for (std_each_forward(v, it), i++)
+	{
+		if (i == 1)
 		{
-			printf("Element #%d in vector failed to match (= %d) (line = %d)" CRLF, (int)i, aiPopped[0], __LINE__);
-			return false;
+			szNum = std_prepend_before(it, 4, 3, 2);
+			TEST_SIZE(v, 5);
+			TEST_SAME(v, szNum, 3);
+			break;
 		}
 	}
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
 
-	std_push_back(v, 1, 2);
-	TEST_SIZE(v, 2);
-	std_append_reversed(v, 5, 4, 3);
-	TEST_SIZE(v, 5);
+	std_push_back(v, 1, 100, 2, 3, 4, 5);
+	TEST_SIZE(v, 6);
+	i = 0;
+	for (std_each_forward(v, it), i++)
+	{
+		if (i == 1)
+		{
+			std_erase(it);
+			TEST_SIZE(v, 5);
+			break;
+		}
+	}
 	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai12345);
 
-	std_push_back(v, 4, 5);
-	TEST_SIZE(v, 2);
-	std_prepend(v, 1, 2, 3);
-	TEST_SIZE(v, 5);
+	std_push_back(v, 100, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 6);
+	i = 0;
+	for (std_each_forward(v, it), i++)
+	{
+		if (i == 0)
+		{
+			std_erase(it);
+			TEST_SIZE(v, 5);
+			break;
+		}
+	}
 	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
 	TEST_SIZE(v, 0);
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai12345);
 
-	std_push_back(v, 100, 100, 1, 2, 3, 4, 5, 100, 100);
-	TEST_SIZE(v, 2 + 5 + 2);
+	std_push_back(v, 1, 2, 3, 4, 5, 100);
+	TEST_SIZE(v, 6);
 	i = 0;
-	for (std_for_range(v, it, 2, 2 + 5 - 1), i++)
-		aiPopped[i] = std_iterator_at(it)[0];
-	TEST_SAME(v, i, 5);
+	for (std_each_forward(v, it), i++)
+	{
+		if (i == 5)
+		{
+			std_erase(it);
+			TEST_SIZE(v, 5);
+			break;
+		}
+	}
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai12345);
-	std_pop_back(v, (int*)NULL, 100);
+
 
 	std_destruct(v);
 
+	return true;
+}
+
+typedef struct
+{
+	int iKey;
+	int iOrder;
+} sort_pair_t;
+
+static int pair_compare(const sort_pair_t* a, const sort_pair_t* b)
+{
+	return (a->iKey > b->iKey) - (a->iKey < b->iKey);
+}
+
+static bool list_sort_test(void)
+{
+	std_list(int) v;
+	std_forward_list(int) fl;
+	std_list(sort_pair_t) vp;
+	int aiPopped[10];
+	int iPrev;
+	size_t szNum;
+	size_t i;
+
+	// Sort a whole list, then check it both forwards and backwards
 	std_construct(v);
-	std_push_back(v, 1, 2, 3, 4, 5);
-	for (std_scope_const(v, it))
+	std_push_back(v, 3, 5, 1, 4, 2);
+	std_sort(v, &int_compare);
+	TEST_SIZE(v, 5);
+	READ_CONTAINER(v, std_each_forward);
+	TEST_ARRAY(aiPopped, ai12345);
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_ARRAY(aiPopped, ai54321);
+	std_pop_back(v, (int *)NULL, 5);
+
+	// Sort only the middle of a list
+	std_push_back(v, 100, 5, 4, 3, 2, 1, 0);
+	std_ranged_sort(v, 1, 5, &int_compare);
+	std_pop_front(v, (int *)NULL, 1);
+	std_pop_back(v, (int *)NULL, 1);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Sort a large pseudo-random list
+	for (i = 0; i < 10000; i++)
 	{
-		for (i = 0; i < 5; i++)
+		std_push_back(v, (int)((i * 7919U) % 10007U));
+	}
+	std_sort(v, &int_compare);
+	iPrev = -1;
+	for (std_each_reverse(v, it))
+	{
+		if ((iPrev != -1) && (std_iterator_at(it)[0] > iPrev))
 		{
-			std_iterator_seek(it, 4 - i);
-			aiPopped[i] = std_iterator_at(it)[0];
+			printf("Error: list wasn't sorted (line #%d)" CRLF, __LINE__);
+			return false;
 		}
+		iPrev = std_iterator_at(it)[0];
 	}
-	TEST_ARRAY(aiPopped, ai54321);
-	std_pop_back(v, (int*)NULL, 5);
+	TEST_SIZE(v, 10000);
 	std_destruct(v);
 
-	std_construct(v);
-	TEST_SIZE(v, 0);
-	std_push_back(v, 1, 2, 3, 4, 5);
-	std_destruct(v);
+	// Equal items should keep their original order
+	std_construct(vp);
+	for (i = 0; i < 100; i++)
+	{
+		std_push_back(vp, { (int)(i % 3U), (int) i });
+	}
+	std_sort(vp, &pair_compare);
+	iPrev = -1;
+	for (std_each_forward_const(vp, it))
+	{
+		const sort_pair_t * pstPair = std_iterator_at(it);
+		if ((pstPair->iKey < iPrev / 1000) || ((pstPair->iKey == iPrev / 1000) && (pstPair->iOrder < iPrev % 1000)))
+		{
+			printf("Error: list sort wasn't stable (line #%d)" CRLF, __LINE__);
+			return false;
+		}
+		iPrev = (pstPair->iKey * 1000) + pstPair->iOrder;
+	}
+	std_destruct(vp);
+
+	// ...and the same for a forward list
+	std_construct(fl);
+	std_push_back(fl, 3, 5, 1, 4, 2);
+	std_sort(fl, &int_compare);
+	READ_CONTAINER(fl, std_each_forward);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// The last node must still be right after sorting, so keep pushing onto the back
+	std_push_back(fl, 0);
+	std_ranged_sort(fl, 3, 5, &int_compare);
+	std_push_back(fl, 6);
+	szNum = std_pop_front(fl, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(fl, szNum, 7);
+	TEST_SAME(fl, aiPopped[3], 0);
+	TEST_SAME(fl, aiPopped[4], 4);
+	TEST_SAME(fl, aiPopped[5], 5);
+	TEST_SAME(fl, aiPopped[6], 6);
+
+	for (i = 0; i < 10000; i++)
+	{
+		std_push_front(fl, (int)((i * 7919U) % 10007U));
+	}
+	std_sort(fl, &int_compare);
+	iPrev = -1;
+	for (std_each_forward(fl, it))
+	{
+		if (std_iterator_at(it)[0] < iPrev)
+		{
+			printf("Error: forward list wasn't sorted (line #%d)" CRLF, __LINE__);
+			return false;
+		}
+		iPrev = std_iterator_at(it)[0];
+	}
+	TEST_SIZE(fl, 10000);
+	std_destruct(fl);
 
 	return true;
 }
 
-static bool ring_test(void)
+static bool list_splice_test(void)
 {
-	std_ring(int) v;
+	std_list(int) v;
+	std_list(int) v2;
+	std_list(int) v3;
+	std_list(int) v4;
+	std_forward_list(int) fl;
+	std_forward_list(int) fl2;
 	int aiPopped[10];
 	size_t szNum;
 	size_t i;
 
-	TEST_CONTAINER_NAME(v, "ring");
-
-	// Construct a container, test the container name & that it starts empty
 	std_construct(v);
-	TEST_SIZE(v, 0);
+	std_construct(v2);
 
-	// Push 1/2/3/4/5 onto the back of the container, and make sure size == 5
-	std_push_back(v, 1, 2, 3, 4, 5);
+	// Move a range from the middle of one list onto the back of another
+	std_push_back(v, 1, 2);
+	std_push_back(v2, 100, 3, 4, 5, 100);
+	szNum = std_splice(v, v2, 1, 3);
+	TEST_SAME(v, szNum, 3);
 	TEST_SIZE(v, 5);
-
-	// Iterate forwards
+	TEST_SIZE(v2, 2);
 	READ_CONTAINER(v, std_each_forward);
-	TEST_SAME(v, i, 5);
-	TEST_ARRAY(aiPopped, ai12345);
-
-	// Iterate forwards const
-	READ_CONTAINER(v, std_each_forward_const);
-	TEST_SAME(v, i, 5);
 	TEST_ARRAY(aiPopped, ai12345);
-
-	// Iterate backwards
 	READ_CONTAINER(v, std_each_reverse);
-	TEST_SAME(v, i, 5);
 	TEST_ARRAY(aiPopped, ai54321);
 
-	// Iterate backwards const
-	READ_CONTAINER(v, std_each_reverse_const);
-	TEST_SAME(v, i, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	// A short range deep inside a long list is found by walking on from its first item
+	std_construct(v3);
+	std_construct(v4);
+	for (i = 0; i < 100; i++)
+	{
+		std_push_back(v3, (int) i);
+	}
+	TEST_SAME(v4, std_splice(v4, v3, 40, 44), 5);
+	TEST_SIZE(v3, 95);
+	i = 40;
+	for (std_each_forward(v4, it))
+	{
+		TEST_SAME(v4, std_iterator_at(it)[0], (int) i++);
+	}
+	TEST_SAME(v4, i, 45);
+	i = 99;
+	for (std_each_reverse(v3, it))
+	{
+		TEST_SAME(v3, std_iterator_at(it)[0], (int) i);
+		i = (i == 45) ? 39 : i - 1U;
+	}
+	std_destruct(v3);
+	std_destruct(v4);
 
-	// Pop 5/4/3/2/1 from the back of the container
-	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	// Move a whole list, then destruct its old owner while its nodes are still in use
+	szNum = std_splice_all(v2, v);
+	TEST_SAME(v2, szNum, 5);
 	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	std_destruct(v);
+	TEST_SIZE(v2, 7);
+	std_pop_front(v2, (int *)NULL, 2);
+	szNum = std_pop_front(v2, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(v2, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
 
-	// Push 1/2/3/4/5 onto the front of the container, and make sure size == 5
-	std_push_front(v, 1, 2, 3, 4, 5);
+	// Merge two sorted lists
+	std_construct(v);
+	std_push_back(v, 1, 3, 5);
+	std_push_back(v2, 2, 4);
+	std_merge(v, v2, &int_compare);
 	TEST_SIZE(v, 5);
-
-	// Pop 5/4/3/2/1 from the front of the container
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
+	TEST_SIZE(v2, 0);
+	READ_CONTAINER(v, std_each_forward);
+	TEST_ARRAY(aiPopped, ai12345);
+	READ_CONTAINER(v, std_each_reverse);
 	TEST_ARRAY(aiPopped, ai54321);
 
-	szNum = 0;
-	for (i = 0; i < 5; i++)
+	// Split a list at an iterator
+	std_push_back(v2, 0);
+	i = 0;
+	for (std_each_forward(v, it), i++)
 	{
-		szNum += std_push_back(v, ai12345[i]);
+		if (i == 2)
+		{
+			szNum = std_split(it, v2);
+		}
 	}
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
-
-	memset(aiPopped, 0, sizeof(aiPopped));
-	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, szNum, 3);
+	TEST_SIZE(v, 2);
+	TEST_SIZE(v2, 4);
+	std_push_back(v, 3);
+	std_pop_front(v2, aiPopped, 1);
+	TEST_SAME(v2, aiPopped[0], 0);
+	std_pop_front(v2, (int *)NULL, 1);
+	std_splice_all(v, v2);
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	std_destruct(v2);
+	std_destruct(v);
+
+	// ...and the same for forward lists
+	std_construct(fl);
+	std_construct(fl2);
+
+	std_push_back(fl, 1, 2);
+	std_push_back(fl2, 100, 3, 4, 5);
+	szNum = std_splice(fl, fl2, 1, 3);
+	TEST_SAME(fl, szNum, 3);
+	TEST_SIZE(fl2, 1);
+	std_push_back(fl2, 101);
+	std_push_back(fl, 6);
+	READ_CONTAINER(fl, std_each_forward);
+	TEST_SAME(fl, i, 6);
+	TEST_ARRAY(aiPopped, ai12345);
+	std_splice_all(fl2, fl);
+	std_destruct(fl);
+	TEST_SIZE(fl2, 8);
+	std_pop_front(fl2, (int *)NULL, 2);
+	std_push_back(fl2, 7);
+	szNum = std_pop_front(fl2, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(fl2, szNum, 7);
+	TEST_ARRAY(aiPopped, ai12345);
+	TEST_SAME(fl2, aiPopped[6], 7);
+
+	std_construct(fl);
+	std_push_back(fl, 2, 4);
+	std_push_back(fl2, 1, 3, 5);
+	std_merge(fl, fl2, &int_compare);
+	TEST_SIZE(fl2, 0);
+	std_push_back(fl, 6);
+	READ_CONTAINER(fl, std_each_forward);
+	TEST_SAME(fl, i, 6);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	i = 0;
+	for (std_each_forward(fl, it), i++)
+	{
+		if (i == 5)
+		{
+			szNum = std_split(it, fl2);
+		}
+	}
+	TEST_SAME(fl, szNum, 1);
+	std_push_back(fl, 10);
+	std_push_back(fl2, 11);
+	TEST_SIZE(fl, 6);
+	TEST_SIZE(fl2, 2);
+	std_pop_front(fl2, aiPopped, 2);
+	TEST_SAME(fl2, aiPopped[0], 6);
+	TEST_SAME(fl2, aiPopped[1], 11);
+
+	std_destruct(fl);
+	std_destruct(fl2);
+
+	return true;
+}
+
+static bool list_pool_test(void)
+{
+	std_list_memoryhandler(int) v;
+	std_list_memoryhandler(int) v2;
+	std_forward_list_memoryhandler(int) fl;
+	std_memoryhandler_t stOtherMemoryHandler;
+	int aiPopped[10];
+	int iMallocs, iReallocs, iFrees;
+	size_t szNum;
+	size_t i;
+
+	// A series of items pushed onto a list should be allocated in one go
+	memorycounter_reset();
+	std_construct_memoryhandler(v, &stMemoryCounter);
+	std_push_back(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v, iMallocs, 1);
+
+	// Pushing items one at a time should allocate nodes in (geometrically growing) batches
+	for (i = 0; i < 10000; i++)
+	{
+		std_push_back(v, (int) i);
+	}
+	TEST_SIZE(v, 10005);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	if (iMallocs > 20)
+	{
+		printf("Error: list made %d allocations (line #%d)" CRLF, iMallocs, __LINE__);
+		return false;
+	}
+
+	// Popped nodes should get recycled rather than freed
+	std_pop_back(v, (int *)NULL, 10000);
+	TEST_SIZE(v, 5);
+	memorycounter_reset();
+	for (i = 0; i < 10000; i++)
+	{
+		std_push_front(v, (int) i);
+	}
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v, iMallocs, 0);
+	TEST_SAME(v, iFrees, 0);
+	std_pop_front(v, (int *)NULL, 10000);
+
+	READ_CONTAINER(v, std_each_forward);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Every block should be freed when the list is destructed
+	memorycounter_reset();
+	std_destruct(v);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	if (iFrees == 0)
+	{
+		printf("Error: list freed no memory on destruct (line #%d)" CRLF, __LINE__);
+		return false;
+	}
+
+	// ...and the same for a forward list
+	memorycounter_reset();
+	std_construct_memoryhandler(fl, &stMemoryCounter);
+	std_push_back(fl, 1, 2, 3, 4, 5);
+	std_push_front(fl, 0);
+	TEST_SIZE(fl, 6);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(fl, iMallocs, 1);
+
+	std_pop_front(fl, (int *)NULL, 1);
+	for (i = 0; i < 1000; i++)
+	{
+		std_pop_front(fl, aiPopped, 1);
+		std_push_back(fl, aiPopped[0]);
+	}
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(fl, iMallocs, 1);
+	TEST_SAME(fl, iFrees, 0);
+
+	READ_CONTAINER(fl, std_each_forward);
+	TEST_SAME(fl, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_destruct(fl);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(fl, iFrees, iMallocs + iReallocs);
+
+	// Nodes spliced into another list should go back to their own list's pool once popped, rather than piling up
+	memorycounter_reset();
+	std_construct_memoryhandler(v, &stMemoryCounter);
+	std_construct_memoryhandler(v2, &stMemoryCounter);
+	for (i = 0; i < 10000; i++)
+	{
+		std_push_back(v, (int) i);
+		std_splice_all(v2, v);
+		std_pop_front(v2, (int *)NULL, 1);
+	}
+	TEST_SIZE(v2, 0);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v, iMallocs, 1);
+
+	// ...and a block should be freed once its last node is popped, even if its own list has gone
+	std_push_back(v, 1, 2, 3, 4, 5);
+	std_splice_all(v2, v);
+	std_destruct(v);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v2, iFrees, iMallocs + iReallocs - 1);
+	std_destruct(v2);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v2, iFrees, iMallocs + iReallocs);
+
+	// Nodes can't move between lists that use different memory handlers
+	stOtherMemoryHandler = stMemoryCounter;
+	std_construct_memoryhandler(v, &stMemoryCounter);
+	std_construct_memoryhandler(v2, &stOtherMemoryHandler);
+	std_push_back(v, 1, 2, 3);
+	szNum = std_splice_all(v2, v);
+	TEST_SAME(v2, szNum, 0);
+	TEST_SIZE(v, 3);
+	TEST_SIZE(v2, 0);
+	std_destruct(v2);
+	std_destruct(v);
+
+	return true;
+}
+
+static bool deque_test(void)
+{
+	std_deque(int) v;
+	int aiPopped[10];
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "deque");
+
+	// Construct a container, test the container name & that it starts empty
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Push 1/2/3/4/5 onto the back of the container, and make sure size == 5
+	std_push_back(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Iterate forwards
+	READ_CONTAINER(v, std_each_forward);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Iterate forwards const
+	READ_CONTAINER(v, std_each_forward_const);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Iterate backwards
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Iterate backwards const
+	READ_CONTAINER(v, std_each_reverse_const);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Pop 5/4/3/2/1 from the back of the container
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Push 1/2/3/4/5 onto the front of the container, and make sure size == 5
+	std_push_front(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Pop 5/4/3/2/1 from the front of the container
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push_back(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai54321);
 
 	szNum = 0;
@@ -946,221 +1654,3021 @@ static bool ring_test(void)
 	TEST_SAME(v, szNum, 5);
 	TEST_ARRAY(aiPopped, ai54321);
 
-	std_destruct(v);
+	szNum = 0;
+	for (i = 0; i < 1000000; i++)
+	{
+		szNum += std_push_back(v, (int)i);
+	}
+	TEST_SIZE(v, 1000000);
+	TEST_SAME(v, szNum, 1000000);
+
+	for (i = 0; i < 1000000; i++)
+	{
+		if (std_pop_back(v, aiPopped, 1U) != 1U)
+		{
+			printf("Failed to pop element #%d from array (line = %d)" CRLF, (int)i, __LINE__);
+			return false;
+		}
+		if (aiPopped[0] != (int)(1000000U - 1U - i))
+		{
+			printf("Element #%d in vector failed to match (= %d) (line = %d)" CRLF, (int)i, aiPopped[0], __LINE__);
+			return false;
+		}
+	}
+	TEST_SIZE(v, 0);
+
+	std_push_back(v, 1, 2);
+	TEST_SIZE(v, 2);
+	std_append_reversed(v, 5, 4, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 4, 5);
+	TEST_SIZE(v, 2);
+	std_prepend(v, 1, 2, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 100, 100, 1, 2, 3, 4, 5, 100, 100);
+	TEST_SIZE(v, 2 + 5 + 2);
+	i = 0;
+	for (std_for_range(v, it, 2, 2 + 5 - 1), i++)
+		aiPopped[i] = std_iterator_at(it)[0];
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+	std_pop_back(v, (int*)NULL, 100);
+
+	std_destruct(v);
+
+	std_construct(v);
+	std_push_back(v, 1, 2, 3, 4, 5);
+	for (std_scope_const(v, it))
+	{
+		for (i = 0; i < 5; i++)
+		{
+			std_iterator_seek(it, 4 - i);
+			aiPopped[i] = std_iterator_at(it)[0];
+		}
+	}
+	TEST_ARRAY(aiPopped, ai54321);
+	std_pop_back(v, (int*)NULL, 5);
+	std_destruct(v);
+
+	std_construct(v);
+	TEST_SIZE(v, 0);
+	std_push_back(v, 1, 2, 3, 4, 5);
+	std_destruct(v);
+
+	return true;
+}
+
+static bool ring_test(void)
+{
+	std_ring(int) v;
+	int aiPopped[10];
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "ring");
+
+	// Construct a container, test the container name & that it starts empty
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Push 1/2/3/4/5 onto the back of the container, and make sure size == 5
+	std_push_back(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Iterate forwards
+	READ_CONTAINER(v, std_each_forward);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Iterate forwards const
+	READ_CONTAINER(v, std_each_forward_const);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	// Iterate backwards
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Iterate backwards const
+	READ_CONTAINER(v, std_each_reverse_const);
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Pop 5/4/3/2/1 from the back of the container
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Push 1/2/3/4/5 onto the front of the container, and make sure size == 5
+	std_push_front(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Pop 5/4/3/2/1 from the front of the container
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push_back(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push_front(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	std_destruct(v);
+
+	std_construct(v);
+
+	szNum = std_push_back(v, 6, 7, 8, 9, 1);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	szNum = std_pop_front(v, (int *)NULL, 4);
+	TEST_SIZE(v, 1);
+	TEST_SAME(v, szNum, 4);
+
+	szNum = std_push_back(v, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 4);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	szNum = 0;
+	for (i = 0; i < 1000000; i++)
+	{
+		szNum += std_push_back(v, (int)i);
+	}
+	TEST_SIZE(v, 1000000);
+	TEST_SAME(v, szNum, 1000000);
+
+	for (i = 0; i < 1000000; i++)
+	{
+		if (std_pop_back(v, aiPopped, 1U) != 1U)
+		{
+			printf("Failed to pop element #%d from ring (line = %d)" CRLF, (int)i, __LINE__);
+			return false;
+		}
+		if (aiPopped[0] != (int)(1000000U - 1U - i))
+		{
+			printf("Element #%d in ring failed to match (= %d) (line = %d)" CRLF, (int)i, aiPopped[0], __LINE__);
+			return false;
+		}
+	}
+	TEST_SIZE(v, 0);
+
+	std_push_back(v, 1, 2);
+	TEST_SIZE(v, 2);
+	std_append_reversed(v, 5, 4, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 4, 5);
+	TEST_SIZE(v, 2);
+	std_prepend(v, 1, 2, 3);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_push_back(v, 100, 100, 1, 2, 3, 4, 5, 100, 100);
+	TEST_SIZE(v, 2 + 5 + 2);
+	i = 0;
+	for (std_for_range(v, it, 2, 2 + 5 - 1), i++)
+		aiPopped[i] = std_iterator_at(it)[0];
+	TEST_SAME(v, i, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+	std_pop_back(v, (int *)NULL, 100);
+
+	std_destruct(v);
+
+	std_construct(v);
+	for (std_scope_const(v, it))
+	{
+		std_push_back(v, 1, 2, 3, 4, 5);
+		for (i = 0; i < 5; i++)
+		{
+			std_iterator_seek(it, 4 - i);
+			aiPopped[i] = std_iterator_at(it)[0];
+		}
+	}
+	TEST_ARRAY(aiPopped, ai54321);
+	std_pop_back(v, (int*)NULL, 5);
+	std_destruct(v);
+
+	std_construct(v);
+	TEST_SIZE(v, 0);
+	std_push_back(v, 1, 2, 3, 4, 5);
+	std_destruct(v);
+
+	return true;
+}
+
+static bool queue_test(void)
+{
+	std_queue(std_vector,int) v;
+	int aiPopped[10];
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "vector");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	TEST_SIZE(v, 0);
+
+	// Push 1/2/3/4/5 onto the container, and make sure size == 5
+	std_enqueue(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Pop 5/4/3/2/1 from the container
+	szNum = std_dequeue(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_enqueue(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_dequeue(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai12345);
+
+	std_destruct(v);
+
+	return true;
+}
+
+static bool stack_test(void)
+{
+	std_stack(std_vector,int) v;
+	int aiPopped[10];
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "vector");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Push 1/2/3/4/5 onto the container, and make sure size == 5
+	std_push(v, 1, 2, 3, 4, 5);
+	TEST_SIZE(v, 5);
+
+	// Pop 5/4/3/2/1 from the container
+	szNum = std_pop(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	szNum = 0;
+	for (i = 0; i < 5; i++)
+	{
+		szNum += std_push(v, ai12345[i]);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+
+	memset(aiPopped, 0, sizeof(aiPopped));
+	szNum = std_pop(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	std_destruct(v);
+
+	return true;
+}
+
+static bool priorityqueue_test(void)
+{
+	std_priorityqueue(int) v;
+	int aiPopped[10];
+	int aiSorted[1000];
+	uint32_t u32Random = 12345U;
+	size_t szFanout;
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "priority queue");
+	std_construct(v);
+	std_priorityqueue_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+
+	szNum = std_push(v, 3, 1, 5, 2, 4);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, std_front(v)[0], 5);
+
+	szNum = std_pop(v, aiPopped, 10);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Only powers of two are allowed as fan-outs
+	TEST_SAME(v, std_priorityqueue_fanout_set(v, 0), false);
+	TEST_SAME(v, std_priorityqueue_fanout_set(v, 1), false);
+	TEST_SAME(v, std_priorityqueue_fanout_set(v, 6), false);
+	TEST_SAME(v, std_priorityqueue_fanout_set(v, STD_PRIORITYQUEUE_MAX_FANOUT * 2U), false);
+
+	// Push lots of pseudo-random items with each fan-out, changing the fan-out half way through
+	for (szFanout = 2U; szFanout <= 16U; szFanout *= 2U)
+	{
+		TEST_SAME(v, std_priorityqueue_fanout_set(v, szFanout), true);
+		for (i = 0; i < STD_NUM_ELEMENTS(aiSorted); i++)
+		{
+			u32Random = (u32Random * 1103515245U) + 12345U;
+			aiSorted[i] = (int)((u32Random >> 16) % 500U);
+			std_push(v, aiSorted[i]);
+			if (i == STD_NUM_ELEMENTS(aiSorted) / 2U)
+			{
+				TEST_SAME(v, std_priorityqueue_fanout_set(v, 64U / szFanout), true);
+			}
+		}
+		qsort(aiSorted, STD_NUM_ELEMENTS(aiSorted), sizeof(aiSorted[0]), &qsort_int_compare);
+		TEST_SIZE(v, STD_NUM_ELEMENTS(aiSorted));
+
+		for (i = STD_NUM_ELEMENTS(aiSorted); i != 0; i--)
+		{
+			TEST_SAME(v, std_front(v)[0], aiSorted[i - 1U]);
+			std_pop(v, aiPopped, 1);
+			TEST_SAME(v, aiPopped[0], aiSorted[i - 1U]);
+		}
+		TEST_SIZE(v, 0);
+	}
+
+	std_destruct(v);
+	return true;
+}
+
+static bool indexed_priorityqueue_test(void)
+{
+	std_indexed_priorityqueue(int) v;
+	int aiPopped[10];
+	int aiValue[200];
+	size_t aszHandle[200];
+	bool abLive[200];
+	uint32_t u32Random = 12345U;
+	size_t szHandle;
+	size_t szNum;
+	size_t szBest;
+	size_t i;
+	size_t j;
+
+	TEST_CONTAINER_NAME(v, "indexed priority queue");
+	std_construct(v);
+	TEST_SAME(v, (std_indexed_priorityqueue_push(v, 1) == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE), true);
+	std_indexed_priorityqueue_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+
+	szNum = std_push(v, 3, 1, 5, 2, 4);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, std_front(v)[0], 5);
+	szNum = std_pop(v, aiPopped, 10);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Re-prioritise and erase items through their handles
+	for (i = 0; i < 5; i++)
+	{
+		aszHandle[i] = std_indexed_priorityqueue_push(v, (int)(i + 1U) * 10);
+	}
+	TEST_SAME(v, std_indexed_priorityqueue_at(v, aszHandle[2])[0], 30);
+	TEST_SAME(v, std_indexed_priorityqueue_update(v, aszHandle[0], 100), true);
+	TEST_SAME(v, std_front(v)[0], 100);
+	TEST_SAME(v, std_indexed_priorityqueue_update(v, aszHandle[0], 5), true);
+	TEST_SAME(v, std_front(v)[0], 50);
+	TEST_SAME(v, std_indexed_priorityqueue_erase(v, aszHandle[4]), true);
+	TEST_SAME(v, std_indexed_priorityqueue_erase(v, aszHandle[4]), false);
+	TEST_SAME(v, (std_indexed_priorityqueue_at(v, aszHandle[4]) == NULL), true);
+	TEST_SAME(v, std_indexed_priorityqueue_update(v, aszHandle[4], 1), false);
+
+	// A stale handle stays dead even once its slot has been reused
+	szHandle = std_indexed_priorityqueue_push(v, 45);
+	TEST_SAME(v, (szHandle != aszHandle[4]), true);
+	TEST_SAME(v, (std_indexed_priorityqueue_at(v, aszHandle[4]) == NULL), true);
+	TEST_SAME(v, std_indexed_priorityqueue_update(v, aszHandle[4], 1), false);
+	TEST_SAME(v, std_indexed_priorityqueue_erase(v, aszHandle[4]), false);
+	TEST_SAME(v, std_front(v)[0], 45);
+	TEST_SAME(v, std_indexed_priorityqueue_erase(v, szHandle), true);
+	TEST_SAME(v, std_front(v)[0], 40);
+	TEST_SIZE(v, 4);
+	szNum = std_pop(v, aiPopped, 10);
+	TEST_SAME(v, szNum, 4);
+	TEST_SAME(v, aiPopped[0], 40);
+	TEST_SAME(v, aiPopped[1], 30);
+	TEST_SAME(v, aiPopped[2], 20);
+	TEST_SAME(v, aiPopped[3], 5);
+	TEST_SAME(v, (std_indexed_priorityqueue_at(v, aszHandle[1]) == NULL), true);
+
+	// Mix pushes, updates, erases and pops at random, checking against a simple model
+	for (i = 0; i < STD_NUM_ELEMENTS(abLive); i++)
+	{
+		abLive[i] = false;
+	}
+	for (i = 0; i < 5000; i++)
+	{
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		j = (u32Random >> 16) % STD_NUM_ELEMENTS(abLive);
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		if (!abLive[j])
+		{
+			aiValue[j] = (int)((u32Random >> 16) % 1000U);
+			aszHandle[j] = std_indexed_priorityqueue_push(v, aiValue[j]);
+			abLive[j] = true;
+		}
+		else if (((u32Random >> 16) % 3U) == 0U)
+		{
+			TEST_SAME(v, std_indexed_priorityqueue_erase(v, aszHandle[j]), true);
+			abLive[j] = false;
+		}
+		else if (((u32Random >> 16) % 3U) == 1U)
+		{
+			aiValue[j] = (int)((u32Random >> 20) % 1000U);
+			TEST_SAME(v, std_indexed_priorityqueue_update(v, aszHandle[j], aiValue[j]), true);
+		}
+		else if (std_pop(v, aiPopped, 1) == 1U)
+		{
+			// The popped item must be (one of) the largest in the model
+			szBest = STD_NUM_ELEMENTS(abLive);
+			for (j = 0; j < STD_NUM_ELEMENTS(abLive); j++)
+			{
+				if (abLive[j] && ((szBest == STD_NUM_ELEMENTS(abLive)) || (aiValue[j] > aiValue[szBest])))
+				{
+					szBest = j;
+				}
+			}
+			TEST_SAME(v, aiPopped[0], aiValue[szBest]);
+			for (j = 0; j < STD_NUM_ELEMENTS(abLive); j++)
+			{
+				if (abLive[j] && (std_indexed_priorityqueue_at(v, aszHandle[j]) == NULL))
+				{
+					abLive[j] = false;
+					break;
+				}
+			}
+		}
+
+		// Every live handle must still reach its own item
+		szNum = 0;
+		for (j = 0; j < STD_NUM_ELEMENTS(abLive); j++)
+		{
+			if (abLive[j])
+			{
+				TEST_SAME(v, std_indexed_priorityqueue_at(v, aszHandle[j])[0], aiValue[j]);
+				szNum++;
+			}
+		}
+		TEST_SIZE(v, szNum);
+	}
+
+	szHandle = std_indexed_priorityqueue_push(v, 1234);
+	TEST_SAME(v, std_front(v)[0], 1234);
+	TEST_SAME(v, std_indexed_priorityqueue_erase(v, szHandle), true);
+
+	std_destruct(v);
+	return true;
+}
+
+static bool indexed_priorityqueue_slots_test(void)
+{
+	std_indexed_priorityqueue(int) v;
+	size_t szMaxItems = ((size_t) 1U << STD_INDEXED_PRIORITYQUEUE_SLOT_BITS) - 1U;
+	size_t szHandle;
+	size_t i;
+	int iPopped;
+
+	// Only small slot spaces (e.g. 32-bit platforms) can be filled up in a test
+	if (STD_INDEXED_PRIORITYQUEUE_SLOT_BITS > 16U)
+	{
+		return true;
+	}
+
+	std_construct(v);
+	std_indexed_priorityqueue_compare_set(v, &int_compare);
+	for (i = 0; i < szMaxItems; i++)
+	{
+		TEST_SAME(v, (std_indexed_priorityqueue_push(v, (int) i) == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE), false);
+	}
+
+	// Once every slot is in use, pushes fail and leave the queue as it was
+	TEST_SAME(v, (std_indexed_priorityqueue_push(v, -1) == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE), true);
+	TEST_SAME(v, std_push(v, -2, -3), 0);
+	TEST_SIZE(v, szMaxItems);
+	TEST_SAME(v, std_front(v)[0], (int) szMaxItems - 1);
+
+	// Popping an item frees a slot up again
+	TEST_SAME(v, std_pop(v, &iPopped, 1), 1);
+	szHandle = std_indexed_priorityqueue_push(v, 1000000);
+	TEST_SAME(v, (szHandle == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE), false);
+	TEST_SAME(v, std_indexed_priorityqueue_at(v, szHandle)[0], 1000000);
+	TEST_SAME(v, (std_indexed_priorityqueue_push(v, -1) == STD_INDEXED_PRIORITYQUEUE_NO_HANDLE), true);
+	std_destruct(v);
+	return true;
+}
+
+static bool prioritydeque_test(void)
+{
+	std_prioritydeque(int) v;
+	int aiPopped[10];
+	int aiSorted[1000];
+	uint32_t u32Random = 12345U;
+	size_t szNum;
+	size_t szLow;
+	size_t szHigh;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "priority deque");
+	std_construct(v);
+	std_prioritydeque_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, (std_prioritydeque_min(v) == NULL), true);
+	TEST_SAME(v, (std_prioritydeque_max(v) == NULL), true);
+
+	// Push some items, then pop them from both ends
+	szNum = std_push(v, 3, 1, 5, 2, 4);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, std_prioritydeque_min(v)[0], 1);
+	TEST_SAME(v, std_prioritydeque_max(v)[0], 5);
+
+	szNum = std_pop_front(v, aiPopped, 2);
+	TEST_SAME(v, szNum, 2);
+	TEST_SAME(v, aiPopped[0], 1);
+	TEST_SAME(v, aiPopped[1], 2);
+	szNum = std_pop(v, aiPopped, 2);
+	TEST_SAME(v, szNum, 2);
+	TEST_SAME(v, aiPopped[0], 5);
+	TEST_SAME(v, aiPopped[1], 4);
+	TEST_SIZE(v, 1);
+	TEST_SAME(v, (std_prioritydeque_min(v) == std_prioritydeque_max(v)), true);
+
+	szNum = std_pop_back(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(v, szNum, 1);
+	TEST_SAME(v, aiPopped[0], 3);
+	TEST_SIZE(v, 0);
+
+	// Push lots of pseudo-random items, then pop them alternately from both ends
+	for (i = 0; i < STD_NUM_ELEMENTS(aiSorted); i++)
+	{
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		aiSorted[i] = (int)((u32Random >> 16) % 500U);
+		std_push(v, aiSorted[i]);
+	}
+	qsort(aiSorted, STD_NUM_ELEMENTS(aiSorted), sizeof(aiSorted[0]), &qsort_int_compare);
+	TEST_SIZE(v, STD_NUM_ELEMENTS(aiSorted));
+
+	szLow = 0;
+	szHigh = STD_NUM_ELEMENTS(aiSorted);
+	while (szLow < szHigh)
+	{
+		TEST_SAME(v, std_prioritydeque_min(v)[0], aiSorted[szLow]);
+		TEST_SAME(v, std_prioritydeque_max(v)[0], aiSorted[szHigh - 1U]);
+		if ((szLow + szHigh) & 1U)
+		{
+			std_pop_front(v, aiPopped, 1);
+			TEST_SAME(v, aiPopped[0], aiSorted[szLow]);
+			szLow++;
+		}
+		else
+		{
+			std_pop_back(v, aiPopped, 1);
+			TEST_SAME(v, aiPopped[0], aiSorted[szHigh - 1U]);
+			szHigh--;
+		}
+	}
+	TEST_SIZE(v, 0);
+
+	// Track the top five of a stream of items, evicting the smallest on every push
+	for (i = 0; i < 100; i++)
+	{
+		std_push(v, (int)((i * 37U) % 100U));
+		if (std_size(v) > 5U)
+		{
+			std_pop_front(v, (int *)NULL, 1);
+		}
+	}
+	szNum = std_pop(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+	TEST_SAME(v, szNum, 5);
+	for (i = 0; i < 5; i++)
+	{
+		TEST_SAME(v, aiPopped[i], (int)(99U - i));
+	}
+
+	std_destruct(v);
+
+	return true;
+}
+
+static bool calendar_queue_test(void)
+{
+	std_calendar_queue(int) v;
+	std_calendar_queue_handle_t ahTimer[500];
+	uint64_t au64Expiry[500];
+	bool abLive[500];
+	int aiPopped[500];
+	uint64_t u64Random = 0x9E3779B97F4A7C15ULL;
+	uint64_t u64Time;
+	size_t szNum;
+	size_t szDue;
+	size_t i;
+	size_t j;
+
+	TEST_CONTAINER_NAME(v, "calendar queue");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Items come out once they are due (but never before)
+	ahTimer[0] = std_calendar_queue_push(v, 10U, 1);
+	ahTimer[1] = std_calendar_queue_push(v, 100U, 2);
+	ahTimer[2] = std_calendar_queue_push(v, 5000U, 3);
+	ahTimer[3] = std_calendar_queue_push(v, 10U, 4);
+	ahTimer[4] = std_calendar_queue_push(v, 1000000U, 5);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, std_calendar_queue_at(v, ahTimer[2])[0], 3);
+	TEST_SAME(v, std_calendar_queue_expiry(ahTimer[1]), 100);
+
+	szNum = std_calendar_queue_pop_due(v, 9U, aiPopped, 10);
+	TEST_SAME(v, szNum, 0);
+	szNum = std_calendar_queue_pop_due(v, 10U, aiPopped, 10);
+	TEST_SAME(v, szNum, 2);
+	TEST_SAME(v, aiPopped[0] + aiPopped[1], 5);
+	TEST_SAME(v, std_calendar_queue_now(v), 10);
+
+	// Cancel one item and move another one earlier
+	TEST_SAME(v, std_calendar_queue_cancel(v, ahTimer[2]), true);
+	TEST_SAME(v, std_calendar_queue_reschedule(v, ahTimer[4], 50U), true);
+	TEST_SIZE(v, 2);
+	szNum = std_calendar_queue_pop_due(v, 99U, aiPopped, 10);
+	TEST_SAME(v, szNum, 1);
+	TEST_SAME(v, aiPopped[0], 5);
+	TEST_SAME(v, std_calendar_queue_now(v), 99);
+
+	// An item pushed with an expiry time in the past is due straight away
+	std_calendar_queue_push(v, 3U, 6);
+	szNum = std_calendar_queue_pop_due(v, 99U, aiPopped, 10);
+	TEST_SAME(v, szNum, 1);
+	TEST_SAME(v, aiPopped[0], 6);
+
+	// Batches are limited to MAXITEMS, leaving the rest for later calls
+	for (i = 0; i < 10; i++)
+	{
+		std_calendar_queue_push(v, 200U + i, (int)i);
+	}
+	szNum = std_calendar_queue_pop_due(v, 10000U, aiPopped, 4);
+	TEST_SAME(v, szNum, 4);
+	szNum = std_calendar_queue_pop_due(v, 10000U, aiPopped, 100);
+	TEST_SAME(v, szNum, 7);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_calendar_queue_now(v), 10000);
+
+	// Push, cancel and reschedule lots of items over a wide range of times, checking against a simple model
+	for (i = 0; i < STD_NUM_ELEMENTS(abLive); i++)
+	{
+		abLive[i] = false;
+	}
+	u64Time = std_calendar_queue_now(v);
+	for (j = 0; j < 200; j++)
+	{
+		for (i = 0; i < STD_NUM_ELEMENTS(abLive); i++)
+		{
+			u64Random ^= u64Random << 13;
+			u64Random ^= u64Random >> 7;
+			u64Random ^= u64Random << 17;
+			if (!abLive[i] && ((u64Random & 3U) == 0U))
+			{
+				// Mostly short timeouts, with the occasional very long one
+				au64Expiry[i] = u64Time + ((u64Random >> 8) % (((u64Random >> 4) & 1U) ? 100000U : 1000U));
+				if ((u64Random & 0xF0U) == 0U)
+				{
+					au64Expiry[i] = u64Time + (u64Random >> 20);
+				}
+				ahTimer[i] = std_calendar_queue_push(v, au64Expiry[i], (int)i);
+				abLive[i] = true;
+			}
+			else if (abLive[i] && ((u64Random & 7U) == 1U))
+			{
+				TEST_SAME(v, std_calendar_queue_cancel(v, ahTimer[i]), true);
+				abLive[i] = false;
+			}
+			else if (abLive[i] && ((u64Random & 7U) == 2U))
+			{
+				au64Expiry[i] = u64Time + ((u64Random >> 8) % 5000U);
+				TEST_SAME(v, std_calendar_queue_reschedule(v, ahTimer[i], au64Expiry[i]), true);
+			}
+		}
+
+		u64Time += (u64Random >> 5) % 3000U;
+		szNum = std_calendar_queue_pop_due(v, u64Time, aiPopped, STD_NUM_ELEMENTS(aiPopped));
+		TEST_SAME(v, std_calendar_queue_now(v), u64Time);
+
+		// Exactly the live items due by now must have been popped
+		szDue = 0;
+		for (i = 0; i < STD_NUM_ELEMENTS(abLive); i++)
+		{
+			if (abLive[i] && (au64Expiry[i] <= u64Time))
+			{
+				szDue++;
+			}
+		}
+		TEST_SAME(v, szNum, szDue);
+		for (i = 0; i < szNum; i++)
+		{
+			TEST_SAME(v, abLive[aiPopped[i]], true);
+			TEST_SAME(v, (au64Expiry[aiPopped[i]] <= u64Time), true);
+			TEST_SAME(v, ((i == 0) || (au64Expiry[aiPopped[i - 1U]] <= au64Expiry[aiPopped[i]])), true);
+			abLive[aiPopped[i]] = false;
+		}
+	}
+
+	// Drain whatever is left
+	std_calendar_queue_pop_due(v, UINT64_MAX, (int *)NULL, SIZE_MAX);
+	TEST_SIZE(v, 0);
+
+	std_destruct(v);
+	return true;
+}
+
+static bool radix_heap_test(void)
+{
+	std_radix_heap(int) v;
+	int aiPopped[10];
+	uint32_t u32Random = 12345U;
+	uint64_t u64PushedSum = 0;
+	uint64_t u64PoppedSum = 0;
+	int iLast = 0;
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "radix heap");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+
+	// Items come out smallest key first (here, each item is its own key)
+	std_radix_heap_push(v, 3U, 3);
+	std_radix_heap_push(v, 1U, 1);
+	std_radix_heap_push(v, 5U, 5);
+	std_radix_heap_push(v, 2U, 2);
+	std_radix_heap_push(v, 4U, 4);
+	TEST_SIZE(v, 5);
+	szNum = std_pop_front(v, aiPopped, 2);
+	TEST_SAME(v, szNum, 2);
+	TEST_SAME(v, aiPopped[0], 1);
+	TEST_SAME(v, aiPopped[1], 2);
+	TEST_SAME(v, std_radix_heap_last_key(v), 2);
+
+	// Keys can't go below the last key popped
+	TEST_SAME(v, std_radix_heap_push(v, 1U, 1), false);
+	TEST_SAME(v, std_radix_heap_push(v, 2U, 2), true);
+	TEST_SAME(v, std_radix_heap_push(v, 1000000000000ULL, 6), true);
+	szNum = std_pop_front(v, aiPopped, 10);
+	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, aiPopped[0], 2);
+	TEST_SAME(v, aiPopped[1], 3);
+	TEST_SAME(v, aiPopped[2], 4);
+	TEST_SAME(v, aiPopped[3], 5);
+	TEST_SAME(v, aiPopped[4], 6);
+	TEST_SAME(v, (std_radix_heap_last_key(v) == 1000000000000ULL), true);
+	TEST_SIZE(v, 0);
+	std_destruct(v);
+
+	// Simulate a stream of events, where each event popped schedules up to two later events
+	std_construct(v);
+	TEST_SAME(v, std_reserve(v, 1000), true);
+	for (i = 0; i < 1000; i++)
+	{
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		std_radix_heap_push(v, (u32Random >> 16) % 1000U, (int)((u32Random >> 16) % 1000U));
+		u64PushedSum += (u32Random >> 16) % 1000U;
+	}
+	for (i = 0; i < 20000; i++)
+	{
+		TEST_SAME(v, std_pop_front(v, aiPopped, 1), 1);
+		TEST_SAME(v, (aiPopped[0] >= iLast), true);
+		iLast = aiPopped[0];
+		u64PoppedSum += (uint64_t)iLast;
+
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		std_radix_heap_push(v, (uint64_t)iLast + ((u32Random >> 16) % 64U), iLast + (int)((u32Random >> 16) % 64U));
+		u64PushedSum += (uint64_t)iLast + ((u32Random >> 16) % 64U);
+		if ((u32Random & 0x10000000U) != 0U)
+		{
+			std_radix_heap_push(v, (uint64_t)iLast + ((u32Random >> 20) % 4096U), iLast + (int)((u32Random >> 20) % 4096U));
+			u64PushedSum += (uint64_t)iLast + ((u32Random >> 20) % 4096U);
+		}
+	}
+	while (std_pop_front(v, aiPopped, 1) == 1U)
+	{
+		TEST_SAME(v, (aiPopped[0] >= iLast), true);
+		iLast = aiPopped[0];
+		u64PoppedSum += (uint64_t)iLast;
+	}
+	TEST_SAME(v, (u64PoppedSum == u64PushedSum), true);
+	TEST_SIZE(v, 0);
+
+	std_destruct(v);
+	return true;
+}
+
+static size_t szNumDestructed;
+
+static bool counting_destruct(const std_item_handler_t * pstItemHandler, void * pvData)
+{
+	if (pstItemHandler || pvData) { /* Unused parameters */ }
+	szNumDestructed++;
+	return true;
+}
+
+static const std_item_handler_t stCountingItemHandler =
+{
+	.szElementSize = sizeof(int),
+	.pfn_Destructor = &counting_destruct,
+	.pfn_Relocator = NULL
+};
+
+static bool skew_heap_test(void)
+{
+	std_skew_heap(int) v;
+	std_skew_heap(int) v2;
+	std_skew_heap_itemhandler(int) v3;
+	std_skew_heap_memoryhandler(int) v4;
+	std_skew_heap_memoryhandler(int) v5;
+	std_memoryhandler_t stOtherMemoryHandler;
+	int aiPopped[10];
+	int aiSorted[1000];
+	int iMallocs, iReallocs, iFrees;
+	uint32_t u32Random = 12345U;
+	size_t szNum;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "skew heap");
+	std_construct(v);
+	std_construct(v2);
+	std_skew_heap_compare_set(v, &int_compare);
+	std_skew_heap_compare_set(v2, &int_compare);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, (std_skew_heap_top(v) == NULL), true);
+
+	szNum = std_push(v, 3, 1, 5, 2, 4);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, szNum, 5);
+	TEST_SAME(v, std_skew_heap_top(v)[0], 5);
+	szNum = std_pop(v, aiPopped, 10);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, szNum, 5);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Meld two heaps of pseudo-random items together, then pop them all
+	for (i = 0; i < STD_NUM_ELEMENTS(aiSorted); i++)
+	{
+		u32Random = (u32Random * 1103515245U) + 12345U;
+		aiSorted[i] = (int)((u32Random >> 16) % 500U);
+		if (i & 1U)
+		{
+			std_push(v, aiSorted[i]);
+		}
+		else
+		{
+			std_push(v2, aiSorted[i]);
+		}
+	}
+	qsort(aiSorted, STD_NUM_ELEMENTS(aiSorted), sizeof(aiSorted[0]), &qsort_int_compare);
+
+	TEST_SAME(v, std_skew_heap_meld(v, v2), true);
+	TEST_SIZE(v, STD_NUM_ELEMENTS(aiSorted));
+	TEST_SIZE(v2, 0);
+	TEST_SAME(v, std_skew_heap_meld(v, v2), true);
+	TEST_SIZE(v, STD_NUM_ELEMENTS(aiSorted));
+
+	// The emptied heap can still be used (and melded back)
+	std_push(v2, 1000, -1);
+	TEST_SAME(v, std_skew_heap_meld(v2, v), true);
+	TEST_SIZE(v2, STD_NUM_ELEMENTS(aiSorted) + 2U);
+	TEST_SIZE(v, 0);
+	std_pop(v2, aiPopped, 1);
+	TEST_SAME(v, aiPopped[0], 1000);
+	for (i = STD_NUM_ELEMENTS(aiSorted); i != 0; i--)
+	{
+		TEST_SAME(v, std_skew_heap_top(v2)[0], aiSorted[i - 1U]);
+		std_pop(v2, aiPopped, 1);
+		TEST_SAME(v, aiPopped[0], aiSorted[i - 1U]);
+	}
+	std_pop(v2, aiPopped, 1);
+	TEST_SAME(v, aiPopped[0], -1);
+	TEST_SIZE(v2, 0);
+
+	// Destructing non-empty heaps frees every node (including the ones melded in)
+	std_push(v, 1, 2, 3);
+	std_push(v2, 4, 5, 6);
+	std_skew_heap_meld(v, v2);
+	std_push(v2, 7);
+
+	std_destruct(v);
+	std_destruct(v2);
+
+	// Destructing a heap with an item handler destructs every item still in it
+	std_construct_itemhandler(v3, &stCountingItemHandler);
+	std_skew_heap_compare_set(v3, &int_compare);
+	for (i = 0; i < 100; i++)
+	{
+		std_push(v3, (int)((i * 37U) % 100U));
+	}
+	std_pop(v3, (int *)NULL, 10);
+	szNumDestructed = 0;
+	std_destruct(v3);
+	TEST_SAME(v, szNumDestructed, 90);
+
+	// Nodes melded into another heap should go back to their own heap's pool once popped, rather than piling up
+	memorycounter_reset();
+	std_construct_memoryhandler(v4, &stMemoryCounter);
+	std_construct_memoryhandler(v5, &stMemoryCounter);
+	std_skew_heap_compare_set(v4, &int_compare);
+	std_skew_heap_compare_set(v5, &int_compare);
+	for (i = 0; i < 10000; i++)
+	{
+		std_push(v4, (int) i, (int) i + 1);
+		std_skew_heap_meld(v5, v4);
+		std_pop(v5, (int *)NULL, 2);
+	}
+	TEST_SIZE(v5, 0);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v, iMallocs, 1);
+	std_destruct(v5);
+	std_destruct(v4);
+	memorycounter_grab(&iMallocs, &iReallocs, &iFrees);
+	TEST_SAME(v, iFrees, iMallocs + iReallocs);
+
+	// Heaps that use different memory handlers can't be melded
+	stOtherMemoryHandler = stMemoryCounter;
+	std_construct_memoryhandler(v4, &stMemoryCounter);
+	std_construct_memoryhandler(v5, &stOtherMemoryHandler);
+	std_skew_heap_compare_set(v4, &int_compare);
+	std_skew_heap_compare_set(v5, &int_compare);
+	std_push(v4, 1, 2, 3);
+	TEST_SAME(v, std_skew_heap_meld(v5, v4), false);
+	TEST_SIZE(v4, 3);
+	TEST_SIZE(v5, 0);
+	std_destruct(v5);
+	std_destruct(v4);
+	return true;
+}
+
+typedef struct
+{
+	int x;
+	int y;
+} test_point_t;
+
+static size_t point_hash(const test_point_t * a)
+{
+	return ((size_t)(unsigned)a->x * 31U) + (size_t)(unsigned)a->y;
+}
+
+static bool point_equal(const test_point_t * a, const test_point_t * b)
+{
+	return (a->x == b->x) && (a->y == b->y);
+}
+
+static bool unordered_set_test(void)
+{
+	std_unorderedset(int) v;
+	std_unorderedset(test_point_t) v2;
+	std_unorderedset_itemhandler(int) v3;
+	int aiPopped[10];
+	int iSum;
+	size_t szNum;
+	int i;
+
+	TEST_CONTAINER_NAME(v, "unordered set");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_unorderedset_contains(v, 3), false);
+	TEST_SAME(v, std_unorderedset_erase(v, 3), false);
+
+	// Pushing an item that's already present leaves the set unchanged
+	szNum = std_push(v, 3, 1, 5, 2, 4, 3, 1);
+	TEST_SAME(v, szNum, 5);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, std_unorderedset_insert(v, 5), false);
+	TEST_SAME(v, std_unorderedset_insert(v, 6), true);
+	TEST_SAME(v, std_unorderedset_contains(v, 6), true);
+	TEST_SAME(v, std_unorderedset_find(v, 2)[0], 2);
+	TEST_SAME(v, (std_unorderedset_find(v, 7) == NULL), true);
+	TEST_SAME(v, std_unorderedset_erase(v, 6), true);
+	TEST_SAME(v, std_unorderedset_erase(v, 6), false);
+	TEST_SIZE(v, 5);
+
+	// Iteration visits every item exactly once (in no particular order)
+	iSum = 0;
+	for (std_each(v, it))
+	{
+		iSum += std_iterator_at(it)[0];
+	}
+	TEST_SAME(v, iSum, 15);
+
+	szNum = std_pop(v, aiPopped, 10);
+	TEST_SAME(v, szNum, 5);
+	TEST_SIZE(v, 0);
+	qsort(aiPopped, szNum, sizeof(aiPopped[0]), &qsort_int_compare);
+	TEST_SAME(v, aiPopped[0] + 4, aiPopped[4]);
+
+	// Grow through many rehashes, then erase and re-insert (churning any tombstones)
+	for (i = 0; i < 5000; i++)
+	{
+		std_unorderedset_insert(v, i * 7);
+	}
+	TEST_SIZE(v, 5000);
+	for (i = 0; i < 5000; i += 2)
+	{
+		TEST_SAME(v, std_unorderedset_erase(v, i * 7), true);
+	}
+	TEST_SIZE(v, 2500);
+	for (i = 0; i < 5000; i++)
+	{
+		TEST_SAME(v, std_unorderedset_contains(v, i * 7), ((i & 1) != 0));
+	}
+	for (i = 0; i < 20000; i++)
+	{
+		std_unorderedset_insert(v, -1 - (i % 100));
+		std_unorderedset_erase(v, -1 - ((i + 50) % 100));
+	}
+	TEST_SIZE(v, 2550);
+	std_reserve(v, 10000);
+	iSum = 0;
+	for (std_each(v, it))
+	{
+		iSum += (std_iterator_at(it)[0] < 0) ? 1 : 0;
+	}
+	TEST_SAME(v, iSum, 50);
+	std_destruct(v);
+
+	// Items with their own hash and equality functions
+	std_construct(v2);
+	std_unorderedset_hash_set(v2, &point_hash, &point_equal);
+	for (i = 0; i < 100; i++)
+	{
+		std_unorderedset_insert(v2, { .x = i, .y = -i });
+	}
+	TEST_SIZE(v2, 100);
+	TEST_SAME(v2, std_unorderedset_contains(v2, { .x = 42, .y = -42 }), true);
+	TEST_SAME(v2, std_unorderedset_contains(v2, { .x = 42, .y = 42 }), false);
+	TEST_SAME(v2, std_unorderedset_find(v2, { .x = 9, .y = -9 })->y, -9);
+	std_destruct(v2);
+
+	// Destructing a set with an item handler destructs every item still in it
+	std_construct_itemhandler(v3, &stCountingItemHandler);
+	for (i = 0; i < 100; i++)
+	{
+		std_unorderedset_insert(v3, i);
+	}
+	szNumDestructed = 0;
+	std_unorderedset_erase(v3, 10);
+	std_pop(v3, (int *)NULL, 9);
+	TEST_SAME(v3, szNumDestructed, 10);
+	szNumDestructed = 0;
+	std_destruct(v3);
+	TEST_SAME(v3, szNumDestructed, 90);
+	return true;
+}
+
+static bool unordered_map_test(void)
+{
+	std_unorderedmap(int, test_point_t) v;
+	std_unorderedmap(test_point_t, int) v2;
+	std_unorderedmap_itemhandler(int, int) v3;
+	STD_ITEM_TYPEOF(v) astPopped[4];
+	test_point_t * pstPoint;
+	int iSum;
+	int i;
+
+	TEST_CONTAINER_NAME(v, "unordered map");
+	std_construct(v);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, (std_unorderedmap_find(v, 1) == NULL), true);
+
+	// Inserting never replaces an existing entry, upserting always does
+	pstPoint = std_unorderedmap_insert(v, 1, { .x = 10, .y = 11 });
+	TEST_SAME(v, (pstPoint != NULL), true);
+	TEST_SAME(v, pstPoint->x, 10);
+	TEST_SAME(v, (std_unorderedmap_insert(v, 1, { .x = 20, .y = 21 }) == NULL), true);
+	TEST_SAME(v, std_unorderedmap_find(v, 1)->x, 10);
+	pstPoint = std_unorderedmap_upsert(v, 1, { .x = 30, .y = 31 });
+	TEST_SAME(v, pstPoint->y, 31);
+	TEST_SAME(v, std_unorderedmap_find(v, 1)->x, 30);
+	std_unorderedmap_upsert(v, 2, { .x = 40, .y = 41 });
+	TEST_SIZE(v, 2);
+
+	// Values can be modified in place
+	std_unorderedmap_find(v, 2)->x++;
+	TEST_SAME(v, std_unorderedmap_find(v, 2)->x, 41);
+	TEST_SAME(v, std_unorderedmap_contains(v, 2), true);
+	TEST_SAME(v, std_unorderedmap_erase(v, 2), true);
+	TEST_SAME(v, std_unorderedmap_contains(v, 2), false);
+	TEST_SAME(v, std_unorderedmap_erase(v, 2), false);
+	TEST_SIZE(v, 1);
+
+	// Iteration visits every entry exactly once
+	for (i = 0; i < 1000; i++)
+	{
+		std_unorderedmap_upsert(v, i, { .x = i, .y = 2 * i });
+	}
+	TEST_SIZE(v, 1000);
+	iSum = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)->stValue.y, 2 * std_iterator_at(it)->stKey);
+		iSum += std_iterator_at(it)->stValue.x;
+	}
+	TEST_SAME(v, iSum, 499500);
+	TEST_SAME(v, std_pop(v, astPopped, 4), 4);
+	TEST_SAME(v, astPopped[3].stValue.x, astPopped[3].stKey);
+	TEST_SIZE(v, 996);
+	std_destruct(v);
+
+	// Keys with their own hash and equality functions
+	std_construct(v2);
+	std_unorderedmap_hash_set(v2, &point_hash, &point_equal);
+	for (i = 0; i < 100; i++)
+	{
+		std_unorderedmap_insert(v2, ((test_point_t){ .x = i, .y = i + 1 }), i);
+	}
+	TEST_SIZE(v2, 100);
+	TEST_SAME(v2, std_unorderedmap_find(v2, { .x = 7, .y = 8 })[0], 7);
+	TEST_SAME(v2, (std_unorderedmap_find(v2, { .x = 8, .y = 7 }) == NULL), true);
+	std_destruct(v2);
+
+	// Upserting, erasing and destructing all destruct the entries they replace or remove
+	std_construct_itemhandler(v3, &stCountingItemHandler);
+	for (i = 0; i < 100; i++)
+	{
+		std_unorderedmap_insert(v3, i, i);
+	}
+	szNumDestructed = 0;
+	std_unorderedmap_upsert(v3, 5, 50);
+	std_unorderedmap_erase(v3, 6);
+	TEST_SAME(v3, szNumDestructed, 2);
+	szNumDestructed = 0;
+	std_destruct(v3);
+	TEST_SAME(v3, szNumDestructed, 99);
+	return true;
+}
+
+static int point_x_compare(const test_point_t * a, const test_point_t * b)
+{
+	return (b->x < a->x);
+}
+
+static bool bRefuseMemory;
+
+static void * refusable_malloc(const std_memoryhandler_t * pstMemoryHandler, size_t szSize)
+{
+	if (pstMemoryHandler) { /* Unused parameter */ }
+	return bRefuseMemory ? NULL : malloc(szSize);
+}
+
+static void * refusable_realloc(const std_memoryhandler_t * pstMemoryHandler, void * pvData, size_t szSize)
+{
+	if (pstMemoryHandler) { /* Unused parameter */ }
+	return bRefuseMemory ? NULL : realloc(pvData, szSize);
+}
+
+static void refusable_free(const std_memoryhandler_t * pstMemoryHandler, void * pvData)
+{
+	if (pstMemoryHandler) { /* Unused parameter */ }
+	free(pvData);
+}
+
+static const std_memoryhandler_t stRefusableMemoryHandler =
+{
+	.pfn_Malloc		= &refusable_malloc,
+	.pfn_Realloc	= &refusable_realloc,
+	.pfn_Free		= &refusable_free
+};
+
+// Items this wide give sets the smallest nodes, so their trees grow (and their roots split) often
+typedef struct
+{
+	int x;
+	int aiPadding[63];
+} test_wide_t;
+
+static int wide_compare(const test_wide_t * a, const test_wide_t * b)
+{
+	return (b->x < a->x);
+}
+
+static bool set_test(void)
+{
+	std_set(int) v;
+	std_set_itemhandler(int) v2;
+	std_set_memoryhandler(test_wide_t) v3;
+	static bool abPresent[4000];
+	int aiPopped[5];
+	size_t szNum;
+	size_t szFirst;
+	size_t szLast;
+	unsigned uSeed;
+	int iPrev;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "set");
+	std_construct(v);
+	std_set_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+	for (std_each(v, it))
+	{
+		return false;
+	}
+
+	// Pushing an item that's already present leaves the set unchanged
+	szNum = std_push(v, 3, 1, 5, 2, 4, 3, 1);
+	TEST_SAME(v, szNum, 5);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, std_set_insert(v, 5), false);
+	TEST_SAME(v, std_set_contains(v, 4), true);
+	TEST_SAME(v, std_set_find(v, 2)[0], 2);
+	TEST_SAME(v, (std_set_find(v, 7) == NULL), true);
+	READ_CONTAINER(v, std_each);
+	TEST_ARRAY(aiPopped, ai12345);
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_ARRAY(aiPopped, ai54321);
+	TEST_SAME(v, std_at(v, 3)[0], 4);
+
+	// std_pop() pops the largest items, std_pop_front() the smallest
+	TEST_SAME(v, std_pop(v, aiPopped, 2), 2);
+	TEST_SAME(v, aiPopped[0], 5);
+	TEST_SAME(v, aiPopped[1], 4);
+	TEST_SAME(v, std_pop_front(v, aiPopped, 2), 2);
+	TEST_SAME(v, aiPopped[0], 1);
+	TEST_SAME(v, aiPopped[1], 2);
+	TEST_SAME(v, std_set_erase(v, 3), true);
+	TEST_SAME(v, std_set_erase(v, 3), false);
+	TEST_SIZE(v, 0);
+
+	// Grow a many-level tree, then erase from all over it
+	std_reserve(v, 4000);
+	uSeed = 1U;
+	for (i = 0; i < 6000; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szNum = (uSeed >> 8) % 4000U;
+		TEST_SAME(v, std_set_insert(v, (int) szNum), !abPresent[szNum]);
+		abPresent[szNum] = true;
+	}
+	for (i = 0; i < 8000; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szNum = (uSeed >> 8) % 4000U;
+		TEST_SAME(v, std_set_erase(v, (int) szNum), abPresent[szNum]);
+		abPresent[szNum] = false;
+	}
+	szNum = 0;
+	for (i = 0; i < 4000; i++)
+	{
+		TEST_SAME(v, std_set_contains(v, (int) i), abPresent[i]);
+		if (abPresent[i])
+		{
+			TEST_SAME(v, std_at(v, szNum)[0], (int) i);
+			TEST_SAME(v, std_set_lower_bound(v, (int) i), szNum);
+			szNum++;
+		}
+	}
+	TEST_SIZE(v, szNum);
+	iPrev = -1;
+	szNum = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, (std_iterator_at(it)[0] > iPrev), true);
+		iPrev = std_iterator_at(it)[0];
+		szNum++;
+	}
+	TEST_SAME(v, szNum, std_size(v));
+	iPrev = 4000;
+	for (std_each_reverse(v, it))
+	{
+		TEST_SAME(v, (std_iterator_at(it)[0] < iPrev), true);
+		iPrev = std_iterator_at(it)[0];
+	}
+
+	// A range query: every item in [1000, 2000)
+	szFirst = std_set_lower_bound(v, 1000);
+	szLast = std_set_lower_bound(v, 2000) - 1U;
+	szNum = 0;
+	for (std_for_range(v, it, szFirst, szLast))
+	{
+		TEST_SAME(v, ((std_iterator_at(it)[0] >= 1000) && (std_iterator_at(it)[0] < 2000)), true);
+		szNum++;
+	}
+	for (i = 1000; i < 2000; i++)
+	{
+		szNum -= abPresent[i] ? 1U : 0U;
+	}
+	TEST_SAME(v, szNum, 0);
+	TEST_SAME(v, std_set_upper_bound(v, 3999), std_size(v));
+	TEST_SAME(v, std_set_upper_bound(v, -1), 0);
+
+	// Emptying the set from both ends
+	while (!std_is_empty(v))
+	{
+		std_pop_front(v, aiPopped, 1);
+		std_pop(v, aiPopped, 1);
+	}
+	TEST_SAME(v, (std_set_find(v, 1) == NULL), true);
+	std_destruct(v);
+
+	// Erasing, popping and destructing all destruct the items they remove
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	std_set_compare_set(v2, &int_compare);
+	for (i = 0; i < 1000; i++)
+	{
+		std_set_insert(v2, (int) i);
+	}
+	szNumDestructed = 0;
+	std_set_erase(v2, 500);
+	std_pop(v2, (int *)NULL, 9);
+	TEST_SAME(v2, szNumDestructed, 10);
+	szNumDestructed = 0;
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 990);
+
+	// Running out of memory part-way through an insert leaves the set as it was (with no empty root)
+	std_construct_memoryhandler(v3, &stRefusableMemoryHandler);
+	std_set_compare_set(v3, &wide_compare);
+	for (i = 0; i < 20000; i++)
+	{
+		bRefuseMemory = true;
+		if (!std_set_insert(v3, { .x = (int) i }))
+		{
+			TEST_SIZE(v3, i);
+			TEST_SAME(v3, ((v3.stBody.pstRoot == NULL) || v3.stBody.pstRoot->bLeaf || (v3.stBody.pstRoot->szNumItems > 0)), true);
+			bRefuseMemory = false;
+			TEST_SAME(v3, std_set_insert(v3, { .x = (int) i }), true);
+		}
+	}
+	bRefuseMemory = false;
+	TEST_SIZE(v3, 20000);
+	i = 0;
+	for (std_each(v3, it))
+	{
+		TEST_SAME(v3, std_iterator_at(it)->x, (int) i);
+		i++;
+	}
+	std_destruct(v3);
+	return true;
+}
+
+static bool multiset_test(void)
+{
+	std_multiset(test_point_t) v;
+	test_point_t astPopped[8];
+	size_t szFirst;
+	size_t szLast;
+	int i;
+
+	TEST_CONTAINER_NAME(v, "multiset");
+	std_construct(v);
+	std_set_compare_set(v, &point_x_compare);
+
+	// Items with equal keys are all kept, in the order they were pushed
+	TEST_SAME(v, std_push(v, { .x = 2, .y = 0 }, { .x = 1, .y = 1 }, { .x = 2, .y = 2 }, { .x = 3, .y = 3 }, { .x = 2, .y = 4 }), 5);
+	TEST_SAME(v, std_set_insert(v, { .x = 1, .y = 5 }), true);
+	TEST_SIZE(v, 6);
+	szFirst = std_set_lower_bound(v, { .x = 2 });
+	szLast = std_set_upper_bound(v, { .x = 2 }) - 1U;
+	TEST_SAME(v, szFirst, 2);
+	TEST_SAME(v, szLast, 4);
+	i = 0;
+	for (std_for_range(v, it, szFirst, szLast))
+	{
+		TEST_SAME(v, std_iterator_at(it)->y, 2 * i);
+		i++;
+	}
+	TEST_SAME(v, i, 3);
+
+	// Erasing a key erases the first of its items
+	TEST_SAME(v, std_set_erase(v, { .x = 2 }), true);
+	TEST_SAME(v, std_set_find(v, { .x = 2 })->y, 2);
+	TEST_SAME(v, std_pop_front(v, astPopped, 8), 5);
+	TEST_SAME(v, astPopped[0].y, 1);
+	TEST_SAME(v, astPopped[1].y, 5);
+	TEST_SAME(v, astPopped[4].y, 3);
+
+	// Lots of duplicates, enough to split nodes holding only equal keys
+	for (i = 0; i < 3000; i++)
+	{
+		std_set_insert(v, { .x = i % 3, .y = i });
+	}
+	i = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)->y, ((i % 1000) * 3) + (i / 1000));
+		i++;
+	}
+	TEST_SAME(v, std_set_lower_bound(v, { .x = 2 }), 2000);
+
+	// Finding a key finds the first of its items, even when equal items span several nodes
+	TEST_SAME(v, std_set_find(v, { .x = 0 })->y, 0);
+	TEST_SAME(v, std_set_find(v, { .x = 1 })->y, 1);
+	TEST_SAME(v, std_set_find(v, { .x = 2 })->y, 2);
+	std_destruct(v);
+	return true;
+}
+
+static bool map_test(void)
+{
+	std_map(int, test_point_t) v;
+	std_map_itemhandler(int, int) v2;
+	STD_ITEM_TYPEOF(v) astPopped[2];
+	test_point_t * pstPoint;
+	int i;
+
+	TEST_CONTAINER_NAME(v, "map");
+	std_construct(v);
+	std_map_compare_set(v, &int_compare);
+	TEST_SAME(v, (std_map_find(v, 1) == NULL), true);
+
+	// Inserting never replaces an existing entry, upserting always does
+	pstPoint = std_map_insert(v, 1, { .x = 10, .y = 11 });
+	TEST_SAME(v, (pstPoint != NULL), true);
+	TEST_SAME(v, pstPoint->x, 10);
+	TEST_SAME(v, (std_map_insert(v, 1, { .x = 20, .y = 21 }) == NULL), true);
+	pstPoint = std_map_upsert(v, 1, { .x = 30, .y = 31 });
+	TEST_SAME(v, pstPoint->y, 31);
+	TEST_SAME(v, std_map_find(v, 1)->x, 30);
+	TEST_SAME(v, std_map_erase(v, 1), true);
+	TEST_SAME(v, std_map_contains(v, 1), false);
+
+	// Entries are iterated in key order, whatever order they were inserted in
+	for (i = 0; i < 1000; i++)
+	{
+		std_map_upsert(v, (i * 7) % 1000, { .x = i, .y = (i * 7) % 1000 });
+	}
+	TEST_SIZE(v, 1000);
+	i = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)->stKey, i);
+		TEST_SAME(v, std_iterator_at(it)->stValue.y, i);
+		i++;
+	}
+	TEST_SAME(v, std_map_lower_bound(v, 250), 250);
+	TEST_SAME(v, std_map_upper_bound(v, 250), 251);
+	TEST_SAME(v, std_at(v, 123)->stKey, 123);
+	TEST_SAME(v, std_pop(v, astPopped, 2), 2);
+	TEST_SAME(v, astPopped[1].stKey, 998);
+	std_destruct(v);
+
+	// Upserting, erasing and destructing all destruct the entries they replace or remove
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	std_map_compare_set(v2, &int_compare);
+	for (i = 0; i < 100; i++)
+	{
+		std_map_insert(v2, i, i);
+	}
+	szNumDestructed = 0;
+	std_map_upsert(v2, 5, 50);
+	std_map_erase(v2, 6);
+	TEST_SAME(v2, szNumDestructed, 2);
+	szNumDestructed = 0;
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 99);
+	return true;
+}
+
+static bool splay_tree_test(void)
+{
+	std_splay_tree(int) v;
+	std_splay_tree_itemhandler(int) v2;
+	static bool abPresent[2000];
+	int aiPopped[5];
+	size_t szNum;
+	unsigned uSeed;
+	int iPrev;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "splay tree");
+	std_construct(v);
+	std_splay_tree_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_splay_tree_contains(v, 1), false);
+
+	// Pushing an item that's already present leaves the tree unchanged
+	szNum = std_push(v, 3, 1, 5, 2, 4, 3, 1);
+	TEST_SAME(v, szNum, 5);
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, std_splay_tree_insert(v, 5), false);
+	READ_CONTAINER(v, std_each);
+	TEST_ARRAY(aiPopped, ai12345);
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_ARRAY(aiPopped, ai54321);
+
+	// Finding an item splays it to the root
+	TEST_SAME(v, std_splay_tree_find(v, 2)[0], 2);
+	TEST_SAME(v, (std_splay_tree_find(v, 7) == NULL), true);
+	TEST_SAME(v, std_splay_tree_find(v, 4)[0], 4);
+	TEST_SAME(v, (std_splay_tree_find(v, 4) == (int *)STD_LINEAR_ADD(v.stBody.pstRoot, v.stBody.szPayloadOffset)), true);
+
+	// std_pop() pops the largest items, std_pop_front() the smallest
+	TEST_SAME(v, std_pop(v, aiPopped, 2), 2);
+	TEST_SAME(v, aiPopped[0], 5);
+	TEST_SAME(v, aiPopped[1], 4);
+	TEST_SAME(v, std_pop_front(v, aiPopped, 2), 2);
+	TEST_SAME(v, aiPopped[0], 1);
+	TEST_SAME(v, aiPopped[1], 2);
+	TEST_SAME(v, std_splay_tree_erase(v, 3), true);
+	TEST_SAME(v, std_splay_tree_erase(v, 3), false);
+	TEST_SIZE(v, 0);
+
+	// Random inserts and erases, with a few keys looked up far more often than the rest
+	uSeed = 1U;
+	for (i = 0; i < 20000; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szNum = (uSeed >> 8) % 2000U;
+		if ((uSeed >> 4) & 3U)
+		{
+			TEST_SAME(v, std_splay_tree_contains(v, (int) (szNum % 8U)), abPresent[szNum % 8U]);
+		}
+		else if (i & 1U)
+		{
+			TEST_SAME(v, std_splay_tree_erase(v, (int) szNum), abPresent[szNum]);
+			abPresent[szNum] = false;
+		}
+		else
+		{
+			TEST_SAME(v, std_splay_tree_insert(v, (int) szNum), !abPresent[szNum]);
+			abPresent[szNum] = true;
+		}
+	}
+	szNum = 0;
+	for (i = 0; i < 2000; i++)
+	{
+		TEST_SAME(v, std_splay_tree_contains(v, (int) i), abPresent[i]);
+		szNum += abPresent[i] ? 1U : 0U;
+	}
+	TEST_SIZE(v, szNum);
+	iPrev = -1;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, (std_iterator_at(it)[0] > iPrev), true);
+		TEST_SAME(v, abPresent[std_iterator_at(it)[0]], true);
+		iPrev = std_iterator_at(it)[0];
+	}
+	std_destruct(v);
+
+	// Erasing, popping and destructing all destruct the items they remove
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	std_splay_tree_compare_set(v2, &int_compare);
+	for (i = 0; i < 1000; i++)
+	{
+		std_splay_tree_insert(v2, (int) i);
+	}
+	szNumDestructed = 0;
+	std_splay_tree_erase(v2, 500);
+	std_pop_front(v2, (int *)NULL, 9);
+	TEST_SAME(v2, szNumDestructed, 10);
+	szNumDestructed = 0;
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 990);
+	return true;
+}
+
+static bool flat_set_test(void)
+{
+	std_flat_set(int) v;
+	std_flat_set(int) v2;
+	std_flat_set_itemhandler(int) v3;
+	std_flat_set_itemhandler(int) v4;
+	static bool abPresent[3000];
+	static bool abOther[3000];
+	static int aiBulk[4000];
+	int aiPopped[5];
+	size_t szNum;
+	unsigned uSeed;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "flat set");
+	std_construct(v);
+	std_flat_set_compare_set(v, &int_compare);
+	TEST_SIZE(v, 0);
+
+	// Pushing a series sorts it and drops duplicates (including keys already present)
+	szNum = std_push(v, 3, 1, 5, 3, 1);
+	TEST_SAME(v, szNum, 3);
+	szNum = std_push(v, 4, 5, 2, 4);
+	TEST_SAME(v, szNum, 2);
+	TEST_SIZE(v, 5);
+	READ_CONTAINER(v, std_each);
+	TEST_ARRAY(aiPopped, ai12345);
+	READ_CONTAINER(v, std_each_reverse);
+	TEST_ARRAY(aiPopped, ai54321);
+	TEST_SAME(v, std_flat_set_insert(v, 5), false);
+	TEST_SAME(v, std_flat_set_insert(v, 0), true);
+	TEST_SAME(v, std_at(v, 0)[0], 0);
+	TEST_SAME(v, std_flat_set_erase(v, 0), true);
+	TEST_SAME(v, std_flat_set_erase(v, 0), false);
+	TEST_SAME(v, std_flat_set_find(v, 4)[0], 4);
+	TEST_SAME(v, (std_flat_set_find(v, 6) == NULL), true);
+	TEST_SAME(v, std_flat_set_lower_bound(v, 3), 2);
+	TEST_SAME(v, std_flat_set_upper_bound(v, 3), 3);
+	TEST_SAME(v, std_pop(v, aiPopped, 1), 1);
+	TEST_SAME(v, aiPopped[0], 5);
+	TEST_SAME(v, std_pop_front(v, aiPopped, 1), 1);
+	TEST_SAME(v, aiPopped[0], 1);
+	std_destruct(v);
+
+	// Bulk-load thousands of random keys into a non-empty set, then combine it with another
+	std_construct(v);
+	std_flat_set_compare_set(v, &int_compare);
+	std_construct(v2);
+	std_flat_set_compare_set(v2, &int_compare);
+	uSeed = 1U;
+	for (i = 0; i < 100; i++)
+	{
+		std_flat_set_insert(v, (int) (i * 30U));
+		abPresent[i * 30U] = true;
+	}
+	for (i = 0; i < STD_NUM_ELEMENTS(aiBulk); i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		aiBulk[i] = (int) ((uSeed >> 8) % 3000U);
+		abPresent[aiBulk[i]] = true;
+	}
+	std_container_call_push(&v.stBody.stContainer, STD_CONTAINER_ENUM_GET(v), STD_CONTAINER_HAS_GET(v), aiBulk, STD_NUM_ELEMENTS(aiBulk));
+	for (i = 0; i < 600; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szNum = (uSeed >> 8) % 3000U;
+		std_flat_set_insert(v2, (int) szNum);
+		abOther[szNum] = true;
+	}
+	szNum = 0;
+	for (i = 0; i < 3000; i++)
+	{
+		if (abPresent[i])
+		{
+			TEST_SAME(v, std_at(v, szNum)[0], (int) i);
+			szNum++;
+		}
+	}
+	TEST_SIZE(v, szNum);
+
+	// Intersection (galloping over the runs of v that aren't in v2)
+	std_flat_set_intersect(v, v2);
+	szNum = 0;
+	for (i = 0; i < 3000; i++)
+	{
+		abPresent[i] = abPresent[i] && abOther[i];
+		TEST_SAME(v, std_flat_set_contains(v, (int) i), abPresent[i]);
+		szNum += abPresent[i] ? 1U : 0U;
+	}
+	TEST_SIZE(v, szNum);
+
+	// Union (moves v2's items in, leaving v2 empty), then difference
+	TEST_SAME(v, std_flat_set_merge(v, v2), true);
+	TEST_SIZE(v2, 0);
+	szNum = 0;
+	for (i = 0; i < 3000; i++)
+	{
+		TEST_SAME(v, std_flat_set_contains(v, (int) i), abOther[i]);
+		szNum += abOther[i] ? 1U : 0U;
+	}
+	TEST_SIZE(v, szNum);
+
+	// Merging a flat set into itself leaves it unchanged
+	TEST_SAME(v, std_flat_set_merge(v, v), true);
+	TEST_SIZE(v, szNum);
+	TEST_SAME(v, std_flat_set_contains(v, 1500), abOther[1500]);
+	std_push(v2, 0, 1, 2, 2999, 1500);
+	std_flat_set_subtract(v, v2);
+	TEST_SAME(v, std_flat_set_contains(v, 1500), false);
+	TEST_SAME(v, std_flat_set_contains(v, 2999), false);
+	for (i = 1U; i < std_size(v); i++)
+	{
+		TEST_SAME(v, (std_at(v, i - 1U)[0] < std_at(v, i)[0]), true);
+	}
+	std_destruct(v2);
+	std_destruct(v);
+
+	// Duplicates dropped while pushing are left alone (as with the other sets), while merging destructs them
+	std_construct_itemhandler(v3, &stCountingItemHandler);
+	std_flat_set_compare_set(v3, &int_compare);
+	std_construct_itemhandler(v4, &stCountingItemHandler);
+	std_flat_set_compare_set(v4, &int_compare);
+	szNumDestructed = 0;
+	TEST_SAME(v3, std_push(v3, 1, 2, 3, 2, 1), 3);
+	TEST_SAME(v3, std_push(v3, 3, 2), 0);
+	TEST_SAME(v3, szNumDestructed, 0);
+	std_push(v4, 3, 4, 5);
+	szNumDestructed = 0;
+	std_flat_set_merge(v3, v4);
+	TEST_SAME(v3, szNumDestructed, 1);
+	TEST_SIZE(v3, 5);
+	std_push(v4, 1, 5);
+	szNumDestructed = 0;
+	std_flat_set_intersect(v3, v4);
+	TEST_SAME(v3, szNumDestructed, 3);
+	szNumDestructed = 0;
+	std_destruct(v3);
+	std_destruct(v4);
+	TEST_SAME(v3, szNumDestructed, 4);
+	return true;
+}
+
+static bool flat_map_test(void)
+{
+	std_flat_map(int, test_point_t) v;
+	test_point_t * pstPoint;
+	int i;
+
+	TEST_CONTAINER_NAME(v, "flat map");
+	std_construct(v);
+	std_flat_map_compare_set(v, &int_compare);
+	TEST_SAME(v, (std_flat_map_find(v, 1) == NULL), true);
+
+	// Inserting never replaces an existing entry, upserting always does
+	pstPoint = std_flat_map_insert(v, 1, { .x = 10, .y = 11 });
+	TEST_SAME(v, pstPoint->x, 10);
+	TEST_SAME(v, (std_flat_map_insert(v, 1, { .x = 20, .y = 21 }) == NULL), true);
+	pstPoint = std_flat_map_upsert(v, 1, { .x = 30, .y = 31 });
+	TEST_SAME(v, std_flat_map_find(v, 1)->y, 31);
+	TEST_SAME(v, std_flat_map_erase(v, 1), true);
+	TEST_SAME(v, std_flat_map_contains(v, 1), false);
+
+	// Bulk-loading entries keeps the first entry pushed for each key
+	std_push(v, { .stKey = 3, .stValue = { 3, 0 } }, { .stKey = 1, .stValue = { 1, 0 } }, { .stKey = 3, .stValue = { 3, 1 } }, { .stKey = 2, .stValue = { 2, 0 } });
+	TEST_SIZE(v, 3);
+	TEST_SAME(v, std_flat_map_find(v, 3)->y, 0);
+	i = 1;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)->stKey, i);
+		TEST_SAME(v, std_iterator_at(it)->stValue.x, i);
+		i++;
+	}
+	TEST_SAME(v, std_flat_map_lower_bound(v, 2), 1);
+	TEST_SAME(v, std_flat_map_upper_bound(v, 2), 2);
+	std_destruct(v);
+	return true;
+}
+
+static bool graph_test(void)
+{
+	std_graph(test_point_t, int) v;
+	std_graph_itemhandler(int, int) v2;
+	static size_t aszSources[20000];
+	static STD_ITEM_TYPEOF(v) astEdges[20000];
+	STD_ITEM_TYPEOF(v) * pstEdges;
+	size_t szNumEdges;
+	size_t szBatch;
+	size_t szFound;
+	unsigned uSeed;
+	size_t i;
+	size_t j;
+
+	TEST_CONTAINER_NAME(v, "graph");
+	std_construct(v);
+	TEST_SAME(v, std_graph_num_vertices(v), 0);
+	TEST_SAME(v, (std_graph_neighbours(v, 0, &szNumEdges) == NULL), true);
+	TEST_SAME(v, szNumEdges, 0);
+
+	// Build a graph from an edge list: each vertex's edges stay in the order they were added
+	size_t aszList[] = { 0, 2, 1, 0, 2, 0 };
+	STD_ITEM_TYPEOF(v) astList[] = { { 1, 10 }, { 0, 20 }, { 3, 30 }, { 2, 40 }, { 1, 50 }, { 0, 60 } };
+	TEST_SAME(v, std_graph_add_edges(v, aszList, astList, STD_NUM_ELEMENTS(astList)), true);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_graph_num_pending(v), 6);
+	TEST_SAME(v, std_graph_commit(v), true);
+	TEST_SIZE(v, 6);
+	TEST_SAME(v, std_graph_num_pending(v), 0);
+	TEST_SAME(v, std_graph_num_vertices(v), 4);
+	pstEdges = std_graph_neighbours(v, 0, &szNumEdges);
+	TEST_SAME(v, szNumEdges, 3);
+	TEST_SAME(v, pstEdges[0].stValue, 10);
+	TEST_SAME(v, pstEdges[1].stValue, 40);
+	TEST_SAME(v, pstEdges[2].szTarget, 0);
+	TEST_SAME(v, std_graph_degree(v, 1), 1);
+	TEST_SAME(v, std_graph_degree(v, 2), 2);
+	TEST_SAME(v, std_graph_degree(v, 3), 0);
+	TEST_SAME(v, (std_graph_neighbours(v, 3, NULL) == NULL), true);
+	i = 0;
+	for (std_for_range(v, it, std_graph_edges_begin(v, 2), std_graph_edges_end(v, 2) - 1U))
+	{
+		TEST_SAME(v, std_iterator_at(it)->stValue, ((i == 0) ? 20 : 50));
+		i++;
+	}
+	TEST_SAME(v, i, 2);
+	TEST_SAME(v, std_at(v, 3)->stValue, 30);
+
+	// Vertex payloads start zeroed, and survive edges being added later
+	TEST_SAME(v, std_graph_vertex(v, 1)->x, 0);
+	std_graph_vertex(v, 1)->x = 5;
+	TEST_SAME(v, (std_graph_vertex(v, 4) == NULL), true);
+	TEST_SAME(v, std_graph_add_vertices(v, 2), 4);
+	TEST_SAME(v, std_graph_num_vertices(v), 6);
+	TEST_SAME(v, std_graph_add_edge(v, 1, 7, 70), true);
+	TEST_SAME(v, std_graph_add_edge(v, 5, 1, 80), true);
+	TEST_SAME(v, std_graph_degree(v, 1), 1);
+	TEST_SAME(v, std_graph_commit(v), true);
+	TEST_SAME(v, std_graph_num_vertices(v), 8);
+	TEST_SAME(v, std_graph_vertex(v, 1)->x, 5);
+	TEST_SAME(v, std_graph_vertex(v, 7)->y, 0);
+	pstEdges = std_graph_neighbours(v, 1, &szNumEdges);
+	TEST_SAME(v, szNumEdges, 2);
+	TEST_SAME(v, pstEdges[1].szTarget, 7);
+	TEST_SAME(v, std_graph_neighbours(v, 5, NULL)->stValue, 80);
+	std_destruct(v);
+
+	// Build a larger graph in several commits, and check every vertex's span against the edge list
+	std_construct(v);
+	uSeed = 1U;
+	for (i = 0; i < STD_NUM_ELEMENTS(astEdges); i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		aszSources[i] = (uSeed >> 8) % 500U;
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		astEdges[i].szTarget = (uSeed >> 8) % 500U;
+		astEdges[i].stValue = (int) i;
+	}
+	for (i = 0; i < STD_NUM_ELEMENTS(astEdges); i += szBatch)
+	{
+		szBatch = (i == 0) ? 12000U : 4000U;
+		TEST_SAME(v, std_graph_add_edges(v, &aszSources[i], &astEdges[i], szBatch), true);
+		TEST_SAME(v, std_graph_commit(v), true);
+	}
+	TEST_SIZE(v, STD_NUM_ELEMENTS(astEdges));
+	for (i = 0; i < std_graph_num_vertices(v); i++)
+	{
+		pstEdges = std_graph_neighbours(v, i, &szNumEdges);
+		szFound = 0;
+		for (j = 0; j < STD_NUM_ELEMENTS(astEdges); j++)
+		{
+			if (aszSources[j] == i)
+			{
+				TEST_SAME(v, (szFound < szNumEdges), true);
+				TEST_SAME(v, pstEdges[szFound].szTarget, astEdges[j].szTarget);
+				TEST_SAME(v, pstEdges[szFound].stValue, astEdges[j].stValue);
+				szFound++;
+			}
+		}
+		TEST_SAME(v, szFound, szNumEdges);
+	}
+	std_destruct(v);
+
+	// Both committed and pending edges are destructed
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	std_graph_add_edge(v2, 0, 1, 1);
+	std_graph_add_edge(v2, 1, 0, 2);
+	std_graph_commit(v2);
+	std_graph_add_edge(v2, 2, 0, 3);
+	szNumDestructed = 0;
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 3);
+	return true;
+}
+
+static bool slot_map_test(void)
+{
+	std_slot_map(test_point_t) v;
+	std_slot_map_itemhandler(int) v2;
+	static std_slot_map_handle_t astHandles[1000];
+	static bool abLive[1000];
+	std_slot_map_handle_t astFirst[5];
+	std_slot_map_handle_t stHandle;
+	test_point_t stPoint;
+	int aiPopped[1];
+	size_t szNumLive;
+	unsigned uSeed;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "slot map");
+	std_construct(v);
+	TEST_SAME(v, std_slot_map_contains(v, STD_SLOT_MAP_NULL_HANDLE), false);
+
+	for (i = 0; i < 5; i++)
+	{
+		astFirst[i] = std_slot_map_insert(v, { .x = (int) i, .y = 10 * (int) i });
+		TEST_SAME(v, std_slot_map_handle_is_null(astFirst[i]), false);
+	}
+	TEST_SIZE(v, 5);
+	TEST_SAME(v, std_slot_map_at(v, astFirst[3])->y, 30);
+
+	// Erasing moves the final item into the hole, but every other handle still finds its item
+	TEST_SAME(v, std_slot_map_erase(v, astFirst[1]), true);
+	TEST_SAME(v, std_slot_map_erase(v, astFirst[1]), false);
+	TEST_SAME(v, (std_slot_map_at(v, astFirst[1]) == NULL), true);
+	TEST_SIZE(v, 4);
+	TEST_SAME(v, std_at(v, 1)->x, 4);
+	TEST_SAME(v, std_slot_map_at(v, astFirst[4])->x, 4);
+	TEST_SAME(v, std_slot_map_at(v, astFirst[0])->x, 0);
+
+	// A recycled slot gets a new generation, so the stale handle stays stale
+	stHandle = std_slot_map_insert(v, { .x = 7, .y = 70 });
+	TEST_SAME(v, stHandle.u32Slot, astFirst[1].u32Slot);
+	TEST_SAME(v, (stHandle.u32Generation != astFirst[1].u32Generation), true);
+	TEST_SAME(v, std_slot_map_contains(v, astFirst[1]), false);
+	TEST_SAME(v, std_slot_map_at(v, stHandle)->y, 70);
+
+	// Iterating sees the items densely packed, and each index maps back to its handle
+	i = 0;
+	for (std_each(v, it))
+	{
+		stHandle = std_slot_map_handle_at(v, i);
+		TEST_SAME(v, (std_slot_map_at(v, stHandle) == std_iterator_at(it)), true);
+		i++;
+	}
+	TEST_SAME(v, i, 5);
+	TEST_SAME(v, std_slot_map_handle_is_null(std_slot_map_handle_at(v, 5)), true);
+
+	// Popping frees the final item's slot
+	stHandle = std_slot_map_handle_at(v, 4);
+	TEST_SAME(v, std_pop(v, &stPoint, 1), 1);
+	TEST_SAME(v, stPoint.y, 70);
+	TEST_SAME(v, std_slot_map_contains(v, stHandle), false);
+	std_destruct(v);
+
+	// Random inserts and erases, checked against a shadow table
+	std_construct(v);
+	uSeed = 1U;
+	szNumLive = 0;
+	for (i = 0; i < 20000; i++)
+	{
+		size_t szIndex;
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szIndex = (uSeed >> 8) % STD_NUM_ELEMENTS(astHandles);
+		if (abLive[szIndex])
+		{
+			TEST_SAME(v, std_slot_map_at(v, astHandles[szIndex])->x, (int) szIndex);
+			TEST_SAME(v, std_slot_map_erase(v, astHandles[szIndex]), true);
+			TEST_SAME(v, std_slot_map_contains(v, astHandles[szIndex]), false);
+			abLive[szIndex] = false;
+			szNumLive--;
+		}
+		else
+		{
+			astHandles[szIndex] = std_slot_map_insert(v, { .x = (int) szIndex, .y = (int) i });
+			abLive[szIndex] = true;
+			szNumLive++;
+		}
+	}
+	TEST_SIZE(v, szNumLive);
+	for (i = 0; i < STD_NUM_ELEMENTS(astHandles); i++)
+	{
+		TEST_SAME(v, std_slot_map_contains(v, astHandles[i]), abLive[i]);
+	}
+	std_destruct(v);
+
+	// Erased, popped and remaining items are all destructed
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	szNumDestructed = 0;
+	stHandle = std_slot_map_insert(v2, 1);
+	std_push(v2, 2, 3, 4);
+	std_slot_map_erase(v2, stHandle);
+	TEST_SAME(v2, szNumDestructed, 1);
+	std_pop(v2, aiPopped, 1);
+	TEST_SAME(v2, aiPopped[0], 3);
+	TEST_SAME(v2, szNumDestructed, 1);
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 3);
+	return true;
+}
+
+static bool bitset_test(void)
+{
+	std_bitset() v;
+	std_bitset() v2;
+	static bool abBits[5000];
+	static bool abOther[3000];
+	size_t szBit;
+	size_t szCount;
+	unsigned uSeed;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "bitset");
+	std_construct(v);
+	TEST_SAME(v, std_bitset_size(v), 0);
+	TEST_SAME(v, std_bitset_find_first(v), STD_BITSET_NPOS);
+	TEST_SAME(v, std_bitset_select(v, 0), STD_BITSET_NPOS);
+
+	// Setting bits grows the bitset; clearing bits beyond its end doesn't
+	TEST_SAME(v, std_bitset_set(v, 3), true);
+	TEST_SAME(v, std_bitset_set(v, 64), true);
+	TEST_SAME(v, std_bitset_set(v, 130), true);
+	TEST_SAME(v, std_bitset_clear(v, 5000), true);
+	TEST_SAME(v, std_bitset_size(v), 131);
+	TEST_SIZE(v, 3);
+	TEST_SAME(v, std_bitset_test(v, 64), true);
+	TEST_SAME(v, std_bitset_test(v, 65), false);
+	TEST_SAME(v, std_bitset_test(v, 100000), false);
+	TEST_SAME(v, std_at(v, 1)[0], 1);
+	TEST_SAME(v, std_bitset_count(v), 3);
+	TEST_SAME(v, std_bitset_find_first(v), 3);
+	TEST_SAME(v, std_bitset_find_next(v, 3), 64);
+	TEST_SAME(v, std_bitset_find_next(v, 64), 130);
+	TEST_SAME(v, std_bitset_find_next(v, 130), STD_BITSET_NPOS);
+	TEST_SAME(v, std_bitset_rank(v, 64), 1);
+	TEST_SAME(v, std_bitset_rank(v, 65), 2);
+	TEST_SAME(v, std_bitset_rank(v, 1000), 3);
+	TEST_SAME(v, std_bitset_select(v, 2), 130);
+	TEST_SAME(v, std_bitset_select(v, 3), STD_BITSET_NPOS);
+	TEST_SAME(v, std_bitset_flip(v, 64), true);
+	TEST_SAME(v, std_bitset_flip(v, 65), true);
+	TEST_SAME(v, std_bitset_assign(v, 4, true), true);
+	TEST_SAME(v, std_bitset_select(v, 2), 65);
+
+	// Shrinking drops the bits beyond the new end (even within the final word)
+	TEST_SAME(v, std_bitset_resize(v, 65), true);
+	TEST_SAME(v, std_bitset_count(v), 2);
+	TEST_SAME(v, std_bitset_resize(v, 200), true);
+	TEST_SAME(v, std_bitset_test(v, 65), false);
+	TEST_SAME(v, std_bitset_test(v, 130), false);
+	std_destruct(v);
+
+	// Random bitsets of different sizes, checked against shadow arrays
+	std_construct(v);
+	std_construct(v2);
+	uSeed = 1U;
+	for (i = 0; i < STD_NUM_ELEMENTS(abBits); i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		abBits[i] = (((uSeed >> 8) % 5U) == 0U);
+		std_bitset_assign(v, i, abBits[i]);
+	}
+	for (i = 0; i < STD_NUM_ELEMENTS(abOther); i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		abOther[i] = (((uSeed >> 8) % 3U) == 0U);
+		std_bitset_assign(v2, i, abOther[i]);
+	}
+	std_bitset_resize(v, STD_NUM_ELEMENTS(abBits));
+	std_bitset_resize(v2, STD_NUM_ELEMENTS(abOther));
+
+	szCount = 0;
+	szBit = std_bitset_find_first(v);
+	for (i = 0; i < STD_NUM_ELEMENTS(abBits); i++)
+	{
+		TEST_SAME(v, std_bitset_rank(v, i), szCount);
+		if (abBits[i])
+		{
+			TEST_SAME(v, szBit, i);
+			TEST_SAME(v, std_bitset_select(v, szCount), i);
+			szBit = std_bitset_find_next(v, szBit);
+			szCount++;
+		}
+	}
+	TEST_SAME(v, szBit, STD_BITSET_NPOS);
+	TEST_SAME(v, std_bitset_count(v), szCount);
+
+	// (v2 is shorter than v, so this also checks the handling of v's extra bits)
+	std_bitset_andnot(v, v2);
+	for (i = 0; i < STD_NUM_ELEMENTS(abBits); i++)
+	{
+		abBits[i] = abBits[i] && !((i < STD_NUM_ELEMENTS(abOther)) && abOther[i]);
+		TEST_SAME(v, std_bitset_test(v, i), abBits[i]);
+	}
+	std_bitset_xor(v, v2);
+	for (i = 0; i < STD_NUM_ELEMENTS(abBits); i++)
+	{
+		abBits[i] = abBits[i] != ((i < STD_NUM_ELEMENTS(abOther)) && abOther[i]);
+		TEST_SAME(v, std_bitset_test(v, i), abBits[i]);
+	}
+	std_bitset_and(v, v2);
+	for (i = 0; i < STD_NUM_ELEMENTS(abBits); i++)
+	{
+		abBits[i] = abBits[i] && (i < STD_NUM_ELEMENTS(abOther)) && abOther[i];
+		TEST_SAME(v, std_bitset_test(v, i), abBits[i]);
+	}
+	std_bitset_resize(v, 10);
+	TEST_SAME(v, std_bitset_or(v, v2), true);
+	TEST_SAME(v, std_bitset_size(v), STD_NUM_ELEMENTS(abOther));
+	for (i = 0; i < STD_NUM_ELEMENTS(abOther); i++)
+	{
+		TEST_SAME(v, std_bitset_test(v, i), (((i < 10) && abBits[i]) || abOther[i]));
+	}
+	std_destruct(v2);
+	std_destruct(v);
+	return true;
+}
+
+static bool sparse_set_test(void)
+{
+	std_sparse_set() v;
+	static bool abShadow[4000];
+	size_t aszPopped[2];
+	size_t szKey;
+	size_t szCount;
+	unsigned uSeed;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "sparse set");
+	std_construct(v);
+	TEST_SAME(v, std_sparse_set_contains(v, 0), false);
+	TEST_SAME(v, std_sparse_set_erase(v, 0), false);
+
+	// Inserting an existing key fails; erasing moves the final key into the hole
+	TEST_SAME(v, std_sparse_set_insert(v, 7), true);
+	TEST_SAME(v, std_sparse_set_insert(v, 3), true);
+	TEST_SAME(v, std_sparse_set_insert(v, 1000), true);
+	TEST_SAME(v, std_sparse_set_insert(v, 3), false);
+	TEST_SIZE(v, 3);
+	TEST_SAME(v, std_sparse_set_contains(v, 1000), true);
+	TEST_SAME(v, std_sparse_set_contains(v, 999), false);
+	TEST_SAME(v, std_sparse_set_erase(v, 7), true);
+	TEST_SAME(v, std_sparse_set_contains(v, 7), false);
+	TEST_SAME(v, std_at(v, 0)[0], 1000);
+	TEST_SAME(v, std_at(v, 1)[0], 3);
+
+	// Pushing skips keys already in the set, popping takes from the dense end
+	TEST_SAME(v, std_push(v, 5, 3, 9), 2);
+	TEST_SIZE(v, 4);
+	i = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)[0], ((size_t[]){ 1000, 3, 5, 9 })[i]);
+		i++;
+	}
+	TEST_SAME(v, i, 4);
+	TEST_SAME(v, std_pop(v, aszPopped, 2), 2);
+	TEST_SAME(v, aszPopped[0], 9);
+	TEST_SAME(v, std_sparse_set_contains(v, 9), false);
+	TEST_SAME(v, std_sparse_set_contains(v, 5), false);
+
+	// Clearing leaves the index's entries stale, which lookups must ignore
+	std_sparse_set_clear(v);
+	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_sparse_set_contains(v, 1000), false);
+	TEST_SAME(v, std_sparse_set_insert(v, 3), true);
+	TEST_SAME(v, std_sparse_set_contains(v, 1000), false);
+	TEST_SAME(v, std_sparse_set_contains(v, 3), true);
+	std_destruct(v);
+
+	// Random inserts and erases, checked against a shadow array
+	std_construct(v);
+	uSeed = 1U;
+	szCount = 0;
+	for (i = 0; i < 20000; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		szKey = (uSeed >> 8) % STD_NUM_ELEMENTS(abShadow);
+		if (((uSeed >> 24) & 1U) != 0)
+		{
+			TEST_SAME(v, std_sparse_set_insert(v, szKey), !abShadow[szKey]);
+			szCount += abShadow[szKey] ? 0 : 1;
+			abShadow[szKey] = true;
+		}
+		else
+		{
+			TEST_SAME(v, std_sparse_set_erase(v, szKey), abShadow[szKey]);
+			szCount -= abShadow[szKey] ? 1 : 0;
+			abShadow[szKey] = false;
+		}
+		if ((i % 5000U) == 4999U)
+		{
+			for (szKey = 0; szKey < STD_NUM_ELEMENTS(abShadow); szKey++)
+			{
+				TEST_SAME(v, std_sparse_set_contains(v, szKey), abShadow[szKey]);
+			}
+		}
+	}
+	TEST_SIZE(v, szCount);
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, abShadow[std_iterator_at(it)[0]], true);
+	}
+	std_destruct(v);
+	return true;
+}
+
+static bool sparse_map_test(void)
+{
+	std_sparse_map(test_point_t) v;
+	std_sparse_map_itemhandler(int) v2;
+	test_point_t * pstPoint;
+	size_t i;
+
+	TEST_CONTAINER_NAME(v, "sparse map");
+	std_construct(v);
+	TEST_SAME(v, (std_sparse_map_find(v, 1) == NULL), true);
+
+	// Inserting never replaces an existing entry, upserting always does
+	pstPoint = std_sparse_map_insert(v, 1, { .x = 10, .y = 11 });
+	TEST_SAME(v, pstPoint->x, 10);
+	TEST_SAME(v, (std_sparse_map_insert(v, 1, { .x = 20, .y = 21 }) == NULL), true);
+	pstPoint = std_sparse_map_upsert(v, 1, { .x = 30, .y = 31 });
+	TEST_SAME(v, std_sparse_map_find(v, 1)->y, 31);
+	pstPoint = std_sparse_map_upsert(v, 60, { .x = 60, .y = 61 });
+	TEST_SAME(v, pstPoint->x, 60);
+	TEST_SIZE(v, 2);
+	TEST_SAME(v, std_sparse_map_erase(v, 1), true);
+	TEST_SAME(v, std_sparse_map_contains(v, 1), false);
+	TEST_SAME(v, std_sparse_map_find(v, 60)->y, 61);
+	TEST_SAME(v, std_at(v, 0)->szKey, 60);
+	std_destruct(v);
+
+	// Erasing, clearing and destructing all destruct entries
+	szNumDestructed = 0;
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	for (i = 0; i < 10; i++)
+	{
+		std_sparse_map_insert(v2, i * 3U, (int) i);
+	}
+	std_sparse_map_upsert(v2, 0, -1);
+	TEST_SAME(v2, szNumDestructed, 1);
+	std_sparse_map_erase(v2, 9);
+	TEST_SAME(v2, szNumDestructed, 2);
+	TEST_SAME(v2, std_sparse_map_find(v2, 27)[0], 9);
+	std_sparse_map_clear(v2);
+	TEST_SAME(v2, szNumDestructed, 11);
+	std_sparse_map_insert(v2, 4, 4);
+	std_sparse_map_insert(v2, 5, 5);
+
+	// Pushing an entry whose key is already there leaves the entry alone (as with the other sets)
+	TEST_SAME(v2, std_push(v2, { .szKey = 5, .stValue = 50 }, { .szKey = 6, .stValue = 6 }), 1);
+	TEST_SAME(v2, szNumDestructed, 11);
+	TEST_SAME(v2, std_sparse_map_find(v2, 5)[0], 5);
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 14);
+	return true;
+}
+
+static size_t szNumRelocated;
+
+static void counting_relocate(const std_item_handler_t * pstItemHandler, void * pvNewAddr, const void * pvOldAddr)
+{
+	if (pstItemHandler || pvNewAddr || pvOldAddr) { /* Unused parameters */ }
+	szNumRelocated++;
+}
+
+static const std_item_handler_t stRelocatingCacheItemHandler =
+{
+	.szElementSize = 2U * sizeof(int),
+	.pfn_Destructor = NULL,
+	.pfn_Relocator = &counting_relocate
+};
+
+static bool cache_test(void)
+{
+	std_cache(int, test_point_t) v;
+	std_cache_itemhandler(int, int) v2;
+	std_cache(int, int) v3;
+	static int aiModel[64];
+	test_point_t * pstPoint;
+	size_t szModel;
+	unsigned uSeed;
+	size_t i;
+	size_t j;
+	int iKey;
+
+	TEST_CONTAINER_NAME(v, "cache");
+	std_construct(v);
+	std_cache_capacity_set(v, 3, 0);
+	TEST_SAME(v, (std_cache_get(v, 1) == NULL), true);
+	TEST_SAME(v, std_cache_evict(v), false);
+
+	// LRU: getting an entry saves it from being the next victim
+	std_cache_put(v, 1, { .x = 10, .y = 11 });
+	std_cache_put(v, 2, { .x = 20, .y = 21 });
+	std_cache_put(v, 3, { .x = 30, .y = 31 });
+	TEST_SAME(v, std_cache_get(v, 1)->x, 10);
+	pstPoint = std_cache_put(v, 4, { .x = 40, .y = 41 });
+	TEST_SAME(v, pstPoint->y, 41);
+	TEST_SIZE(v, 3);
+	TEST_SAME(v, std_cache_contains(v, 2), false);
+	TEST_SAME(v, std_cache_contains(v, 1), true);
+
+	// Peeking doesn't count as using, putting an existing key replaces its value
+	TEST_SAME(v, std_cache_peek(v, 3)->x, 30);
+	std_cache_put(v, 3, { .x = 33, .y = 34 });
+	std_cache_put(v, 5, { .x = 50, .y = 51 });
+	TEST_SAME(v, std_cache_contains(v, 1), false);
+	TEST_SAME(v, std_cache_get(v, 3)->x, 33);
+	i = 0;
+	for (std_each(v, it))
+	{
+		TEST_SAME(v, std_iterator_at(it)->stKey, ((int[]){ 3, 5, 4 })[i]);
+		i++;
+	}
+	TEST_SAME(v, i, 3);
+	TEST_SAME(v, std_cache_erase(v, 5), true);
+	TEST_SAME(v, std_cache_erase(v, 5), false);
+	TEST_SAME(v, std_cache_evict(v), true);
+	TEST_SAME(v, std_cache_contains(v, 4), false);
+	TEST_SIZE(v, 1);
+	std_destruct(v);
+
+	// CLOCK: referenced entries get a second chance as the hand passes
+	std_construct(v3);
+	std_cache_policy_set(v3, std_cache_policy_clock);
+	std_cache_capacity_set(v3, 3, 0);
+	std_cache_put(v3, 1, 1);
+	std_cache_put(v3, 2, 2);
+	std_cache_put(v3, 3, 3);
+	std_cache_put(v3, 4, 4);
+	TEST_SAME(v3, std_cache_contains(v3, 1), false);
+	TEST_SAME(v3, std_cache_get(v3, 2)[0], 2);
+	std_cache_put(v3, 5, 5);
+	TEST_SAME(v3, std_cache_contains(v3, 2), true);
+	TEST_SAME(v3, std_cache_contains(v3, 3), false);
+	TEST_SIZE(v3, 3);
+	std_destruct(v3);
+
+	// Byte capacity: the entry just put is never evicted, however big it is
+	std_construct(v3);
+	std_cache_capacity_set(v3, 0, 100);
+	for (iKey = 0; iKey < 10; iKey++)
+	{
+		std_cache_put_sized(v3, iKey, 30, iKey);
+	}
+	TEST_SIZE(v3, 3);
+	TEST_SAME(v3, std_cache_num_bytes(v3), 90);
+	std_cache_put_sized(v3, 100, 250, 100);
+	TEST_SIZE(v3, 1);
+	TEST_SAME(v3, std_cache_get(v3, 100)[0], 100);
+	std_cache_capacity_set(v3, 0, 0);
+	std_destruct(v3);
+
+	// The item handler's destructor is the eviction callback
+	szNumDestructed = 0;
+	std_construct_itemhandler(v2, &stCountingItemHandler);
+	std_cache_capacity_set(v2, 4, 0);
+	for (iKey = 0; iKey < 10; iKey++)
+	{
+		std_cache_put(v2, iKey, iKey);
+	}
+	TEST_SAME(v2, szNumDestructed, 6);
+	std_cache_put(v2, 9, -9);
+	TEST_SAME(v2, szNumDestructed, 7);
+	std_cache_erase(v2, 8);
+	TEST_SAME(v2, szNumDestructed, 8);
+	std_cache_capacity_set(v2, 1, 0);
+	TEST_SAME(v2, szNumDestructed, 10);
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 11);
+
+	// Each put relocates its entry into place, and growing the entry storage relocates the entries already held
+	szNumRelocated = 0;
+	std_construct_itemhandler(v2, &stRelocatingCacheItemHandler);
+	std_cache_capacity_set(v2, 32, 0);
+	for (iKey = 0; iKey < 20; iKey++)
+	{
+		std_cache_put(v2, iKey, -iKey);
+	}
+	TEST_SAME(v2, szNumRelocated, 20 + 8 + 16);
+	TEST_SAME(v2, *std_cache_get(v2, 3), -3);
+	std_destruct(v2);
+
+	// Random gets and puts, checked against a model LRU list (most recently used first)
+	std_construct(v3);
+	std_cache_capacity_set(v3, STD_NUM_ELEMENTS(aiModel), 0);
+	szModel = 0;
+	uSeed = 1U;
+	for (i = 0; i < 50000; i++)
+	{
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		iKey = (int)((uSeed >> 8) % 200U);
+		for (j = 0; (j < szModel) && (aiModel[j] != iKey); j++)
+		{
+		}
+		if (((uSeed >> 24) & 3U) == 0)
+		{
+			std_cache_put(v3, iKey, -iKey);
+			if (j == szModel)
+			{
+				j = (szModel < STD_NUM_ELEMENTS(aiModel)) ? szModel++ : szModel - 1U;
+			}
+		}
+		else
+		{
+			TEST_SAME(v3, (std_cache_get(v3, iKey) != NULL), (j < szModel));
+			if (j == szModel)
+			{
+				continue;
+			}
+		}
+		memmove(&aiModel[1], &aiModel[0], j * sizeof(aiModel[0]));
+		aiModel[0] = iKey;
+	}
+	TEST_SIZE(v3, szModel);
+	i = 0;
+	for (std_each(v3, it))
+	{
+		TEST_SAME(v3, std_iterator_at(it)->stKey, aiModel[i]);
+		TEST_SAME(v3, std_iterator_at(it)->stValue, -aiModel[i]);
+		i++;
+	}
+	std_destruct(v3);
+	return true;
+}
+
+static size_t szNumTestLocks;
+static size_t szNumTestLocksHeld;
+static size_t szNumTestLockUpdates;
+
+static bool test_lock_construct(std_lock_handle_t * ppstvLock)
+{
+	std_lock_state_t * peState = malloc(sizeof(std_lock_state_t));
+
+	if (peState == NULL)
+	{
+		return false;
+	}
+	*peState = e_std_lock_Unlocked;
+	*ppstvLock = peState;
+	szNumTestLocks++;
+	return true;
+}
+
+static bool test_lock_destruct(std_lock_handle_t * ppstvLock)
+{
+	free(*ppstvLock);
+	*ppstvLock = NULL;
+	szNumTestLocks--;
+	return true;
+}
+
+// A (single-threaded) lock that just checks that it is always taken and released in pairs
+static std_lock_state_t test_lock_update(std_lock_handle_t pstvLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	std_lock_state_t * peState = (std_lock_state_t *) pstvLock;
+	std_lock_state_t eOldState = *peState;
+
+	if (u32Timeout_msec) { /* Unused parameter */ }
+	szNumTestLockUpdates++;
+	szNumTestLocksHeld += (eNewState != e_std_lock_Unlocked) ? 1U : 0U;
+	szNumTestLocksHeld -= (eOldState != e_std_lock_Unlocked) ? 1U : 0U;
+	*peState = eNewState;
+	return eOldState;
+}
+
+static const std_lock_handler_t stTestLockHandler =
+{
+	.pfnLock_Construct = &test_lock_construct,
+	.pfnLock_Destruct = &test_lock_destruct,
+	.pfnLock_Update = &test_lock_update
+};
+
+static void add_to_value(void * pvContext, void * pvValue)
+{
+	*(int *) pvValue += *(int *) pvContext;
+}
 
-	std_construct(v);
+static void sum_values(void * pvContext, const void * pvEntry)
+{
+	const struct { int iKey; int iValue; } * pstEntry = pvEntry;
+	*(long *) pvContext += pstEntry->iValue;
+}
 
-	szNum = std_push_back(v, 6, 7, 8, 9, 1);
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
+static size_t szNumHashed;
 
-	szNum = std_pop_front(v, (int *)NULL, 4);
-	TEST_SIZE(v, 1);
-	TEST_SAME(v, szNum, 4);
+static size_t counting_int_hash(const int * a)
+{
+	szNumHashed++;
+	return (size_t)(unsigned)*a;
+}
 
-	szNum = std_push_back(v, 2, 3, 4, 5);
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 4);
+static bool int_equal(const int * a, const int * b)
+{
+	return (*a == *b);
+}
 
-	memset(aiPopped, 0, sizeof(aiPopped));
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+static bool concurrent_map_test(void)
+{
+	std_concurrent_map(int, test_point_t) v;
+	std_concurrent_map_lockhandler_itemhandler(int, int) v2;
+	test_point_t stPoint;
+	int iValue;
+	int iDelta;
+	long lSum;
+	int i;
 
-	szNum = 0;
-	for (i = 0; i < 1000000; i++)
+	TEST_CONTAINER_NAME(v, "concurrent map");
+	std_construct(v);
+	TEST_SAME(v, std_concurrent_map_find(v, 1, &stPoint), false);
+
+	// Inserting never replaces an existing entry, upserting always does
+	TEST_SAME(v, std_concurrent_map_insert(v, 1, { .x = 10, .y = 11 }), true);
+	TEST_SAME(v, std_concurrent_map_insert(v, 1, { .x = 20, .y = 21 }), false);
+	TEST_SAME(v, std_concurrent_map_find(v, 1, &stPoint), true);
+	TEST_SAME(v, stPoint.x, 10);
+	TEST_SAME(v, std_concurrent_map_upsert(v, 1, { .x = 30, .y = 31 }), true);
+	TEST_SAME(v, std_concurrent_map_find(v, 1, &stPoint), true);
+	TEST_SAME(v, stPoint.y, 31);
+	TEST_SAME(v, std_concurrent_map_erase(v, 1), true);
+	TEST_SAME(v, std_concurrent_map_erase(v, 1), false);
+	TEST_SAME(v, std_concurrent_map_contains(v, 1), false);
+
+	// Enough entries to make every segment grow several times
+	TEST_SAME(v, std_reserve(v, 1000), true);
+	for (i = 0; i < 20000; i++)
 	{
-		szNum += std_push_back(v, (int)i);
+		std_concurrent_map_insert(v, i, { .x = i, .y = -i });
 	}
-	TEST_SIZE(v, 1000000);
-	TEST_SAME(v, szNum, 1000000);
-
-	for (i = 0; i < 1000000; i++)
+	TEST_SAME(v, std_concurrent_map_size(v), 20000);
+	for (i = 0; i < 20000; i += 2)
 	{
-		if (std_pop_back(v, aiPopped, 1U) != 1U)
-		{
-			printf("Failed to pop element #%d from ring (line = %d)" CRLF, (int)i, __LINE__);
-			return false;
-		}
-		if (aiPopped[0] != (int)(1000000U - 1U - i))
-		{
-			printf("Element #%d in ring failed to match (= %d) (line = %d)" CRLF, (int)i, aiPopped[0], __LINE__);
-			return false;
-		}
+		std_concurrent_map_erase(v, i);
 	}
-	TEST_SIZE(v, 0);
+	TEST_SAME(v, std_concurrent_map_size(v), 10000);
+	for (i = 0; i < 20000; i++)
+	{
+		TEST_SAME(v, std_concurrent_map_find(v, i, &stPoint), ((i & 1) != 0));
+		TEST_SAME(v, (((i & 1) == 0) || (stPoint.y == -i)), true);
+	}
+	std_destruct(v);
 
-	std_push_back(v, 1, 2);
-	TEST_SIZE(v, 2);
-	std_append_reversed(v, 5, 4, 3);
-	TEST_SIZE(v, 5);
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	// Each operation hashes its key just once (to pick the segment, and then inside it)
+	std_construct(v);
+	std_concurrent_map_hash_set(v, &counting_int_hash, &int_equal);
+	szNumHashed = 0;
+	TEST_SAME(v, std_concurrent_map_insert(v, 1, { .x = 10, .y = 11 }), true);
+	TEST_SAME(v, std_concurrent_map_upsert(v, 1, { .x = 20, .y = 21 }), true);
+	TEST_SAME(v, std_concurrent_map_find(v, 1, &stPoint), true);
+	TEST_SAME(v, std_concurrent_map_erase(v, 1), true);
+	TEST_SAME(v, szNumHashed, 4);
+	std_destruct(v);
 
-	std_push_back(v, 4, 5);
-	TEST_SIZE(v, 2);
-	std_prepend(v, 1, 2, 3);
-	TEST_SIZE(v, 5);
-	szNum = std_pop_front(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+	// Each segment's lock is constructed, always released after use, and destructed
+	szNumDestructed = 0;
+	std_construct_lockhandler_itemhandler(v2, &stTestLockHandler, &stCountingItemHandler);
+	TEST_SAME(v2, szNumTestLocks, STD_CONCURRENT_MAP_SEGMENTS + 1U);
+	for (i = 0; i < 100; i++)
+	{
+		std_concurrent_map_insert(v2, i, i);
+	}
+	iDelta = 1000;
+	TEST_SAME(v2, std_concurrent_map_update(v2, 7, &add_to_value, &iDelta), true);
+	TEST_SAME(v2, std_concurrent_map_update(v2, 100, &add_to_value, &iDelta), false);
+	TEST_SAME(v2, std_concurrent_map_find(v2, 7, &iValue), true);
+	TEST_SAME(v2, iValue, 1007);
+	lSum = 0;
+	std_concurrent_map_visit(v2, &sum_values, &lSum);
+	TEST_SAME(v2, lSum, (99 * 100 / 2) + 1000);
+	std_concurrent_map_erase(v2, 5);
+	std_concurrent_map_upsert(v2, 6, 0);
+	TEST_SAME(v2, szNumDestructed, 2);
+	TEST_SAME(v2, szNumTestLocksHeld, 0);
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 2 + 99);
+	TEST_SAME(v2, szNumTestLocks, 0);
+	return true;
+}
 
-	std_push_back(v, 100, 100, 1, 2, 3, 4, 5, 100, 100);
-	TEST_SIZE(v, 2 + 5 + 2);
-	i = 0;
-	for (std_for_range(v, it, 2, 2 + 5 - 1), i++)
-		aiPopped[i] = std_iterator_at(it)[0];
-	TEST_SAME(v, i, 5);
-	TEST_ARRAY(aiPopped, ai12345);
-	std_pop_back(v, (int *)NULL, 100);
+static bool lock_session_test(void)
+{
+	std_vector_lockhandler(int) v;
+	std_list_lockhandler_itemhandler(int) v2;
+	size_t szNumUpdates;
+	size_t szNumHeld;
+	long lSum;
+	int i;
 
-	std_destruct(v);
+	// Fifty pushes outside a session lock (and restore) the vector fifty times...
+	std_construct_lockhandler(v, &stTestLockHandler);
+	szNumUpdates = szNumTestLockUpdates;
+	for (i = 0; i < 50; i++)
+	{
+		std_push_back(v, i);
+	}
+	TEST_SAME(v, (szNumTestLockUpdates - szNumUpdates), 100);
 
-	std_construct(v);
-	for (std_scope_const(v, it))
+	// ...whereas inside a session, it is only locked (and restored) once, however many operations there are
+	szNumUpdates = szNumTestLockUpdates;
+	szNumHeld = 0;
+	for (std_lock_session(v, view))
 	{
-		std_push_back(v, 1, 2, 3, 4, 5);
-		for (i = 0; i < 5; i++)
+		for (i = 50; i < 1000; i++)
 		{
-			std_iterator_seek(it, 4 - i);
-			aiPopped[i] = std_iterator_at(it)[0];
+			std_push_back(view, i);
 		}
+		std_pop_back(view, &i, 1);
+		szNumHeld = szNumTestLocksHeld;
 	}
-	TEST_ARRAY(aiPopped, ai54321);
-	std_pop_back(v, (int*)NULL, 5);
-	std_destruct(v);
-
-	std_construct(v);
-	TEST_SIZE(v, 0);
-	std_push_back(v, 1, 2, 3, 4, 5);
+	TEST_SAME(v, (szNumTestLockUpdates - szNumUpdates), 2);
+	TEST_SAME(v, szNumHeld, 1);
+	TEST_SAME(v, szNumTestLocksHeld, 0);
+
+	// Changes made through the view (including the vector growing) end up in the container
+	TEST_SIZE(v, 999);
+	lSum = 0;
+	for (std_each_const(v, it))
+	{
+		lSum += *std_iterator_at(it);
+	}
+	TEST_SAME(v, lSum, (998 * 999 / 2));
 	std_destruct(v);
 
+	// Node-based containers (and their item handlers) work through a view too
+	szNumDestructed = 0;
+	std_construct_lockhandler_itemhandler(v2, &stTestLockHandler, &stCountingItemHandler);
+	for (std_lock_session(v2, view))
+	{
+		std_push_back(view, 1, 2, 3);
+		std_push_front(view, 0);
+		std_pop_back(view, &i, 1);
+	}
+	TEST_SIZE(v2, 3);
+	lSum = 0;
+	for (std_each_const(v2, it))
+	{
+		lSum = (lSum * 10) + *std_iterator_at(it);
+	}
+	TEST_SAME(v2, lSum, 12);
+	std_destruct(v2);
+	TEST_SAME(v2, szNumDestructed, 3);
+	TEST_SAME(v2, szNumTestLocks, 0);
 	return true;
 }
 
-static bool queue_test(void)
+#if defined(STD_LOCK_HAS_PTHREADS) && defined(STD_LOCK_HAS_ATOMICS)
+
+typedef struct
 {
-	std_queue(std_vector,int) v;
-	int aiPopped[10];
-	size_t szNum;
-	size_t i;
+	const std_lock_handler_t * pstHandler;
+	std_lock_handle_t hLock;
+	std_lock_state_t eNewState;
+	uint32_t u32Timeout_msec;
+	std_lock_state_t eResult;
+} other_thread_lock_t;
+
+// Try to take a lock from another thread (releasing it again if that worked)
+static void * other_thread_lock(void * pvArg)
+{
+	other_thread_lock_t * pstArg = pvArg;
 
-	TEST_CONTAINER_NAME(v, "vector");
-	std_construct(v);
-	TEST_SIZE(v, 0);
+	pstArg->eResult = std_lock_update(pstArg->pstHandler, pstArg->hLock, pstArg->eNewState, pstArg->u32Timeout_msec);
+	if (pstArg->eResult != e_std_lock_Invalid)
+	{
+		std_lock_update(pstArg->pstHandler, pstArg->hLock, pstArg->eResult, 0);
+	}
+	return NULL;
+}
 
-	TEST_SIZE(v, 0);
+static std_lock_state_t lock_from_other_thread(const std_lock_handler_t * pstHandler, std_lock_handle_t hLock, std_lock_state_t eNewState, uint32_t u32Timeout_msec)
+{
+	other_thread_lock_t stArg = { pstHandler, hLock, eNewState, u32Timeout_msec, e_std_lock_Invalid };
+	pthread_t tThread;
 
-	// Push 1/2/3/4/5 onto the container, and make sure size == 5
-	std_enqueue(v, 1, 2, 3, 4, 5);
-	TEST_SIZE(v, 5);
+	if (pthread_create(&tThread, NULL, &other_thread_lock, &stArg) == 0)
+	{
+		pthread_join(tThread, NULL);
+	}
+	return stArg.eResult;
+}
 
-	// Pop 5/4/3/2/1 from the container
-	szNum = std_dequeue(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+static std_vector_lockhandler(int) vLockShared;
 
-	szNum = 0;
-	for (i = 0; i < 5; i++)
+static void * push_many(void * pvArg)
+{
+	int i;
+
+	for (i = 0; i < 1000; i++)
 	{
-		szNum += std_enqueue(v, ai12345[i]);
+		std_push_back(vLockShared, (int)(intptr_t) pvArg);
 	}
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
+	return NULL;
+}
 
-	memset(aiPopped, 0, sizeof(aiPopped));
-	szNum = std_dequeue(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai12345);
+static void * push_one(void * pvArg)
+{
+	std_push_back(vLockShared, (int)(intptr_t) pvArg);
+	return NULL;
+}
 
-	std_destruct(v);
+static void * push_many_in_sessions(void * pvArg)
+{
+	int i;
+	int j;
 
-	return true;
+	for (i = 0; i < 20; i++)
+	{
+		for (std_lock_session(vLockShared, view))
+		{
+			for (j = 0; j < 50; j++)
+			{
+				std_push_back(view, (int)(intptr_t) pvArg);
+			}
+		}
+	}
+	return NULL;
 }
 
-static bool stack_test(void)
+static bool lock_handlers_test(void)
 {
-	std_stack(std_vector,int) v;
-	int aiPopped[10];
-	size_t szNum;
+	static const struct
+	{
+		const std_lock_handler_t * pstHandler;
+		bool bSharedReads;
+		bool bTimesOut;
+		bool bOptimisticReads;
+	} astHandlers[] =
+	{
+		{ &std_lock_handler_pthread_rwlock,	true,	true,	false },
+		{ &std_lock_handler_pthread_mutex,	false,	true,	false },
+		{ &std_lock_handler_spinlock,		false,	true,	false },
+		{ &std_lock_handler_ticketlock,		false,	false,	false },
+		{ &std_lock_handler_seqlock,		false,	true,	true },
+	};
+	const std_lock_handler_t * pstHandler;
+	std_lock_handle_t hLock;
+	std_lock_state_t eOldState;
+	std_lock_state_t eNestedState;
+	const struct timespec stHoldTime = { .tv_sec = 0, .tv_nsec = 600000000L };	// (Longer than the old 500msec container timeout)
+	pthread_t atThreads[4];
+	long lSum;
+	int iItem;
 	size_t i;
+	size_t t;
 
-	TEST_CONTAINER_NAME(v, "vector");
-	std_construct(v);
-	TEST_SIZE(v, 0);
+	for (i = 0; i < STD_NUM_ELEMENTS(astHandlers); i++)
+	{
+		pstHandler = astHandlers[i].pstHandler;
+		std_construct_lockhandler(vLockShared, pstHandler);
+		hLock = vLockShared.stBody.stContainer.phLock;
+		TEST_SAME(vLockShared, (hLock != NULL), true);
+		if (astHandlers[i].bOptimisticReads)
+		{
+			// (Optimistic readers could be looking at the items, so they can't be moved later)
+			TEST_SAME(vLockShared, std_reserve(vLockShared, 3 + (2000 * STD_NUM_ELEMENTS(atThreads))), true);
+		}
 
-	// Push 1/2/3/4/5 onto the container, and make sure size == 5
-	std_push(v, 1, 2, 3, 4, 5);
-	TEST_SIZE(v, 5);
+		// Write-locking returns the previous state, and the holder can nest (and undo) more locks inside it
+		eOldState = std_lock_for_writing(pstHandler, hLock, 0);
+		TEST_SAME(vLockShared, eOldState, e_std_lock_Unlocked);
+		eNestedState = std_lock_for_reading(pstHandler, hLock, 0);
+		TEST_SAME(vLockShared, eNestedState, e_std_lock_WriteLocked);
+		std_lock_update(pstHandler, hLock, eNestedState, 0);
+		std_push_back(vLockShared, 1, 2, 3);
+
+		// Meanwhile, other threads can't get in (and time out trying)
+		TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_ReadLocked, 0), e_std_lock_Invalid);
+		if (astHandlers[i].bTimesOut)
+		{
+			TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 20), e_std_lock_Invalid);
+		}
+		std_lock_update(pstHandler, hLock, eOldState, 0);
+		TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Unlocked);
 
-	// Pop 5/4/3/2/1 from the container
-	szNum = std_pop(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+		// Only the rwlock lets other readers share a read lock (and optimistic readers hold no lock at all)
+		eOldState = std_lock_for_reading(pstHandler, hLock, 0);
+		if (astHandlers[i].bOptimisticReads)
+		{
+			TEST_SAME(vLockShared, eOldState, e_std_lock_NoRestoreNeeded);
+			TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_ReadLocked, 0), e_std_lock_NoRestoreNeeded);
+			TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Unlocked);
+		}
+		else
+		{
+			TEST_SAME(vLockShared, eOldState, e_std_lock_Unlocked);
+			TEST_SAME(vLockShared, (lock_from_other_thread(pstHandler, hLock, e_std_lock_ReadLocked, 0) == e_std_lock_Unlocked), astHandlers[i].bSharedReads);
+			TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Invalid);
+		}
+		std_lock_update(pstHandler, hLock, eOldState, 0);
+
+		// Restoring an invalid (timed out) state is a no-op
+		TEST_SAME(vLockShared, std_lock_update(pstHandler, hLock, e_std_lock_Invalid, 0), e_std_lock_Invalid);
+		TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Unlocked);
+
+		// Container operations wait for as long as the lock is held (rather than timing out and going ahead unlocked)
+		eOldState = std_lock_for_writing(pstHandler, hLock, 0);
+		TEST_SAME(vLockShared, pthread_create(&atThreads[0], NULL, &push_one, (void *)(intptr_t) 4), 0);
+		nanosleep(&stHoldTime, NULL);
+		TEST_SIZE(vLockShared, 3);
+		std_lock_update(pstHandler, hLock, eOldState, 0);
+		pthread_join(atThreads[0], NULL);
+		TEST_SIZE(vLockShared, 4);
+		std_pop_back(vLockShared, &iItem, 1);
+
+		// Several threads pushing at once don't lose any items
+		for (t = 0; t < STD_NUM_ELEMENTS(atThreads); t++)
+		{
+			TEST_SAME(vLockShared, pthread_create(&atThreads[t], NULL, &push_many, (void *)(intptr_t)(t + 1U)), 0);
+		}
+		for (t = 0; t < STD_NUM_ELEMENTS(atThreads); t++)
+		{
+			pthread_join(atThreads[t], NULL);
+		}
+		TEST_SIZE(vLockShared, (3 + (1000 * STD_NUM_ELEMENTS(atThreads))));
+		lSum = 0;
+		for (std_each_const(vLockShared, it))
+		{
+			lSum += *std_iterator_at(it);
+		}
+		TEST_SAME(vLockShared, lSum, (1 + 2 + 3) + (1000 * (1 + 2 + 3 + 4)));
 
-	szNum = 0;
-	for (i = 0; i < 5; i++)
-	{
-		szNum += std_push(v, ai12345[i]);
+		// ...nor do several threads pushing in locked sessions
+		for (t = 0; t < STD_NUM_ELEMENTS(atThreads); t++)
+		{
+			TEST_SAME(vLockShared, pthread_create(&atThreads[t], NULL, &push_many_in_sessions, (void *)(intptr_t)(t + 1U)), 0);
+		}
+		for (t = 0; t < STD_NUM_ELEMENTS(atThreads); t++)
+		{
+			pthread_join(atThreads[t], NULL);
+		}
+		TEST_SIZE(vLockShared, (3 + (2000 * STD_NUM_ELEMENTS(atThreads))));
+
+		std_destruct(vLockShared);
+		TEST_SAME(vLockShared, (vLockShared.stBody.stContainer.phLock == NULL), true);
 	}
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
+	return true;
+}
 
-	memset(aiPopped, 0, sizeof(aiPopped));
-	szNum = std_pop(v, aiPopped, STD_NUM_ELEMENTS(aiPopped));
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+static atomic_int iNumBumps;
 
-	std_destruct(v);
+static void * bump_pair(void * pvArg)
+{
+	int i;
 
-	return true;
+	for (i = 0; i < (int)(intptr_t) pvArg; i++)
+	{
+		for (std_container_lock_wrapper(vLockShared, false))
+		{
+			*std_at(vLockShared, 0) += 1;
+			*std_at(vLockShared, 1) -= 1;
+		}
+		atomic_fetch_add(&iNumBumps, 1);
+	}
+	return NULL;
 }
 
-static bool priorityqueue_test(void)
+static bool seqlock_test(void)
 {
-#if 0
-	std_priorityqueue(int) v;
-	int aiPopped[10];
-	size_t szNum;
+	const std_lock_handler_t * pstHandler = &std_lock_handler_seqlock;
+	std_vector(int) v;
+	std_vector_lockhandler(int) vPinned;
+	std_lock_handle_t hLock;
+	std_lock_state_t eOldState;
+	std_lock_state_t eNestedState;
+	pthread_t tWriter;
+	size_t szNumTorn;
+	size_t szNumRetries;
+	int iPasses;
+	int iValue;
+	int i;
 
-	TEST_CONTAINER_NAME(v, "priority queue");
+	// Without a lock handler (or with one without optimistic reads), a read wrapper runs its body once
 	std_construct(v);
-	std_priorityqueue_compare_set(v, &int_compare);
-	TEST_SIZE(v, 0);
+	std_push_back(v, 5);
+	iPasses = 0;
+	for (std_container_read_wrapper(v))
+	{
+		iValue = *std_at(v, 0);
+		iPasses++;
+	}
+	TEST_SAME(v, iPasses, 1);
+	TEST_SAME(v, iValue, 5);
+	std_destruct(v);
 
-	szNum = std_push(v, 3, 1, 5, 2, 4);
-	TEST_SIZE(v, 5);
-	TEST_SAME(v, szNum, 5);
+	std_construct_lockhandler(vLockShared, pstHandler);
+	TEST_SAME(vLockShared, std_reserve(vLockShared, 2), true);
+	std_push_back(vLockShared, 1, -1);
+	hLock = vLockShared.stBody.stContainer.phLock;
 
-	szNum = std_pop(v, aiPopped, 10);
-	TEST_SIZE(v, 0);
-	TEST_SAME(v, szNum, 5);
-	TEST_ARRAY(aiPopped, ai54321);
+	// Wrapped reads take no lock, so a writer can get into the middle of one (which is then run again)
+	iPasses = 0;
+	for (std_container_read_wrapper(vLockShared))
+	{
+		iValue = *std_at(vLockShared, 0);
+		if (iPasses++ == 0)
+		{
+			TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Unlocked);
+		}
+	}
+	TEST_SAME(vLockShared, iPasses, 2);
+	TEST_SAME(vLockShared, iValue, 1);
+
+	// Ordinary reads take no lock either
+	eOldState = std_lock_for_reading(pstHandler, hLock, 0);
+	TEST_SAME(vLockShared, eOldState, e_std_lock_NoRestoreNeeded);
+	TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Unlocked);
+	std_lock_update(pstHandler, hLock, eOldState, 0);
+
+	// Writers exclude each other and keep readers waiting (who time out trying), but can read without waiting for themselves
+	eOldState = std_lock_for_writing(pstHandler, hLock, 0);
+	TEST_SAME(vLockShared, eOldState, e_std_lock_Unlocked);
+	eNestedState = std_lock_for_reading(pstHandler, hLock, 0);
+	TEST_SAME(vLockShared, eNestedState, e_std_lock_WriteLocked);
+	std_lock_update(pstHandler, hLock, eNestedState, 0);
+	TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 0), e_std_lock_Invalid);
+	TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_WriteLocked, 20), e_std_lock_Invalid);
+	TEST_SAME(vLockShared, lock_from_other_thread(pstHandler, hLock, e_std_lock_ReadLocked, 20), e_std_lock_Invalid);
+	iPasses = 0;
+	for (std_container_read_wrapper(vLockShared))
+	{
+		iPasses++;
+	}
+	TEST_SAME(vLockShared, iPasses, 1);
+	std_lock_update(pstHandler, hLock, eOldState, 0);
 
-	std_destruct(v);
-#endif
+	// A thread can write in the middle of its own wrapped read (which its own write doesn't make it run again)
+	iPasses = 0;
+	for (std_container_read_wrapper(vLockShared))
+	{
+		iPasses++;
+		for (std_container_lock_wrapper(vLockShared, false))
+		{
+			*std_at(vLockShared, 0) += 1;
+			*std_at(vLockShared, 1) -= 1;
+		}
+		iValue = *std_at(vLockShared, 0);
+	}
+	TEST_SAME(vLockShared, iPasses, 1);
+	TEST_SAME(vLockShared, iValue, 2);
+
+	// Readers alongside a writer are run again when it gets in, and never see a half-finished write (the pair always sums to zero)
+	szNumTorn = 0;
+	szNumRetries = 0;
+	atomic_store(&iNumBumps, 0);
+	for (i = 0; i < 100000; i++)
+	{
+		iPasses = 0;
+		for (std_container_read_wrapper(vLockShared))
+		{
+			iValue = *std_at(vLockShared, 0);
+			if ((i == 0) && (iPasses == 0))
+			{
+				// (Start the writer in the middle of the first read, so that at least that one is run again)
+				TEST_SAME(vLockShared, pthread_create(&tWriter, NULL, &bump_pair, (void *)(intptr_t) 100000), 0);
+				while (atomic_load(&iNumBumps) == 0)
+				{
+					sched_yield();
+				}
+			}
+			iValue += *std_at(vLockShared, 1);
+			iPasses++;
+		}
+		szNumRetries += (size_t)(iPasses - 1);
+		szNumTorn += (iValue != 0) ? 1U : 0U;
+	}
+	pthread_join(tWriter, NULL);
+	TEST_SAME(vLockShared, szNumTorn, 0);
+	TEST_SAME(vLockShared, (szNumRetries > 0), true);
+	TEST_SAME(vLockShared, *std_at(vLockShared, 0), 100002);
+	std_destruct(vLockShared);
+
+	// Optimistic readers could be looking at the items, so once allocated, they never move (pushing past them fails instead)
+	std_construct_lockhandler(vPinned, pstHandler);
+	TEST_SAME(vPinned, std_reserve(vPinned, 3), true);
+	TEST_SAME(vPinned, std_push_back(vPinned, 1, 2, 3, 4), 4);
+	TEST_SAME(vPinned, std_push_back(vPinned, 5), 0);
+	TEST_SAME(vPinned, std_reserve(vPinned, 5), false);
+	TEST_SIZE(vPinned, 4);
+	TEST_SAME(vPinned, *std_at(vPinned, 3), 4);
+	std_pop_back(vPinned, &iValue, 1);
+	TEST_SAME(vPinned, std_push_back(vPinned, 6), 1);
+	TEST_SAME(vPinned, *std_at(vPinned, 3), 6);
+	std_destruct(vPinned);
 	return true;
 }
 
-static bool prioritydeque_test(void)
-{
-#if 0
-	std_prioritydeque(int) v;
-
-	TEST_CONTAINER_NAME(v, "priority deque");
-	std_construct(v);
-	std_destruct(v);
 #endif
-	return true;
-}
 
 static bool vector_of_lists_test(void)
 {
@@ -1222,14 +4730,44 @@ int main(int argc, char * argv[])
 
 	bStatus = true;
 	if (bRunAll || strcmp(pachArg, "vector") == 0)			{	bStatus &= vector_test();			}
+	if (bRunAll || strcmp(pachArg, "soavector") == 0)		{	bStatus &= soa_vector_test();		}
 	if (bRunAll || strcmp(pachArg, "forwardlist") == 0)		{	bStatus &= forward_list_test();		}
 	if (bRunAll || strcmp(pachArg, "list") == 0)			{	bStatus &= list_test();				}
+	if (bRunAll || strcmp(pachArg, "unrolledlist") == 0)	{	bStatus &= unrolled_list_test();	}
+	if (bRunAll || strcmp(pachArg, "listsort") == 0)		{	bStatus &= list_sort_test();		}
+	if (bRunAll || strcmp(pachArg, "listsplice") == 0)		{	bStatus &= list_splice_test();		}
+	if (bRunAll || strcmp(pachArg, "listpool") == 0)		{	bStatus &= list_pool_test();		}
 	if (bRunAll || strcmp(pachArg, "deque") == 0)			{	bStatus &= deque_test();			}
 	if (bRunAll || strcmp(pachArg, "ring") == 0)			{	bStatus &= ring_test();				}
 	if (bRunAll || strcmp(pachArg, "queue") == 0)			{	bStatus &= queue_test();			}
 	if (bRunAll || strcmp(pachArg, "stack") == 0)			{	bStatus &= stack_test();			}
 	if (bRunAll || strcmp(pachArg, "priorityqueue") == 0)	{	bStatus &= priorityqueue_test();	}
 	if (bRunAll || strcmp(pachArg, "prioritydeque") == 0)	{	bStatus &= prioritydeque_test();	}
+	if (bRunAll || strcmp(pachArg, "indexedpriorityqueue") == 0)	{	bStatus &= indexed_priorityqueue_test();	}
+	if (bRunAll || strcmp(pachArg, "indexedpriorityqueueslots") == 0)	{	bStatus &= indexed_priorityqueue_slots_test();	}
+	if (bRunAll || strcmp(pachArg, "calendarqueue") == 0)	{	bStatus &= calendar_queue_test();	}
+	if (bRunAll || strcmp(pachArg, "radixheap") == 0)		{	bStatus &= radix_heap_test();		}
+	if (bRunAll || strcmp(pachArg, "skewheap") == 0)		{	bStatus &= skew_heap_test();		}
+	if (bRunAll || strcmp(pachArg, "unorderedset") == 0)	{	bStatus &= unordered_set_test();	}
+	if (bRunAll || strcmp(pachArg, "unorderedmap") == 0)	{	bStatus &= unordered_map_test();	}
+	if (bRunAll || strcmp(pachArg, "set") == 0)			{	bStatus &= set_test();	}
+	if (bRunAll || strcmp(pachArg, "multiset") == 0)	{	bStatus &= multiset_test();	}
+	if (bRunAll || strcmp(pachArg, "map") == 0)			{	bStatus &= map_test();	}
+	if (bRunAll || strcmp(pachArg, "splaytree") == 0)	{	bStatus &= splay_tree_test();	}
+	if (bRunAll || strcmp(pachArg, "flatset") == 0)		{	bStatus &= flat_set_test();	}
+	if (bRunAll || strcmp(pachArg, "flatmap") == 0)		{	bStatus &= flat_map_test();	}
+	if (bRunAll || strcmp(pachArg, "graph") == 0)		{	bStatus &= graph_test();	}
+	if (bRunAll || strcmp(pachArg, "slotmap") == 0)		{	bStatus &= slot_map_test();	}
+	if (bRunAll || strcmp(pachArg, "bitset") == 0)		{	bStatus &= bitset_test();	}
+	if (bRunAll || strcmp(pachArg, "sparseset") == 0)	{	bStatus &= sparse_set_test();	}
+	if (bRunAll || strcmp(pachArg, "sparsemap") == 0)	{	bStatus &= sparse_map_test();	}
+	if (bRunAll || strcmp(pachArg, "cache") == 0)		{	bStatus &= cache_test();	}
+	if (bRunAll || strcmp(pachArg, "concurrentmap") == 0)	{	bStatus &= concurrent_map_test();	}
+	if (bRunAll || strcmp(pachArg, "locksession") == 0)	{	bStatus &= lock_session_test();	}
+#if defined(STD_LOCK_HAS_PTHREADS) && defined(STD_LOCK_HAS_ATOMICS)
+	if (bRunAll || strcmp(pachArg, "lockhandlers") == 0)	{	bStatus &= lock_handlers_test();	}
+	if (bRunAll || strcmp(pachArg, "seqlock") == 0)		{	bStatus &= seqlock_test();	}
+#endif
 	if (bRunAll || strcmp(pachArg, "nested") == 0)			{	bStatus &= vector_of_lists_test();	}
 
 	return bStatus ? EXIT_SUCCESS : EXIT_FAILURE;
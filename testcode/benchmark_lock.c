@@ -0,0 +1,188 @@
+/*
+ * testcode/benchmark_lock.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+
+/*
+ * Compares the ready-made lock handlers under contention: for each one, T
+ * threads share a std_vector_lockhandler(int), each repeatedly pushing an
+ * item, reading R items (in a std_container_read_wrapper()) and popping an
+ * item, so that readers and writers both contend for the vector's lock.
+ * The vector's capacity is reserved up front (as the seqlock requires), so
+ * that pushing never reallocates it.
+ *
+ * Usage: LockBenchmark [operations per thread] [R]	(defaults to 200000 and 8;
+ *		try an R of 1000 or more for read-mostly containers)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "std/container.h"
+#include "std/lock_handlers.h"
+
+#define DEFAULT_NUM_OPS		200000U
+#define NUM_PREFILLED		1024
+#define DEFAULT_NUM_READS	8U
+#define MAX_THREADS			8U
+
+typedef struct
+{
+	const char * pszName;
+	const std_lock_handler_t * pstHandler;
+} named_handler_t;
+
+static const named_handler_t astHandlers[] =
+{
+	{ "pthread rwlock",	&std_lock_handler_pthread_rwlock },
+	{ "pthread mutex",	&std_lock_handler_pthread_mutex },
+	{ "spinlock",		&std_lock_handler_spinlock },
+	{ "ticket lock",	&std_lock_handler_ticketlock },
+	{ "seqlock",		&std_lock_handler_seqlock },
+};
+
+static const size_t aszThreadCounts[] = { 1U, 2U, 4U, MAX_THREADS };
+
+static std_vector_lockhandler(int) v;
+static size_t szOpsPerThread = DEFAULT_NUM_OPS;
+static size_t szReadsPerWrite = DEFAULT_NUM_READS;
+
+static double seconds_since(const struct timespec * pstStart)
+{
+	struct timespec stNow;
+
+	timespec_get(&stNow, TIME_UTC);
+	return (double)(stNow.tv_sec - pstStart->tv_sec) + ((double)(stNow.tv_nsec - pstStart->tv_nsec) / 1e9);
+}
+
+static void * worker(void * pvArg)
+{
+	uintptr_t uSeed = (uintptr_t) pvArg;
+	long lSum = 0;
+	long lRead = 0;
+	int iItem;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < szOpsPerThread; i += szReadsPerWrite + 2U)
+	{
+		std_push_back(v, (int) i);
+
+		for (std_container_read_wrapper(v))
+		{
+			lRead = 0;
+			for (j = 0; j < szReadsPerWrite; j++)
+			{
+				lRead += *std_at(v, (uSeed + i + j) % std_size(v));
+			}
+		}
+		lSum += lRead;
+
+		std_pop_back(v, &iItem, 1);
+		lSum += iItem;
+	}
+	return (void *)(intptr_t) lSum;
+}
+
+static bool benchmark_handler(const named_handler_t * pstNamed, size_t szNumThreads)
+{
+	pthread_t atThreads[MAX_THREADS];
+	struct timespec stStart;
+	double dSeconds;
+	int i;
+	size_t t;
+
+	std_construct_lockhandler(v, pstNamed->pstHandler);
+	if (!std_reserve(v, NUM_PREFILLED + MAX_THREADS))
+	{
+		std_destruct(v);
+		return false;
+	}
+	for (i = 0; i < NUM_PREFILLED; i++)
+	{
+		std_push_back(v, i);
+	}
+
+	timespec_get(&stStart, TIME_UTC);
+	for (t = 0; t < szNumThreads; t++)
+	{
+		if (pthread_create(&atThreads[t], NULL, &worker, (void *)(uintptr_t) t) != 0)
+		{
+			printf("%s: couldn't create thread\n", pstNamed->pszName);
+			szNumThreads = t;
+			break;
+		}
+	}
+	for (t = 0; t < szNumThreads; t++)
+	{
+		pthread_join(atThreads[t], NULL);
+	}
+	dSeconds = seconds_since(&stStart);
+
+	if (std_size(v) != NUM_PREFILLED)
+	{
+		printf("%s: vector ended up with %zu items\n", pstNamed->pszName, std_size(v));
+		std_destruct(v);
+		return false;
+	}
+	printf("%-16s %7zu %12.3f %12.0f\n", pstNamed->pszName, szNumThreads, dSeconds, (double)(szNumThreads * szOpsPerThread) / dSeconds);
+
+	std_destruct(v);
+	return true;
+}
+
+int main(int argc, char * argv[])
+{
+	bool bStatus = true;
+	size_t i;
+	size_t t;
+
+	if (argc > 1)
+	{
+		szOpsPerThread = (size_t)strtoull(argv[1], NULL, 10);
+		if (szOpsPerThread == 0U)
+		{
+			printf("Usage: %s [operations per thread] [reads per push/pop pair]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (argc > 2)
+	{
+		szReadsPerWrite = (size_t)strtoull(argv[2], NULL, 10);
+	}
+
+	printf("%zu operations per thread, %zu reads per push/pop pair\n", szOpsPerThread, szReadsPerWrite);
+	printf("handler          threads      seconds        ops/s\n");
+	for (i = 0; i < STD_NUM_ELEMENTS(astHandlers); i++)
+	{
+		for (t = 0; t < STD_NUM_ELEMENTS(aszThreadCounts); t++)
+		{
+			bStatus &= benchmark_handler(&astHandlers[i], aszThreadCounts[t]);
+		}
+	}
+
+	return bStatus ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,149 @@
+/*
+ * testcode/benchmark_priority_queue.c
+
+Copyright (c) 2024 Nick Pelling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/*
+ * Compares priority queue fan-outs by timing three workloads for each one:
+ * pushing N pseudo-random keys, popping them all again, and a "hold" model
+ * (repeatedly popping the next key and pushing a later one, as in a
+ * discrete-event simulator) on a queue holding N keys.
+ *
+ * Usage: PriorityQueueBenchmark [N]	(N defaults to 1000000; try up to 100000000)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "std/container.h"
+#include "std/stack.h"
+
+#define DEFAULT_NUM_ITEMS	1000000U
+#define NUM_HOLD_STEPS		1000000U
+
+static const size_t aszFanouts[] = { 2U, 4U, 8U, 16U };
+
+// Rank smaller keys later, so that std_pop() returns the smallest key first
+static int key_compare(const uint64_t * pu64A, const uint64_t * pu64B)
+{
+	return (*pu64A < *pu64B);
+}
+
+static uint64_t random_next(uint64_t * pu64State)
+{
+	// xorshift64
+	*pu64State ^= *pu64State << 13;
+	*pu64State ^= *pu64State >> 7;
+	*pu64State ^= *pu64State << 17;
+	return *pu64State;
+}
+
+static double seconds_since(clock_t tStart)
+{
+	return (double)(clock() - tStart) / (double)CLOCKS_PER_SEC;
+}
+
+static bool benchmark_fanout(size_t szFanout, size_t szNumItems)
+{
+	std_priorityqueue(uint64_t) pq;
+	uint64_t u64State = 0x9E3779B97F4A7C15ULL;
+	uint64_t u64Key;
+	uint64_t u64Last;
+	double dPush;
+	double dPop;
+	double dHold;
+	clock_t tStart;
+	size_t i;
+
+	std_construct(pq);
+	std_priorityqueue_compare_set(pq, &key_compare);
+	if (!std_priorityqueue_fanout_set(pq, szFanout) || !std_reserve(pq, szNumItems + 1U))
+	{
+		std_destruct(pq);
+		return false;
+	}
+
+	tStart = clock();
+	for (i = 0; i < szNumItems; i++)
+	{
+		u64Key = random_next(&u64State);
+		std_push(pq, u64Key);
+	}
+	dPush = seconds_since(tStart);
+
+	tStart = clock();
+	for (i = 0; i < NUM_HOLD_STEPS; i++)
+	{
+		std_pop(pq, &u64Key, 1);
+		u64Key += random_next(&u64State) >> 40;
+		std_push(pq, u64Key);
+	}
+	dHold = seconds_since(tStart);
+
+	tStart = clock();
+	u64Last = 0;
+	for (i = 0; i < szNumItems; i++)
+	{
+		std_pop(pq, &u64Key, 1);
+		if (u64Key < u64Last)
+		{
+			printf("fan-out %zu: keys popped out of order\n", szFanout);
+			std_destruct(pq);
+			return false;
+		}
+		u64Last = u64Key;
+	}
+	dPop = seconds_since(tStart);
+
+	printf("%7zu %12.3f %12.3f %12.3f\n", szFanout, dPush, dPop, dHold);
+
+	std_destruct(pq);
+	return true;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t szNumItems = DEFAULT_NUM_ITEMS;
+	bool bStatus = true;
+	size_t i;
+
+	if (argc > 1)
+	{
+		szNumItems = (size_t)strtoull(argv[1], NULL, 10);
+		if (szNumItems == 0U)
+		{
+			printf("Usage: %s [number of items]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("%zu items, %u hold steps (times in seconds)\n", szNumItems, NUM_HOLD_STEPS);
+	printf("fan-out         push          pop         hold\n");
+	for (i = 0; i < STD_NUM_ELEMENTS(aszFanouts); i++)
+	{
+		bStatus &= benchmark_fanout(aszFanouts[i], szNumItems);
+	}
+
+	return bStatus ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,7 +27,7 @@ SOFTWARE.
 
 #include "std/memory.h"
 
-extern std_memoryhandler_t stdMemoryCounter;
+extern std_memoryhandler_t stMemoryCounter;
 
 extern void memorycounter_reset(void);
 extern void memorycounter_grab(int* piMallocs, int* piReallocs, int* piFrees);